@@ -4,5 +4,8 @@
 #include "../../core/clsAdmin.h"
 #include "../../core/clsBankClient.h"
 
-clsAdmin CurrentAdmin = clsAdmin::Find("","");
-clsBankClient CurrentClient = clsBankClient::Find("","");
+// Session state: nobody is logged in at start-up. The empty objects are built
+// in memory, so no data file is read before main() (start-up cost does not
+// grow with Clients.txt / Admins.text).
+clsAdmin CurrentAdmin = clsAdmin::GetEmptyAdminObject();
+clsBankClient CurrentClient = clsBankClient::GetEmptyClientObject();
@@ -2,24 +2,22 @@
 
 #include <iostream>
 #include <iomanip>
-#include <thread>
-#include <chrono>
-#include <windows.h>
 
 #include "../../core/clsAdmin.h"
 #include "Global.h"
 #include "../../core/clsBankClient.h"
 #include "../../utils/clsInputValidate.h"
+#include "../../utils/clsTerminal.h"
 
 using namespace std;
 
 class clsScreen
 {
 protected:
-    // Change the text color in the console screen
+    // Change the text color in the console screen (console attribute, see clsTerminal)
     static void _SetColor(int color)
     {
-        SetConsoleTextAttribute(GetStdHandle(STD_OUTPUT_HANDLE), color);
+        clsTerminal::SetColor(color);
     }
     static void _printCentered(const string& text, int consoleWidth = 80) {
         int len = text.length();
@@ -32,7 +30,7 @@ protected:
     {
         if (ClearScreen)
         {
-            system("cls");
+            clsTerminal::ClearScreen();
         }
         _SetColor(14); // Gold for borders
         cout << "\n\n\t\t\t\t\t======================================";
@@ -87,8 +85,7 @@ protected:
         for (int i = 0; i < 15; i++)
         {
             cout << ".";
-            cout.flush();
-            this_thread::sleep_for(chrono::milliseconds(250));
+            clsTerminal::SleepFor(250);
         }
         cout << "\n\t\t\t\t\tPress any key to exit...";
         _SetColor(7);
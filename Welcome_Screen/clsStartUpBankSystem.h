@@ -3,6 +3,7 @@
 #include <iomanip>
 
 #include "../utils/clsInputValidate.h"
+#include "../core/clsSharedAccountTable.h"
 
 #include "base_screen/clsScreen.h"
 #include "startup/1)Login_As_Admin/clsAdminLoginScreen.h"
@@ -35,7 +36,7 @@ private:
     static void _GoBackToStartMenu()
     {
         cout << "Press any Key to Back Start Menu.";
-        system("pause>0");
+        clsTerminal::PressAnyKey();
         ShowStartUpMenu();
     }
 
@@ -45,14 +46,14 @@ private:
 
     static void _HandleLoginToAdminPanel()
     {
-        system("cls");
+        clsTerminal::ClearScreen();
         clsAdminLoginScreen::ShowLoginScreen();
         _GoBackToStartMenu();
     }
 
     static void _HandleOpenATMInterface()
     {
-        system("cls");
+        clsTerminal::ClearScreen();
         
         clsClientLoginScreen::ShowLoginScreen();
         _GoBackToStartMenu();
@@ -60,14 +61,14 @@ private:
 
     static void _HandleRegisterNewClient()
     {
-        system("cls");
+        clsTerminal::ClearScreen();
         clsCreatClientAccount::CreateNewClient();
         _GoBackToStartMenu();
     }
 
     static void _HandleRegisterNewAdmin()
     {
-        system("cls");
+        clsTerminal::ClearScreen();
         clsCreatAdminAccount::CreateNewAdmin();
         _GoBackToStartMenu();
     }
@@ -93,12 +94,14 @@ private:
             break;
 
         case eExitSystem:
-            system("cls");
+            clsTerminal::ClearScreen();
             _SetColor(10);
             cout << "\n"
                  << setw(37) << left << "" << "Exiting system...\n";
             _SetColor(7);
             _DrawEndScreen();
+            // shared mode: write the balances back before leaving
+            clsSharedAccountTable::Detach();
             exit(0);
             break;
         }
@@ -108,7 +111,7 @@ public:
 
     static void ShowStartUpMenu()
     {
-        system("cls");
+        clsTerminal::ClearScreen();
 
         // Title Box
         _SetColor(14); // Gold border
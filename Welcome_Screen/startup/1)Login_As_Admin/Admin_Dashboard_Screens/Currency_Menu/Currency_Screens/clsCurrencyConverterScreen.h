@@ -100,7 +100,7 @@ public:
         while (CalcAgain)
         {
 
-            system("cls");
+            clsTerminal::ClearScreen();
             _DrawScreenHeader("\tCurrency Calculation Screen");
 
             string CurrencyCodeFrom, CurrencyCodeTo;
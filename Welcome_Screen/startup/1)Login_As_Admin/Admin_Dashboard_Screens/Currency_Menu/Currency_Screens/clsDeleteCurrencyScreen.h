@@ -95,7 +95,7 @@ public:
         bool DeleteAgain = true;
         while (DeleteAgain)
         {
-            system("cls");
+            clsTerminal::ClearScreen();
             _DrawScreenHeader("\tDelete Currency Screen");
             cout << "Delete by [1] Currency Code or [2] Country?";
             _SetColor(12);
@@ -129,7 +129,7 @@ public:
                     _SetColor(14); // Yellow warning
                     cout << "\n⚠ Go back.\n";
                     _SetColor(7);
-                    Sleep(2000); // to make sure user read the message for 1 second
+                    clsTerminal::SleepFor(2000); // to make sure user read the message for 1 second
                     continue;
                 }
                 CurrencyCode = clsString::UpperAllString(CurrencyCode);
@@ -158,7 +158,7 @@ public:
                 }
                 if (cont)
                 {
-                    Sleep(2000); // to make sure user read the message for 1 second
+                    clsTerminal::SleepFor(2000); // to make sure user read the message for 1 second
                     continue;
                 } // go back to start of do while loop
             }
@@ -175,7 +175,7 @@ public:
                     _SetColor(14); // Yellow warning
                     cout << "\n⚠ Go back.\n";
                     _SetColor(7);
-                    Sleep(2000); // to make sure user read the message for 1 second
+                    clsTerminal::SleepFor(2000); // to make sure user read the message for 1 second
                     continue;
                 }
                 Country = clsString::UpperAllString(Country);
@@ -203,7 +203,7 @@ public:
                 }
                 if (cont)
                 {
-                    Sleep(2000); // to make sure user read the message for 1 second
+                    clsTerminal::SleepFor(2000); // to make sure user read the message for 1 second
                     continue;
                 } // go back to start of do while loop
             }
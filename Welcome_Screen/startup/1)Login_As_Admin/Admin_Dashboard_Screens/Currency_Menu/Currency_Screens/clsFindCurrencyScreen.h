@@ -62,7 +62,7 @@ Design Notes:
       - Red for errors
       - Yellow for warnings
 - Uses loops to allow multiple searches until the user decides to stop.
-- Uses Sleep() to give the user time to read important messages.
+- Uses clsTerminal::SleepFor() to give the user time to read important messages.
 
 ================================================================================
 Usage Example:
@@ -99,7 +99,7 @@ public:
         bool FindAgain = true;
         while (FindAgain)
         {
-            system("cls");
+            clsTerminal::ClearScreen();
             _DrawScreenHeader("\tFind Currency Screen");
             cout << "Found by [1] Currency Code or [2] Country?";
             _SetColor(12);
@@ -133,7 +133,7 @@ public:
                     _SetColor(14); // Yellow warning
                     cout << "\n⚠ WAIT TWO SEC TO GO BACK.\n";
                     _SetColor(7);
-                    Sleep(2000); // to make sure user read the message for 1 second
+                    clsTerminal::SleepFor(2000); // to make sure user read the message for 1 second
                     continue;
                 }
 
@@ -164,7 +164,7 @@ public:
                 }
                 if (cont)
                 {
-                    Sleep(2000); // to make sure user read the message for 1 second
+                    clsTerminal::SleepFor(2000); // to make sure user read the message for 1 second
                     continue;
                 } // go back to start of do while loop
             }
@@ -181,7 +181,7 @@ public:
                     _SetColor(14); // Yellow warning
                     cout << "\n⚠ Go back.\n";
                     _SetColor(7);
-                    Sleep(2000); // to make sure user read the message for 1 second
+                    clsTerminal::SleepFor(2000); // to make sure user read the message for 1 second
                     continue;
                 }
                 Country = clsString::UpperAllString(Country);
@@ -209,7 +209,7 @@ public:
                 }
                 if (cont)
                 {
-                    Sleep(2000); // to make sure user read the message for 1 second
+                    clsTerminal::SleepFor(2000); // to make sure user read the message for 1 second
                     continue;
                 } // go back to start of do while loop
             }
@@ -188,7 +188,7 @@ private:
             cout << "(0 to cancel)";
             _SetColor(7);
             cout << ": ";
-            AdminUserName = clsInputValidate::ReadString();
+            AdminUserName = clsInputValidate::ReadString("\nInvalid input, Enter again\n", clsAdminUsername::MaxLength);
 
             if (AdminUserName == "0") 
                 return AdminUserName;
@@ -257,6 +257,9 @@ public:
             cout << "\nError: Admin was not saved because AdminUsername is used!\n";
             _SetColor(7);
             break;
+
+        default:
+            break;
         }
     }
 };
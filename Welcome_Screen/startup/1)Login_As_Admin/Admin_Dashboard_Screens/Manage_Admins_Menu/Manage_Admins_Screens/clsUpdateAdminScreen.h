@@ -325,7 +325,7 @@ public:
         bool UpdateAgain = true;
         while (UpdateAgain)
         {
-            system("cls");
+            clsTerminal::ClearScreen();
             _DrawScreenHeader("\t   Update Admin Screen");
 
             string AdminUsername = _ReadAdminUsername();
@@ -384,6 +384,16 @@ public:
                     _SetColor(7);
                     break;
                 }
+                case clsAdmin::enSaveResults::svFaildVersionConflict:
+                {
+                    _SetColor(12);
+                    cout << "\nError Admin was not saved because another admin changed it while you were editing.";
+                    cout << "\nPlease update it again.\n";
+                    _SetColor(7);
+                    break;
+                }
+                default:
+                    break;
                 }
             }
             cout << "Do you want update another account? [1] Yes [0] No: ";
@@ -74,7 +74,7 @@ private:
             cout << "(0 to cancel)";
             _SetColor(7);
             cout << ": ";
-            AccountNumber = clsInputValidate::ReadString();
+            AccountNumber = clsInputValidate::ReadString("\nInvalid input, Enter again\n", clsAccountNumber::MaxLength);
 
             if (AccountNumber == "0")
                 return AccountNumber;
@@ -105,7 +105,7 @@ private:
         Client.SetPhone(clsInputValidate::ReadPhone());
 
         cout << "\nEnter PinCode: ";
-        Client.SetPinCode(clsInputValidate::ReadString());
+        Client.SetPinCode(clsInputValidate::ReadString("\nInvalid input, Enter again\n", clsPinCode::MaxLength));
 
         cout << "\nEnter Account Balance: ";
         Client.SetAccountBalance(clsInputValidate::ReadPositiveDouble());
@@ -170,6 +170,8 @@ public:
             _SetColor(7);
             break;
         }
+        default:
+            break;
         }
     }
 };
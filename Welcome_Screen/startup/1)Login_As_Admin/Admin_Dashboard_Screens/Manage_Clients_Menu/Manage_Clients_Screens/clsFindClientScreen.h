@@ -72,7 +72,7 @@ public:
         bool FindAgain = true;
         while (FindAgain)
         {
-            system("cls");
+            clsTerminal::ClearScreen();
 
             _DrawScreenHeader("\t Find Client Screen");
 
@@ -97,7 +97,7 @@ public:
                 }
             }
 
-            clsBankClient Client1 = clsBankClient::Find(AccountNumber);
+            clsBankClient Client1 = clsBankClient::FindReadOnly(AccountNumber);
 
             _SetColor(10); // green
             cout << "\nClient Found Successfully:-)\n";
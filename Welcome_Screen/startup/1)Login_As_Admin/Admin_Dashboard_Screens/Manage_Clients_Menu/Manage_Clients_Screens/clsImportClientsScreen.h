@@ -0,0 +1,166 @@
+/*clsImportClientsScreen Overview
+================================================================================
+                        clsImportClientsScreen.h
+================================================================================
+Overview:
+----------
+This file defines the clsImportClientsScreen class, which adds many clients at
+once from a CSV file through clsClientImporter.
+
+Main Features:
+--------------
+1. Reads the path of the CSV file (0 to cancel).
+2. Validates the whole file before writing anything and shows:
+   - rows read, valid rows and rejected rows
+   - the first rejected rows with their line number and reason
+3. Asks for confirmation, then writes all valid clients in one commit.
+
+Key Functions:
+--------------
+- _ReadCsvPath():
+   Private helper function to read the CSV path from the user.
+
+- _PrintRejectedRows(const clsClientImporter::stImportResult &Result):
+   Private function to print the rejected rows table.
+
+- ShowImportClientsScreen():
+   Public function that orchestrates reading, validating, confirming and importing.
+
+Notes:
+------
+- The class inherits protectedly from clsScreen to utilize screen helper functions.
+- CSV columns follow Clients.txt:
+     FirstName,LastName,Email,Phone,AccountNumber,PinCode,Balance
+- Only the first _MaxRejectedRowsShown rejected rows are listed on screen.
+
+Usage Example:
+--------------
+clsImportClientsScreen::ShowImportClientsScreen();
+================================================================================
+*/
+
+#pragma once
+
+#include <iostream>
+#include <string>
+#include <iomanip>
+
+#include "../../../../../../utils/clsInputValidate.h"
+#include "../../../../../base_screen/clsScreen.h"
+#include "../../../../../../core/clsClientImporter.h"
+
+using namespace std;
+
+class clsImportClientsScreen : protected clsScreen
+{
+
+private:
+    static const size_t _MaxRejectedRowsShown = 20;
+
+    static string _ReadCsvPath()
+    {
+        cout << "Please Enter CSV File Path ";
+        _SetColor(12);
+        cout << "(0 to cancel)";
+        _SetColor(7);
+        cout << ": ";
+        return clsInputValidate::ReadString();
+    }
+
+    static void _PrintRejectedRows(const clsClientImporter::stImportResult &Result)
+    {
+        cout << setw(8) << "" << "\t" << string(74, '_') << "\n\n";
+        cout << setw(8) << "" << "\t" << "| " << left << setw(8) << "Line";
+        cout << "| " << left << setw(16) << "Account Number";
+        cout << "| " << left << setw(44) << "Reason" << "|";
+        cout << endl << setw(8) << "" << "\t" << string(74, '_') << endl;
+
+        _SetColor(12);
+        for (size_t i = 0; i < Result.vRejected.size() && i < _MaxRejectedRowsShown; i++)
+        {
+            const clsClientImporter::stRejectedRow &Row = Result.vRejected[i];
+
+            cout << setw(8) << "" << "\t" << "| " << setw(8) << left << Row.LineNumber;
+            cout << "| " << setw(16) << left << Row.AccountNumber.substr(0, 15);
+            cout << "| " << setw(44) << left << Row.Reason.substr(0, 43) << "|" << endl;
+        }
+        _SetColor(7);
+
+        cout << setw(8) << "" << "\t" << string(74, '_') << endl;
+
+        if (Result.vRejected.size() > _MaxRejectedRowsShown)
+            cout << "\t\t... and " << Result.vRejected.size() - _MaxRejectedRowsShown << " more.\n";
+    }
+
+public:
+    static void ShowImportClientsScreen()
+    {
+        _DrawScreenHeader("\t  Import Clients Screen", "\t  CSV File -> Clients.txt");
+
+        cout << "Columns: FirstName,LastName,Email,Phone,AccountNumber,PinCode,Balance\n\n";
+
+        string CsvPath = _ReadCsvPath();
+        if (CsvPath == "0")
+        {
+            _SetColor(14); // Yellow warning
+            cout << "\n⚠ Operation Cancelled.\n\a";
+            _SetColor(7);
+            return;
+        }
+
+        clsClientImporter::stImportResult Result = clsClientImporter::Prepare(CsvPath);
+        if (!Result.FileFound)
+        {
+            _SetColor(4);
+            cout << "\nError: cannot open [ " << CsvPath << " ].\n";
+            _SetColor(7);
+            return;
+        }
+
+        _SetColor(11);
+        cout << "\nRows Read   : " << Result.Rows;
+        _SetColor(10);
+        cout << "\nValid       : " << Result.vClients.size();
+        _SetColor(12);
+        cout << "\nRejected    : " << Result.vRejected.size();
+        _SetColor(11);
+        cout << "\nChecked in  : " << Result.Seconds << " s\n\n";
+        _SetColor(7);
+
+        if (!Result.vRejected.empty())
+            _PrintRejectedRows(Result);
+
+        if (Result.vClients.empty())
+        {
+            _SetColor(14);
+            cout << "\nNothing to import.\n";
+            _SetColor(7);
+            return;
+        }
+
+        cout << "\nAre you sure you want to import " << Result.vClients.size() << " client(s) (Y/N)? ";
+        char Answer = clsInputValidate::ReadYesOrNo();
+        if (Answer != 'Y' && Answer != 'y')
+        {
+            _SetColor(14);
+            cout << "\n⚠ Operation Cancelled.\n";
+            _SetColor(7);
+            return;
+        }
+
+        size_t RejectedBefore = Result.vRejected.size();
+        clsClientImporter::Commit(Result);
+
+        _SetColor(10);
+        cout << "\n" << Result.Imported << " Client(s) Imported Successfully :-)\n";
+        _SetColor(7);
+
+        if (Result.vRejected.size() > RejectedBefore)
+        {
+            _SetColor(14);
+            cout << Result.vRejected.size() - RejectedBefore
+                 << " client(s) skipped: account number was added by someone else meanwhile.\n";
+            _SetColor(7);
+        }
+    }
+};
@@ -21,7 +21,7 @@ Main Features:
 
 Key Functions:
 --------------
-- _PrintClientRecordBalanceLine(clsBankClient Client):
+- _PrintClientRecordBalanceLine(const clsAccountTable& Table, size_t Index):
    Private function to print a single client's balance row.
 
 - _PrintTotalBalance(double TotalBalances):
@@ -34,7 +34,11 @@ Key Functions:
 Notes:
 ------
 - The class inherits protectedly from clsScreen to use screen helper functions.
-- Relies on clsBankClient to fetch client list and calculate total balances.
+- Relies on clsAccountTable: the total streams the dense balance array and
+  only the account number / name of each printed row is decoded from the
+  cold store, so the file is read once instead of twice.
+- The table is the published one (clsClientTableRcu): no file read and no
+  lock while the list is printed; ATM writers are not held up.
 - Uses clsUtil::NumberToText to convert numeric total balance into text.
 - Uses _SetColor for colored output to enhance readability.
 
@@ -54,18 +58,20 @@ clsTotalBalancesScreen::ShowTotalBalancesScreen();
 #include "../../../../../../utils/clsUtil.h"
 #include "../../../../../base_screen/clsScreen.h"
 #include "../../../../../../core/clsBankClient.h"
+#include "../../../../../../core/clsAccountTable.h"
+#include "../../../../../../core/clsClientTableRcu.h"
 
 
 class clsTotalBalancesScreen : protected clsScreen
 {
 
 private:
-    static void _PrintClientRecordBalanceLine(clsBankClient Client)
+    static void _PrintClientRecordBalanceLine(const clsAccountTable &Table, size_t Index)
     {
 
-        cout << setw(8) << "" << "\t"<<"| " << setw(15) << left << Client.GetAccountNumber();
-        cout << "| " << setw(40) << left << Client.FullName();
-        cout << "| " << setw(12) << left << Client.GetAccountBalance()<<"|";
+        cout << setw(8) << "" << "\t"<<"| " << setw(15) << left << Table.GetAccountNumber(Index);
+        cout << "| " << setw(40) << left << Table.GetFullName(Index);
+        cout << "| " << setw(12) << left << (float)Table.GetBalance(Index)<<"|";
     }
     static void _PrintTotalBalance(double TotalBalances)
     {
@@ -85,13 +91,13 @@ private:
 public:
     static void ShowTotalBalancesScreen()
     {
-        vector<clsBankClient> vClients = clsBankClient::GetClientsList();
+        clsClientTableRcu::clsReadGuard Table; // published table, no lock
         
         string subtitle = "\tBalances List ";
-        if (vClients.size() == 0)
+        if (Table->Size() == 0)
             subtitle += "(0) No Clients.";
         else
-            subtitle += "(" + to_string(vClients.size()) + ") Client" + (vClients.size() > 1 ? "s." : ".");
+            subtitle += "(" + to_string(Table->Size()) + ") Client" + (Table->Size() > 1 ? "s." : ".");
             
         _DrawScreenHeader("\t Total Balances Screen",subtitle);
         // Draw Table Header
@@ -102,9 +108,9 @@ public:
         cout << "| " << left << setw(12) << "Balance"<< "|";
         cout << setw(8) << "" << "\t"<<endl << setw(8) << "" << "\t"<< string(74, '_') << endl;
 
-        double TotalBalances = clsBankClient::GetTotalBalances();
+        double TotalBalances = Table->GetTotalBalances();
 
-        if (vClients.size() == 0)
+        if (Table->Size() == 0)
         {
             _SetColor(14);
             cout << "\t\t\t\tNo Clients Available In the System!";
@@ -113,9 +119,9 @@ public:
 
         else
         {
-            for (const clsBankClient &Client : vClients)
+            for (size_t i = 0; i < Table->Size(); i++)
             {
-                _PrintClientRecordBalanceLine(Client);
+                _PrintClientRecordBalanceLine(*Table, i);
                 cout << endl;
             }
         }
@@ -90,7 +90,7 @@ private:
         Client.SetPhone(clsInputValidate::ReadPhone());
 
         cout << "\nEnter PinCode: ";
-        Client.SetPinCode(clsInputValidate::ReadString());
+        Client.SetPinCode(clsInputValidate::ReadString("\nInvalid input, Enter again\n", clsPinCode::MaxLength));
 
         cout << "\nEnter Account Balance: ";
         Client.SetAccountBalance(clsInputValidate::ReadPositiveDouble());
@@ -151,7 +151,7 @@ private:
 
             case ePinCode:
                 cout << "\nEnter New Pin Code: ";
-                Client.SetPinCode(clsInputValidate::ReadString());
+                Client.SetPinCode(clsInputValidate::ReadString("\nInvalid input, Enter again\n", clsPinCode::MaxLength));
                 break;
 
             case eAccountBalance:
@@ -258,6 +258,22 @@ public:
             cout << "Error: Account was not saved because it's empty.\n";
             _SetColor(7);
             break;
+
+        case clsBankClient::enSaveResults::svFaildVersionConflict:
+            _SetColor(12); // Red
+            cout << "Error: Account was not saved because it was changed by another user\n";
+            cout << "       (transaction or update) while you were editing. Please update it again.\n";
+            _SetColor(7);
+            break;
+
+        case clsBankClient::enSaveResults::svFaildNotFound:
+            _SetColor(12); // Red
+            cout << "Error: Account was not saved because it was deleted by another user.\n";
+            _SetColor(7);
+            break;
+
+        default:
+            break;
         }
 
         cout << "\n======================================\n";
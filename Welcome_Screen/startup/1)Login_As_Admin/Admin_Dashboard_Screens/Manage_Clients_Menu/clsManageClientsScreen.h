@@ -7,7 +7,7 @@ Overview:
 This file defines the Manage Clients Menu Screen — a controller screen responsible
 for navigating all Client-management operations in the system.
 It displays a menu, reads the user's choice, and directs the workflow to the
-correct sub-screen (List, Add, Find, Update, Delete, Login History).
+correct sub-screen (List, Add, Find, Update, Delete, Login History, Import).
 
 It does NOT modify data directly; it only calls other screens that contain the
 real logic.
@@ -17,7 +17,7 @@ Class Responsibilities:
 -----------------------
 
 1. Display the "Manage Clients" menu.
-2. Read and validate user input (1 to 7).
+2. Read and validate user input (1 to 8).
 3. Redirect the user to the appropriate screen:
       - List Clients
       - Add New Client
@@ -25,6 +25,7 @@ Class Responsibilities:
       - Update Client
       - Delete Client
       - Client Login Register History
+      - Import Clients (CSV)
 4. Offer a "Go Back" mechanism that returns to the menu after each operation.
 5. Keep UI consistency using clsScreen (headers, colors, formatting).
 
@@ -38,7 +39,8 @@ Menu Options:
     4 → Update Client
     5 → Delete Admin
     6 → Client Login Register History
-    7 → Return to Main Menu
+    7 → Import Clients (CSV)
+    8 → Return to Main Menu
 
 The options are represented internally using the enum:
 
@@ -52,7 +54,7 @@ The method:
 
     _ReadManageClientsMenuOption()
 
-uses clsInputValidate to ensure the user Enters a number between 1 and 7.
+uses clsInputValidate to ensure the user Enters a number between 1 and 8.
 Invalid input never crashes the system.
 
 ================================================================================
@@ -76,6 +78,7 @@ Each helper like `_ShowListClientsScreen()` simply calls the corresponding class
     clsUpdateClientScreen::ShowUpdateClientScreen();
     clsDeleteClientScreen::ShowDeleteAdminScreen();
     clsClientsSessionLogScreen::ShowClientsSessionLogScreen();
+    clsImportClientsScreen::ShowImportClientsScreen();
 
 This preserves clean separation between menu logic and actual features.
 
@@ -128,6 +131,7 @@ Usage Example (from Main Menu):
 #include "Manage_Clients_Screens/clsDeleteClientScreen.h"
 #include "Manage_Clients_Screens/clsClientsSessionLogScreen.h"
 #include "Manage_Clients_Screens/clsTotalBalancesScreen.h"
+#include "Manage_Clients_Screens/clsImportClientsScreen.h"
 
 using namespace std;
 
@@ -142,20 +146,21 @@ private:
         eUpdateClient = 4,
         eDeleteClient = 5,
         eClientsSessions = 6,
+        eImportClients = 7,
         eMainMenu
     };
 
     static short _ReadManageClientsMenuOption()
     {
-        cout << setw(37) << left << "" << "Choose what do you want to do? [1 to 7]? ";
-        short Choice = clsInputValidate::ReadIntNumberBetween(1, 7, "Enter Number between 1 to 7? ");
+        cout << setw(37) << left << "" << "Choose what do you want to do? [1 to 8]? ";
+        short Choice = clsInputValidate::ReadIntNumberBetween(1, 8, "Enter Number between 1 to 8? ");
         return Choice;
     }
 
     static void _GoBackToManageClientsMenu()
     {
         cout << "\n\nPress any key to go back to Manage Clients Menu...";
-        system("pause>0");
+        clsTerminal::PressAnyKey();
         ShowManageClientsMenu();
     }
     
@@ -231,45 +236,58 @@ private:
     static void _ShowClientSessionsHistory(){
         clsClientsSessionLogScreen::ShowClientsSessionLogScreen();
     }
+    static void _ShowImportClientsScreen()
+    {
+        if (!CheckAccessRights(clsAdmin::enPermissions::pAddNewClient))
+        {
+            return; // importing adds clients, same right as Add New Client
+        }
+        clsImportClientsScreen::ShowImportClientsScreen();
+    }
 
     static void _PerformManageClientsMenuOption(enManageClientsMenuOptions ManageClientsMenuOption)
     {
         switch (ManageClientsMenuOption)
         {
         case enManageClientsMenuOptions::eListClients:
-            system("cls");
+            clsTerminal::ClearScreen();
             _ShowAllClientsScreen();
             _GoBackToManageClientsMenu();
             break;
 
         case enManageClientsMenuOptions::eAddNewClient:
-            system("cls");
+            clsTerminal::ClearScreen();
             _AddNewClientScreen();
             _GoBackToManageClientsMenu();
             break;
 
         case enManageClientsMenuOptions::eFindClient:
-            system("cls");
+            clsTerminal::ClearScreen();
             _ShowFindClientScreen();
             _GoBackToManageClientsMenu();
             break;
 
         case enManageClientsMenuOptions::eUpdateClient:
-            system("cls");
+            clsTerminal::ClearScreen();
             _ShowUpdateClientScreen();
             _GoBackToManageClientsMenu();
             break;
 
         case enManageClientsMenuOptions::eDeleteClient:
-            system("cls");
+            clsTerminal::ClearScreen();
             _ShowDeleteClientScreen();
             _GoBackToManageClientsMenu();
             break;
         case enManageClientsMenuOptions::eClientsSessions:
-            system("cls");
+            clsTerminal::ClearScreen();
             _ShowClientSessionsHistory();
             _GoBackToManageClientsMenu();
             break;
+        case enManageClientsMenuOptions::eImportClients:
+            clsTerminal::ClearScreen();
+            _ShowImportClientsScreen();
+            _GoBackToManageClientsMenu();
+            break;
         case enManageClientsMenuOptions::eMainMenu:
             // do nothing, main screen will handle it :-)
             break;
@@ -279,7 +297,7 @@ private:
 public:
     static void ShowManageClientsMenu()
     {
-        system("cls");
+        clsTerminal::ClearScreen();
         _DrawScreenHeader("\tManage Clients Screen");
         cout << setw(37) << left << "" << "===========================================\n";
         cout << setw(37) << left << "" << "\t\t  Manage Clients Menu\n";
@@ -290,7 +308,8 @@ public:
         cout << setw(37) << left << "" << "\t[4] Update Client.\n";
         cout << setw(37) << left << "" << "\t[5] Delete Client.\n";
         cout << setw(37) << left << "" << "\t[6] Clients Sessions History.\n";
-        cout << setw(37) << left << "" << "\t[7] Main Menu.\n";
+        cout << setw(37) << left << "" << "\t[7] Import Clients (CSV).\n";
+        cout << setw(37) << left << "" << "\t[8] Main Menu.\n";
         cout << setw(37) << left << "" << "===========================================\n";
         _PerformManageClientsMenuOption((enManageClientsMenuOptions)_ReadManageClientsMenuOption());
     }
@@ -0,0 +1,148 @@
+/*clsMetricsScreen Overview
+================================================================================
+                           clsMetricsScreen.h
+================================================================================
+Overview:
+----------
+This file defines the clsMetricsScreen class, which displays the latency of
+every instrumented core operation (clsMetrics) since the program started.
+
+Main Features:
+--------------
+1. Displays a table with one row per operation:
+   - Operation
+   - Count and Rate (operations per second since start)
+   - Mean, p50, p95, p99 and Max latency in milliseconds
+2. Operations that were never called are shown in gray.
+3. Lets the admin reset all counters after reading them.
+4. Shows a notice instead of the table when the program was built with
+   -DSMARTBANK_DISABLE_METRICS.
+
+Key Functions:
+--------------
+- _FormatMs(double Nanoseconds):
+   Private function that formats a latency in milliseconds.
+
+- _PrintOperationLine(clsMetrics::enOperation Operation, double Seconds):
+   Private function to print a single operation row.
+
+- ShowMetricsScreen():
+   Public function that draws the header, the table and the reset prompt.
+
+Notes:
+------
+- The class inherits protectedly from clsScreen to use screen helper functions.
+- Percentiles come from clsLatencyHistogram buckets, so they are accurate to
+  a few percent; Max is exact.
+
+Usage Example:
+--------------
+clsMetricsScreen::ShowMetricsScreen();
+================================================================================
+*/
+
+#pragma once
+
+#include <iostream>
+#include <string>
+#include <iomanip>
+#include <sstream>
+
+#include "../../../../../utils/clsInputValidate.h"
+#include "../../../../base_screen/clsScreen.h"
+#include "../../../../../core/clsMetrics.h"
+
+class clsMetricsScreen : protected clsScreen
+{
+
+private:
+    static string _FormatMs(double Nanoseconds)
+    {
+        ostringstream Stream;
+        Stream << fixed << setprecision(3) << Nanoseconds / 1e6;
+        return Stream.str();
+    }
+
+    static void _PrintStartupLine()
+    {
+        ostringstream Startup;
+        Startup << fixed << setprecision(3) << clsMetrics::StartupMilliseconds();
+
+        _SetColor(clsMetrics::IsStartupWithinBudget() ? 10 : 12);
+        cout << setw(8) << "" << "\t" << "Startup: " << Startup.str() << " ms"
+             << " (budget " << clsMetrics::StartupBudgetMs << " ms)\n\n";
+        _SetColor(7);
+    }
+
+    static void _PrintOperationLine(clsMetrics::enOperation Operation, double Seconds)
+    {
+        clsLatencyHistogram::stSnapshot Snapshot = clsMetrics::Histogram(Operation).GetSnapshot();
+
+        ostringstream Rate;
+        Rate << fixed << setprecision(1) << ((Seconds > 0) ? Snapshot.Count / Seconds : 0.0);
+
+        _SetColor(Snapshot.Count == 0 ? 8 : 7); // Gray for operations never called
+
+        cout << setw(8) << "" << "\t" << "| " << setw(30) << left << clsMetrics::OperationName(Operation);
+        cout << "| " << setw(10) << left << Snapshot.Count;
+        cout << "| " << setw(9) << left << Rate.str();
+        cout << "| " << setw(9) << left << _FormatMs(Snapshot.Mean());
+        cout << "| " << setw(9) << left << _FormatMs(Snapshot.Percentile(50));
+        cout << "| " << setw(9) << left << _FormatMs(Snapshot.Percentile(95));
+        cout << "| " << setw(9) << left << _FormatMs(Snapshot.Percentile(99));
+        cout << "| " << setw(9) << left << _FormatMs((double)Snapshot.MaxNanos) << "|";
+
+        _SetColor(7);
+    }
+
+public:
+    static void ShowMetricsScreen()
+    {
+        double Seconds = clsMetrics::SecondsSinceStart();
+
+        ostringstream Uptime;
+        Uptime << fixed << setprecision(0) << Seconds;
+
+        _DrawScreenHeader("\t Performance Metrics Screen", "\tUptime: " + Uptime.str() + " second(s)");
+
+        if (!clsMetrics::IsEnabled())
+        {
+            _SetColor(14);
+            _printCentered("Metrics are disabled in this build (SMARTBANK_DISABLE_METRICS).");
+            _SetColor(7);
+            return;
+        }
+
+        _PrintStartupLine();
+
+        // Draw Table Header
+        cout << setw(8) << "" << "\t" << "Latencies in ms\n"
+             << setw(8) << "" << "\t" << string(113, '_') << "\n\n";
+        cout << setw(8) << "" << "\t" << "| " << left << setw(30) << "Operation";
+        cout << "| " << left << setw(10) << "Count";
+        cout << "| " << left << setw(9) << "Rate/s";
+        cout << "| " << left << setw(9) << "Mean";
+        cout << "| " << left << setw(9) << "p50";
+        cout << "| " << left << setw(9) << "p95";
+        cout << "| " << left << setw(9) << "p99";
+        cout << "| " << left << setw(9) << "Max" << "|";
+        cout << endl << setw(8) << "" << "\t" << string(113, '_') << endl;
+
+        for (int i = 0; i < clsMetrics::OperationCount; i++)
+        {
+            _PrintOperationLine((clsMetrics::enOperation)i, Seconds);
+            cout << endl;
+        }
+        cout << setw(8) << "" << "\t" << string(113, '_') << endl;
+
+        cout << "\n\tDo you want to reset all counters? (Y/N)? ";
+        char Answer = clsInputValidate::ReadYesOrNo();
+        if (Answer == 'Y' || Answer == 'y')
+        {
+            clsMetrics::ResetAll();
+            _SetColor(10);
+            cout << "\n\tCounters reset successfully.\n";
+            _SetColor(7);
+        }
+    }
+};
@@ -0,0 +1,187 @@
+/*clsBatchPaymentsScreen Overview
+================================================================================
+                        clsBatchPaymentsScreen.h
+================================================================================
+Overview:
+----------
+This file defines the clsBatchPaymentsScreen class, which posts a file of
+payment instructions (payroll, mass deposits, bulk transfers) through
+clsBatchPaymentEngine.
+
+Main Features:
+--------------
+1. Reads the path of the instruction file (0 to cancel).
+2. Simulates the whole batch first and shows:
+   - instructions, postings, rejected lines
+   - total amount and number of accounts touched
+   - the first rejected lines with their reason
+3. Asks for confirmation, then writes all balances and the log in one commit.
+
+Key Functions:
+--------------
+- _ReadFilePath():
+   Private helper function to read the instruction file path.
+
+- _PrintSummary(const clsBatchPaymentEngine::stBatchResult &Result):
+   Private function to print the counters of a prepared or committed batch.
+
+- _PrintRejectedLines(const clsBatchPaymentEngine::stBatchResult &Result):
+   Private function to print the rejected lines table.
+
+- ShowBatchPaymentsScreen():
+   Public function that orchestrates reading, simulating, confirming and posting.
+
+Notes:
+------
+- The class inherits protectedly from clsScreen to utilize screen helper functions.
+- Instruction lines are "from,to,amount"; "-" as from is a deposit, "-" as to
+  is a withdrawal.
+- Postings are logged as admin operations by the current admin.
+
+Usage Example:
+--------------
+clsBatchPaymentsScreen::ShowBatchPaymentsScreen();
+================================================================================
+*/
+
+#pragma once
+
+#include <iostream>
+#include <string>
+#include <iomanip>
+
+#include "../../../../../../utils/clsInputValidate.h"
+#include "../../../../../base_screen/clsScreen.h"
+#include "../../../../../../core/clsBatchPaymentEngine.h"
+
+using namespace std;
+
+class clsBatchPaymentsScreen : protected clsScreen
+{
+
+private:
+    static const size_t _MaxRejectedLinesShown = 20;
+
+    static string _ReadFilePath()
+    {
+        cout << "Please Enter Instructions File Path ";
+        _SetColor(12);
+        cout << "(0 to cancel)";
+        _SetColor(7);
+        cout << ": ";
+        return clsInputValidate::ReadString();
+    }
+
+    static void _PrintSummary(const clsBatchPaymentEngine::stBatchResult &Result)
+    {
+        _SetColor(11);
+        cout << "\nInstructions     : " << Result.vInstructions.size();
+        _SetColor(10);
+        cout << "\nPostings         : " << Result.Posted;
+        _SetColor(12);
+        cout << "\nRejected         : " << Result.vRejected.size();
+        _SetColor(11);
+        cout << "\nTotal Amount     : " << fixed << setprecision(2) << Result.TotalAmount;
+        cout << "\nAccounts Touched : " << Result.AccountsTouched;
+        cout << "\nTime             : " << setprecision(3) << Result.Seconds << " s\n";
+        cout.unsetf(ios::fixed);
+        cout << setprecision(6);
+        _SetColor(7);
+    }
+
+    static void _PrintRejectedLines(const clsBatchPaymentEngine::stBatchResult &Result)
+    {
+        cout << "\n" << setw(8) << "" << "\t" << string(84, '_') << "\n\n";
+        cout << setw(8) << "" << "\t" << "| " << left << setw(8) << "Line";
+        cout << "| " << left << setw(44) << "Instruction";
+        cout << "| " << left << setw(26) << "Reason" << "|";
+        cout << endl << setw(8) << "" << "\t" << string(84, '_') << endl;
+
+        _SetColor(12);
+        for (size_t i = 0; i < Result.vRejected.size() && i < _MaxRejectedLinesShown; i++)
+        {
+            const clsBatchPaymentEngine::stRejectedPosting &Line = Result.vRejected[i];
+
+            cout << setw(8) << "" << "\t" << "| " << setw(8) << left << Line.LineNumber;
+            cout << "| " << setw(44) << left << Line.Instruction.substr(0, 43);
+            cout << "| " << setw(26) << left << Line.Reason.substr(0, 25) << "|" << endl;
+        }
+        _SetColor(7);
+
+        cout << setw(8) << "" << "\t" << string(84, '_') << endl;
+
+        if (Result.vRejected.size() > _MaxRejectedLinesShown)
+            cout << "\t\t... and " << Result.vRejected.size() - _MaxRejectedLinesShown << " more.\n";
+    }
+
+public:
+    static void ShowBatchPaymentsScreen()
+    {
+        _DrawScreenHeader("\t  Batch Payments Screen", "\t  from,to,amount per line");
+
+        string FilePath = _ReadFilePath();
+        if (FilePath == "0")
+        {
+            _SetColor(14); // Yellow warning
+            cout << "\n⚠ Operation Cancelled.\n\a";
+            _SetColor(7);
+            return;
+        }
+
+        clsBatchPaymentEngine::stBatchResult Result =
+            clsBatchPaymentEngine::Prepare(FilePath, CurrentAdmin.GetAdminUsername());
+
+        if (!Result.FileFound)
+        {
+            _SetColor(4);
+            cout << "\nError: cannot open [ " << FilePath << " ].\n";
+            _SetColor(7);
+            return;
+        }
+
+        _PrintSummary(Result);
+
+        if (!Result.vRejected.empty())
+            _PrintRejectedLines(Result);
+
+        if (Result.Posted == 0)
+        {
+            _SetColor(14);
+            cout << "\nNothing to post.\n";
+            _SetColor(7);
+            return;
+        }
+
+        cout << "\nAre you sure you want to post " << Result.Posted << " payment(s) (Y/N)? ";
+        char Answer = clsInputValidate::ReadYesOrNo();
+        if (Answer != 'Y' && Answer != 'y')
+        {
+            _SetColor(14);
+            cout << "\n⚠ Operation Cancelled.\n";
+            _SetColor(7);
+            return;
+        }
+
+        size_t PreparedPostings = Result.Posted;
+        if (!clsBatchPaymentEngine::Commit(Result))
+        {
+            _SetColor(12);
+            cout << "\nError: nothing was posted, " << Result.vConflicts.size()
+                 << " account(s) kept changing during the commit. Try again.\n";
+            _SetColor(7);
+            return;
+        }
+
+        _SetColor(10);
+        cout << "\n" << Result.Posted << " Payment(s) Posted Successfully :-)\n";
+        _SetColor(7);
+
+        if (Result.Posted != PreparedPostings)
+        {
+            _SetColor(14);
+            cout << "Balances changed since the preview; the committed batch:\n";
+            _SetColor(7);
+            _PrintSummary(Result);
+        }
+    }
+};
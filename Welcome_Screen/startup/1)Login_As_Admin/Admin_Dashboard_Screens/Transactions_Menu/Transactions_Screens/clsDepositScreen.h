@@ -118,7 +118,13 @@ public:
 
         if (Answer == 'Y' || Answer == 'y')
         {
-            Client1.Deposit(Amount);
+            if (Client1.Deposit(Amount) != clsBankClient::enTransactionResults::trSucceeded)
+            {
+                _SetColor(12);
+                cout << "\nCannot deposit, the account was deleted by another user.\n";
+                _SetColor(7);
+                return;
+            }
             clsTransactionLogger::LogAdminDeposit(CurrentAdmin,Client1,Amount);
             _SetColor(10); // green
             cout << "\n________________________________";
@@ -0,0 +1,292 @@
+/*clsStandingOrdersScreen Overview
+================================================================================
+                        clsStandingOrdersScreen.h
+================================================================================
+Overview:
+----------
+This file defines the clsStandingOrdersScreen class, which lists, adds and
+cancels standing orders (recurring transfers) and can post the due ones
+immediately through clsStandingOrders.
+
+Main Features:
+--------------
+1. Lists all standing orders (id, accounts, amount, frequency, next due date).
+2. Adds an order: source and destination clients, amount, weekly / monthly,
+   first due date (dd/mm/yyyy).
+3. Cancels an order by id.
+4. Runs the due orders now and shows posted / rejected payments.
+
+Key Functions:
+--------------
+- _PrintOrdersTable(): Private function to print the orders table.
+- _ReadExistingAccount(const string &Prompt): Private helper that reads an
+  account number of an existing client (0 to cancel).
+- _ReadDate(): Private helper that reads a valid dd/mm/yyyy date.
+- _AddOrder(), _CancelOrder(), _RunDueOrders(): Private functions for each action.
+- ShowStandingOrdersScreen(): Public function that shows the list and runs
+  the chosen action.
+
+Notes:
+------
+- The class inherits protectedly from clsScreen to utilize screen helper functions.
+- Due orders are also posted automatically every time the start-up menu is
+  shown, so this screen is only needed to post them at once.
+
+Usage Example:
+--------------
+clsStandingOrdersScreen::ShowStandingOrdersScreen();
+================================================================================
+*/
+
+#pragma once
+
+#include <iostream>
+#include <string>
+#include <iomanip>
+
+#include "../../../../../../utils/clsInputValidate.h"
+#include "../../../../../../utils/clsDate.h"
+#include "../../../../../base_screen/clsScreen.h"
+#include "../../../../../base_screen/Global.h"
+#include "../../../../../../core/clsBankClient.h"
+#include "../../../../../../core/clsStandingOrders.h"
+
+using namespace std;
+
+class clsStandingOrdersScreen : protected clsScreen
+{
+
+private:
+    enum enStandingOrdersOptions
+    {
+        eAddOrder = 1,
+        eCancelOrder = 2,
+        eRunDueOrders = 3,
+        eBack = 4
+    };
+
+    static void _PrintOrderRecordLine(const clsStandingOrders::stStandingOrder &Order)
+    {
+        cout << setw(8) << "" << "\t| " << setw(6) << left << Order.Id;
+        cout << "| " << setw(15) << left << Order.FromAccount;
+        cout << "| " << setw(15) << left << Order.ToAccount;
+        cout << "| " << setw(12) << left << fixed << setprecision(2) << Order.Amount;
+        cout << "| " << setw(10) << left << clsStandingOrders::FrequencyName(Order.Frequency);
+        cout << "| " << setw(12) << left << Order.NextDueDate().DateToString();
+        cout << "| " << setw(14) << left << Order.CreatedBy << "|";
+        cout.unsetf(ios::fixed);
+        cout << setprecision(6);
+    }
+
+    static void _PrintOrdersTable(const vector<clsStandingOrders::stStandingOrder> &vOrders)
+    {
+        cout << setw(8) << "" << "\t" << string(101, '_') << "\n\n";
+        cout << setw(8) << "" << "\t| " << left << setw(6) << "Id";
+        cout << "| " << left << setw(15) << "From Account";
+        cout << "| " << left << setw(15) << "To Account";
+        cout << "| " << left << setw(12) << "Amount";
+        cout << "| " << left << setw(10) << "Frequency";
+        cout << "| " << left << setw(12) << "Next Due";
+        cout << "| " << left << setw(14) << "Created By";
+        cout << "|" << endl
+             << setw(8) << "" << "\t" << string(101, '_') << "\n\n";
+
+        if (vOrders.empty())
+        {
+            _SetColor(12);
+            cout << "\t\t\t\tNo Standing Orders In the System!\n";
+            _SetColor(7);
+        }
+        else
+        {
+            for (const clsStandingOrders::stStandingOrder &Order : vOrders)
+            {
+                _PrintOrderRecordLine(Order);
+                cout << endl;
+            }
+        }
+        cout << setw(8) << "" << "\t" << string(101, '_') << "\n";
+    }
+
+    static short _ReadStandingOrdersOption()
+    {
+        cout << "\n";
+        cout << setw(37) << left << "" << "\t[1] Add Standing Order.\n";
+        cout << setw(37) << left << "" << "\t[2] Cancel Standing Order.\n";
+        cout << setw(37) << left << "" << "\t[3] Run Due Orders Now.\n";
+        cout << setw(37) << left << "" << "\t[4] Back.\n";
+        cout << setw(37) << left << "" << "Choose what do you want to do? [1 to 4]? ";
+        return clsInputValidate::ReadIntNumberBetween(1, 4, "Enter Number between 1 to 4? ");
+    }
+
+    static string _ReadExistingAccount(const string &Prompt)
+    {
+        // returns "0" when the user cancels
+        while (true)
+        {
+            cout << Prompt;
+            _SetColor(12);
+            cout << "(0 to cancel)";
+            _SetColor(7);
+            cout << ": ";
+
+            string AccountNumber = clsInputValidate::ReadString();
+            if (AccountNumber == "0" || clsBankClient::IsClientExist(AccountNumber))
+                return AccountNumber;
+
+            cout << "\nClient with [" << AccountNumber << "] does not exist.\n";
+        }
+    }
+
+    static clsDate _ReadDate()
+    {
+        while (true)
+        {
+            cout << "Please Enter First Due Date (dd/mm/yyyy)? ";
+            string Text = clsInputValidate::ReadString();
+
+            vector<string> vParts = clsString::Split(Text, "/");
+            bool Digits = (vParts.size() == 3);
+            for (const string &Part : vParts)
+                Digits = Digits && !Part.empty() && Part.size() <= 4 &&
+                         Part.find_first_not_of("0123456789") == string::npos;
+
+            if (Digits)
+            {
+                clsDate Date((short)stoi(vParts[0]), (short)stoi(vParts[1]), (short)stoi(vParts[2]));
+                if (Date.IsValid())
+                    return Date;
+            }
+
+            _SetColor(12);
+            cout << "\nInvalid date, Enter again.\n";
+            _SetColor(7);
+        }
+    }
+
+    static void _AddOrder()
+    {
+        string FromAccount = _ReadExistingAccount("\nPlease Enter Account Number to Pay From ");
+        if (FromAccount == "0")
+            return;
+
+        string ToAccount;
+        while (true)
+        {
+            ToAccount = _ReadExistingAccount("Please Enter Account Number to Pay To ");
+            if (ToAccount == "0")
+                return;
+            if (ToAccount != FromAccount)
+                break;
+            cout << "\n⚠ You cannot transfer to the same account. Please Enter a different account number.\n";
+        }
+
+        cout << "\nPlease Enter amount per payment? ";
+        double Amount = clsInputValidate::ReadPositiveDouble();
+
+        cout << "\nFrequency: [1] Weekly  [2] Monthly? ";
+        clsStandingOrders::enFrequency Frequency = (clsInputValidate::ReadIntNumberBetween(1, 2, "Enter 1 or 2? ") == 1)
+                                                       ? clsStandingOrders::fWeekly
+                                                       : clsStandingOrders::fMonthly;
+
+        clsDate FirstDueDate = _ReadDate();
+
+        cout << "\nAre you sure you want to add this standing order (Y/N)? ";
+        char Answer = clsInputValidate::ReadYesOrNo();
+        if (Answer != 'Y' && Answer != 'y')
+        {
+            _SetColor(14);
+            cout << "\n⚠ Operation Cancelled.\n";
+            _SetColor(7);
+            return;
+        }
+
+        int Id = clsStandingOrders::Add(FromAccount, ToAccount, Amount, Frequency, FirstDueDate,
+                                        CurrentAdmin.GetAdminUsername());
+        if (Id < 0)
+        {
+            _SetColor(4);
+            cout << "\nError: Standing order was not saved.\n";
+            _SetColor(7);
+            return;
+        }
+
+        _SetColor(10);
+        cout << "\nStanding Order [" << Id << "] Added Successfully :-)\n";
+        _SetColor(7);
+    }
+
+    static void _CancelOrder()
+    {
+        cout << "\nPlease Enter Standing Order Id to cancel? ";
+        int Id = clsInputValidate::ReadIntNumber();
+
+        cout << "\nAre you sure you want to cancel standing order [" << Id << "] (Y/N)? ";
+        char Answer = clsInputValidate::ReadYesOrNo();
+        if (Answer != 'Y' && Answer != 'y')
+            return;
+
+        if (clsStandingOrders::Cancel(Id))
+        {
+            _SetColor(10);
+            cout << "\nStanding Order Cancelled Successfully :-)\n";
+        }
+        else
+        {
+            _SetColor(12);
+            cout << "\nStanding order [" << Id << "] was not found.\n";
+        }
+        _SetColor(7);
+    }
+
+    static void _RunDueOrders()
+    {
+        clsStandingOrders::stRunResult Result = clsStandingOrders::RunDueOrders();
+
+        _SetColor(11);
+        cout << "\nOrders Due   : " << Result.OrdersDue;
+        cout << "\nPayments     : " << Result.Occurrences;
+        _SetColor(10);
+        cout << "\nPosted       : " << Result.Posted;
+        _SetColor(12);
+        cout << "\nRejected     : " << Result.vRejected.size();
+        _SetColor(11);
+        cout << "\nTotal Amount : " << fixed << setprecision(2) << Result.TotalAmount << "\n";
+        cout.unsetf(ios::fixed);
+        cout << setprecision(6);
+        _SetColor(7);
+
+        for (const clsBatchPaymentEngine::stRejectedPosting &Rejected : Result.vRejected)
+        {
+            _SetColor(12);
+            cout << "\tOrder [" << Rejected.LineNumber << "] " << Rejected.Instruction << " : " << Rejected.Reason << "\n";
+            _SetColor(7);
+        }
+    }
+
+public:
+    static void ShowStandingOrdersScreen()
+    {
+        vector<clsStandingOrders::stStandingOrder> vOrders = clsStandingOrders::GetAllOrders();
+
+        string SubTitle = "\t    (" + to_string(vOrders.size()) + ") Standing Order" + (vOrders.size() == 1 ? "." : "s.");
+        _DrawScreenHeader("\t  Standing Orders Screen", SubTitle);
+
+        _PrintOrdersTable(vOrders);
+
+        switch ((enStandingOrdersOptions)_ReadStandingOrdersOption())
+        {
+        case enStandingOrdersOptions::eAddOrder:
+            _AddOrder();
+            break;
+        case enStandingOrdersOptions::eCancelOrder:
+            _CancelOrder();
+            break;
+        case enStandingOrdersOptions::eRunDueOrders:
+            _RunDueOrders();
+            break;
+        case enStandingOrdersOptions::eBack:
+            break;
+        }
+    }
+};
@@ -16,24 +16,35 @@ private:
     static void _PrintTransactionLine(const clsTransactionLogger::stTransactionRecord &Record)
     {
         // Color code based on operation type
-        if (Record.OperationType == "DEPOSIT" || Record.OperationType == "ADMIN_DEPOSIT")
+        switch (Record.OperationType)
+        {
+        case clsTransactionLogger::DEPOSIT:
+        case clsTransactionLogger::ADMIN_DEPOSIT:
             _SetColor(10); // Green
-        else if (Record.OperationType == "WITHDRAW" || Record.OperationType == "ADMIN_WITHDRAW")
+            break;
+        case clsTransactionLogger::WITHDRAW:
+        case clsTransactionLogger::ADMIN_WITHDRAW:
             _SetColor(12); // Red
-        else if (Record.OperationType == "TRANSFER_OUT" || Record.OperationType == "ADM_TRANS_OUT")
+            break;
+        case clsTransactionLogger::TRANSFER_OUT:
+        case clsTransactionLogger::ADM_TRANS_OUT:
             _SetColor(14); // Yellow
-        else if (Record.OperationType == "TRANSFER_IN" || Record.OperationType == "ADM_TRANS_IN")
+            break;
+        case clsTransactionLogger::TRANSFER_IN:
+        case clsTransactionLogger::ADM_TRANS_IN:
             _SetColor(11); // Cyan
-        else
+            break;
+        default:
             _SetColor(7); // Default
+        }
 
-        cout << setw(8) << left << "" << "| " << setw(12) << left << Record.Date;
-        cout << "| " << setw(12) << left << Record.Time;
-        cout << "| " << setw(15) << left << Record.Username;
-        cout << "| " << setw(14) << left << Record.OperationType;
+        cout << setw(8) << left << "" << "| " << setw(12) << left << Record.Date();
+        cout << "| " << setw(12) << left << Record.Time();
+        cout << "| " << setw(15) << left << Record.Username();
+        cout << "| " << setw(14) << left << Record.OperationName();
         cout << "| " << setw(10) << left << Record.Amount;
-        cout << "| " << setw(12) << left << Record.FromAccount;
-        cout << "| " << setw(12) << left << Record.ToAccount;
+        cout << "| " << setw(12) << left << Record.FromAccount();
+        cout << "| " << setw(12) << left << Record.ToAccount();
         cout << "| " << setw(10) << left << Record.BalanceAfter;
         cout << "|";
 
@@ -43,8 +54,10 @@ private:
 public:
     static void ShowAllTransactionsScreen()
     {
-        vector<clsTransactionLogger::stTransactionRecord> vTransactions =
-            clsTransactionLogger::GetAllAdminTransactions();
+        // records and their text live in one arena, freed when the screen returns
+        clsTransactionLogger::stQueryResult Result;
+        clsTransactionLogger::QueryAdminTransactions(Result);
+        const auto &vTransactions = Result.Records;
 
         string Title = "\tAll Transactions (Admin View)";
         string SubTitle = "\tTotal: " + to_string(vTransactions.size()) + " transaction(s)";
@@ -185,7 +185,7 @@ public:
                 cout << "\n⚠ \aInsufficient balance in the source account.\n";
                 _SetColor(14);
                 cout << "\nPress any key to Enter Valid amount.";
-                system("pause>0");
+                clsTerminal::PressAnyKey();
                 _SetColor(7);
                 cout << endl;
                 continue;
@@ -194,8 +194,29 @@ public:
             char Answer = clsInputValidate::ReadYesOrNo();
             if (Answer == 'Y' || Answer == 'y')
             {
-                FromClient.Withdraw(Amount);
-                ToClient.Deposit(Amount);
+                clsBankClient::enTransactionResults Result = FromClient.Transfer(Amount, ToClient);
+                if (Result == clsBankClient::enTransactionResults::trInsufficientBalance)
+                {
+                    // the source balance changed since it was shown
+                    _SetColor(12); // Red for error
+                    cout << "\n⚠ \aInsufficient balance in the source account.\n";
+                    cout << "\nSource Account Balance Is: " << FromClient.GetAccountBalance() << "\n";
+                    _SetColor(14);
+                    cout << "\nPress any key to Enter Valid amount.";
+                    clsTerminal::PressAnyKey();
+                    _SetColor(7);
+                    cout << endl;
+                    continue;
+                }
+                if (Result != clsBankClient::enTransactionResults::trSucceeded)
+                {
+                    _SetColor(12);
+                    cout << "\n⚠ \aTransfer failed: the "
+                         << (Result == clsBankClient::enTransactionResults::trDestinationNotFound ? "destination" : "source")
+                         << " account was deleted by another user. Nothing was transferred.\n";
+                    _SetColor(7);
+                    break;
+                }
                 clsTransactionLogger::LogAdminTransfer(CurrentAdmin,FromClient,ToClient,Amount);
                 _SetColor(10); // green
                 cout << "\nAmount Transferred Successfully.\n";
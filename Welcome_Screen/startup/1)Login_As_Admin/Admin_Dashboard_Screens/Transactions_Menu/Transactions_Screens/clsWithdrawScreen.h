@@ -121,7 +121,8 @@ public:
 
             if (Answer == 'Y' || Answer == 'y')
             {
-                if (Client1.Withdraw(Amount))
+                clsBankClient::enTransactionResults Result = Client1.Withdraw(Amount);
+                if (Result == clsBankClient::enTransactionResults::trSucceeded)
                 {
                     clsTransactionLogger::LogAdminWithdraw(CurrentAdmin,Client1,Amount);
                     _SetColor(10);
@@ -130,6 +131,13 @@ public:
                     cout << "\nNew Balance Is: " << Client1.GetAccountBalance();
                     break;
                 }
+                else if (Result == clsBankClient::enTransactionResults::trNotFound)
+                {
+                    _SetColor(12); // red
+                    cout << "\nCannot withdraw, the account was deleted by another user.\n";
+                    _SetColor(7);
+                    break;
+                }
                 else
                 {
                    
@@ -140,7 +148,7 @@ public:
                     _SetColor(14);
                     cout << "\nPress any key to Enter Valid amount.";
                     _SetColor(7);
-                    system("pause>0");
+                    clsTerminal::PressAnyKey();
                     cout << endl;
                 }
             }
@@ -15,6 +15,8 @@ Main Features:
    - Transfer Money
    - View Transfer History
    - View Total Balances
+   - Batch Payments (payroll / mass transfers from a file)
+   - Standing Orders (recurring transfers)
    - Return to Main Menu
 2. Validates user input for menu selection.
 3. Calls the appropriate screen based on user choice.
@@ -24,7 +26,8 @@ Key Functions:
 --------------
 - _ReadTransactionsMenuOption(): Reads and validates the user's menu choice.
 - _ShowDepositScreen(), _ShowWithdrawScreen(), _ShowTransferScreen(),
-  _ShowTransferHistoryScreen(), _ShowTotalBalancesScreen(): Private functions
+  _ShowTransferHistoryScreen(), _ShowTotalBalancesScreen(),
+  _ShowBatchPaymentsScreen(), _ShowStandingOrdersScreen(): Private functions
   that call the respective screens for each transaction.
 - _GoBackToTransactionsMenu(): Returns the user to the transactions menu.
 - _PerformTransactionsMenuOption(enTransactionsMenuOptions option): Executes
@@ -35,7 +38,8 @@ Key Functions:
 Notes:
 ------
 - The class inherits protectedly from clsScreen to use screen drawing utilities.
-- Integrates with deposit, withdrawal, transfer, transfer history, and balance screens.
+- Integrates with deposit, withdrawal, transfer, transfer history, balance,
+  batch payment and standing order screens.
 - Uses clsInputValidate for input validation and _SetColor for colored console output.
 
 Usage Example:
@@ -56,6 +60,8 @@ clsTransactionsScreen::ShowTransactionsMenu();
 #include "Transactions_Screens/clsWithdrawScreen.h"
 #include "Transactions_Screens/clsTransferScreen.h"
 #include "Transactions_Screens/clsTransferHistoryScreen.h"
+#include "Transactions_Screens/clsBatchPaymentsScreen.h"
+#include "Transactions_Screens/clsStandingOrdersScreen.h"
 #include "../Manage_Clients_Menu/Manage_Clients_Screens/clsTotalBalancesScreen.h"
 
 
@@ -72,13 +78,15 @@ private:
         eTransferMoney = 3,
         eTransferHistory = 4,
         eTotalBalance = 5,
-        eMainMenu = 6
+        eBatchPayments = 6,
+        eStandingOrders = 7,
+        eMainMenu = 8
     };
 
     static short _ReadTransactionsMenuOption()
     {
-        cout << setw(37) << left << "" << "Choose what do you want to do? [1 to 6]? ";
-        short Choice = clsInputValidate::ReadIntNumberBetween(1, 6, "Enter Number between 1 to 6? ");
+        cout << setw(37) << left << "" << "Choose what do you want to do? [1 to 8]? ";
+        short Choice = clsInputValidate::ReadIntNumberBetween(1, 8, "Enter Number between 1 to 8? ");
         return Choice;
     }
 
@@ -103,11 +111,19 @@ private:
     {
         clsTotalBalancesScreen::ShowTotalBalancesScreen();
     }
+    static void _ShowBatchPaymentsScreen()
+    {
+        clsBatchPaymentsScreen::ShowBatchPaymentsScreen();
+    }
+    static void _ShowStandingOrdersScreen()
+    {
+        clsStandingOrdersScreen::ShowStandingOrdersScreen();
+    }
 
     static void _GoBackToTransactionsMenu()
     {
         cout << "\n\nPress any key to go back to Transactions Menu...";
-        system("pause>0");
+        clsTerminal::PressAnyKey();
         ShowTransactionsMenu();
     }
 
@@ -117,7 +133,7 @@ private:
         {
         case enTransactionsMenuOptions::eDeposit:
         {
-            system("cls");
+            clsTerminal::ClearScreen();
             _ShowDepositScreen();
             _GoBackToTransactionsMenu();
             break;
@@ -125,7 +141,7 @@ private:
 
         case enTransactionsMenuOptions::eWithdraw:
         {
-            system("cls");
+            clsTerminal::ClearScreen();
             _ShowWithdrawScreen();
             _GoBackToTransactionsMenu();
             break;
@@ -133,25 +149,39 @@ private:
 
         case enTransactionsMenuOptions::eTransferMoney:
         {
-            system("cls");
+            clsTerminal::ClearScreen();
             _ShowTransferScreen();
             _GoBackToTransactionsMenu();
             break;
         }
         case enTransactionsMenuOptions::eTransferHistory:
         {
-            system("cls");
+            clsTerminal::ClearScreen();
             _ShowTransferHistoryScreen();
             _GoBackToTransactionsMenu();
             break;
         }
         case enTransactionsMenuOptions::eTotalBalance:
         {
-            system("cls");
+            clsTerminal::ClearScreen();
             _ShowTotalBalancesScreen();
             _GoBackToTransactionsMenu();
             break;
         }
+        case enTransactionsMenuOptions::eBatchPayments:
+        {
+            clsTerminal::ClearScreen();
+            _ShowBatchPaymentsScreen();
+            _GoBackToTransactionsMenu();
+            break;
+        }
+        case enTransactionsMenuOptions::eStandingOrders:
+        {
+            clsTerminal::ClearScreen();
+            _ShowStandingOrdersScreen();
+            _GoBackToTransactionsMenu();
+            break;
+        }
 
         case enTransactionsMenuOptions::eMainMenu:
         {
@@ -163,7 +193,7 @@ private:
 public:
     static void ShowTransactionsMenu()
     {
-        system("cls");
+        clsTerminal::ClearScreen();
         _DrawScreenHeader("\t Transactions Screen");
         cout << setw(37) << left << "" << "===========================================\n";
         cout << setw(37) << left << "" << "\t\t  Transactions Menu\n";
@@ -173,7 +203,9 @@ public:
         cout << setw(37) << left << "" << "\t[3] Transfer Money.\n";
         cout << setw(37) << left << "" << "\t[4] View Transfer History.\n";
         cout << setw(37) << left << "" << "\t[5] Total Balances.\n";
-        cout << setw(37) << left << "" << "\t[6] Main Menu.\n";
+        cout << setw(37) << left << "" << "\t[6] Batch Payments (File).\n";
+        cout << setw(37) << left << "" << "\t[7] Standing Orders.\n";
+        cout << setw(37) << left << "" << "\t[8] Main Menu.\n";
         cout << setw(37) << left << "" << "===========================================\n";
 
         _PerformTransactionsMenuOption((enTransactionsMenuOptions)_ReadTransactionsMenuOption());
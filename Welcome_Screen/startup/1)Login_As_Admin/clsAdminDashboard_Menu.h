@@ -20,6 +20,7 @@ Main Features:
    - Transactions
    - Manage Admins
    - Currency Exchange
+   - Performance Metrics (requires the Manage Admins permission)
    - Logout
 2. Checks Admin access rights before executing each menu option.
 3. Handles user input and validation for menu selection.
@@ -61,6 +62,7 @@ clsAdminDashboardMenu::ShowMainMenu();
 #include "Admin_Dashboard_Screens/Transactions_Menu/clsTransactionsMenu.h"
 #include "Admin_Dashboard_Screens/Currency_Menu/clsCurrencyMenu.h"
 #include "Admin_Dashboard_Screens/Manage_Admins_Menu/clsManageAdminMenu.h"
+#include "Admin_Dashboard_Screens/Metrics_Screen/clsMetricsScreen.h"
 using namespace std;
 
 class clsAdminDashboardMenu : protected clsScreen
@@ -73,21 +75,22 @@ private:
         eManageAdminsMenu,          // [8] Transactions
         eTransactionsMenu,          // [9] Manage Admins
         eCurrencyMenu,              // [10] Currency Menu
+        ePerformanceMetrics,        // [5] Performance Metrics
         eLogout                     // [11] Logout
     };
 
 
     static short _ReadMainMenuOption()
     {
-        cout << setw(37) << left << "" << "Choose what do you want to do? [1 to 5]? ";
-        short Choice = clsInputValidate::ReadIntNumberBetween(1, 5, "Enter Number between 1 to 5? ");
+        cout << setw(37) << left << "" << "Choose what do you want to do? [1 to 6]? ";
+        short Choice = clsInputValidate::ReadIntNumberBetween(1, 6, "Enter Number between 1 to 6? ");
         return Choice;
     }
 
     static void _GoBackToMainMenu()
     {
         cout << setw(37) << left << "" << "\n\tPress any key to go back to Main MenuS...";
-        system("pause>0"); // wait for any press
+        clsTerminal::PressAnyKey(); // wait for any press
         ShowAdminDashboard();
     }
 
@@ -131,10 +134,18 @@ private:
     {
         clsCurrencyMenu::ShowCurrencyMenue();
     }
+    static void _ShowMetricsScreen()
+    {
+        if (!CheckAccessRights(clsAdmin::enPermissions::pManageAdmins))
+        {
+            return; // metrics are for super admins only
+        }
+        clsMetricsScreen::ShowMetricsScreen();
+    }
     static void _Logout()
     {
         clsAdmin::RegisterAdminSession(CurrentAdmin, "LOGOUT");
-        CurrentAdmin = clsAdmin::Find("", "");
+        CurrentAdmin = clsAdmin::GetEmptyAdminObject();
         // Logs out the current user by clearing CurrentAdmin.
         // After this, control returns to the caller function.
     }
@@ -144,27 +155,32 @@ private:
         switch (MainMenuOption)
         {
         case enMainMenuOptions::eManageClientsMenu:
-            system("cls");
+            clsTerminal::ClearScreen();
             _ShowManageClintMenu();
             _GoBackToMainMenu();
             break;
         case enMainMenuOptions::eManageAdminsMenu:
-            system("cls");
+            clsTerminal::ClearScreen();
             _ShowManageAdminMenu();
             _GoBackToMainMenu();
             break;
         case enMainMenuOptions::eTransactionsMenu:
-            system("cls");
+            clsTerminal::ClearScreen();
             _ShowTransactionsMenu();
             _GoBackToMainMenu();
             break;
         case enMainMenuOptions::eCurrencyMenu:
-            system("cls");
+            clsTerminal::ClearScreen();
             _CurrencyMenu();
             _GoBackToMainMenu();
             break;
+        case enMainMenuOptions::ePerformanceMetrics:
+            clsTerminal::ClearScreen();
+            _ShowMetricsScreen();
+            _GoBackToMainMenu();
+            break;
         case enMainMenuOptions::eLogout:
-            system("cls");
+            clsTerminal::ClearScreen();
             _Logout();
             _SetColor(10);
             cout << setw(37) << left << "" << "\n\tYou are logged out successfully.\n";
@@ -177,7 +193,7 @@ private:
 public:
     static void ShowAdminDashboard()
     {
-        system("cls");
+        clsTerminal::ClearScreen();
 
         _DrawScreenHeader("\tAdmin Dashboard Screen");
         
@@ -188,7 +204,8 @@ public:
         cout << setw(37) << left << "" << "\t[2] Manage Admins Menu.\n";
         cout << setw(37) << left << "" << "\t[3] Transactions Menu.\n";
         cout << setw(37) << left << "" << "\t[4] Currency Menu.\n";
-        cout << setw(37) << left << "" << "\t[5] Logout.\n";
+        cout << setw(37) << left << "" << "\t[5] Performance Metrics.\n";
+        cout << setw(37) << left << "" << "\t[6] Logout.\n";
         cout << setw(37) << left << "" << "===========================================\n";
 
         _PerformMainMenuOption((enMainMenuOptions)_ReadMainMenuOption());
@@ -90,7 +90,7 @@ private:
         cout <<"(0 to Cancel)";
         _SetColor(7);
         cout <<": ";
-        string PIN = clsInputValidate::ReadString();
+        string PIN = clsInputValidate::ReadString("\nInvalid input, Enter again\n", clsPinCode::MaxLength);
         return PIN;
     }
 
@@ -229,8 +229,21 @@ public:
 
         if (Answer == 'Y' || Answer == 'y')
         {
+            // the session's client may be stale (a deposit from another
+            // session since login): reload it and set the PIN again
             CurrentClient.SetPinCode(NewPIN);
-            CurrentClient.Save();
+            clsBankClient::enSaveResults SaveResult;
+            while ((SaveResult = CurrentClient.Save()) == clsBankClient::enSaveResults::svFaildVersionConflict &&
+                   CurrentClient.Refresh())
+                CurrentClient.SetPinCode(NewPIN);
+
+            if (SaveResult != clsBankClient::enSaveResults::svSucceeded)
+            {
+                _SetColor(12);
+                cout << "\n\a[X] PIN was not changed: the account could not be saved.\n";
+                _SetColor(7);
+                return;
+            }
 
             _SetColor(10);
             cout << "\n========================================\n";
@@ -22,7 +22,8 @@ Key Functions:
 
 Notes:
 ------
-- Uses CurrentClient (logged-in user) for instant access.
+- Uses CurrentClient (logged-in user) for instant access; the balance is
+  read from the published client table (clsBankClient::FindReadOnly).
 - Read-only operation - safest ATM function.
 - No validation or confirmation needed.
 - Uses _SetColor for attractive colored display.
@@ -61,6 +62,11 @@ private:
 
     static void _PrintBalanceInfo()
     {
+        // the balance as published now (a deposit made at the counter or by
+        // another session since login shows up), read without a lock
+        clsBankClient Current = clsBankClient::FindReadOnly(CurrentClient.GetAccountNumber());
+        float Balance = Current.IsEmpty() ? CurrentClient.GetAccountBalance() : Current.GetAccountBalance();
+
         _SetColor(11); // Cyan
         cout << "\n****************************************\n";
         cout << "*                                      *\n";
@@ -69,7 +75,7 @@ private:
         cout << "****************************************\n";
         _SetColor(10); // Green
         cout << "*                                      *\n";
-        cout << "*           " << setw(15) << left << CurrentClient.GetAccountBalance() 
+        cout << "*           " << setw(15) << left << Balance 
              << "            *\n";
         cout << "*                                      *\n";
         _SetColor(11);
@@ -88,7 +88,17 @@ public:
 
         if (Answer == 'Y' || Answer == 'y')
         {
-            CurrentClient.Deposit(Amount);
+            if (CurrentClient.Deposit(Amount) != clsBankClient::enTransactionResults::trSucceeded)
+            {
+                _SetColor(12);
+                cout <<"\a";
+                cout << "\n----------------------------------------\n";
+                cout << "|      Deposit Failed!                 |\n";
+                cout << "|      Account Not Found               |\n";
+                cout << "----------------------------------------\n";
+                _SetColor(7);
+                return;
+            }
             clsTransactionLogger::LogDeposit(CurrentClient, Amount);
 
             _SetColor(10);
@@ -136,7 +136,8 @@ public:
 
         if (Answer == 'Y' || Answer == 'y')
         {
-            if (CurrentClient.Withdraw(Amount))
+            clsBankClient::enTransactionResults Result = CurrentClient.Withdraw(Amount);
+            if (Result == clsBankClient::enTransactionResults::trSucceeded)
             {
                 clsTransactionLogger::LogWithdraw(CurrentClient, Amount);
                 _SetColor(10);
@@ -154,7 +155,10 @@ public:
                 cout <<"\a";
                 cout << "\n----------------------------------------\n";
                 cout << "|      Withdrawal Failed!              |\n";
-                cout << "|      Insufficient Balance            |\n";
+                if (Result == clsBankClient::enTransactionResults::trInsufficientBalance)
+                    cout << "|      Insufficient Balance            |\n";
+                else
+                    cout << "|      Account Not Found               |\n";
                 cout << "----------------------------------------\n";
                 _SetColor(7);
             }
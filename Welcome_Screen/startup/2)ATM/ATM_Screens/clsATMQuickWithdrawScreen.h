@@ -151,7 +151,8 @@ private:
         }
 
         // Perform withdrawal
-        if (CurrentClient.Withdraw(Amount))
+        clsBankClient::enTransactionResults Result = CurrentClient.Withdraw(Amount);
+        if (Result == clsBankClient::enTransactionResults::trSucceeded)
         {
             clsTransactionLogger::LogWithdraw(CurrentClient, Amount);
             _SetColor(10); // Green
@@ -170,6 +171,10 @@ private:
             cout <<"\a";
             cout << "\n========================================\n";
             cout << "|      Withdrawal Failed!              |\n";
+            if (Result == clsBankClient::enTransactionResults::trInsufficientBalance)
+                cout << "|      Insufficient Balance            |\n";
+            else
+                cout << "|      Account Not Found               |\n";
             cout << "========================================\n";
             _SetColor(7);
         }
@@ -178,7 +183,7 @@ private:
 public:
     static void ShowQuickWithdrawScreen()
     {
-        system("cls");
+        clsTerminal::ClearScreen();
         _DrawScreenHeader("\t  Quick Withdraw");
 
         _PrintClientCard();
@@ -35,24 +35,24 @@ class clsATMTransferHistoryScreen : protected clsScreen
 {
 
 private:
-    static void _PrintRecordLine(clsTransactionLogger::stTransactionRecord Record)
+    static void _PrintRecordLine(const clsTransactionLogger::stTransactionRecord &Record)
     {
         // Color based on operation type
-        if (Record.OperationType == "DEPOSIT")
+        if (Record.OperationType == clsTransactionLogger::DEPOSIT)
             _SetColor(10); // Green
-        else if (Record.OperationType == "WITHDRAW")
+        else if (Record.OperationType == clsTransactionLogger::WITHDRAW)
             _SetColor(12); // Red
-        else if (Record.OperationType == "TRANSFER_OUT")
+        else if (Record.OperationType == clsTransactionLogger::TRANSFER_OUT)
             _SetColor(14); // Yellow
-        else if (Record.OperationType == "TRANSFER_IN")
+        else if (Record.OperationType == clsTransactionLogger::TRANSFER_IN)
             _SetColor(11); // Cyan
 
-        cout << setw(8) << left << "" << "| " << setw(12) << left << Record.Date;
-        cout << "| " << setw(12) << left << Record.Time;
-        cout << "| " << setw(14) << left << Record.OperationType;
+        cout << setw(8) << left << "" << "| " << setw(12) << left << Record.Date();
+        cout << "| " << setw(12) << left << Record.Time();
+        cout << "| " << setw(14) << left << Record.OperationName();
         cout << "| " << setw(10) << left << Record.Amount;
-        cout << "| " << setw(12) << left << Record.FromAccount;
-        cout << "| " << setw(12) << left << Record.ToAccount;
+        cout << "| " << setw(12) << left << Record.FromAccount();
+        cout << "| " << setw(12) << left << Record.ToAccount();
         cout << "| " << setw(10) << left << Record.BalanceAfter;
         cout << "|";
 
@@ -62,8 +62,10 @@ private:
 public:
     static void ShowTransactionHistoryScreen()
     {
-        vector<clsTransactionLogger::stTransactionRecord> vTransactions = 
-            clsTransactionLogger::GetAccountTransactions(CurrentClient.GetAccountNumber());
+        // records and their text live in one arena, freed when the screen returns
+        clsTransactionLogger::stQueryResult Result;
+        clsTransactionLogger::QueryAccountTransactions(Result, CurrentClient.GetAccountNumber());
+        const auto &vTransactions = Result.Records;
 
         string Title = "\tTransaction History";
         string SubTitle = "    Account: " + CurrentClient.GetAccountNumber() + 
@@ -284,9 +284,9 @@ public:
 
         if (Answer == 'Y' || Answer == 'y')
         {
-            if (CurrentClient.Withdraw(Amount))
+            clsBankClient::enTransactionResults Result = CurrentClient.Transfer(Amount, ToClient);
+            if (Result == clsBankClient::enTransactionResults::trSucceeded)
             {
-                ToClient.Deposit(Amount);
                 clsTransactionLogger::LogTransfer(CurrentClient, ToClient, Amount);
                 
                 _SetColor(10);
@@ -316,7 +316,12 @@ public:
                 cout <<"\a";
                 cout << "\n============================================\n";
                 cout << "         TRANSFER FAILED!\n";
-                cout << "         Insufficient Balance\n";
+                if (Result == clsBankClient::enTransactionResults::trInsufficientBalance)
+                    cout << "         Insufficient Balance\n";
+                else if (Result == clsBankClient::enTransactionResults::trDestinationNotFound)
+                    cout << "         Recipient Account Not Found\n";
+                else
+                    cout << "         Account Not Found\n";
                 cout << "============================================\n";
                 _SetColor(7);
             }
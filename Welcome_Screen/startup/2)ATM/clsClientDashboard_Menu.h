@@ -88,7 +88,7 @@ private:
     static void _GoBackToATMMenu()
     {
         cout << setw(37) << left << "" << "\n\tPress any key to go back to ATM Menu...\n";
-        system("pause>0");
+        clsTerminal::PressAnyKey();
         ShowATMMainMenu();
     }
 
@@ -135,7 +135,7 @@ private:
     static void _Logout()
     {
         clsBankClient::RegisterClientSession(CurrentClient, "LOGOUT");
-        CurrentClient = clsBankClient::Find("", "");
+        CurrentClient = clsBankClient::GetEmptyClientObject();
         // Logs out the current client by clearing CurrentClient
     }
 
@@ -144,55 +144,55 @@ private:
         switch (ATMMenuOption)
         {
         case enATMMenuOptions::eQuickWithdraw:
-            system("cls");
+            clsTerminal::ClearScreen();
             _ShowQuickWithdrawScreen();
             _GoBackToATMMenu();
             break;
             
         case enATMMenuOptions::eNormalWithdraw:
-            system("cls");
+            clsTerminal::ClearScreen();
             _ShowNormalWithdrawScreen();
             _GoBackToATMMenu();
             break;
             
         case enATMMenuOptions::eDeposit:
-            system("cls");
+            clsTerminal::ClearScreen();
             _ShowDepositScreen();
             _GoBackToATMMenu();
             break;
             
         case enATMMenuOptions::eCheckBalance:
-            system("cls");
+            clsTerminal::ClearScreen();
             _ShowCheckBalanceScreen();
             _GoBackToATMMenu();
             break;
             
         case enATMMenuOptions::eTransfer:
-            system("cls");
+            clsTerminal::ClearScreen();
             _ShowTransferScreen();
             _GoBackToATMMenu();
             break;
             
         case enATMMenuOptions::eTransferHistory:
-            system("cls");
+            clsTerminal::ClearScreen();
             _ShowTransferHistoryScreen();
             _GoBackToATMMenu();
             break;
             
         case enATMMenuOptions::eChangePIN:
-            system("cls");
+            clsTerminal::ClearScreen();
             _ShowChangePINScreen();
             _GoBackToATMMenu();
             break;
 
         case enATMMenuOptions::eMySessionHistory:
-            system("cls");
+            clsTerminal::ClearScreen();
             _ShowMySessionHistoryScreen();
             _GoBackToATMMenu();
             break;
 
         case enATMMenuOptions::eLogout:
-            system("cls");
+            clsTerminal::ClearScreen();
             _Logout();
             _SetColor(10);
             cout << setw(37) << left << "" << "\n\tLogged out successfully. Thank you!\n";
@@ -205,7 +205,7 @@ private:
 public:
     static void ShowATMMainMenu()
     {
-        system("cls");
+        clsTerminal::ClearScreen();
 
         _DrawScreenHeader("\tATM Main Menu");
         
@@ -0,0 +1,491 @@
+/*clsAccountTable Overview
+================================================================================
+                               clsAccountTable.h
+================================================================================
+Overview:
+---------
+This file defines the clsAccountTable class, an in-memory, structure-of-arrays
+view of Clients.txt built for bank-wide, balance-heavy work (total balances,
+interest runs, reconciliation) where the personal data is never needed.
+
+A clsBankClient object carries names, email, phone, account number, PIN and
+balance together, so summing balances over a vector<clsBankClient> drags all
+of those strings through the cache. clsAccountTable splits every client into:
+
+    HOT  (dense, contiguous):   _Balances[i]    double
+                                _AccountIds[i]  unsigned int
+    COLD (joined by index i):   _ColdRecords[i] the client's stored line
+                                (names, email, phone, account number,
+                                 encrypted PIN) decoded only on demand
+
+================================================================================
+Loading:
+--------
+Load() first tries the binary snapshot (clsSnapshot): the balances are copied
+out of the mapped client rows (log tail already replayed), the cold records
+and the account index stay in the mapping, and no text is parsed.
+
+Without a usable snapshot it reads the clients store (clsStorage::Clients())
+once. For each line only two
+columns are extracted with clsString::GetFieldView: the account number (for
+the index) and the balance (for the hot array). Nothing is split, decrypted or
+copied into clsPerson strings; the raw line is kept as the cold record.
+The balances are parsed in parallel on the shared thread pool
+(clsThreadPool); the account index is then built in file order.
+
+In shared mode (clsSharedAccountTable) the balances are then taken from the
+shared table, and SaveBalances() writes them there before one checkpoint.
+Jobs that load, change and save balances hold clsSharedAccountTable::
+clsExclusiveLock around it, so no other process's transaction is overwritten.
+
+================================================================================
+Saving:
+-------
+The balance of every row as loaded is kept next to the working one.
+SaveBalances() rewrites the clients store once, under the store's lock
+(clsRecordStore::Rewrite: file lock, or one transaction), and first checks
+every row the job changed against the line stored now: its balance, and its
+record version when the table was loaded from the store, must still be the
+ones Load() saw. If another writer (an ATM, another process) changed one of
+them, nothing is written and the accounts come back in vConflicts; the job
+loads again and repeats its work. A table loaded from the snapshot carries
+older record versions, so only its balances are compared.
+
+After a write SaveCount() moves on, and clsClientTableRcu drops its
+published table.
+
+================================================================================
+Main Features:
+--------------
+1. GetTotalBalances()     : streams the dense balance array.
+   (1-3 run on clsThreadPool in fixed chunks of RowsPerTask balances, so a
+   total does not depend on the worker count)
+2. ApplyInterest(Rate)    : adds Rate% to every balance, returns the total paid.
+3. CountAccountsBelow(X)  : how many accounts hold less than X.
+4. FindIndex(Account)     : account number -> row index (clsAccountNumber hash).
+5. GetBalance / SetBalance / GetAccountId : hot access by index.
+6. GetAccountNumber / GetFullName / GetColdFields : cold access by index.
+7. SaveBalances()         : writes the changed balances back with one store
+                            Rewrite, or reports the rows changed meanwhile.
+8. SetRecord / RemoveRecord : change one row in place (the copy-on-write
+                            versions of clsClientTableRcu).
+
+================================================================================
+Usage Example:
+--------------
+    clsAccountTable Table = clsAccountTable::Load();
+    double Total = Table.GetTotalBalances();
+
+    Table.ApplyInterest(1.5);
+    if (!Table.SaveBalances().vConflicts.empty())
+        ... load again and repeat
+
+================================================================================
+*/
+
+#pragma once
+
+#include <iostream>
+#include <fstream>
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include <memory>
+#include <atomic>
+
+#include "../utils/clsString.h" // utils/clsString.h
+#include "../utils/clsFixedString.h" // utils/clsFixedString.h
+#include "../utils/clsThreadPool.h" // utils/clsThreadPool.h
+#include "clsStorage.h"         // core/clsStorage.h
+#include "clsSnapshot.h"        // core/clsSnapshot.h
+#include "clsRecordVersion.h"   // core/clsRecordVersion.h
+#include "clsSharedAccountTable.h" // core/clsSharedAccountTable.h
+
+using namespace std;
+
+class clsAccountTable
+{
+public:
+    struct stSaveResult
+    {
+        size_t ChangedRows = 0;     // rows whose balance the job changed
+        bool Written = false;       // the store (or the shared table) was written
+        vector<string> vConflicts;  // accounts changed by another writer since Load()
+    };
+
+private:
+    // column positions in Clients.txt
+    static const short _AccountNumberColumn = 4;
+    static const short _BalanceColumn = 6;
+
+    static const size_t _LinesPerParseTask = 16384; // stod per line: smaller chunks
+
+    // hot
+    vector<double> _Balances;
+    vector<unsigned int> _AccountIds;
+
+    // as loaded: what SaveBalances() expects to find in the store
+    vector<double> _LoadedBalances;
+    bool _VersionsKnown = true; // false: cold records come from a snapshot
+
+    inline static atomic<unsigned long long> _SaveCount{0};
+
+    // cold
+    vector<string> _ColdRecords;
+    unordered_map<clsAccountNumber, unsigned int> _IndexByAccount; // 16-byte inline keys
+
+    // set when loaded from a snapshot: cold records and index live in its mapping
+    shared_ptr<const clsSnapshot> _Snapshot;
+
+    string_view _ColdRecord(size_t Index) const
+    {
+        return _Snapshot ? _Snapshot->ClientLine(Index) : string_view(_ColdRecords[Index]);
+    }
+
+    static double _ParseBalance(string_view Balance)
+    {
+        return Balance.empty() ? 0.0 : stod(string(Balance));
+    }
+
+    void _AddRow(const string &Line)
+    {
+        string_view AccountNumber = clsString::GetFieldView(Line, " || ", _AccountNumberColumn);
+        string_view Balance = clsString::GetFieldView(Line, " || ", _BalanceColumn);
+
+        unsigned int Index = (unsigned int)_Balances.size();
+
+        _Balances.push_back(_ParseBalance(Balance));
+        _LoadedBalances.push_back(_Balances.back());
+        _AccountIds.push_back(Index);
+        _IndexByAccount.emplace(clsAccountNumber(AccountNumber), Index);
+        _ColdRecords.push_back(Line);
+    }
+
+    static clsAccountTable _LoadFromSnapshot(const shared_ptr<const clsSnapshot> &Snapshot)
+    {
+        clsAccountTable Table;
+        Table._Snapshot = Snapshot;
+        Table._VersionsKnown = false;
+
+        size_t Count = Snapshot->ClientCount();
+        Table._Balances.resize(Count);
+        Table._AccountIds.resize(Count);
+        clsThreadPool::Shared().ParallelFor(0, Count, RowsPerTask, [&Table, &Snapshot](size_t Begin, size_t End)
+                                            {
+                                                for (size_t i = Begin; i < End; i++)
+                                                {
+                                                    Table._Balances[i] = Snapshot->ClientRow(i).Balance;
+                                                    Table._AccountIds[i] = (unsigned int)i;
+                                                } }, "AccountTableSnapshotLoad");
+        Table._LoadedBalances = Table._Balances;
+        return Table;
+    }
+
+    void _Materialize()
+    {
+        // before a row's line changes: copy the snapshot's lines out, the
+        // mapping is read-only
+        if (!_Snapshot)
+            return;
+
+        size_t Count = _Balances.size();
+        _ColdRecords.reserve(Count);
+        for (size_t i = 0; i < Count; i++)
+        {
+            _ColdRecords.emplace_back(_Snapshot->ClientLine(i));
+            _IndexByAccount.emplace(clsAccountNumber(clsString::GetFieldView(_ColdRecords[i], " || ", _AccountNumberColumn)), (unsigned int)i);
+        }
+        _Snapshot.reset();
+    }
+
+    void _LoadSharedBalances()
+    {
+        // shared mode: Clients.txt only holds the balances of the last checkpoint
+        // (a repeated account number keeps its stored balance: only the first
+        // line is the shared account, as with Find())
+        clsSharedAccountTable *Shared = clsSharedAccountTable::Active();
+        if (Shared == nullptr)
+            return;
+
+        for (size_t i = 0; i < _Balances.size(); i++)
+        {
+            string_view AccountNumber = clsString::GetFieldView(_ColdRecord(i), " || ", _AccountNumberColumn);
+            if (FindIndex(AccountNumber) == (int)i)
+                Shared->GetBalance(AccountNumber, _Balances[i]);
+        }
+    }
+
+public:
+    // balances per pool task in the bank-wide loops (fixed: see GetTotalBalances)
+    static const size_t RowsPerTask = 65536;
+
+    static clsAccountTable Load()
+    {
+        shared_ptr<const clsSnapshot> Snapshot = clsSnapshot::Load();
+        if (Snapshot)
+        {
+            clsAccountTable Table = _LoadFromSnapshot(Snapshot);
+            Table._LoadSharedBalances();
+            return Table;
+        }
+
+        // Load process steps (text / memory / binary / sqlite store):
+        // 1. Read every line once into the cold records.
+        // 2. Parse the balances in parallel (each chunk owns its rows).
+        // 3. Build the account index in line order (the first line of a
+        //    repeated account number keeps the index, as before).
+        clsAccountTable Table;
+
+        clsStorage::Clients().ForEach([&Table](const string &Line)
+                                      {
+                                          Table._ColdRecords.push_back(Line);
+                                          return false; });
+
+        size_t Count = Table._ColdRecords.size();
+        Table._Balances.resize(Count);
+        Table._AccountIds.resize(Count);
+        clsThreadPool::Shared().ParallelFor(0, Count, _LinesPerParseTask, [&Table](size_t Begin, size_t End)
+                                            {
+                                                for (size_t i = Begin; i < End; i++)
+                                                {
+                                                    Table._Balances[i] = _ParseBalance(clsString::GetFieldView(Table._ColdRecords[i], " || ", _BalanceColumn));
+                                                    Table._AccountIds[i] = (unsigned int)i;
+                                                } }, "AccountTableParse");
+
+        Table._IndexByAccount.reserve(Count);
+        for (size_t i = 0; i < Count; i++)
+            Table._IndexByAccount.emplace(clsAccountNumber(clsString::GetFieldView(Table._ColdRecords[i], " || ", _AccountNumberColumn)), (unsigned int)i);
+
+        Table._LoadedBalances = Table._Balances;
+        Table._LoadSharedBalances();
+        return Table;
+    }
+
+    size_t Size() const { return _Balances.size(); }
+
+    //---------------------------------------------
+    // Hot path (balances only)
+    //---------------------------------------------
+    double GetTotalBalances() const
+    {
+        // up to RowsPerTask rows this is the plain serial sum
+        return clsThreadPool::Shared().ParallelReduce(
+            0, _Balances.size(), RowsPerTask, 0.0,
+            [this](size_t Begin, size_t End)
+            {
+                double Total = 0;
+                for (size_t i = Begin; i < End; i++)
+                    Total += _Balances[i];
+                return Total;
+            },
+            [](double A, double B)
+            { return A + B; },
+            "AccountTableTotal");
+    }
+
+    double ApplyInterest(double RatePercent)
+    {
+        double Factor = RatePercent / 100.0;
+
+        return clsThreadPool::Shared().ParallelReduce(
+            0, _Balances.size(), RowsPerTask, 0.0,
+            [this, Factor](size_t Begin, size_t End)
+            {
+                double TotalInterest = 0;
+                for (size_t i = Begin; i < End; i++)
+                {
+                    double Interest = _Balances[i] * Factor;
+                    _Balances[i] += Interest;
+                    TotalInterest += Interest;
+                }
+                return TotalInterest;
+            },
+            [](double A, double B)
+            { return A + B; },
+            "AccountTableInterest");
+    }
+
+    size_t CountAccountsBelow(double Threshold) const
+    {
+        return clsThreadPool::Shared().ParallelReduce(
+            0, _Balances.size(), RowsPerTask, (size_t)0,
+            [this, Threshold](size_t Begin, size_t End)
+            {
+                size_t Count = 0;
+                for (size_t i = Begin; i < End; i++)
+                    Count += (_Balances[i] < Threshold) ? 1 : 0;
+                return Count;
+            },
+            [](size_t A, size_t B)
+            { return A + B; },
+            "AccountTableCountBelow");
+    }
+
+    int FindIndex(string_view AccountNumber) const
+    {
+        if (_Snapshot)
+            return _Snapshot->FindClient(AccountNumber);
+
+        auto It = _IndexByAccount.find(clsAccountNumber(AccountNumber));
+        return (It == _IndexByAccount.end()) ? -1 : (int)It->second;
+    }
+
+    double GetBalance(size_t Index) const { return _Balances[Index]; }
+    void SetBalance(size_t Index, double Balance) { _Balances[Index] = Balance; }
+    unsigned int GetAccountId(size_t Index) const { return _AccountIds[Index]; }
+
+    //---------------------------------------------
+    // Cold path (decoded on demand)
+    //---------------------------------------------
+    string GetAccountNumber(size_t Index) const
+    {
+        return string(clsString::GetFieldView(_ColdRecord(Index), " || ", _AccountNumberColumn));
+    }
+
+    string GetFullName(size_t Index) const
+    {
+        string_view Line = _ColdRecord(Index);
+        return string(clsString::GetFieldView(Line, " || ", 0)) + " " +
+               string(clsString::GetFieldView(Line, " || ", 1));
+    }
+
+    vector<string> GetColdFields(size_t Index) const
+    {
+        // FirstName, LastName, Email, Phone, AccountNumber, EncryptedPin, (stored balance)
+        return clsString::Split(string(_ColdRecord(Index)), " || ");
+    }
+
+    //---------------------------------------------
+    // Row changes
+    //---------------------------------------------
+    void SetRecord(const string &Line)
+    {
+        // the first row of the line's account takes the line and its balance;
+        // an account not in the table is appended
+        _Materialize();
+
+        int Index = FindIndex(clsString::GetFieldView(Line, " || ", _AccountNumberColumn));
+        if (Index < 0)
+        {
+            _AddRow(Line);
+            return;
+        }
+
+        string_view Balance = clsString::GetFieldView(Line, " || ", _BalanceColumn);
+        _Balances[Index] = _ParseBalance(Balance);
+        _LoadedBalances[Index] = _Balances[Index];
+        _ColdRecords[Index] = Line;
+    }
+
+    bool RemoveRecord(string_view AccountNumber)
+    {
+        // rows after it move up one place, so ids and the index are rebuilt
+        _Materialize();
+
+        int Index = FindIndex(AccountNumber);
+        if (Index < 0)
+            return false;
+
+        _Balances.erase(_Balances.begin() + Index);
+        _LoadedBalances.erase(_LoadedBalances.begin() + Index);
+        _ColdRecords.erase(_ColdRecords.begin() + Index);
+        _AccountIds.resize(_Balances.size());
+        _IndexByAccount.clear();
+        for (size_t i = 0; i < _ColdRecords.size(); i++)
+        {
+            _AccountIds[i] = (unsigned int)i;
+            _IndexByAccount.emplace(clsAccountNumber(clsString::GetFieldView(_ColdRecords[i], " || ", _AccountNumberColumn)), (unsigned int)i);
+        }
+        return true;
+    }
+
+    string_view GetRecord(size_t Index) const { return _ColdRecord(Index); }
+
+    //---------------------------------------------
+    // Persist
+    //---------------------------------------------
+    static unsigned long long SaveCount()
+    {
+        // moves on with every SaveBalances() that wrote: published copies compare it
+        return _SaveCount.load();
+    }
+
+    stSaveResult SaveBalances() const
+    {
+        // SaveBalances process steps:
+        // 1. Shared mode: set the shared balances and checkpoint them instead
+        //    (the checkpoint is the one rewrite; the caller holds
+        //    clsSharedAccountTable::clsExclusiveLock, so nothing can conflict).
+        // 2. Otherwise one Rewrite() of the clients store. Under its lock every
+        //    row the job changed is checked against the stored line (balance,
+        //    and version when known, as loaded) and gets its new balance and
+        //    next record version (clsRecordVersion).
+        // 3. One conflict and nothing is written: the accounts are returned.
+        // 4. After a write, SaveCount() moves on (clsClientTableRcu reloads).
+        stSaveResult Result;
+        for (size_t i = 0; i < _Balances.size(); i++)
+        {
+            if ((float)_Balances[i] != (float)_LoadedBalances[i])
+                Result.ChangedRows++;
+        }
+
+        clsSharedAccountTable::clsWriteGuard Guard;
+        if (clsSharedAccountTable *Shared = clsSharedAccountTable::Active())
+        {
+            bool AllShared = true;
+            for (size_t i = 0; i < _Balances.size(); i++)
+            {
+                string AccountNumber = GetAccountNumber(i);
+                if (FindIndex(AccountNumber) == (int)i)
+                    AllShared = Shared->SetBalance(AccountNumber, _Balances[i]) && AllShared;
+            }
+
+            if (AllShared)
+            {
+                Shared->Checkpoint();
+                Result.Written = true;
+                _SaveCount++;
+                return Result;
+            }
+        }
+
+        if (Result.ChangedRows == 0)
+            return Result;
+
+        // The lines are taken from the store, not from the cold records: the
+        // table may come from a snapshot whose lines carry older versions.
+        // Row i is normally line i; a line that moved is found by account.
+        Result.Written = clsStorage::Clients().Rewrite([this, &Result](vector<string> &vLines)
+                                                       {
+                                                           size_t Row = 0;
+                                                           for (string &Line : vLines)
+                                                           {
+                                                               string_view AccountNumber = clsString::GetFieldView(Line, " || ", _AccountNumberColumn);
+                                                               int Index = (Row < _Balances.size() && GetAccountNumber(Row) == AccountNumber)
+                                                                               ? (int)Row
+                                                                               : FindIndex(AccountNumber);
+                                                               Row++;
+
+                                                               if (Index < 0 || (float)_Balances[Index] == (float)_LoadedBalances[Index])
+                                                                   continue; // not in the table, or not changed by the job
+
+                                                               unsigned long long Version = clsRecordVersion::Of(Line, clsStorage::ClientsVersionColumn);
+                                                               bool Moved = (float)_ParseBalance(clsString::GetFieldView(Line, " || ", _BalanceColumn)) != (float)_LoadedBalances[Index] ||
+                                                                            (_VersionsKnown && Version != clsRecordVersion::Of(_ColdRecord(Index), clsStorage::ClientsVersionColumn));
+                                                               if (Moved)
+                                                               {
+                                                                   Result.vConflicts.push_back(string(AccountNumber));
+                                                                   continue;
+                                                               }
+
+                                                               Line = clsRecordVersion::WithVersion(
+                                                                   clsRecordVersion::WithField(Line, _BalanceColumn, to_string((float)_Balances[Index])),
+                                                                   clsStorage::ClientsVersionColumn, Version + 1);
+                                                           }
+                                                           return Result.vConflicts.empty(); });
+
+        if (Result.Written)
+            _SaveCount++;
+        return Result;
+    }
+};
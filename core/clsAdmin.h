@@ -7,7 +7,8 @@ Overview:
 This file defines the clsAdmin class, which represents a Admin in the banking
 system. Each Admin has personal information (inherited from clsPerson), login
 credentials, and system permissions. The class also handles reading, writing,
-updating, deleting, and searching Admins in the data\\Admins.text file.
+updating, deleting, and searching Admins in the admins store
+(clsStorage::Admins(): data\\Admins.text by default).
 
 The class also manages:
 - Admin authentication (AdminUserName + password)
@@ -20,12 +21,18 @@ Data Storage Format:
 --------------------
 Each Admin is stored in the file "data\\Admins.text" in the following structure:
 
-FirstName || LastName || Email || Phone || AdminUserName || EncryptedPassword || Permissions
+FirstName || LastName || Email || Phone || AdminUserName || EncryptedPassword || Permissions || Version
+
+Version is the record version (clsRecordVersion): Save() of an UpdateMode
+Admin only writes when the stored line still has the version the object was
+read with, so two Admins editing the same record cannot silently overwrite
+each other (the second gets svFaildVersionConflict and can Refresh()).
 
 Transactions performed by Admins are logged in:
 - Transactions.txt
 Login activity is logged in:
-- LoginRegister.txt
+- AdminsSessionLog.txt (clsStorage::AdminSessions(): segmented by day, or
+  the AdminsSessionLog table with the sqlite backend)
 
 ================================================================================
 Main Features:
@@ -83,11 +90,17 @@ Important Methods:
 ● Find(AdminUserName, password)
     Used for login authentication.
 
+● GetEmptyAdminObject()
+    The "no admin" object (logged-out session state); no file I/O.
+
 ● Save()
     Adds or updates an Admin depending on the object's Mode.
 
+● Refresh()
+    Reloads the Admin from the store (after a version conflict).
+
 ● Delete()
-    Marks the Admin as deleted and re-saves the file.
+    Writes an in-place tombstone over the Admin's line (see clsRecordFile).
 
 ● CheckAccessPermission(permission)
     Returns true only if the Admin has the specific permission.
@@ -101,12 +114,13 @@ Important Methods:
 ================================================================================
 File Handling:
 --------------
-The class uses text-based storage. When updating:
-- Load all Admins into a vector.
-- Modify or delete an Admin inside the vector.
-- Write the vector back to the file.
+All record I/O goes through the configured store (clsStorage::Admins(); text
+files by default, memory or binary when configured). When updating, the
+store replaces the one record with the same AdminUserName.
 
-New Admins are appended to the file without loading all Admins.
+New Admins are appended to the store without loading all Admins.
+With text files, deletes overwrite the Admin's line with a tombstone in place;
+a background compactor reclaims the space once enough tombstones accumulate.
 
 ================================================================================
 Security Notes:
@@ -137,6 +151,10 @@ Usage Summary:
 #include "../utils/clsString.h"
 #include "../utils/clsDate.h"  
 #include "../utils/clsUtil.h"  
+#include "../utils/clsFixedString.h"
+#include "clsStorage.h"
+#include "clsRecordVersion.h"
+#include "clsMetrics.h"
 
 using namespace std;
 
@@ -150,32 +168,51 @@ private:
         AddNewMode = 2
     };
     enMode _Mode;
-    string _AdminUserName;
+    clsAdminUsername _AdminUserName; // inline 32-byte key, no heap string
+    string _StoredAdminUserName;     // a stored name too long for the key, written back as read
     string _Password;
     int _Permissions;
+    unsigned long long _Version = 0; // record version this object was read with
     bool _MarkedForDelete = false;
 
-    static clsAdmin _ConvertLinetoAdminObject(string Line, string Seperator = " || ")
+    static clsAdmin _ConvertLinetoAdminObject(const string &Line, string_view Seperator = " || ")
     {
         vector<string> vAdminData = clsString::Split(Line, Seperator);
 
-        return clsAdmin(enMode::UpdateMode,
-                        vAdminData[0], vAdminData[1], vAdminData[2],
-                        vAdminData[3], vAdminData[4], clsUtil::DecryptText(vAdminData[5]), // to DecryptPassword from text File
-                        stoi(vAdminData[6]));
+        clsAdmin Admin(enMode::UpdateMode,
+                       move(vAdminData[0]), move(vAdminData[1]), move(vAdminData[2]),
+                       move(vAdminData[3]), vAdminData[4], clsUtil::DecryptText(vAdminData[5]), // to DecryptPassword from text File
+                       stoi(vAdminData[6]));
+        Admin._Version = vAdminData.size() > 7 ? strtoull(vAdminData[7].c_str(), nullptr, 10) : 0; // no column -> 0
+        return Admin;
     }
 
-    static string _ConverAdminObjectToLine(const clsAdmin &Admin, string Seperator = " || ")
+    string_view _Key() const
     {
-        string AdminRecord = "";
-
-        AdminRecord += Admin.GetFirstName() + Seperator;
-        AdminRecord += Admin.GetLastName() + Seperator;
-        AdminRecord += Admin.GetEmail() + Seperator;
-        AdminRecord += Admin.GetPhone() + Seperator;
-        AdminRecord += Admin.GetAdminUsername() + Seperator;
-        AdminRecord += clsUtil::EncryptText(Admin.GetPassword()) + Seperator; // to Eecrypt Password to text File
+        // the user name as stored: the store key of this Admin's record
+        return _AdminUserName.IsValid() ? _AdminUserName.View() : string_view(_StoredAdminUserName);
+    }
+
+    static string _ConverAdminObjectToLine(const clsAdmin &Admin, unsigned long long Version, string_view Seperator = " || ")
+    {
+        string AdminRecord;
+        AdminRecord.reserve(112); // one buffer, fields appended in place
+
+        AdminRecord += Admin.GetFirstName();
+        AdminRecord += Seperator;
+        AdminRecord += Admin.GetLastName();
+        AdminRecord += Seperator;
+        AdminRecord += Admin.GetEmail();
+        AdminRecord += Seperator;
+        AdminRecord += Admin.GetPhone();
+        AdminRecord += Seperator;
+        AdminRecord += Admin._Key();
+        AdminRecord += Seperator;
+        AdminRecord += clsUtil::EncryptText(Admin.GetPassword()); // to Eecrypt Password to text File
+        AdminRecord += Seperator;
         AdminRecord += to_string(Admin.GetPermissions());
+        AdminRecord += Seperator;
+        AdminRecord += to_string(Version);
 
         return AdminRecord;
     }
@@ -183,73 +220,55 @@ private:
     static vector<clsAdmin> _LoadAdminsDataFromFile()
     {
         vector<clsAdmin> vAdmins;
-        fstream MyFile("../data/Admins.text", ios::in); // Read mode
 
-        if (MyFile.is_open())
-        {
-            string Line;
-            while (getline(MyFile, Line)) // Read line by line from text file
-            {
-                clsAdmin Admin = _ConvertLinetoAdminObject(Line); // convert Each line in text file to Admin Object
-                vAdmins.push_back(Admin);                         // append Admin Object to vector from data type clsAdmin
-            }
-            MyFile.close();
-        }
+        // every live line of the admins store (deleted Admins are skipped by the store)
+        clsStorage::Admins().ForEach([&vAdmins](const string &Line)
+                                     {
+                                         vAdmins.push_back(_ConvertLinetoAdminObject(Line)); // convert Each line to Admin Object
+                                         return false; });
 
         return vAdmins;
     }
 
     static void _SaveAdminDataToFile(const vector<clsAdmin> &vAdmins)
     {
-        fstream MyFile("../data/Admins.text", ios::out); // write mode
+        vector<string> vLines;
+        vLines.reserve(vAdmins.size());
 
-        if (MyFile.is_open())
+        for (const clsAdmin &A : vAdmins)
         {
-            for (const clsAdmin &A : vAdmins)
+            if (!A.IsMarkedForDelete())
             {
-                if (!A.IsMarkedForDelete())
-                {
-                    string DataLine = _ConverAdminObjectToLine(A);
-                    MyFile << DataLine << endl;
-                }
+                vLines.push_back(_ConverAdminObjectToLine(A, A._Version));
             }
-            MyFile.close();
         }
+        clsStorage::Admins().ReplaceAll(vLines); // text store: temp file + rename
     }
 
-    void _AddDataLineToFile(string stDataLine)
+    void _AddDataLineToFile(const string &stDataLine)
     {
-        fstream MyFile("../data/Admins.text", ios::out | ios::app);
-        if (MyFile.is_open())
-        {
-            MyFile << stDataLine << endl; // append Admin Record to Text File
-            MyFile.close();
-        }
+        clsStorage::Admins().Append(stDataLine); // append Admin Record to the admins store
     }
 
-    void _Update()
+    clsRecordVersion::enReplaceResult _Update()
     {
         // Update process steps:
         // 1. In the update Admin screen, create a new Admin object containing the updated data.
         // 2. Call this function and pass the new Admin object.
-        // 3. The function loads all Admins from the storage into vAdmins.
-        // 4. Iterate through each Admin in vAdmins.
-        // 5. When a Admin in the vector has the same AdminUserName (or ID) as the new Admin:
-        //   A = *this;
-        //    Here: A is a reference to the existing Admin in the vector,
-        //    and *this is the new Admin from the update Admin screen.
-        //    This line replaces the old Admin's data with the new data in the vector.
-        // then save data to file
-        vector<clsAdmin> vAdmins = _LoadAdminsDataFromFile();
-        for (clsAdmin &A : vAdmins)
-        {
-            if (A.GetAdminUsername() == this->_AdminUserName)
-            {
-                A = *this;
-                break;
-            }
-        }
-        _SaveAdminDataToFile(vAdmins);
+        // 3. Convert *this (the new Admin from the update Admin screen) into its line,
+        //    with the next record version.
+        // 4. Ask the admins store to replace the record with the same AdminUserName,
+        //    only if it still has the version *this was read with; no other Admin
+        //    object is built (the text store rewrites the file once, the memory
+        //    and binary stores replace the one record).
+        // 5. rrConflict: the Admin was saved by someone else since; nothing written.
+        string CurrentLine;
+        clsRecordVersion::enReplaceResult Result = clsStorage::Admins().ReplaceIfVersion(
+            _Key(), clsStorage::AdminsVersionColumn, _Version,
+            _ConverAdminObjectToLine(*this, _Version + 1), CurrentLine);
+        if (Result == clsRecordVersion::rrReplaced)
+            _Version++;
+        return Result;
     }
 
     void _AddNew()
@@ -264,7 +283,9 @@ private:
         //    effectively saving the new Admin's data persistently.
         // 6. After this method finishes execution, the new Admin is stored in the file
         //    and can later be loaded back into memory when needed.
-        _AddDataLineToFile(_ConverAdminObjectToLine(*this));
+        // A new record starts at version 1.
+        _Version = 1;
+        _AddDataLineToFile(_ConverAdminObjectToLine(*this, _Version));
     }
 
     static clsAdmin _GetEmptyAdminObject()
@@ -275,12 +296,12 @@ private:
 public:
     // Inherited Constructor
     clsAdmin(enMode Mode, string FirstName, string LastName,
-             string Email, string Phone, string AdminUserName,
-             string Password, int Permissions) : clsPerson(FirstName, LastName, Email, Phone)
+             string Email, string Phone, string_view AdminUserName,
+             string Password, int Permissions) : clsPerson(move(FirstName), move(LastName), move(Email), move(Phone))
     {
         _Mode = Mode;
-        _AdminUserName = AdminUserName;
-        _Password = Password;
+        SetAdminUsername(AdminUserName);
+        _Password = move(Password);
         _Permissions = Permissions;
     }
 
@@ -299,11 +320,16 @@ public:
     //--------------------------------------
     // Getter and Setter
     //--------------------------------------
-    string GetAdminUsername() const { return _AdminUserName; } // Avoid using the name GetAdminUsername because it conflicts with a Windows API macro.
-    void SetAdminUsername(string AdminUserName) { _AdminUserName = AdminUserName; }
+    string GetAdminUsername() const { return string(_Key()); } // Avoid using the name GetAdminUsername because it conflicts with a Windows API macro.
+    const clsAdminUsername &GetAdminUsernameKey() const { return _AdminUserName; } // no copy, for comparisons
+    void SetAdminUsername(string_view AdminUserName)
+    {
+        _AdminUserName = clsAdminUsername(AdminUserName);
+        _StoredAdminUserName = _AdminUserName.IsValid() ? "" : string(AdminUserName);
+    }
 
-    string GetPassword() const { return _Password; }
-    void SetPassword(string Password) { _Password = Password; }
+    const string &GetPassword() const { return _Password; }
+    void SetPassword(string Password) { _Password = move(Password); }
 
     int GetPermissions() const { return _Permissions; }
     void SetPermissions(int Permissions) { _Permissions = Permissions; }
@@ -328,43 +354,36 @@ public:
     //--------------------------------------
     // Find Admin
     //--------------------------------------
-    static clsAdmin Find(string AdminUserName) // Find BY User Name *used in find Admin screen
+    static clsAdmin Find(const string &AdminUserName) // Find BY User Name *used in find Admin screen
     {
-        fstream MyFile("../data/Admins.text", ios::in); // Read Mode
-        if (MyFile.is_open())
-        {
-            string Line;
-            while (getline(MyFile, Line))
-            {
-                clsAdmin Admin = _ConvertLinetoAdminObject(Line);
-                if (Admin.GetAdminUsername() == AdminUserName)
-                {
-                    MyFile.close();
-                    return Admin;
-                }
-            }
-            MyFile.close();
-        }
-        return _GetEmptyAdminObject();
+        SB_MEASURE(AdminFind);
+        clsAdminUsername Key(AdminUserName); // too long (or empty) to be a user name -> cannot exist
+        if (!Key.IsValid() || Key.IsEmpty())
+            return _GetEmptyAdminObject();
+
+        string Line; // the store compares the user name column only
+        if (!clsStorage::Admins().Find(clsStorage::AdminsKeyColumn, Key.View(), Line))
+            return _GetEmptyAdminObject();
+
+        return _ConvertLinetoAdminObject(Line);
     }
 
-    static clsAdmin Find(string AdminUserName, string Password) // Find BY User Name&Password *used in login screen
+    static clsAdmin Find(const string &AdminUserName, const string &Password) // Find BY User Name&Password *used in login screen
     {
-        fstream MyFile("../data/Admins.text", ios::in); // Read Mode
-        if (MyFile.is_open())
-        {
-            string Line;
-            while (getline(MyFile, Line))
-            {
-                clsAdmin Admin = _ConvertLinetoAdminObject(Line);
-                if (Admin.GetAdminUsername() == AdminUserName && Admin.GetPassword() == Password)
-                {
-                    MyFile.close();
-                    return Admin;
-                }
-            }
-            MyFile.close();
-        }
+        SB_MEASURE(AdminLogin);
+        clsAdminUsername Key(AdminUserName);
+        if (!Key.IsValid() || Key.IsEmpty())
+            return _GetEmptyAdminObject();
+
+        string Line;
+        if (!clsStorage::Admins().Find(clsStorage::AdminsKeyColumn, Key.View(), Line))
+            return _GetEmptyAdminObject();
+
+        // user name matched: decode (and decrypt the password) for this line only
+        clsAdmin Admin = _ConvertLinetoAdminObject(Line);
+        if (Admin.GetPassword() == Password)
+            return Admin;
+
         return _GetEmptyAdminObject();
     }
     //--------------------------------------
@@ -374,22 +393,25 @@ public:
     {
         svFaildEmptyObject = 0,
         svSucceeded = 1,
-        svFaildAdminExists = 2
+        svFaildAdminExists = 2,
+        svFaildVersionConflict = 3 // changed by someone else since Find(): Refresh() and edit again
     };
 
     enSaveResults Save()
     {
+        SB_MEASURE(AdminSave);
         switch (_Mode)
         {
         case enMode::EmptyMode:
             return enSaveResults::svFaildEmptyObject;
 
         case enMode::UpdateMode:
-            _Update();
+            if (_Update() == clsRecordVersion::rrConflict)
+                return enSaveResults::svFaildVersionConflict;
             return enSaveResults::svSucceeded;
 
         case enMode::AddNewMode:
-            if (clsAdmin::IsAdminExist(_AdminUserName))
+            if (clsAdmin::IsAdminExist(GetAdminUsername()))
                 return enSaveResults::svFaildAdminExists;
             else
             {
@@ -409,17 +431,37 @@ public:
     bool IsEmpty() const { return (_Mode == enMode::EmptyMode); }
     bool IsMarkedForDelete() const { return _MarkedForDelete; }
 
-    static bool IsAdminExist(string AdminUserName)
+    static bool IsAdminExist(const string &AdminUserName)
     {
         clsAdmin Admin = clsAdmin::Find(AdminUserName);
         return !Admin.IsEmpty();
     }
 
-    static clsAdmin GetAddNewAdminObject(string AdminUserName)
+    bool Refresh()
+    {
+        // reload a stored Admin (one keyed lookup); false when it no longer exists
+        if (_Mode != enMode::UpdateMode)
+            return false;
+
+        string Line;
+        if (!clsStorage::Admins().Find(clsStorage::AdminsKeyColumn, _Key(), Line))
+            return false;
+
+        *this = _ConvertLinetoAdminObject(Line);
+        return true;
+    }
+
+    static clsAdmin GetAddNewAdminObject(const string &AdminUserName)
     {
         return clsAdmin(enMode::AddNewMode, "", "", "", "", AdminUserName, "", 0);
     }
 
+    static clsAdmin GetEmptyAdminObject()
+    {
+        // built in memory: unlike Find("", ""), it never opens Admins.text
+        return _GetEmptyAdminObject();
+    }
+
     static vector<clsAdmin> GetAdminsList()
     {
         return _LoadAdminsDataFromFile();
@@ -430,30 +472,19 @@ public:
     bool Delete()
     {
         // Delete Admin process:
-        // 1. Load all Admins from the data file into a local vector vAdmins.
-        // 2. Iterate through each Admin in the vector:
-        //    - Check if the AdminUserName of the current Admin (A.GetAdminUsername())
-        //      matches the AdminUserName of this object (_AdminUserName).
-        //    - If a match is found, mark this Admin for deletion by setting
-        //      A._MarkedForDelete = true.
-        //    - Break the loop once the matching Admin is found and marked.
-        // 3. Save the updated vector back to the data file using _SaveAdminDataToFile(vAdmins),
-        //    so the deletion is persisted.
-        // 4. Replace the current object (*this) with an empty Admin object
+        // 1. Ask the admins store to delete this Admin's record. The text store
+        //    overwrites the line in Admins.text, in place, with a tombstone
+        //    ("~" + spaces, same length) through clsRecordFile::MarkDeleted.
+        //    Nothing else is loaded or rewritten.
+        // 2. Readers skip deleted records; compaction removes them once
+        //    the garbage ratio of the store crosses its threshold.
+        // 3. Replace the current object (*this) with an empty Admin object
         //    by calling _GetEmptyAdminObject(), effectively resetting it.
-        // 5. Return true to indicate that the delete operation was completed successfully.
-        vector<clsAdmin> vAdmins = _LoadAdminsDataFromFile();
-        for (clsAdmin &A : vAdmins)
-        {
-            if (A.GetAdminUsername() == _AdminUserName)
-            {
-                A._MarkedForDelete = true;
-                break;
-            }
-        }
-        _SaveAdminDataToFile(vAdmins);
+        // 4. Return true when the Admin was found and tombstoned.
+        SB_MEASURE(AdminDelete);
+        bool Deleted = clsStorage::Admins().Delete(_Key());
         *this = _GetEmptyAdminObject();
-        return true;
+        return Deleted;
     }
 
     //---------------------------------------------
@@ -487,9 +518,9 @@ public:
     //---------------------------------------------
     // Add process To File
     //---------------------------------------------
-    static void AddTransactionToFile(string AdminUserName, double amount, string fromAccount, double fromBalance, string toAccount, double toBalance)
+    static void AddTransactionToFile(const string &AdminUserName, double amount, const string &fromAccount, double fromBalance, const string &toAccount, double toBalance)
     {
-        fstream MyFile("../data/Transactions.txt", ios::out | ios::app);
+        fstream MyFile(clsStorage::Path("Transactions.txt"), ios::out | ios::app);
 
         if (MyFile.is_open())
         {
@@ -518,108 +549,69 @@ public:
     }
 
     // Helper: Get last LOGIN time for a user
-    static string _GetLastLoginTime(string Username)
+    static string _GetLastLoginTime(const string &Username)
     {
-        vector<string> vSessions;
-        fstream MyFile("../data/AdminsSessionLog.txt", ios::in);
-
-        if (MyFile.is_open())
-        {
-            string Line;
-            while (getline(MyFile, Line))
-            {
-                vector<string> vData = clsString::Split(Line, "#//#");
-                if (vData.size() >= 4 && vData[3] == Username && vData[2] == "LOGIN")
-                {
-                    vSessions.push_back(vData[0] + " " + vData[1]); // Date + Time
-                }
-            }
-            MyFile.close();
-        }
-
-        if (vSessions.size() > 0)
-            return vSessions[vSessions.size() - 1];
-
-        return "";
+        // newest -> oldest, stops at the first LOGIN of this admin
+        string LastLogin = "";
+        clsStorage::AdminSessions().ForEachLineNewestFirst([&](const string &Line)
+                                                {
+                                                    if (clsString::GetFieldView(Line, "#//#", 3) != Username ||
+                                                        clsString::GetFieldView(Line, "#//#", 2) != "LOGIN")
+                                                        return false;
+
+                                                    LastLogin = string(clsString::GetFieldView(Line, "#//#", 0)) + " " +
+                                                                string(clsString::GetFieldView(Line, "#//#", 1)); // Date + Time
+                                                    return true;
+                                                });
+        return LastLogin;
     }
     // Register Admin Session (LOGIN or LOGOUT)
-    static void RegisterAdminSession(const clsAdmin &Admin, string SessionType)
+    static void RegisterAdminSession(const clsAdmin &Admin, const string &SessionType)
     {
-        fstream MyFile("../data/AdminsSessionLog.txt", ios::out | ios::app);
-
-        if (MyFile.is_open())
-        {
-            string Date = clsDate::DateToString(clsDate::GetSystemDate());
-            string Time = clsDate::GetAccurateTime();
+        string Date = clsDate::DateToString(clsDate::GetSystemDate());
+        string Time = clsDate::GetAccurateTime();
 
-            string Duration = "-";
+        string Duration = "-";
 
-            if (SessionType == "LOGOUT")
+        if (SessionType == "LOGOUT")
+        {
+            string LastLoginTime = _GetLastLoginTime(Admin.GetAdminUsername());
+            if (LastLoginTime != "")
             {
-                string LastLoginTime = _GetLastLoginTime(Admin.GetAdminUsername());
-                if (LastLoginTime != "")
-                {
-                    Duration = _CalculateDuration(LastLoginTime, Date + " " + Time);
-                }
+                Duration = _CalculateDuration(LastLoginTime, Date + " " + Time);
             }
+        }
 
-            MyFile << Date << "#//#"
-                   << Time << "#//#"
-                   << SessionType << "#//#"
-                   << Admin.GetAdminUsername() << "#//#"
-                   << Admin.GetFirstName() + " " + Admin.GetLastName() << "#//#"
-                   << Admin.GetPermissions() << "#//#"
-                   << Duration
-                   << endl;
+        string Line = Date + "#//#" +
+                      Time + "#//#" +
+                      SessionType + "#//#" +
+                      Admin.GetAdminUsername() + "#//#" +
+                      Admin.GetFirstName() + " " + Admin.GetLastName() + "#//#" +
+                      to_string(Admin.GetPermissions()) + "#//#" +
+                      Duration;
 
-            MyFile.close();
-        }
+        clsStorage::AdminSessions().AppendLine(Line);
     }
 
     // Get all admin sessions
     static vector<string> GetAdminSessionLog()
     {
-        vector<string> vSessions;
-        fstream MyFile("../data/AdminsSessionLog.txt", ios::in);
-
-        if (MyFile.is_open())
-        {
-            string Line;
-            while (getline(MyFile, Line))
-            {
-                vSessions.push_back(Line);
-            }
-            MyFile.close();
-        }
-
-        return vSessions;
+        return clsStorage::AdminSessions().ReadAllLines();
     }
 
     // Get sessions for specific admin
-    static vector<string> GetAdminSessionLog(string Username)
+    static vector<string> GetAdminSessionLog(const string &Username)
     {
         vector<string> vSessions;
-        fstream MyFile("../data/AdminsSessionLog.txt", ios::in);
-
-        if (MyFile.is_open())
-        {
-            string Line;
-            while (getline(MyFile, Line))
-            {
-                vector<string> vData = clsString::Split(Line, "#//#");
-
-                if (vData.size() >= 4 && vData[3] == Username)
-                {
-                    vSessions.push_back(Line);
-                }
-            }
-            MyFile.close();
-        }
-
+        clsStorage::AdminSessions().ForEachLineMentioning(Username, [&](const string &Line)
+                                     {
+                                         if (clsString::GetFieldView(Line, "#//#", 3) == Username)
+                                             vSessions.push_back(Line);
+                                     });
         return vSessions;
     }
     // Helper: Calculate duration between login and logout
-    static string _CalculateDuration(string LoginDateTime, string LogoutDateTime)
+    static string _CalculateDuration(const string &LoginDateTime, const string &LogoutDateTime)
     {
         // Parse DateTime format: "25/11/2025 01:30:45 PM"
         vector<string> vLoginParts = clsString::Split(LoginDateTime, " ");
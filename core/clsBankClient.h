@@ -48,7 +48,8 @@ Key Concepts Implemented:
    - File operations are hidden inside private static functions
 
 3. **Data Persistence (File I/O)**
-   - Clients stored in "Clients.txt"
+   - Clients stored in the configured clients store (clsStorage::Clients():
+     "Clients.txt" by default, or the memory / binary backend)
    - Loading and saving done via serialization/deserialization:
         - _ConvertLinetoClientObject()
         - _ConverClientObjectToLine()
@@ -70,6 +71,7 @@ Key Concepts Implemented:
 6. **Financial Operations**
    - Deposit()
    - Withdraw()
+   - Transfer() (withdraw from this client, deposit to another)
    - Auto-saving after each transaction
 
 ================================================================================
@@ -77,7 +79,10 @@ File Storage Format:
 --------------------
 Each client is stored in a single line using the separator `" || "`:
 
-    FirstName || LastName || Email || Phone || AccountNumber || EncryptedPin || Balance
+    FirstName || LastName || Email || Phone || AccountNumber || EncryptedPin || Balance || Version
+
+Version is the record version (clsRecordVersion): a new client starts at 1
+and every write stores the next one.
 
 Internal functions handle converting between text lines and clsBankClient objects.
 
@@ -107,6 +112,14 @@ Important Internal Methods:
 - _AddNew(), _Update()
     Handle object persistence depending on mode.
 
+- _SaveBalance()
+    Save used by Deposit / Withdraw; Save(), adds and deletes also invalidate
+    the binary snapshot (clsSnapshot) because the transaction log does not
+    describe them.
+
+- _RefreshFrom()
+    Reloads the object from the stored line handed back by a version conflict.
+
 - _AddDataLineToFile()
     Appends new clients to the file.
 
@@ -115,11 +128,16 @@ Public Interface Summary:
 -------------------------
 
 ● **Find()** – search by account number (with/without PIN)
-● **Save()** – add or update a client
+● **FindReadOnly()** – the client as in the published table (clsClientTableRcu), no store access
+● **GetEmptyClientObject()** – an empty client (logged-out session state), no file I/O
+● **Save()** – add or update a client (svFaildVersionConflict when the record changed since it was read)
+● **Refresh()** – reload a client whose record may have changed
+● **AddNewClients()** – append a validated batch of new clients in one write
 ● **Delete()** – remove a client from storage
 ● **GetClientsList()** – return all clients
 ● **GetTotalBalances()** – sum all balances
-● **Deposit() / Withdraw()** – financial transactions
+● **Deposit() / Withdraw() / Transfer()** – financial transactions (enTransactionResults: succeeded,
+  insufficient balance, or the account no longer exists)
 ● **Print() / PrintShortClientCard()** – formatted output
 
 ================================================================================
@@ -142,7 +160,27 @@ Design Notes:
 - The class hides all low-level file logic to keep UI code clean.
 - Object mode ensures correct behaviour when saving.
 - Sensitive data (PIN) is encrypted using clsUtil.
-- All file operations rewrite the full file to maintain consistency.
+- All record I/O goes through clsStorage::Clients(); with the text backend
+  updates rewrite the full file (temp file + rename) and deletes write an
+  in-place tombstone that clsRecordFile compacts later.
+- Shared mode (clsSharedAccountTable, "--shared"): balances come from and go
+  to the shared table, Deposit / Withdraw never rewrite Clients.txt, and
+  every write to the clients store holds the data root's file lock.
+- Optimistic concurrency: an object remembers the version it was read with
+  and _Update() only writes when the stored record still has that version
+  (clsRecordStore::ReplaceIfVersion, CompareAndSet in shared mode). No lock
+  is held while a screen waits for the user. A long-lived object (the ATM's
+  CurrentClient) that lost the race reloads itself from the stored line:
+  Deposit / Withdraw re-apply their amount to the fresh balance, Save()
+  reports svFaildVersionConflict and leaves the choice to the screen.
+- Read-only views (GetClientsList, GetTotalBalances, FindReadOnly) come from
+  the published client table (clsClientTableRcu) without any lock; every
+  successful write queues its change there.
+- A stored account number or PIN too long for its clsFixedString key (edited
+  by hand, older data) is kept as stored and written back unchanged by every
+  save, so a deposit never blanks the record's key or credential.
+- Find, Save, Delete, Deposit, Withdraw and Transfer are timed with SB_MEASURE
+  (see clsMetrics.h); the Admin metrics screen shows the results.
 - Methods are carefully divided into static and non-static
   depending on whether they belong to the object or the database.
 
@@ -159,6 +197,13 @@ Design Notes:
 #include "clsPerson.h"          // core/clsPerson.h
 #include "../utils/clsString.h" // utils/clsString.h
 #include "../utils/clsUtil.h"   // utils/clsUtil.h
+#include "../utils/clsFixedString.h" // utils/clsFixedString.h
+#include "clsStorage.h"           // core/clsStorage.h
+#include "clsAccountTable.h"      // core/clsAccountTable.h
+#include "clsSnapshot.h"          // core/clsSnapshot.h
+#include "clsSharedAccountTable.h" // core/clsSharedAccountTable.h
+#include "clsClientTableRcu.h"     // core/clsClientTableRcu.h
+#include "clsMetrics.h"           // core/clsMetrics.h
 
 using namespace std;
 
@@ -173,6 +218,23 @@ class clsBankClient : public clsPerson
 // - PrintClientData(): prints all client details
 
 {
+public:
+    enum enTransactionResults
+    {
+        // Result of Deposit / Withdraw / Transfer:
+        //   trSucceeded           : the new balance is stored.
+        //   trInsufficientBalance : withdraw / transfer: the (newest) balance is too low.
+        //   trNotFound            : the account was deleted since this object read it.
+        //   trDestinationNotFound : transfer: the destination was deleted; the amount
+        //                           went back to the source.
+        // A concurrent writer that saved first is not a result: the amount is
+        // applied again to the newest balance (_SaveBalance()).
+        trSucceeded = 0,
+        trInsufficientBalance = 1,
+        trNotFound = 2,
+        trDestinationNotFound = 3
+    };
+
 private:
     // Why we use this mode enum:
     // - To identify the type of operation to perform on the object.
@@ -189,33 +251,57 @@ private:
     };
 
     enMode _Mode;
-    string _AccountNumber;
-    string _PinCode;
+    clsAccountNumber _AccountNumber; // inline 16-byte key, no heap string
+    clsPinCode _PinCode;
+    // a stored account number / PIN longer than the key capacity is kept as
+    // read (the PIN encrypted) and written back unchanged; empty otherwise
+    string _StoredAccountNumber;
+    string _StoredPinCode;
     float _AccountBalance;
+    unsigned long long _Version = 0; // record version this object was read with
     bool _MarkedForDelete = false;
 
-    static clsBankClient _ConvertLinetoClientObject(string Line, string Seperator = " || ")
+    static clsBankClient _ConvertLinetoClientObject(const string &Line, string_view Seperator = " || ", bool SharedBalance = true)
     {
         // Converts a line from the file into a clsBankClient object and returns it.
         // - Static: can be called without creating a clsBankClient object.
-        // - Private: not accessible directly from outside the class.
+        // - Private: not accessible from outside the class.
         // How it works:
         // 1. Reserve a vector of strings to store the split data from the line.
         // 2. Use clsString::Split to divide the line by the given separator.
         // 3. Store the resulting vector of strings in vClientData.
         // 4. Return a clsBankClient object initialized with:
         //    - UpdateMode (because this line comes from an existing file, not new input)
-        //    - The split data from the line
+        //    - The split data from the line (moved into the object, not copied)
         //    - Decrypted password
+        //    - The balance and version of the shared account table in shared mode
+        //      (the line's may be older than the last checkpoint)
+        //    - The record version (0 for a line written before the column existed)
+
+        vector<string> vClientData = clsString::Split(Line, Seperator);
+
+        clsSharedAccountTable::stAccount Account;
+        Account.Balance = stod(vClientData[6]);
+        Account.Version = vClientData.size() > 7 ? strtoull(vClientData[7].c_str(), nullptr, 10) : 0;
+        clsSharedAccountTable *Shared = clsSharedAccountTable::Active();
+        if (Shared != nullptr && SharedBalance)
+            Shared->GetAccount(vClientData[4], Account);
+
+        clsBankClient Client(enMode::UpdateMode, move(vClientData[0]), move(vClientData[1]), move(vClientData[2]),
+                             move(vClientData[3]), vClientData[4], clsUtil::DecryptText(vClientData[5]), Account.Balance);
+        Client._Version = Account.Version;
+        if (!Client._PinCode.IsValid())
+            Client._StoredPinCode = move(vClientData[5]); // as stored, not encrypted again
+        return Client;
+    }
 
-        vector<string> vClientData;
-        vClientData = clsString::Split(Line, Seperator);
-
-        return clsBankClient(enMode::UpdateMode, vClientData[0], vClientData[1], vClientData[2],
-                             vClientData[3], vClientData[4], clsUtil::DecryptText(vClientData[5]), stod(vClientData[6]));
+    string_view _Key() const
+    {
+        // the account number as stored: the store key of this client's record
+        return _AccountNumber.IsValid() ? _AccountNumber.View() : string_view(_StoredAccountNumber);
     }
 
-    static string _ConverClientObjectToLine(const clsBankClient &Client, string Seperator = " || ")
+    static string _ConverClientObjectToLine(const clsBankClient &Client, unsigned long long Version, string_view Seperator = " || ")
     {
         // Converts a clsBankClient object into a single line string for file storage.
         // - Static: can be called without creating a clsBankClient object.
@@ -227,53 +313,61 @@ private:
         // 3. Insert the specified separator between each data field.
         // 4. Encrypt sensitive data like the account number before adding it.
         // 5. Convert numeric values (like account balance) to string.
+        //    The record version written is the one passed in (the next one on update).
         // 6. Return the final string that represents the client record for the file.
-
-        string stClientRecord = "";
-        stClientRecord += Client.GetFirstName() + Seperator;
-        stClientRecord += Client.GetLastName() + Seperator;
-        stClientRecord += Client.GetEmail() + Seperator;
-        stClientRecord += Client.GetPhone() + Seperator;
-        stClientRecord += Client.GetAccountNumber() + Seperator;
-        stClientRecord += clsUtil::EncryptText(Client.GetPinCode()) + Seperator;
+        //    (appended in place into one reserved buffer, no temporary per field)
+
+        string stClientRecord;
+        stClientRecord.reserve(96);
+        stClientRecord += Client.GetFirstName();
+        stClientRecord += Seperator;
+        stClientRecord += Client.GetLastName();
+        stClientRecord += Seperator;
+        stClientRecord += Client.GetEmail();
+        stClientRecord += Seperator;
+        stClientRecord += Client.GetPhone();
+        stClientRecord += Seperator;
+        stClientRecord += Client._Key();
+        stClientRecord += Seperator;
+        if (Client._PinCode.IsValid())
+            stClientRecord += clsUtil::EncryptText(Client.GetPinCode());
+        else
+            stClientRecord += Client._StoredPinCode;
+        stClientRecord += Seperator;
         stClientRecord += to_string(Client.GetAccountBalance());
+        stClientRecord += Seperator;
+        stClientRecord += to_string(Version);
 
         return stClientRecord;
     }
 
+    static clsBankClient _ConvertPublishedRow(const clsAccountTable &Table, size_t Index)
+    {
+        // the row's line with the row's balance (the line's balance column is
+        // only the one it was loaded with); no shared-table lookup, so every
+        // client of one read comes from the same version
+        clsBankClient Client = _ConvertLinetoClientObject(string(Table.GetRecord(Index)), " || ", false);
+        Client._AccountBalance = (float)Table.GetBalance(Index);
+        return Client;
+    }
+
     static vector<clsBankClient> _LoadClientsDataFromFile()
     {
-        // Loads all bank clients from the file into a vector.
+        // Loads all bank clients into a vector.
         // - Static: can be called without creating a clsBankClient object.
         // - Private: not accessible from outside the class.
         // How it works:
-        // 1. Prepare an empty vector of clsBankClient to store the client objects.
-        // 2. Open "Clients.txt" in read mode.
-        // 3. If the file opens successfully:
-        //    a. Read each line of the file using getline.
-        //    b. Convert each line into a clsBankClient object using _ConvertLinetoClientObject().
-        //    c. Append the client object to the vector.
-        // 4. Close the file after reading all lines.
-        // 5. Return the vector containing all client objects loaded from the file.
-        vector<clsBankClient> vClients;
+        // 1. Pin the published client table (clsClientTableRcu): no lock is
+        //    taken, and writers (ATM withdrawals) go on while the list is built.
+        // 2. Convert each row into a clsBankClient object and append it to the vector.
+        // 3. Return the vector containing all client objects.
+        //    (a repeated account number keeps its stored balance, as in the store)
+        clsClientTableRcu::clsReadGuard Table;
 
-        fstream MyFile;
-        MyFile.open("../data/Clients.txt", ios::in); // read Mode
-
-        if (MyFile.is_open())
-        {
-            string Line;
-
-            while (getline(MyFile, Line))
-            {
-
-                clsBankClient Client = _ConvertLinetoClientObject(Line);
-
-                vClients.push_back(Client);
-            }
-
-            MyFile.close();
-        }
+        vector<clsBankClient> vClients;
+        vClients.reserve(Table->Size());
+        for (size_t i = 0; i < Table->Size(); i++)
+            vClients.push_back(_ConvertPublishedRow(*Table, i));
 
         return vClients;
     }
@@ -285,52 +379,82 @@ private:
         // - Accepts a vector of clsBankClient objects (by const reference for efficiency).
         // - Skips any client marked for deletion.
         // - Converts each client object into a formatted line before writing.
+        // - The store replaces everything at once (the text store writes a temporary
+        //   file and renames it, so readers never see a half-written Clients.txt).
         // The method is static and private because it serves as an internal
         // helper for data persistence and is not intended to be accessed externally.
-        fstream MyFile;
-        MyFile.open("../data/Clients.txt", ios::out); // overwrite Mode
-
-        string DataLine;
+        vector<string> vLines;
+        vLines.reserve(vClients.size());
 
-        if (MyFile.is_open())
+        for (const clsBankClient &C : vClients)
         {
-            for (const clsBankClient &C : vClients)
+            if (C._MarkedForDelete == false) // if true skip mean you have been delete this line
             {
-                if (C._MarkedForDelete == false) // if true skip mean you have been delete this line
-                {
-                    DataLine = _ConverClientObjectToLine(C);
-                    MyFile << DataLine << endl;
-                }
+                vLines.push_back(_ConverClientObjectToLine(C, C._Version));
             }
-            MyFile.close();
         }
+
+        clsStorage::Clients().ReplaceAll(vLines);
+        clsClientTableRcu::Invalidate();
     }
 
-    void _Update()
+    clsRecordVersion::enReplaceResult _Update(string &CurrentLine)
     {
         // Updates the current client's record in the data file.
         // This is a non-static, private method because it modifies the object
         // that invoked it and should not be accessed externally.
         //
         // Workflow:
-        // - Load all clients from the file into a vector.
-        // - Search for the client whose AccountNumber matches the current object.
-        // - Replace that record with the current object's data.
-        // - Save the updated list back to the file.
+        // - Build the current object's line with the next record version.
+        // - Ask the clients store to replace the record with the same account
+        //   number, but only if it still has the version this object was read
+        //   with (compare-and-swap, done under the store's lock).
+        //   The text store rewrites Clients.txt once (no clsBankClient objects are
+        //   built); the memory and binary stores replace the one record in place.
+        // - rrConflict: someone saved the record first; nothing is written and
+        //   CurrentLine holds the stored record.
         //
-        // Used only when the object is operating in UpdateMode.
-        vector<clsBankClient> _vClients = _LoadClientsDataFromFile();
-
-        for (clsBankClient &C : _vClients)
+        // Used only when the object is operating in UpdateMode
+        // (Deposit / Withdraw / transfers all land here).
+        // In shared mode the compare-and-swap is done on the shared table's
+        // version, and the write holds the data root's file lock (no other
+        // process, no checkpoint in between).
+        clsSharedAccountTable::clsWriteGuard Guard;
+        if (clsSharedAccountTable *Shared = clsSharedAccountTable::Active())
         {
-            if (C.GetAccountNumber() == this->GetAccountNumber())
+            clsSharedAccountTable::stAccount Current;
+            switch (Shared->CompareAndSet(_Key(), _Version, _AccountBalance, Current))
             {
-                C = *this; // overwrite the matching record
-                break;
+            case clsSharedAccountTable::urDone:
+                _Version = Current.Version;
+                clsStorage::Clients().Replace(_Key(), _ConverClientObjectToLine(*this, _Version));
+                return clsRecordVersion::rrReplaced;
+
+            case clsSharedAccountTable::urConflict:
+                clsStorage::Clients().Find(clsStorage::ClientsKeyColumn, _Key(), CurrentLine);
+                return clsRecordVersion::rrConflict;
+
+            default:
+                break; // not shared: compare with the stored line
             }
         }
 
-        _SaveCleintsDataToFile(_vClients);
+        clsRecordVersion::enReplaceResult Result = clsStorage::Clients().ReplaceIfVersion(
+            _Key(), clsStorage::ClientsVersionColumn, _Version,
+            _ConverClientObjectToLine(*this, _Version + 1), CurrentLine);
+        if (Result == clsRecordVersion::rrReplaced)
+            _Version++;
+        return Result;
+    }
+
+    bool _RefreshFrom(const string &Line)
+    {
+        // Reload this object from the stored line (after a version conflict);
+        // the line comes from the store, so no second read is needed.
+        if (Line.empty())
+            return false;
+        *this = _ConvertLinetoClientObject(Line);
+        return true;
     }
 
     void _AddNew()
@@ -345,29 +469,100 @@ private:
         //    effectively saving the new client's data persistently.
         // 6. After this method finishes execution, the new client is stored in the file
         //    and can later be loaded back into memory when needed.
-        _AddDataLineToFile(_ConverClientObjectToLine(*this));
+        // A new record starts at version 1.
+        _Version = 1;
+        string Line = _ConverClientObjectToLine(*this, _Version);
+        _AddDataLineToFile(Line);
+        clsClientTableRcu::RecordChanged(Line);
     }
 
-    void _AddDataLineToFile(string stDataLine)
+    void _AddDataLineToFile(const string &stDataLine)
     {
         // Adds a new client record to the file.
         // - Non-static: operates on the object that called it.
         // - Private: not accessible from outside the class.
         // How it works:
         // 1. Receives a string representing the client record to be added.
-        // 2. Opens "Clients.txt" in append mode to add the record at the end of the file.
-        // 3. Checks if the file is open.
-        // 4. Writes the string to the file.
-        // 5. Closes the file after writing.
-        fstream MyFile;
-        MyFile.open("../data/Clients.txt", ios::out | ios::app);
-
-        if (MyFile.is_open())
+        // 2. Appends it to the clients store (for text files through clsRecordFile,
+        //    which serializes the write with deletes and with the background compactor).
+        // 3. In shared mode, under the file lock, and the account joins the shared table.
+        clsSharedAccountTable::clsWriteGuard Guard;
+        clsStorage::Clients().Append(stDataLine);
+
+        if (clsSharedAccountTable *Shared = clsSharedAccountTable::Active())
+            Shared->AddAccount(_Key(), _AccountBalance, _Version);
+    }
+
+    enTransactionResults _ApplyShared(double Amount, bool IsWithdraw, bool &Applied)
+    {
+        // Deposit / Withdraw in shared mode: the balance changes in the shared
+        // table under the account's shard lock (check and change in one step),
+        // and Clients.txt is written by the next checkpoint. Applied is false
+        // when the account is not shared; the caller then saves as usual.
+        Applied = false;
+        clsSharedAccountTable *Shared = clsSharedAccountTable::Active();
+        if (Shared == nullptr || _Mode != enMode::UpdateMode)
+            return enTransactionResults::trSucceeded;
+
+        clsSharedAccountTable::stAccount After;
+        clsSharedAccountTable::enUpdateResult Result = IsWithdraw
+                                                           ? Shared->Withdraw(_Key(), Amount, After)
+                                                           : Shared->Deposit(_Key(), Amount, After);
+        if (Result == clsSharedAccountTable::urNotShared)
+            return enTransactionResults::trSucceeded;
+
+        Applied = true;
+        _AccountBalance = (float)After.Balance; // includes the other processes' changes
+        _Version = After.Version;
+        if (Result == clsSharedAccountTable::urInsufficient)
+            return enTransactionResults::trInsufficientBalance;
+        return (Result == clsSharedAccountTable::urDone) ? enTransactionResults::trSucceeded : enTransactionResults::trNotFound;
+    }
+
+    enTransactionResults _SaveBalance(double Amount, bool IsWithdraw)
+    {
+        // Save() for Deposit / Withdraw. The caller logs the new balance in the
+        // transaction log, so the snapshot replays it and is kept (Save()
+        // invalidates the snapshot).
+        // _SaveBalance process steps:
+        // 1. Check the funds (withdraw) and apply the amount to the balance.
+        // 2. Compare-and-swap the record (_Update()).
+        // 3. On a version conflict the object was stale (another screen,
+        //    thread or process saved the account since it was read): reload
+        //    it from the stored line and go back to 1, so the amount is
+        //    applied to the newest balance and no update is lost.
+        // 4. The account was deleted meanwhile: nothing is written, trNotFound.
+        if (_Mode != enMode::UpdateMode)
         {
+            if (IsWithdraw && _AccountBalance < Amount)
+                return enTransactionResults::trInsufficientBalance;
+            _AccountBalance += IsWithdraw ? -Amount : Amount;
+            if (Save() == enSaveResults::svSucceeded)
+                return enTransactionResults::trSucceeded;
+            _AccountBalance += IsWithdraw ? Amount : -Amount;
+            return enTransactionResults::trNotFound;
+        }
+
+        SB_MEASURE(ClientSave);
+        while (true)
+        {
+            if (IsWithdraw && _AccountBalance < Amount)
+                return enTransactionResults::trInsufficientBalance;
+
+            float Before = _AccountBalance;
+            _AccountBalance += IsWithdraw ? -Amount : Amount;
 
-            MyFile << stDataLine << endl;
+            string CurrentLine;
+            clsRecordVersion::enReplaceResult Result = _Update(CurrentLine);
+            if (Result == clsRecordVersion::rrReplaced)
+            {
+                clsClientTableRcu::BalanceChanged(_Key(), _AccountBalance, _Version);
+                return enTransactionResults::trSucceeded;
+            }
 
-            MyFile.close();
+            _AccountBalance = Before;
+            if (Result == clsRecordVersion::rrNotFound || !_RefreshFrom(CurrentLine))
+                return enTransactionResults::trNotFound;
         }
     }
 
@@ -400,25 +595,29 @@ public:
      * - Use the default constructor to create an empty object for later initialization.
      */
     clsBankClient(enMode Mode, string FirstName, string LastName,
-                  string Email, string Phone, string AccountNumber, string PinCode,
-                  float AccountBalance) : clsPerson(FirstName, LastName, Email, Phone)
+                  string Email, string Phone, string_view AccountNumber, string_view PinCode,
+                  float AccountBalance) : clsPerson(move(FirstName), move(LastName), move(Email), move(Phone))
 
     {
         _Mode = Mode;
-        _AccountNumber = AccountNumber;
-        _PinCode = PinCode;
+        _AccountNumber = clsAccountNumber(AccountNumber);
+        if (!_AccountNumber.IsValid())
+            _StoredAccountNumber = string(AccountNumber);
+        SetPinCode(PinCode);
         _AccountBalance = AccountBalance;
     }
 
     //---------------------------------------------
     // Getters and Setters
     //---------------------------------------------
-    string GetAccountNumber() const { return _AccountNumber; }
-    void SetPinCode(string PinCode)
+    string GetAccountNumber() const { return string(_Key()); }
+    const clsAccountNumber &GetAccountKey() const { return _AccountNumber; } // no copy, for comparisons and lookups
+    void SetPinCode(string_view PinCode)
     {
-        _PinCode = PinCode;
+        _PinCode = clsPinCode(PinCode);
+        _StoredPinCode = _PinCode.IsValid() ? "" : clsUtil::EncryptText(string(PinCode));
     }
-    string GetPinCode() const { return _PinCode; }
+    string GetPinCode() const { return _PinCode.ToString(); }
     void SetAccountBalance(float AccountBalance)
     {
         _AccountBalance = AccountBalance;
@@ -461,7 +660,7 @@ public:
     //---------------------------------------------
     // Find Clients
     //---------------------------------------------
-    static clsBankClient Find(string AccountNumber)
+    static clsBankClient Find(const string &AccountNumber)
     {
         // Find Client by Account Number
         // - Static: can be called without creating a clsBankClient object
@@ -471,35 +670,42 @@ public:
         //     * clsBankClient object with data if a matching account is found
         //     * Empty clsBankClient object if no match is found
         // How it works:
-        // 1. Open the "Clients.txt" file in read mode.
-        // 2. If the file is successfully opened:
-        //    a. Prepare an empty string to read each line.
-        //    b. Use a while loop with getline to read each line from the file.
-        //    c. Convert the line into a clsBankClient object using _ConvertLinetoClientObject.
-        //    d. Compare the object's account number with the given account number.
-        //    e. If a match is found, close the file and return the client object.
-        // 3. If the file cannot be opened or no client is found, return an empty client
-        fstream MyFile;
-        MyFile.open("../data/Clients.txt", ios::in); // read Mode
-
-        if (MyFile.is_open())
-        {
-            string Line;
-            while (getline(MyFile, Line))
-            {
-                clsBankClient Client = _ConvertLinetoClientObject(Line);
-                if (Client.GetAccountNumber() == AccountNumber)
-                {
-                    MyFile.close();
-                    return Client;
-                }
-            }
-            MyFile.close();
-        }
-        return _GetEmptyClientObject();
+        // 1. Ask the clients store for the line whose account-number column matches.
+        //    - The text store scans Clients.txt comparing only that column as a view
+        //      (clsString::GetFieldView); non-matching lines are never split, decrypted or parsed.
+        //    - The memory and binary stores look the key up in their hash index.
+        // 2. On a match, convert the line into a full clsBankClient object and return it.
+        // 3. If no client is found, return an empty client.
+        // The account number is turned into a clsAccountNumber key once; a value too
+        // long to be a key, or an empty one, cannot exist in the store, so the lookup is skipped.
+        SB_MEASURE(ClientFind);
+        clsAccountNumber Key(AccountNumber);
+        if (!Key.IsValid() || Key.IsEmpty())
+            return _GetEmptyClientObject();
+
+        string Line;
+        if (!clsStorage::Clients().Find(clsStorage::ClientsKeyColumn, Key.View(), Line))
+            return _GetEmptyClientObject();
+
+        return _ConvertLinetoClientObject(Line);
+    }
+
+    static clsBankClient FindReadOnly(const string &AccountNumber)
+    {
+        // Find for screens that only show a client (find screen, balance
+        // inquiry): the row of the published client table (clsClientTableRcu),
+        // no store access and no lock. Saving the object is still safe: its
+        // version makes a stale Save() a conflict.
+        SB_MEASURE(ClientFind);
+        clsClientTableRcu::clsReadGuard Table;
+        int Index = Table->FindIndex(AccountNumber);
+        if (Index < 0)
+            return _GetEmptyClientObject();
+
+        return _ConvertPublishedRow(*Table, (size_t)Index);
     }
 
-    static clsBankClient Find(string AccountNumber, string PinCode)
+    static clsBankClient Find(const string &AccountNumber, const string &PinCode)
     {
         // Overloaded Find method:
         // - Static method, accessible without creating a clsBankClient object.
@@ -508,24 +714,23 @@ public:
         // - Searches for a client record in the file by account number and PIN code.
         // - Returns the corresponding clsBankClient object if found,
         //   otherwise returns an empty client object.
-        fstream MyFile;
-        MyFile.open("../data/Clients.txt", ios::in); // read Mode
-
-        if (MyFile.is_open())
-        {
-            string Line;
-            while (getline(MyFile, Line))
-            {
-                clsBankClient Client = _ConvertLinetoClientObject(Line);
-                if (Client.GetAccountNumber() == AccountNumber && Client.GetPinCode() == PinCode)
-                {
-                    MyFile.close();
-                    return Client;
-                }
-            }
+        // - Only the account number is looked up in the store; the PIN is
+        //   decrypted for the matching line only.
+        SB_MEASURE(ClientLogin);
+        clsAccountNumber Key(AccountNumber);
+        clsPinCode Pin(PinCode);
+        if (!Key.IsValid() || Key.IsEmpty() || !Pin.IsValid())
+            return _GetEmptyClientObject();
+
+        string Line;
+        if (!clsStorage::Clients().Find(clsStorage::ClientsKeyColumn, Key.View(), Line))
+            return _GetEmptyClientObject();
+
+        // account matched: decode the full record (and decrypt the PIN) once
+        clsBankClient Client = _ConvertLinetoClientObject(Line);
+        if (Client._PinCode == Pin)
+            return Client;
 
-            MyFile.close();
-        }
         return _GetEmptyClientObject();
     }
     //---------------------------------------------
@@ -540,9 +745,15 @@ public:
         //   svFaildEmptyObject         : Save operation failed because the client object is empty.
         //   svSucceeded                : Save operation succeeded successfully.
         //   svFaildAccountNumberExists : Save operation failed because the account number already exists.
+        //   svFaildVersionConflict     : Save operation failed because the record was changed since this
+        //                                object read it (Refresh() and apply the change again).
+        //   svFaildNotFound            : Save operation failed because the record was deleted since this
+        //                                object read it (nothing is written).
         svFaildEmptyObject = 0,
         svSucceeded = 1,
-        svFaildAccountNumberExists = 2
+        svFaildAccountNumberExists = 2,
+        svFaildVersionConflict = 3,
+        svFaildNotFound = 4
     };
 
     enSaveResults Save()
@@ -554,6 +765,9 @@ public:
         //      - If the object is empty, return a failed save result.
         // 3. If the mode is UpdateMode:
         //      - Call _Update() to overwrite the existing record in the storage.
+        //      - If the record changed since this object read it, nothing is
+        //        written: return a version conflict (the object is kept as is).
+        //      - If the record was deleted meanwhile, return a not-found failure.
         //      - Return a successful save result.
         // 4. If the mode is AddNewMode:
         //      - Check whether a client with the same AccountNumber already exists.
@@ -563,6 +777,7 @@ public:
         //      - Return a successful save result.
         // 5. If none of the above modes match:
         //      - Treat it as an invalid state and return a failed save result.
+        SB_MEASURE(ClientSave);
         switch (_Mode)
         {
         case enMode::EmptyMode:
@@ -576,7 +791,15 @@ public:
         case enMode::UpdateMode:
         {
 
-            _Update();
+            string CurrentLine;
+            clsRecordVersion::enReplaceResult Result = _Update(CurrentLine);
+            if (Result == clsRecordVersion::rrConflict)
+                return enSaveResults::svFaildVersionConflict;
+            if (Result == clsRecordVersion::rrNotFound)
+                return enSaveResults::svFaildNotFound;
+            clsSnapshot::Invalidate(); // not in the transaction log: the snapshot cannot replay it
+            if (Result == clsRecordVersion::rrReplaced)
+                clsClientTableRcu::RecordChanged(_ConverClientObjectToLine(*this, _Version));
 
             return enSaveResults::svSucceeded;
 
@@ -585,13 +808,14 @@ public:
         case enMode::AddNewMode:
         {
             // This will add new record to file or database
-            if (clsBankClient::IsClientExist(_AccountNumber))
+            if (clsBankClient::IsClientExist(GetAccountNumber()))
             {
                 return enSaveResults::svFaildAccountNumberExists;
             }
             else
             {
                 _AddNew();
+                clsSnapshot::Invalidate();
 
                 // We need to set the mode to update after add new
                 _Mode = enMode::UpdateMode;
@@ -609,7 +833,7 @@ public:
     //---------------------------------------------
     // Utilities
     //---------------------------------------------
-    static bool IsClientExist(string AccountNumber)
+    static bool IsClientExist(const string &AccountNumber)
     {
         // IsClientExist process steps:
         // 1. This function is declared static so it can be used without creating an object of the class.
@@ -643,7 +867,7 @@ public:
         return (_Mode == enMode::EmptyMode);
     }
 
-    static clsBankClient GetAddNewClientObject(string AccountNumber)
+    static clsBankClient GetAddNewClientObject(const string &AccountNumber)
     {
         // GetAddNewClientObject process steps:
         // 1. This function creates and returns a new clsBankClient object prepared for adding a new client.
@@ -655,6 +879,73 @@ public:
 
         return clsBankClient(enMode::AddNewMode, "", "", "", "", AccountNumber, "", 0);
     }
+
+    static clsBankClient GetEmptyClientObject()
+    {
+        // The "no client" object (CurrentClient before login / after logout).
+        // Built in memory: unlike Find(""), it never opens Clients.txt.
+        return _GetEmptyClientObject();
+    }
+
+    bool Refresh()
+    {
+        // Refresh process steps:
+        // 1. Only a stored client (UpdateMode) can be refreshed.
+        // 2. Shared mode: when the shared table still has this object's
+        //    version, nothing changed: no store read at all.
+        // 3. Otherwise read the record again (one keyed lookup) and reload
+        //    the object from it.
+        // 4. Return false when the record no longer exists.
+        if (_Mode != enMode::UpdateMode)
+            return false;
+
+        clsSharedAccountTable::stAccount Current;
+        clsSharedAccountTable *Shared = clsSharedAccountTable::Active();
+        if (Shared != nullptr && Shared->GetAccount(_Key(), Current) && Current.Version == _Version)
+            return true;
+
+        string Line;
+        if (!clsStorage::Clients().Find(clsStorage::ClientsKeyColumn, _Key(), Line))
+            return false;
+
+        _RefreshFrom(Line);
+        return true;
+    }
+
+    static void AddNewClients(vector<clsBankClient> &vClients)
+    {
+        // AddNewClients process steps (bulk version of Save() in AddNewMode):
+        // 1. The caller has already checked that every account number is new
+        //    (clsClientImporter checks the whole batch against one hash set),
+        //    so no per-client IsClientExist() scan is done here.
+        // 2. Convert every client into its file line (record version 1).
+        // 3. Append all lines with a single write (clsRecordStore::AppendAll).
+        // 4. Switch every client to UpdateMode, as Save() does after adding.
+        vector<string> vLines;
+        vLines.reserve(vClients.size());
+
+        for (clsBankClient &Client : vClients)
+        {
+            Client._Version = 1;
+            vLines.push_back(_ConverClientObjectToLine(Client, Client._Version));
+        }
+
+        clsSharedAccountTable::clsWriteGuard Guard;
+        clsStorage::Clients().AppendAll(vLines);
+        clsSnapshot::Invalidate();
+        if (vLines.size() >= clsClientTableRcu::PublishEveryChanges)
+            clsClientTableRcu::Invalidate(); // one reload instead of many copies
+        else
+            for (const string &Line : vLines)
+                clsClientTableRcu::RecordChanged(Line);
+
+        if (clsSharedAccountTable *Shared = clsSharedAccountTable::Active())
+            for (const clsBankClient &Client : vClients)
+                Shared->AddAccount(Client._Key(), Client._AccountBalance, Client._Version);
+
+        for (clsBankClient &Client : vClients)
+            Client._Mode = enMode::UpdateMode;
+    }
     //---------------------------------------------
     // Delete Client
     //---------------------------------------------
@@ -662,35 +953,28 @@ public:
     {
         // Delete process steps:
         // 1. This function is non-static, meaning it must be called through an existing object instance.
-        // 2. Create a vector of clsBankClient to hold all client records.
-        // 3. Call _LoadClientsDataFromFile() to load all clients from the storage into the vector.
-        // 4. Iterate through the vector using a ranged-for loop (by reference).
-        // 5. For each client in the vector:
-        //      - Check if its AccountNumber matches the AccountNumber of the current object (*this).
-        //      - If a match is found, set the client's _MarkedForDelete flag to true.
-        //      - Break the loop since the target client has been located.
-        // 6. Call _SaveClientsDataToFile() to write the updated list back to the file.
-        //      - Only clients NOT marked for deletion will be saved.
-        // 7. Replace the current object (*this) with an empty client object by calling _GetEmptyClientObject().
-        // 8. Return true to indicate that the deletion process completed successfully.
-
-        vector<clsBankClient> _vClients;
-        _vClients = _LoadClientsDataFromFile();
-
-        for (clsBankClient &C : _vClients)
+        // 2. Ask the clients store to delete this client's record. The text store
+        //    overwrites the line in place with a tombstone (same length, starts with '~');
+        //    no other line is loaded or rewritten.
+        // 3. Readers skip deleted records, and the space is reclaimed by compaction
+        //    once the garbage ratio of the store crosses its threshold.
+        // 4. Replace the current object (*this) with an empty client object by calling _GetEmptyClientObject().
+        // 5. Return true when the record was found and tombstoned.
+
+        SB_MEASURE(ClientDelete);
+        clsSharedAccountTable::clsWriteGuard Guard;
+        bool Deleted = clsStorage::Clients().Delete(_Key());
+        if (Deleted)
         {
-            if (C.GetAccountNumber() == this->_AccountNumber)
-            {
-                C._MarkedForDelete = true;
-                break;
-            }
+            clsSnapshot::Invalidate();
+            clsClientTableRcu::Removed(_Key());
+            if (clsSharedAccountTable *Shared = clsSharedAccountTable::Active())
+                Shared->RemoveAccount(_Key());
         }
 
-        _SaveCleintsDataToFile(_vClients);
-
         *this = _GetEmptyClientObject();
 
-        return true;
+        return Deleted;
     }
     //---------------------------------------------
     // List and Balance
@@ -700,7 +984,8 @@ public:
         // GetClientsList process steps:
         // 1. This function is declared static, so it can be called without creating an object of the class.
         // 2. The function retrieves all clients stored in the file.
-        // 3. It calls _LoadClientsDataFromFile(), which reads the file and returns a vector of clsBankClient.
+        // 3. It calls _LoadClientsDataFromFile(), which reads the published client table
+        //    (clsClientTableRcu) and returns a vector of clsBankClient.
         // 4. The function returns that vector as the complete list of clients.
 
         return _LoadClientsDataFromFile();
@@ -711,119 +996,127 @@ public:
     static double GetTotalBalances()
     {
         // GetTotalBalances process steps:
-        // 1. Declare a vector to hold all clients.
-        // 2. Call GetClientsList() to retrieve all client records.
-        // 3. Create a variable to accumulate the total balances.
-        // 4. Loop through each client in the vector (by value).
-        // 5. For each client, retrieve its balance using GetAccountBalance().
-        // 6. Add the balance to the total accumulator.
-        // 7. After completing the loop, return the total balance of all clients.
-        // 8. This function is static because the calculation does not depend on any specific object.
-
-        vector<clsBankClient> vClients = clsBankClient::GetClientsList();
-
-        double TotalBalances = 0;
-        for (clsBankClient &Client : vClients)
-        {
-            TotalBalances += Client.GetAccountBalance();
-        }
-        return TotalBalances;
+        // 1. Pin the published clsAccountTable (clsClientTableRcu: balances in one
+        //    dense array, personal data kept aside as cold records), no lock.
+        // 2. Sum the balance array; no clsBankClient / clsPerson strings are built.
+        // 3. This function is static because the calculation does not depend on any specific object.
+
+        SB_MEASURE(ClientTotalBalances);
+        clsClientTableRcu::clsReadGuard Table;
+        return Table->GetTotalBalances();
     }
 
-    void Deposit(double Amount)
+    enTransactionResults Deposit(double Amount)
     {
         // Deposit process steps:
         // 1. Increase the account balance by the deposit amount.
-        // 2. Call Save() to update the client's record in the storage.
-        _AccountBalance += Amount;
-        Save();
+        // 2. Call _SaveBalance() to update the client's record in the storage
+        //    (re-applied to the newest balance if the object was stale).
+        // 3. Return trSucceeded, or trNotFound when the account is gone (nothing stored).
+        // In shared mode the shared table is updated instead (_ApplyShared()).
+        SB_MEASURE(ClientDeposit);
+        bool Applied;
+        enTransactionResults Result = _ApplyShared(Amount, false, Applied);
+        if (Applied)
+            return Result;
+
+        return _SaveBalance(Amount, false);
     }
 
-    bool Withdraw(double Amount)
+    enTransactionResults Withdraw(double Amount)
     {
         // Withdraw process steps:
         // 1. Check if the current balance is sufficient for the withdrawal.
         // 2. If the balance is less than the requested amount:
-        //      - Return false to indicate the withdrawal failed.
+        //      - Return trInsufficientBalance to indicate the withdrawal failed.
         // 3. Otherwise:
         //      - Deduct the withdrawal amount from the balance.
-        //      - Call Save() to persist the updated balance.
-        //      - Return true to indicate a successful withdrawal.
-        if (_AccountBalance < Amount)
-        {
-            return false;
-        }
-        else
-        {
-            _AccountBalance -= Amount;
-            Save();
-            return true;
-        }
+        //      - Call _SaveBalance() to persist the updated balance.
+        //      - Return trSucceeded (trNotFound when the account is gone).
+        // _SaveBalance() does the check and the deduction; a stale object is
+        // refreshed and checked again against the newest balance.
+        // In shared mode the check uses the shared balance (_ApplyShared()).
+        SB_MEASURE(ClientWithdraw);
+        bool Applied;
+        enTransactionResults Result = _ApplyShared(Amount, true, Applied);
+        if (Applied)
+            return Result;
+
+        return _SaveBalance(Amount, true);
+    }
+
+    enTransactionResults Transfer(double Amount, clsBankClient &DestinationClient)
+    {
+        // Transfer process steps:
+        // 1. Withdraw the amount from this client; stop if that fails.
+        // 2. Deposit the same amount into the destination client.
+        // 3. The destination is gone: deposit the amount back into this client
+        //    (no money disappears) and return trDestinationNotFound.
+        // 4. Return trSucceeded when both sides were saved.
+        // Logging stays with the caller (client or admin transfer record).
+        SB_MEASURE(ClientTransfer);
+
+        enTransactionResults Result = Withdraw(Amount);
+        if (Result != enTransactionResults::trSucceeded)
+            return Result;
+
+        if (DestinationClient.Deposit(Amount) == enTransactionResults::trSucceeded)
+            return enTransactionResults::trSucceeded;
+
+        Deposit(Amount);
+        return enTransactionResults::trDestinationNotFound;
     }
     
     //////////////////////////////////////////////
     // Helper: Get last LOGIN time for a client
     //////////////////////////////////////////////
     
-    static string _GetLastLoginTime(string AccountNumber)
+    static string _GetLastLoginTime(const string &AccountNumber)
     {
-        vector<string> vSessions;
-        fstream MyFile("../data/ClientsSessionLog.txt", ios::in);
-
-        if (MyFile.is_open())
-        {
-            string Line;
-            while (getline(MyFile, Line))
-            {
-                vector<string> vData = clsString::Split(Line, "#//#");
-                if (vData.size() >= 4 && vData[3] == AccountNumber && vData[2] == "LOGIN")
-                {
-                    vSessions.push_back(vData[0] + " " + vData[1]); // Date + Time
-                }
-            }
-            MyFile.close();
-        }
-
-        if (vSessions.size() > 0)
-            return vSessions[vSessions.size() - 1];
-
-        return "";
+        // Scan newest -> oldest and stop at the first LOGIN of this client,
+        // normally found in the active segment without opening older ones.
+        string LastLogin = "";
+        clsStorage::ClientSessions().ForEachLineNewestFirst([&](const string &Line)
+                                                {
+                                                    if (clsString::GetFieldView(Line, "#//#", 3) != AccountNumber ||
+                                                        clsString::GetFieldView(Line, "#//#", 2) != "LOGIN")
+                                                        return false;
+
+                                                    LastLogin = string(clsString::GetFieldView(Line, "#//#", 0)) + " " +
+                                                                string(clsString::GetFieldView(Line, "#//#", 1)); // Date + Time
+                                                    return true;
+                                                });
+        return LastLogin;
     }
     
     //////////////////////////////////////////////
     // Register Client Session (LOGIN or LOGOUT)
     //////////////////////////////////////////////
     
-    static void RegisterClientSession(const clsBankClient &Client, string SessionType)
+    static void RegisterClientSession(const clsBankClient &Client, const string &SessionType)
     {
-        fstream MyFile("../data/ClientsSessionLog.txt", ios::out | ios::app);
+        string Date = clsDate::DateToString(clsDate::GetSystemDate());
+        string Time = clsDate::GetAccurateTime();
 
-        if (MyFile.is_open())
-        {
-            string Date = clsDate::DateToString(clsDate::GetSystemDate());
-            string Time = clsDate::GetAccurateTime();
-
-            string Duration = "-";
+        string Duration = "-";
 
-            if (SessionType == "LOGOUT")
+        if (SessionType == "LOGOUT")
+        {
+            string LastLoginTime = _GetLastLoginTime(Client.GetAccountNumber());
+            if (LastLoginTime != "")
             {
-                string LastLoginTime = _GetLastLoginTime(Client.GetAccountNumber());
-                if (LastLoginTime != "")
-                {
-                    Duration = _CalculateDuration(LastLoginTime, Date + " " + Time);
-                }
+                Duration = _CalculateDuration(LastLoginTime, Date + " " + Time);
             }
+        }
 
-            MyFile << Date << "#//#"
-                   << Time << "#//#"
-                   << SessionType << "#//#"
-                   << Client.GetAccountNumber() << "#//#"
-                   << Client.FullName() << "#//#"
-                   << Duration
-                   << endl;
+        string Line = Date + "#//#" +
+                      Time + "#//#" +
+                      SessionType + "#//#" +
+                      Client.GetAccountNumber() + "#//#" +
+                      Client.FullName() + "#//#" +
+                      Duration;
 
-            MyFile.close();
-        }
+        clsStorage::ClientSessions().AppendLine(Line);
     }
     
     //////////////////////////////////////////////
@@ -832,46 +1125,21 @@ public:
     
     static vector<string> GetClientSessionLog()
     {
-        vector<string> vSessions;
-        fstream MyFile("../data/ClientsSessionLog.txt", ios::in);
-
-        if (MyFile.is_open())
-        {
-            string Line;
-            while (getline(MyFile, Line))
-            {
-                vSessions.push_back(Line);
-            }
-            MyFile.close();
-        }
-
-        return vSessions;
+        return clsStorage::ClientSessions().ReadAllLines();
     }
     
     //////////////////////////////////////////////
     // Get sessions for specific client
     //////////////////////////////////////////////
     
-    static vector<string> GetClientSessionLog(string AccountNumber)
+    static vector<string> GetClientSessionLog(const string &AccountNumber)
     {
         vector<string> vSessions;
-        fstream MyFile("../data/ClientsSessionLog.txt", ios::in);
-
-        if (MyFile.is_open())
-        {
-            string Line;
-            while (getline(MyFile, Line))
-            {
-                vector<string> vData = clsString::Split(Line, "#//#");
-
-                if (vData.size() >= 4 && vData[3] == AccountNumber)
-                {
-                    vSessions.push_back(Line);
-                }
-            }
-            MyFile.close();
-        }
-
+        clsStorage::ClientSessions().ForEachLineMentioning(AccountNumber, [&](const string &Line)
+                                     {
+                                         if (clsString::GetFieldView(Line, "#//#", 3) == AccountNumber)
+                                             vSessions.push_back(Line);
+                                     });
         return vSessions;
     }
     
@@ -879,7 +1147,7 @@ public:
     // Helper: Calculate duration between login and logout
     //////////////////////////////////////////////
     
-    static string _CalculateDuration(string LoginDateTime, string LogoutDateTime)
+    static string _CalculateDuration(const string &LoginDateTime, const string &LogoutDateTime)
     {
         // Parse DateTime format: "25/11/2025 01:30:45 PM"
         vector<string> vLoginParts = clsString::Split(LoginDateTime, " ");
@@ -0,0 +1,350 @@
+/*clsBankProtocol Overview
+================================================================================
+                               clsBankProtocol.h
+================================================================================
+Overview:
+---------
+This file defines clsBankProtocol, the length-prefixed binary protocol spoken
+between the bank daemon (clsBankServer, "--serve") and its clients
+(clsBankServiceClient, "SmartBank LoadGenerator").
+
+Every message is one frame; all integers are little-endian:
+
+    uint32 Length                 bytes that follow (at most MaxFrameBytes)
+    payload:
+      request : uint32 RequestId | uint8 Opcode | arguments
+      response: uint32 RequestId | uint8 Opcode | uint8 Status | results
+
+- str is uint16 length + bytes, f64 an IEEE-754 double (8 bytes), u32 a
+  uint32.
+- RequestId is chosen by the client and echoed back. A connection may send
+  many requests without waiting (pipelining); the responses come back in
+  request order.
+- Results are only present when Status is rsOk.
+
+================================================================================
+Operations:
+-----------
+    opcode         arguments                     results
+    opPing         -                             -
+    opFind         str Account                   str FirstName, str LastName, str Email,
+                                                 str Phone, f64 Balance
+    opBalance      str Account                   f64 Balance
+    opDeposit      str Account, f64 Amount       f64 Balance
+    opWithdraw     str Account, f64 Amount       f64 Balance
+    opTransfer     str From, str To, f64 Amount  f64 FromBalance, f64 ToBalance
+    opHistory      str Account, u32 MaxRecords   u32 Count, Count x (str Date, str Time,
+                                                 u8 Type, str From, str To, f64 Amount,
+                                                 f64 BalanceAfter)   newest last
+    opConvert      str From, str To, f64 Amount  f64 Converted   (currency codes)
+
+The PIN is never sent back. Amounts must be finite and positive.
+
+================================================================================
+Addresses:
+----------
+    unix:/path/to/socket          Unix domain socket
+    tcp:7070                      127.0.0.1:7070
+    tcp:127.0.0.1:7070            TCP, loopback addresses only ("localhost" too)
+
+================================================================================
+Public Methods:
+---------------
+    static bool ParseAddress(const string &Address, stAddress &Parsed, string &Error)
+    static string StatusName(enStatus Status)
+    static string OperationName(enOpcode Opcode)
+
+    class clsWriter                 builds frames into a string
+        BeginFrame() / EndFrame(), U8(), U32(), F64(), Str()
+    class clsReader                 bounds-checked reads from one payload
+        U8(), U32(), F64(), Str(), IsValid(), AtEnd()
+    static bool NextFrame(string_view Buffer, size_t &Offset, string_view &Payload, bool &Invalid)
+
+================================================================================
+Usage Example:
+--------------
+    string Out;
+    clsBankProtocol::clsWriter Writer(Out);
+    Writer.BeginFrame();
+    Writer.U32(RequestId).U8(clsBankProtocol::opBalance).Str("A101");
+    Writer.EndFrame();
+
+================================================================================
+*/
+
+#pragma once
+
+#include <string>
+#include <string_view>
+#include <cstdint>
+#include <cstring>
+
+using namespace std;
+
+class clsBankProtocol
+{
+public:
+    static const uint32_t MaxFrameBytes = 1 << 20; // 1 MB
+    static const uint32_t MaxHistoryRecords = 1000;
+
+    enum enOpcode
+    {
+        opPing = 0,
+        opFind = 1,
+        opBalance = 2,
+        opDeposit = 3,
+        opWithdraw = 4,
+        opTransfer = 5,
+        opHistory = 6,
+        opConvert = 7,
+        OpcodeCount
+    };
+
+    enum enStatus
+    {
+        rsOk = 0,
+        rsBadRequest = 1,          // malformed arguments or amount
+        rsNotFound = 2,            // account (or currency) does not exist
+        rsInsufficientBalance = 3,
+        rsSameAccount = 4,         // transfer to the account itself
+        rsUnknownOperation = 5,
+        rsFailed = 6,              // the operation could not be stored
+        rsConnectionLost = 255     // client side only: no response arrived
+    };
+
+    enum enAddressKind
+    {
+        akUnix,
+        akTcp
+    };
+
+    struct stAddress
+    {
+        enAddressKind Kind = akUnix;
+        string Path;              // akUnix
+        string Host = "127.0.0.1"; // akTcp
+        unsigned short Port = 0;   // akTcp
+    };
+
+    static string StatusName(enStatus Status)
+    {
+        switch (Status)
+        {
+        case rsOk: return "ok";
+        case rsBadRequest: return "bad request";
+        case rsNotFound: return "not found";
+        case rsInsufficientBalance: return "insufficient balance";
+        case rsSameAccount: return "same account";
+        case rsUnknownOperation: return "unknown operation";
+        case rsFailed: return "failed";
+        case rsConnectionLost: return "connection lost";
+        default: return "unknown status";
+        }
+    }
+
+    static string OperationName(enOpcode Opcode)
+    {
+        switch (Opcode)
+        {
+        case opPing: return "ping";
+        case opFind: return "find";
+        case opBalance: return "balance";
+        case opDeposit: return "deposit";
+        case opWithdraw: return "withdraw";
+        case opTransfer: return "transfer";
+        case opHistory: return "history";
+        case opConvert: return "convert";
+        default: return "unknown";
+        }
+    }
+
+    static bool ParseAddress(const string &Address, stAddress &Parsed, string &Error)
+    {
+        // "unix:<path>", "tcp:<port>" or "tcp:<loopback host>:<port>"
+        Parsed = stAddress();
+        if (Address.rfind("unix:", 0) == 0)
+        {
+            Parsed.Kind = akUnix;
+            Parsed.Path = Address.substr(5);
+            if (Parsed.Path.empty() || Parsed.Path.size() >= 108) // sockaddr_un::sun_path
+            {
+                Error = "invalid unix socket path: " + Address;
+                return false;
+            }
+            return true;
+        }
+
+        if (Address.rfind("tcp:", 0) != 0)
+        {
+            Error = "address must start with unix: or tcp: (" + Address + ")";
+            return false;
+        }
+
+        Parsed.Kind = akTcp;
+        string Rest = Address.substr(4);
+        size_t Colon = Rest.rfind(':');
+        string PortText = (Colon == string::npos) ? Rest : Rest.substr(Colon + 1);
+        if (Colon != string::npos)
+        {
+            string Host = Rest.substr(0, Colon);
+            if (Host != "127.0.0.1" && Host != "localhost")
+            {
+                Error = "the daemon only listens on the loopback interface (127.0.0.1)";
+                return false;
+            }
+        }
+
+        if (PortText.empty() || PortText.size() > 5 || PortText.find_first_not_of("0123456789") != string::npos ||
+            stoul(PortText) == 0 || stoul(PortText) > 65535)
+        {
+            Error = "invalid tcp port: " + Address;
+            return false;
+        }
+        Parsed.Port = (unsigned short)stoul(PortText);
+        return true;
+    }
+
+    //---------------------------------------------
+    // Encoding
+    //---------------------------------------------
+    class clsWriter
+    {
+    private:
+        string &_Out;
+        size_t _FrameStart = 0;
+
+    public:
+        explicit clsWriter(string &Out) : _Out(Out) {}
+
+        void BeginFrame()
+        {
+            _FrameStart = _Out.size();
+            U32(0); // patched by EndFrame()
+        }
+
+        void EndFrame()
+        {
+            uint32_t Length = (uint32_t)(_Out.size() - _FrameStart - 4);
+            for (int i = 0; i < 4; i++)
+                _Out[_FrameStart + i] = (char)((Length >> (8 * i)) & 0xFF);
+        }
+
+        clsWriter &U8(uint8_t Value)
+        {
+            _Out += (char)Value;
+            return *this;
+        }
+
+        clsWriter &U32(uint32_t Value)
+        {
+            for (int i = 0; i < 4; i++)
+                _Out += (char)((Value >> (8 * i)) & 0xFF);
+            return *this;
+        }
+
+        clsWriter &F64(double Value)
+        {
+            uint64_t Bits;
+            memcpy(&Bits, &Value, sizeof(Bits));
+            for (int i = 0; i < 8; i++)
+                _Out += (char)((Bits >> (8 * i)) & 0xFF);
+            return *this;
+        }
+
+        clsWriter &Str(string_view Value)
+        {
+            // longer strings are cut: no field of the bank comes near 64 KB
+            size_t Length = Value.size() > 0xFFFF ? 0xFFFF : Value.size();
+            _Out += (char)(Length & 0xFF);
+            _Out += (char)((Length >> 8) & 0xFF);
+            _Out.append(Value.data(), Length);
+            return *this;
+        }
+    };
+
+    class clsReader
+    {
+    private:
+        string_view _Data;
+        size_t _Position = 0;
+        bool _Valid = true;
+
+        bool _Need(size_t Bytes)
+        {
+            if (_Valid && _Data.size() - _Position < Bytes)
+                _Valid = false;
+            return _Valid;
+        }
+
+        uint64_t _Little(size_t Bytes)
+        {
+            uint64_t Value = 0;
+            for (size_t i = 0; i < Bytes; i++)
+                Value |= (uint64_t)(unsigned char)_Data[_Position + i] << (8 * i);
+            _Position += Bytes;
+            return Value;
+        }
+
+    public:
+        explicit clsReader(string_view Data) : _Data(Data) {}
+
+        bool IsValid() const { return _Valid; }
+        bool AtEnd() const { return _Position == _Data.size(); }
+
+        uint8_t U8()
+        {
+            return _Need(1) ? (uint8_t)_Little(1) : 0;
+        }
+
+        uint32_t U32()
+        {
+            return _Need(4) ? (uint32_t)_Little(4) : 0;
+        }
+
+        double F64()
+        {
+            if (!_Need(8))
+                return 0;
+            uint64_t Bits = _Little(8);
+            double Value;
+            memcpy(&Value, &Bits, sizeof(Value));
+            return Value;
+        }
+
+        string_view Str()
+        {
+            if (!_Need(2))
+                return string_view();
+            size_t Length = (size_t)_Little(2);
+            if (!_Need(Length))
+                return string_view();
+            string_view Value = _Data.substr(_Position, Length);
+            _Position += Length;
+            return Value;
+        }
+    };
+
+    static bool NextFrame(string_view Buffer, size_t &Offset, string_view &Payload, bool &Invalid)
+    {
+        // the next complete frame at Offset (Offset moves past it); false when
+        // the frame is not complete yet or its length is over MaxFrameBytes
+        Invalid = false;
+        if (Buffer.size() - Offset < 4)
+            return false;
+
+        uint32_t Length = 0;
+        for (int i = 0; i < 4; i++)
+            Length |= (uint32_t)(unsigned char)Buffer[Offset + i] << (8 * i);
+        if (Length > MaxFrameBytes)
+        {
+            Invalid = true;
+            return false;
+        }
+        if (Buffer.size() - Offset - 4 < Length)
+            return false;
+
+        Payload = Buffer.substr(Offset + 4, Length);
+        Offset += 4 + Length;
+        return true;
+    }
+};
@@ -0,0 +1,748 @@
+/*clsBankServer Overview
+================================================================================
+                                clsBankServer.h
+================================================================================
+Overview:
+---------
+This file defines the clsBankServer class, the daemon mode of the bank
+("SmartBank System & ATM" --serve <address>): the core banking operations
+(find, balance, deposit, withdraw, transfer, history, currency conversion)
+served on a localhost socket in the binary protocol of clsBankProtocol.
+
+It runs the same engine the screens and clsBatchRunner use: deposits,
+withdrawals and transfers go through clsBankClient and are logged in
+AllTransactions.txt exactly like the ATM logs them; find / balance read the
+published client table (clsBankClient::FindReadOnly).
+
+================================================================================
+Event Loop:
+-----------
+One thread, one epoll set: the listening socket, every connection and a
+stop event (SIGINT / SIGTERM / Stop()).
+
+1. A readable connection is read until the socket is empty.
+2. Every complete frame in its buffer is executed in order (pipelining: a
+   client does not wait for a response before sending the next request).
+3. All responses produced by that read are written with one send()
+   (batched responses); what the socket does not take waits for EPOLLOUT.
+4. A connection whose unsent responses pass OutputHighWaterBytes is not
+   read again until they drain, so a client that never reads cannot make
+   the daemon buffer without limit.
+
+A frame longer than clsBankProtocol::MaxFrameBytes closes the connection;
+malformed arguments get an rsBadRequest response. Once a second the loop does
+the housekeeping of the interactive main loop (standing orders that fell due,
+snapshot refresh).
+
+Operations run on the loop thread one after another, so requests of all
+connections are serialized the way one ATM session's would be; throughput
+comes from pipelining and batching, not from threads.
+
+================================================================================
+Security:
+---------
+The daemon only listens on localhost: a Unix socket (created with mode 0600,
+owner only) or TCP on 127.0.0.1. It has the trust model of --batch: whoever
+can reach the socket can move money, and no PIN is asked.
+
+================================================================================
+Public Methods:
+---------------
+    static bool Run(const string &Address, string &Error)   blocks until stopped
+    static void Stop()                                       from any thread
+    static void Execute(string_view Request, string &Responses)
+        one request payload -> one response frame appended to Responses
+    static stStatistics GetStatistics()
+
+Settings:
+    MaxConnections          (default 1024)
+    OutputHighWaterBytes    (default 4 MB)
+
+Linux only (epoll); elsewhere Run() reports that the daemon is unavailable.
+
+================================================================================
+Usage Example:
+--------------
+    "SmartBank System & ATM" --data-root ../data/ --serve unix:/tmp/smartbank.sock
+    "SmartBank LoadGenerator" --address unix:/tmp/smartbank.sock --connections 4 --depth 32
+
+================================================================================
+*/
+
+#pragma once
+
+#include <iostream>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <unordered_map>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+
+#ifndef _WIN32
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <arpa/inet.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <signal.h>
+#include <cerrno>
+#endif
+
+#include "clsBankProtocol.h"      // core/clsBankProtocol.h
+#include "clsBankClient.h"        // core/clsBankClient.h
+#include "clsTransactionLogger.h" // core/clsTransactionLogger.h
+#include "clsCurrency.h"          // core/clsCurrency.h
+#include "clsStandingOrders.h"    // core/clsStandingOrders.h
+#include "clsSnapshot.h"          // core/clsSnapshot.h
+
+using namespace std;
+
+class clsBankServer
+{
+public:
+    struct stStatistics
+    {
+        unsigned long long Connections = 0; // accepted since Run()
+        unsigned long long Requests = 0;    // frames executed
+        unsigned long long Writes = 0;      // send() calls that carried responses
+    };
+
+    inline static size_t MaxConnections = 1024;
+    inline static size_t OutputHighWaterBytes = 4 << 20;
+
+private:
+    typedef clsBankProtocol::enStatus enStatus;
+    typedef clsBankProtocol::clsReader clsReader;
+    typedef clsBankProtocol::clsWriter clsWriter;
+
+    struct stConnection
+    {
+        int Socket = -1;
+        string In;
+        size_t InOffset = 0; // first byte not executed yet
+        string Out;
+        size_t OutOffset = 0; // first byte not sent yet
+        bool Reading = true;  // EPOLLIN registered
+        bool Writing = false; // EPOLLOUT registered
+    };
+
+    inline static atomic<int> _StopEvent{-1};
+    inline static atomic<unsigned long long> _Connections{0};
+    inline static atomic<unsigned long long> _Requests{0};
+    inline static atomic<unsigned long long> _Writes{0};
+
+    //---------------------------------------------
+    // Operations
+    //---------------------------------------------
+    static bool _ReadAmount(clsReader &Reader, double &Amount)
+    {
+        Amount = Reader.F64();
+        return isfinite(Amount) && Amount > 0;
+    }
+
+    static bool _IsAccountNumber(string_view Account)
+    {
+        return !Account.empty() && Account.size() <= clsAccountNumber::MaxLength;
+    }
+
+    static enStatus _Find(clsReader &Reader, clsWriter &Writer)
+    {
+        string_view Account = Reader.Str();
+        if (!Reader.IsValid() || !Reader.AtEnd())
+            return clsBankProtocol::rsBadRequest;
+        if (!_IsAccountNumber(Account))
+            return clsBankProtocol::rsNotFound;
+
+        clsBankClient Client = clsBankClient::FindReadOnly(string(Account));
+        if (Client.IsEmpty())
+            return clsBankProtocol::rsNotFound;
+
+        // the PIN is never sent
+        Writer.Str(Client.GetFirstName()).Str(Client.GetLastName()).Str(Client.GetEmail()).Str(Client.GetPhone());
+        Writer.F64(Client.GetAccountBalance());
+        return clsBankProtocol::rsOk;
+    }
+
+    static enStatus _Balance(clsReader &Reader, clsWriter &Writer)
+    {
+        string_view Account = Reader.Str();
+        if (!Reader.IsValid() || !Reader.AtEnd())
+            return clsBankProtocol::rsBadRequest;
+        if (!_IsAccountNumber(Account))
+            return clsBankProtocol::rsNotFound;
+
+        clsBankClient Client = clsBankClient::FindReadOnly(string(Account));
+        if (Client.IsEmpty())
+            return clsBankProtocol::rsNotFound;
+
+        Writer.F64(Client.GetAccountBalance());
+        return clsBankProtocol::rsOk;
+    }
+
+    static enStatus _Deposit(clsReader &Reader, clsWriter &Writer)
+    {
+        string_view Account = Reader.Str();
+        double Amount;
+        bool ValidAmount = _ReadAmount(Reader, Amount);
+        if (!Reader.IsValid() || !Reader.AtEnd() || !ValidAmount)
+            return clsBankProtocol::rsBadRequest;
+        if (!_IsAccountNumber(Account))
+            return clsBankProtocol::rsNotFound;
+
+        clsBankClient Client = clsBankClient::Find(string(Account));
+        if (Client.IsEmpty())
+            return clsBankProtocol::rsNotFound;
+
+        if (Client.Deposit(Amount) != clsBankClient::enTransactionResults::trSucceeded)
+            return clsBankProtocol::rsNotFound;
+        clsTransactionLogger::LogDeposit(Client, Amount);
+
+        Writer.F64(Client.GetAccountBalance());
+        return clsBankProtocol::rsOk;
+    }
+
+    static enStatus _Withdraw(clsReader &Reader, clsWriter &Writer)
+    {
+        string_view Account = Reader.Str();
+        double Amount;
+        bool ValidAmount = _ReadAmount(Reader, Amount);
+        if (!Reader.IsValid() || !Reader.AtEnd() || !ValidAmount)
+            return clsBankProtocol::rsBadRequest;
+        if (!_IsAccountNumber(Account))
+            return clsBankProtocol::rsNotFound;
+
+        clsBankClient Client = clsBankClient::Find(string(Account));
+        if (Client.IsEmpty())
+            return clsBankProtocol::rsNotFound;
+
+        switch (Client.Withdraw(Amount))
+        {
+        case clsBankClient::enTransactionResults::trSucceeded:
+            break;
+        case clsBankClient::enTransactionResults::trInsufficientBalance:
+            return clsBankProtocol::rsInsufficientBalance;
+        default:
+            return clsBankProtocol::rsNotFound;
+        }
+        clsTransactionLogger::LogWithdraw(Client, Amount);
+
+        Writer.F64(Client.GetAccountBalance());
+        return clsBankProtocol::rsOk;
+    }
+
+    static enStatus _Transfer(clsReader &Reader, clsWriter &Writer)
+    {
+        string_view From = Reader.Str();
+        string_view To = Reader.Str();
+        double Amount;
+        bool ValidAmount = _ReadAmount(Reader, Amount);
+        if (!Reader.IsValid() || !Reader.AtEnd() || !ValidAmount)
+            return clsBankProtocol::rsBadRequest;
+        if (!_IsAccountNumber(From) || !_IsAccountNumber(To))
+            return clsBankProtocol::rsNotFound;
+        if (From == To)
+            return clsBankProtocol::rsSameAccount;
+
+        clsBankClient FromClient = clsBankClient::Find(string(From));
+        clsBankClient ToClient = clsBankClient::Find(string(To));
+        if (FromClient.IsEmpty() || ToClient.IsEmpty())
+            return clsBankProtocol::rsNotFound;
+
+        switch (FromClient.Transfer(Amount, ToClient))
+        {
+        case clsBankClient::enTransactionResults::trSucceeded:
+            break;
+        case clsBankClient::enTransactionResults::trInsufficientBalance:
+            return clsBankProtocol::rsInsufficientBalance;
+        default:
+            return clsBankProtocol::rsNotFound; // either side deleted meanwhile
+        }
+        clsTransactionLogger::LogTransfer(FromClient, ToClient, Amount);
+
+        Writer.F64(FromClient.GetAccountBalance()).F64(ToClient.GetAccountBalance());
+        return clsBankProtocol::rsOk;
+    }
+
+    static enStatus _History(clsReader &Reader, clsWriter &Writer)
+    {
+        string_view Account = Reader.Str();
+        uint32_t MaxRecords = Reader.U32();
+        if (!Reader.IsValid() || !Reader.AtEnd())
+            return clsBankProtocol::rsBadRequest;
+        if (!_IsAccountNumber(Account) || clsBankClient::FindReadOnly(string(Account)).IsEmpty())
+            return clsBankProtocol::rsNotFound;
+
+        if (MaxRecords == 0 || MaxRecords > clsBankProtocol::MaxHistoryRecords)
+            MaxRecords = clsBankProtocol::MaxHistoryRecords;
+
+        clsTransactionLogger::stQueryResult Result;
+        clsTransactionLogger::QueryAccountTransactions(Result, Account);
+
+        // the newest MaxRecords, oldest first
+        size_t First = (Result.Records.size() > MaxRecords) ? Result.Records.size() - MaxRecords : 0;
+        Writer.U32((uint32_t)(Result.Records.size() - First));
+        for (size_t i = First; i < Result.Records.size(); i++)
+        {
+            const clsTransactionLogger::stTransactionRecord &Record = Result.Records[i];
+            Writer.Str(Record.Date()).Str(Record.Time()).U8((uint8_t)Record.OperationType);
+            Writer.Str(Record.FromAccount()).Str(Record.ToAccount()).F64(Record.Amount).F64(Record.BalanceAfter);
+        }
+        return clsBankProtocol::rsOk;
+    }
+
+    static enStatus _Convert(clsReader &Reader, clsWriter &Writer)
+    {
+        string_view FromCode = Reader.Str();
+        string_view ToCode = Reader.Str();
+        double Amount;
+        bool ValidAmount = _ReadAmount(Reader, Amount);
+        if (!Reader.IsValid() || !Reader.AtEnd() || !ValidAmount)
+            return clsBankProtocol::rsBadRequest;
+
+        clsCurrency From = clsCurrency::FindByCode(FromCode);
+        clsCurrency To = clsCurrency::FindByCode(ToCode);
+        if (From.IsEmpty() || To.IsEmpty())
+            return clsBankProtocol::rsNotFound;
+        if (From.GetRate() <= 0)
+            return clsBankProtocol::rsFailed;
+
+        // same formula as the currency converter screen
+        Writer.F64(Amount * (To.GetRate() / From.GetRate()));
+        return clsBankProtocol::rsOk;
+    }
+
+#ifndef _WIN32
+    //---------------------------------------------
+    // Sockets
+    //---------------------------------------------
+    static void _OnSignal(int)
+    {
+        // async-signal-safe: only write() to the stop event
+        int Event = _StopEvent.load();
+        if (Event >= 0)
+        {
+            uint64_t One = 1;
+            ssize_t Ignored = write(Event, &One, sizeof(One));
+            (void)Ignored;
+        }
+    }
+
+    static int _Listen(const clsBankProtocol::stAddress &Address, string &Error)
+    {
+        int Socket = -1;
+        if (Address.Kind == clsBankProtocol::akUnix)
+        {
+            // a socket left by a daemon that did not exit cleanly is replaced;
+            // any other file at the path is not touched
+            struct stat Info;
+            if (lstat(Address.Path.c_str(), &Info) == 0 && S_ISSOCK(Info.st_mode))
+                unlink(Address.Path.c_str());
+
+            sockaddr_un Local{};
+            Local.sun_family = AF_UNIX;
+            memcpy(Local.sun_path, Address.Path.c_str(), Address.Path.size() + 1);
+
+            Socket = socket(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+            mode_t OldMask = umask(0177); // created as 0600: owner only
+            bool Bound = Socket >= 0 && bind(Socket, (sockaddr *)&Local, sizeof(Local)) == 0;
+            umask(OldMask);
+            if (!Bound)
+            {
+                Error = "cannot bind " + Address.Path + ": " + strerror(errno);
+                if (Socket >= 0)
+                    close(Socket);
+                return -1;
+            }
+        }
+        else
+        {
+            sockaddr_in Local{};
+            Local.sin_family = AF_INET;
+            Local.sin_port = htons(Address.Port);
+            Local.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+
+            Socket = socket(AF_INET, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+            int On = 1;
+            if (Socket < 0 || setsockopt(Socket, SOL_SOCKET, SO_REUSEADDR, &On, sizeof(On)) != 0 ||
+                bind(Socket, (sockaddr *)&Local, sizeof(Local)) != 0)
+            {
+                Error = "cannot bind 127.0.0.1:" + to_string(Address.Port) + ": " + strerror(errno);
+                if (Socket >= 0)
+                    close(Socket);
+                return -1;
+            }
+        }
+
+        if (listen(Socket, SOMAXCONN) != 0)
+        {
+            Error = string("listen failed: ") + strerror(errno);
+            close(Socket);
+            return -1;
+        }
+        return Socket;
+    }
+
+    static bool _Watch(int Epoll, stConnection &Connection, bool Reading, bool Writing, bool Add)
+    {
+        epoll_event Event{};
+        uint32_t Mask = EPOLLRDHUP;
+        if (Reading)
+            Mask |= EPOLLIN;
+        if (Writing)
+            Mask |= EPOLLOUT;
+        Event.events = Mask;
+        Event.data.fd = Connection.Socket;
+        if (epoll_ctl(Epoll, Add ? EPOLL_CTL_ADD : EPOLL_CTL_MOD, Connection.Socket, &Event) != 0)
+            return false;
+        Connection.Reading = Reading;
+        Connection.Writing = Writing;
+        return true;
+    }
+
+    static bool _Receive(stConnection &Connection, bool &PeerClosed)
+    {
+        // everything the socket has now; false on a socket error. PeerClosed:
+        // the client sent its last byte (what it sent is still answered)
+        char Buffer[65536];
+        PeerClosed = false;
+        while (true)
+        {
+            ssize_t Received = recv(Connection.Socket, Buffer, sizeof(Buffer), 0);
+            if (Received > 0)
+            {
+                Connection.In.append(Buffer, (size_t)Received);
+                if (Connection.In.size() - Connection.InOffset > OutputHighWaterBytes)
+                    return true; // execute what we have first
+                continue;
+            }
+            if (Received == 0)
+            {
+                PeerClosed = true;
+                return true;
+            }
+            if (errno == EINTR)
+                continue;
+            return errno == EAGAIN || errno == EWOULDBLOCK;
+        }
+    }
+
+    static bool _ExecuteFrames(stConnection &Connection)
+    {
+        // every complete frame, in order, while the responses fit under the
+        // high-water mark; false on a frame over MaxFrameBytes
+        string_view Payload;
+        bool Invalid = false;
+        while (Connection.Out.size() - Connection.OutOffset < OutputHighWaterBytes &&
+               clsBankProtocol::NextFrame(Connection.In, Connection.InOffset, Payload, Invalid))
+        {
+            Execute(Payload, Connection.Out);
+            _Requests++;
+        }
+
+        if (Connection.InOffset == Connection.In.size())
+        {
+            Connection.In.clear();
+            Connection.InOffset = 0;
+        }
+        else if (Connection.InOffset > Connection.In.size() / 2)
+        {
+            Connection.In.erase(0, Connection.InOffset);
+            Connection.InOffset = 0;
+        }
+        return !Invalid;
+    }
+
+    static bool _Send(stConnection &Connection)
+    {
+        // one send() for all pending responses when the socket takes them
+        while (Connection.OutOffset < Connection.Out.size())
+        {
+            ssize_t Sent = send(Connection.Socket, Connection.Out.data() + Connection.OutOffset,
+                                Connection.Out.size() - Connection.OutOffset, MSG_NOSIGNAL);
+            if (Sent > 0)
+            {
+                Connection.OutOffset += (size_t)Sent;
+                _Writes++;
+                continue;
+            }
+            if (Sent < 0 && errno == EINTR)
+                continue;
+            return Sent < 0 && (errno == EAGAIN || errno == EWOULDBLOCK);
+        }
+
+        Connection.Out.clear();
+        Connection.OutOffset = 0;
+        return true;
+    }
+
+    static bool _Serve(int Epoll, stConnection &Connection, bool Readable)
+    {
+        // read, execute, answer; repeat while output drains and frames wait
+        bool PeerClosed = false;
+        if (Readable && !_Receive(Connection, PeerClosed))
+            return false;
+
+        while (true)
+        {
+            size_t Before = Connection.InOffset + Connection.In.size();
+            if (!_ExecuteFrames(Connection) || !_Send(Connection))
+                return false;
+
+            bool Progress = (Connection.InOffset + Connection.In.size()) != Before;
+            if (!Progress || Connection.Out.size() > Connection.OutOffset || Connection.InOffset == Connection.In.size())
+                break;
+        }
+
+        // a closed peer gets the responses the socket takes now, then the
+        // connection is closed
+        if (PeerClosed)
+            return false;
+
+        bool Pending = Connection.Out.size() > Connection.OutOffset;
+        bool Reading = (Connection.Out.size() - Connection.OutOffset) < OutputHighWaterBytes;
+        if (Reading != Connection.Reading || Pending != Connection.Writing)
+            return _Watch(Epoll, Connection, Reading, Pending, false);
+        return true;
+    }
+
+    static void _Housekeeping()
+    {
+        // what the interactive main loop does between screens
+        clsStandingOrders::RunDueOrders();
+        clsSnapshot::WriteIfDue();
+    }
+#endif
+
+public:
+    static void Execute(string_view Request, string &Responses)
+    {
+        // Execute process steps:
+        // 1. Read the request id and opcode.
+        // 2. Run the operation; its results are written after an rsOk status.
+        // 3. On any other status the results are dropped and the status kept.
+        // 4. Close the frame (length prefix).
+        clsReader Reader(Request);
+        uint32_t RequestId = Reader.U32();
+        uint8_t Opcode = Reader.U8();
+
+        clsWriter Writer(Responses);
+        Writer.BeginFrame();
+        Writer.U32(RequestId).U8(Opcode);
+        size_t StatusAt = Responses.size();
+        Writer.U8(clsBankProtocol::rsOk);
+
+        enStatus Status = clsBankProtocol::rsBadRequest;
+        if (Reader.IsValid())
+        {
+            switch (Opcode)
+            {
+            case clsBankProtocol::opPing:
+                Status = Reader.AtEnd() ? clsBankProtocol::rsOk : clsBankProtocol::rsBadRequest;
+                break;
+            case clsBankProtocol::opFind:
+                Status = _Find(Reader, Writer);
+                break;
+            case clsBankProtocol::opBalance:
+                Status = _Balance(Reader, Writer);
+                break;
+            case clsBankProtocol::opDeposit:
+                Status = _Deposit(Reader, Writer);
+                break;
+            case clsBankProtocol::opWithdraw:
+                Status = _Withdraw(Reader, Writer);
+                break;
+            case clsBankProtocol::opTransfer:
+                Status = _Transfer(Reader, Writer);
+                break;
+            case clsBankProtocol::opHistory:
+                Status = _History(Reader, Writer);
+                break;
+            case clsBankProtocol::opConvert:
+                Status = _Convert(Reader, Writer);
+                break;
+            default:
+                Status = clsBankProtocol::rsUnknownOperation;
+                break;
+            }
+        }
+
+        if (Status != clsBankProtocol::rsOk)
+        {
+            Responses.resize(StatusAt);
+            Writer.U8((uint8_t)Status);
+        }
+        Writer.EndFrame();
+    }
+
+    static stStatistics GetStatistics()
+    {
+        stStatistics Statistics;
+        Statistics.Connections = _Connections;
+        Statistics.Requests = _Requests;
+        Statistics.Writes = _Writes;
+        return Statistics;
+    }
+
+    static void Stop()
+    {
+#ifndef _WIN32
+        _OnSignal(0);
+#endif
+    }
+
+    static bool Run(const string &Address, string &Error)
+    {
+        // Run process steps:
+        // 1. Listen on the address (Unix socket 0600 or TCP on 127.0.0.1).
+        // 2. Register the listener and the stop event with epoll; SIGINT and
+        //    SIGTERM trigger the stop event.
+        // 3. Loop: accept, serve readable / writable connections, housekeeping
+        //    once a second.
+        // 4. On stop: close every connection and remove the Unix socket file.
+#ifdef _WIN32
+        (void)Address;
+        Error = "the daemon mode needs Linux (epoll)";
+        return false;
+#else
+        clsBankProtocol::stAddress Parsed;
+        if (!clsBankProtocol::ParseAddress(Address, Parsed, Error))
+            return false;
+
+        int Listener = _Listen(Parsed, Error);
+        if (Listener < 0)
+            return false;
+
+        int Epoll = epoll_create1(EPOLL_CLOEXEC);
+        int StopEvent = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+        if (Epoll < 0 || StopEvent < 0)
+        {
+            Error = string("epoll setup failed: ") + strerror(errno);
+            close(Listener);
+            if (Epoll >= 0)
+                close(Epoll);
+            if (StopEvent >= 0)
+                close(StopEvent);
+            return false;
+        }
+
+        epoll_event Event{};
+        Event.events = EPOLLIN;
+        Event.data.fd = Listener;
+        epoll_ctl(Epoll, EPOLL_CTL_ADD, Listener, &Event);
+        Event.data.fd = StopEvent;
+        epoll_ctl(Epoll, EPOLL_CTL_ADD, StopEvent, &Event);
+
+        _StopEvent = StopEvent;
+        struct sigaction Handler{}, OldInterrupt{}, OldTerminate{};
+        Handler.sa_handler = &clsBankServer::_OnSignal;
+        sigemptyset(&Handler.sa_mask);
+        sigaction(SIGINT, &Handler, &OldInterrupt);
+        sigaction(SIGTERM, &Handler, &OldTerminate);
+
+        cout << "SmartBank daemon listening on " << Address << endl;
+
+        unordered_map<int, stConnection> Connections;
+        epoll_event vEvents[64];
+        auto LastHousekeeping = chrono::steady_clock::now();
+        bool Running = true;
+
+        auto CloseConnection = [&Connections, Epoll](int Socket)
+        {
+            epoll_ctl(Epoll, EPOLL_CTL_DEL, Socket, nullptr);
+            close(Socket);
+            Connections.erase(Socket);
+        };
+
+        while (Running)
+        {
+            int Ready = epoll_wait(Epoll, vEvents, 64, 1000);
+            if (Ready < 0 && errno != EINTR)
+            {
+                Error = string("epoll_wait failed: ") + strerror(errno);
+                break;
+            }
+
+            for (int i = 0; i < Ready; i++)
+            {
+                int Socket = vEvents[i].data.fd;
+                unsigned int Events = vEvents[i].events;
+
+                if (Socket == StopEvent)
+                {
+                    Running = false;
+                    continue;
+                }
+
+                if (Socket == Listener)
+                {
+                    int Client;
+                    while ((Client = accept4(Listener, nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC)) >= 0)
+                    {
+                        if (Connections.size() >= MaxConnections)
+                        {
+                            close(Client);
+                            continue;
+                        }
+                        if (Parsed.Kind == clsBankProtocol::akTcp)
+                        {
+                            int On = 1; // responses are already batched; do not delay them
+                            setsockopt(Client, IPPROTO_TCP, TCP_NODELAY, &On, sizeof(On));
+                        }
+
+                        stConnection &Connection = Connections[Client];
+                        Connection.Socket = Client;
+                        if (!_Watch(Epoll, Connection, true, false, true))
+                        {
+                            close(Client);
+                            Connections.erase(Client);
+                            continue;
+                        }
+                        _Connections++;
+                    }
+                    continue;
+                }
+
+                auto It = Connections.find(Socket);
+                if (It == Connections.end())
+                    continue;
+
+                bool Readable = (Events & (EPOLLIN | EPOLLRDHUP | EPOLLHUP | EPOLLERR)) != 0 && It->second.Reading;
+                if ((Events & EPOLLERR) != 0 || !_Serve(Epoll, It->second, Readable))
+                    CloseConnection(Socket);
+            }
+
+            auto Now = chrono::steady_clock::now();
+            if (Now - LastHousekeeping >= chrono::seconds(1))
+            {
+                LastHousekeeping = Now;
+                _Housekeeping();
+            }
+        }
+
+        for (auto &Entry : Connections)
+            close(Entry.first);
+        Connections.clear();
+
+        sigaction(SIGINT, &OldInterrupt, nullptr);
+        sigaction(SIGTERM, &OldTerminate, nullptr);
+        _StopEvent = -1;
+        close(StopEvent);
+        close(Epoll);
+        close(Listener);
+        if (Parsed.Kind == clsBankProtocol::akUnix)
+            unlink(Parsed.Path.c_str());
+
+        stStatistics Statistics = GetStatistics();
+        cout << "SmartBank daemon stopped: " << Statistics.Connections << " connections, "
+             << Statistics.Requests << " requests, " << Statistics.Writes << " writes" << endl;
+        return Error.empty();
+#endif
+    }
+};
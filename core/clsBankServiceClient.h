@@ -0,0 +1,496 @@
+/*clsBankServiceClient Overview
+================================================================================
+                             clsBankServiceClient.h
+================================================================================
+Overview:
+---------
+This file defines the clsBankServiceClient class, the client side of the bank
+daemon (clsBankServer, "--serve"): one connection speaking clsBankProtocol.
+
+Two ways to use it:
+
+1. Blocking calls - Find(), GetBalance(), Deposit(), Withdraw(), Transfer(),
+   History(), Convert(), Ping(): send one request, wait for its response,
+   return the status (rsOk or the reason it failed).
+
+2. Pipelining - QueueX() appends a request to the send buffer and returns its
+   RequestId; Flush() sends everything queued in one write; Receive() returns
+   the responses one by one in request order. This is how
+   "SmartBank LoadGenerator" keeps many requests in flight per connection.
+
+A blocking call made while pipelined requests are still pending skips their
+responses; finish (Receive) them first.
+
+================================================================================
+Public Methods:
+---------------
+    bool Connect(const string &Address, string &Error)     unix:<path> | tcp:<port>
+    void Close()
+    bool IsConnected() const
+
+    uint32_t QueuePing() / QueueFind(Account) / QueueBalance(Account)
+    uint32_t QueueDeposit(Account, Amount) / QueueWithdraw(Account, Amount)
+    uint32_t QueueTransfer(From, To, Amount) / QueueHistory(Account, MaxRecords)
+    uint32_t QueueConvert(FromCode, ToCode, Amount)
+    bool Flush()
+    bool Receive(stResponse &Response)
+    size_t PendingResponses() const
+
+    enStatus Ping()
+    enStatus Find(Account, stClientInfo &Info)
+    enStatus GetBalance(Account, double &Balance)
+    enStatus Deposit(Account, Amount, double &Balance)
+    enStatus Withdraw(Account, Amount, double &Balance)
+    enStatus Transfer(From, To, Amount, double &FromBalance, double &ToBalance)
+    enStatus History(Account, MaxRecords, vector<stHistoryRecord> &vRecords)
+    enStatus Convert(FromCode, ToCode, Amount, double &Converted)
+
+Linux / POSIX only, like the daemon.
+
+================================================================================
+Usage Example:
+--------------
+    clsBankServiceClient Client;
+    string Error;
+    if (Client.Connect("unix:/tmp/smartbank.sock", Error))
+    {
+        double Balance;
+        if (Client.Deposit("A101", 100, Balance) == clsBankProtocol::rsOk)
+            cout << Balance;
+    }
+
+================================================================================
+*/
+
+#pragma once
+
+#include <string>
+#include <string_view>
+#include <vector>
+#include <cstdint>
+#include <cstring>
+
+#ifndef _WIN32
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <arpa/inet.h>
+#include <unistd.h>
+#include <cerrno>
+#endif
+
+#include "clsBankProtocol.h" // core/clsBankProtocol.h
+
+using namespace std;
+
+class clsBankServiceClient
+{
+public:
+    typedef clsBankProtocol::enStatus enStatus;
+
+    struct stResponse
+    {
+        uint32_t RequestId = 0;
+        clsBankProtocol::enOpcode Opcode = clsBankProtocol::opPing;
+        enStatus Status = clsBankProtocol::rsConnectionLost;
+        string Results; // encoded results, read with clsBankProtocol::clsReader
+    };
+
+    struct stClientInfo
+    {
+        string FirstName;
+        string LastName;
+        string Email;
+        string Phone;
+        double Balance = 0;
+    };
+
+    struct stHistoryRecord
+    {
+        string Date;
+        string Time;
+        uint8_t OperationType = 0; // clsTransactionLogger::enOperationType
+        string FromAccount;
+        string ToAccount;
+        double Amount = 0;
+        double BalanceAfter = 0;
+    };
+
+private:
+    int _Socket = -1;
+    string _Out;
+    string _In;
+    size_t _InOffset = 0;
+    uint32_t _NextRequestId = 1;
+    size_t _Pending = 0; // queued requests whose response has not been received
+
+    clsBankProtocol::clsWriter _BeginRequest(clsBankProtocol::enOpcode Opcode, uint32_t &RequestId)
+    {
+        RequestId = _NextRequestId++;
+        _Pending++;
+
+        clsBankProtocol::clsWriter Writer(_Out);
+        Writer.BeginFrame();
+        Writer.U32(RequestId).U8((uint8_t)Opcode);
+        return Writer;
+    }
+
+    bool _Call(uint32_t RequestId, stResponse &Response)
+    {
+        // the response to RequestId; responses to older pipelined requests
+        // are skipped
+        while (Receive(Response))
+        {
+            if (Response.RequestId == RequestId)
+                return true;
+        }
+        return false;
+    }
+
+public:
+    clsBankServiceClient() = default;
+    clsBankServiceClient(const clsBankServiceClient &) = delete;
+    clsBankServiceClient &operator=(const clsBankServiceClient &) = delete;
+
+    ~clsBankServiceClient()
+    {
+        Close();
+    }
+
+    bool IsConnected() const
+    {
+        return _Socket >= 0;
+    }
+
+    size_t PendingResponses() const
+    {
+        return _Pending;
+    }
+
+    bool Connect(const string &Address, string &Error)
+    {
+        Close();
+#ifdef _WIN32
+        (void)Address;
+        Error = "the bank daemon client needs Linux";
+        return false;
+#else
+        clsBankProtocol::stAddress Parsed;
+        if (!clsBankProtocol::ParseAddress(Address, Parsed, Error))
+            return false;
+
+        int Socket;
+        bool Connected;
+        if (Parsed.Kind == clsBankProtocol::akUnix)
+        {
+            sockaddr_un Remote{};
+            Remote.sun_family = AF_UNIX;
+            memcpy(Remote.sun_path, Parsed.Path.c_str(), Parsed.Path.size() + 1);
+            Socket = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+            Connected = Socket >= 0 && connect(Socket, (sockaddr *)&Remote, sizeof(Remote)) == 0;
+        }
+        else
+        {
+            sockaddr_in Remote{};
+            Remote.sin_family = AF_INET;
+            Remote.sin_port = htons(Parsed.Port);
+            Remote.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+            Socket = socket(AF_INET, SOCK_STREAM | SOCK_CLOEXEC, 0);
+            Connected = Socket >= 0 && connect(Socket, (sockaddr *)&Remote, sizeof(Remote)) == 0;
+            if (Connected)
+            {
+                int On = 1; // requests are already batched by Flush()
+                setsockopt(Socket, IPPROTO_TCP, TCP_NODELAY, &On, sizeof(On));
+            }
+        }
+
+        if (!Connected)
+        {
+            Error = "cannot connect to " + Address + ": " + strerror(errno);
+            if (Socket >= 0)
+                close(Socket);
+            return false;
+        }
+
+        _Socket = Socket;
+        return true;
+#endif
+    }
+
+    void Close()
+    {
+#ifndef _WIN32
+        if (_Socket >= 0)
+            close(_Socket);
+#endif
+        _Socket = -1;
+        _Out.clear();
+        _In.clear();
+        _InOffset = 0;
+        _Pending = 0;
+    }
+
+    //---------------------------------------------
+    // Pipelining
+    //---------------------------------------------
+    uint32_t QueuePing()
+    {
+        uint32_t RequestId;
+        _BeginRequest(clsBankProtocol::opPing, RequestId).EndFrame();
+        return RequestId;
+    }
+
+    uint32_t QueueFind(string_view Account)
+    {
+        uint32_t RequestId;
+        clsBankProtocol::clsWriter Writer = _BeginRequest(clsBankProtocol::opFind, RequestId);
+        Writer.Str(Account).EndFrame();
+        return RequestId;
+    }
+
+    uint32_t QueueBalance(string_view Account)
+    {
+        uint32_t RequestId;
+        clsBankProtocol::clsWriter Writer = _BeginRequest(clsBankProtocol::opBalance, RequestId);
+        Writer.Str(Account).EndFrame();
+        return RequestId;
+    }
+
+    uint32_t QueueDeposit(string_view Account, double Amount)
+    {
+        uint32_t RequestId;
+        clsBankProtocol::clsWriter Writer = _BeginRequest(clsBankProtocol::opDeposit, RequestId);
+        Writer.Str(Account).F64(Amount).EndFrame();
+        return RequestId;
+    }
+
+    uint32_t QueueWithdraw(string_view Account, double Amount)
+    {
+        uint32_t RequestId;
+        clsBankProtocol::clsWriter Writer = _BeginRequest(clsBankProtocol::opWithdraw, RequestId);
+        Writer.Str(Account).F64(Amount).EndFrame();
+        return RequestId;
+    }
+
+    uint32_t QueueTransfer(string_view From, string_view To, double Amount)
+    {
+        uint32_t RequestId;
+        clsBankProtocol::clsWriter Writer = _BeginRequest(clsBankProtocol::opTransfer, RequestId);
+        Writer.Str(From).Str(To).F64(Amount).EndFrame();
+        return RequestId;
+    }
+
+    uint32_t QueueHistory(string_view Account, uint32_t MaxRecords)
+    {
+        uint32_t RequestId;
+        clsBankProtocol::clsWriter Writer = _BeginRequest(clsBankProtocol::opHistory, RequestId);
+        Writer.Str(Account).U32(MaxRecords).EndFrame();
+        return RequestId;
+    }
+
+    uint32_t QueueConvert(string_view FromCode, string_view ToCode, double Amount)
+    {
+        uint32_t RequestId;
+        clsBankProtocol::clsWriter Writer = _BeginRequest(clsBankProtocol::opConvert, RequestId);
+        Writer.Str(FromCode).Str(ToCode).F64(Amount).EndFrame();
+        return RequestId;
+    }
+
+    bool Flush()
+    {
+        // every queued request in as few send() calls as the socket allows
+#ifdef _WIN32
+        return false;
+#else
+        size_t Sent = 0;
+        while (Sent < _Out.size())
+        {
+            ssize_t Written = send(_Socket, _Out.data() + Sent, _Out.size() - Sent, MSG_NOSIGNAL);
+            if (Written < 0 && errno == EINTR)
+                continue;
+            if (Written <= 0)
+            {
+                Close();
+                return false;
+            }
+            Sent += (size_t)Written;
+        }
+        _Out.clear();
+        return true;
+#endif
+    }
+
+    bool Receive(stResponse &Response)
+    {
+        // Receive process steps:
+        // 1. Send what is still queued (a response may be waiting on it).
+        // 2. Return the next complete frame already read, if any.
+        // 3. Otherwise block on recv() and try again.
+        // False when the connection is closed or the server sent garbage.
+#ifdef _WIN32
+        (void)Response;
+        return false;
+#else
+        if (_Socket < 0 || (!_Out.empty() && !Flush()))
+            return false;
+
+        while (true)
+        {
+            string_view Payload;
+            bool Invalid = false;
+            if (clsBankProtocol::NextFrame(_In, _InOffset, Payload, Invalid))
+            {
+                clsBankProtocol::clsReader Reader(Payload);
+                Response.RequestId = Reader.U32();
+                Response.Opcode = (clsBankProtocol::enOpcode)Reader.U8();
+                Response.Status = (enStatus)Reader.U8();
+                if (!Reader.IsValid())
+                {
+                    Close();
+                    return false;
+                }
+                Response.Results.assign(Payload.substr(6));
+
+                if (_InOffset == _In.size())
+                {
+                    _In.clear();
+                    _InOffset = 0;
+                }
+                if (_Pending > 0)
+                    _Pending--;
+                return true;
+            }
+            if (Invalid)
+            {
+                Close();
+                return false;
+            }
+
+            if (_InOffset > 0)
+            {
+                _In.erase(0, _InOffset);
+                _InOffset = 0;
+            }
+
+            char Buffer[65536];
+            ssize_t Received = recv(_Socket, Buffer, sizeof(Buffer), 0);
+            if (Received < 0 && errno == EINTR)
+                continue;
+            if (Received <= 0)
+            {
+                Close();
+                return false;
+            }
+            _In.append(Buffer, (size_t)Received);
+        }
+#endif
+    }
+
+    //---------------------------------------------
+    // Blocking calls
+    //---------------------------------------------
+    enStatus Ping()
+    {
+        stResponse Response;
+        return _Call(QueuePing(), Response) ? Response.Status : clsBankProtocol::rsConnectionLost;
+    }
+
+    enStatus Find(string_view Account, stClientInfo &Info)
+    {
+        stResponse Response;
+        if (!_Call(QueueFind(Account), Response))
+            return clsBankProtocol::rsConnectionLost;
+        if (Response.Status == clsBankProtocol::rsOk)
+        {
+            clsBankProtocol::clsReader Reader(Response.Results);
+            Info.FirstName = string(Reader.Str());
+            Info.LastName = string(Reader.Str());
+            Info.Email = string(Reader.Str());
+            Info.Phone = string(Reader.Str());
+            Info.Balance = Reader.F64();
+        }
+        return Response.Status;
+    }
+
+    enStatus GetBalance(string_view Account, double &Balance)
+    {
+        stResponse Response;
+        if (!_Call(QueueBalance(Account), Response))
+            return clsBankProtocol::rsConnectionLost;
+        if (Response.Status == clsBankProtocol::rsOk)
+            Balance = clsBankProtocol::clsReader(Response.Results).F64();
+        return Response.Status;
+    }
+
+    enStatus Deposit(string_view Account, double Amount, double &Balance)
+    {
+        stResponse Response;
+        if (!_Call(QueueDeposit(Account, Amount), Response))
+            return clsBankProtocol::rsConnectionLost;
+        if (Response.Status == clsBankProtocol::rsOk)
+            Balance = clsBankProtocol::clsReader(Response.Results).F64();
+        return Response.Status;
+    }
+
+    enStatus Withdraw(string_view Account, double Amount, double &Balance)
+    {
+        stResponse Response;
+        if (!_Call(QueueWithdraw(Account, Amount), Response))
+            return clsBankProtocol::rsConnectionLost;
+        if (Response.Status == clsBankProtocol::rsOk)
+            Balance = clsBankProtocol::clsReader(Response.Results).F64();
+        return Response.Status;
+    }
+
+    enStatus Transfer(string_view From, string_view To, double Amount, double &FromBalance, double &ToBalance)
+    {
+        stResponse Response;
+        if (!_Call(QueueTransfer(From, To, Amount), Response))
+            return clsBankProtocol::rsConnectionLost;
+        if (Response.Status == clsBankProtocol::rsOk)
+        {
+            clsBankProtocol::clsReader Reader(Response.Results);
+            FromBalance = Reader.F64();
+            ToBalance = Reader.F64();
+        }
+        return Response.Status;
+    }
+
+    enStatus History(string_view Account, uint32_t MaxRecords, vector<stHistoryRecord> &vRecords)
+    {
+        stResponse Response;
+        if (!_Call(QueueHistory(Account, MaxRecords), Response))
+            return clsBankProtocol::rsConnectionLost;
+        if (Response.Status != clsBankProtocol::rsOk)
+            return Response.Status;
+
+        clsBankProtocol::clsReader Reader(Response.Results);
+        uint32_t Count = Reader.U32();
+        vRecords.clear();
+        for (uint32_t i = 0; i < Count && Reader.IsValid(); i++)
+        {
+            stHistoryRecord Record;
+            Record.Date = string(Reader.Str());
+            Record.Time = string(Reader.Str());
+            Record.OperationType = Reader.U8();
+            Record.FromAccount = string(Reader.Str());
+            Record.ToAccount = string(Reader.Str());
+            Record.Amount = Reader.F64();
+            Record.BalanceAfter = Reader.F64();
+            if (Reader.IsValid())
+                vRecords.push_back(move(Record));
+        }
+        return Response.Status;
+    }
+
+    enStatus Convert(string_view FromCode, string_view ToCode, double Amount, double &Converted)
+    {
+        stResponse Response;
+        if (!_Call(QueueConvert(FromCode, ToCode, Amount), Response))
+            return clsBankProtocol::rsConnectionLost;
+        if (Response.Status == clsBankProtocol::rsOk)
+            Converted = clsBankProtocol::clsReader(Response.Results).F64();
+        return Response.Status;
+    }
+};
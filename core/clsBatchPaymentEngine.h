@@ -0,0 +1,471 @@
+/*clsBatchPaymentEngine Overview
+================================================================================
+                            clsBatchPaymentEngine.h
+================================================================================
+Overview:
+---------
+This file defines the clsBatchPaymentEngine class, which posts a whole file of
+payment instructions (payroll, mass deposits, bulk transfers) in one go.
+
+Posting the same file through the Deposit / Transfer screens rewrites
+Clients.txt and reopens AllTransactions.txt for every single operation. The
+engine instead:
+
+1. Loads the clients once into a clsAccountTable (balances in a dense array,
+   account number -> row through a hash index).
+2. Applies every instruction to the in-memory balances, in file order, so a
+   deposit earlier in the file can fund a transfer later in it. All the
+   changes of one account land on its single row.
+3. Rejects bad lines (unknown account, bad amount, insufficient funds...)
+   with their line number and reason; they never stop the other lines.
+4. Persists with ONE rewrite of Clients.txt (clsAccountTable::SaveBalances)
+   and ONE group commit of all log lines (AppendTransactionLines).
+
+================================================================================
+Instruction File:
+-----------------
+One instruction per line:
+
+    from,to,amount
+
+- "-" as from  : deposit into "to" (money entering the bank, e.g. payroll)
+- "-" as to    : withdrawal from "from"
+- otherwise    : transfer from "from" to "to"
+
+Blank lines, lines starting with '#' and a "from,to,amount" header are skipped.
+
+================================================================================
+Prepare / Commit:
+-----------------
+Prepare() parses the file and simulates it on a freshly loaded table: nothing
+is written, the result shows what would be posted and rejected.
+
+Commit() reloads the table and applies the parsed instructions again, so
+balances changed by ATM operations after Prepare() are taken into account
+(and re-checked for insufficient funds), then writes data and log once.
+SaveBalances() writes nothing when an account it changes was changed by
+another writer since the load; Commit() then loads and applies again, up to
+CommitAttempts times, and otherwise posts nothing (every line is rejected).
+
+Log lines are client operations (TRANSFER_OUT/IN, DEPOSIT, WITHDRAW) or, when
+an operator username is given, admin operations (ADM_TRANS_OUT/IN,
+ADMIN_DEPOSIT, ADMIN_WITHDRAW) by that admin.
+
+================================================================================
+Public Methods:
+---------------
+    Prepare(FilePath, OperatorUsername = "")   parse + simulate, writes nothing
+    Commit(Result)                             apply on fresh data, write once
+    Post(FilePath, OperatorUsername = "")      parse + commit (no preview)
+    Post(vInstructions, OperatorUsername = "") commit instructions built in memory
+
+Settings:
+    CommitAttempts (default 3)
+
+================================================================================
+Usage Example:
+--------------
+    clsBatchPaymentEngine::stBatchResult Result =
+        clsBatchPaymentEngine::Prepare("../data/payroll.csv", CurrentAdmin.GetAdminUsername());
+
+    cout << Result.Posted << " postings, " << Result.vRejected.size() << " rejected";
+    clsBatchPaymentEngine::Commit(Result);
+
+================================================================================
+*/
+
+#pragma once
+
+#include <iostream>
+#include <fstream>
+#include <string>
+#include <vector>
+#include <chrono>
+#include <cstdlib>
+#include <cmath>
+#include <cstdio>
+
+#include "clsAccountTable.h"      // core/clsAccountTable.h
+#include "clsClientTableRcu.h"    // core/clsClientTableRcu.h
+#include "clsTransactionLogger.h" // core/clsTransactionLogger.h
+#include "../utils/clsString.h"       // utils/clsString.h
+#include "../utils/clsFixedString.h"  // utils/clsFixedString.h
+#include "../utils/clsDate.h"         // utils/clsDate.h
+
+using namespace std;
+
+class clsBatchPaymentEngine
+{
+public:
+    // Commit(): loads + applies + saves tried while other writers keep
+    // changing the same accounts
+    inline static int CommitAttempts = 3;
+
+    struct stRejectedPosting
+    {
+        size_t LineNumber = 0;
+        string Instruction;
+        string Reason;
+    };
+
+    struct stInstruction
+    {
+        size_t LineNumber = 0;
+        clsAccountNumber FromAccount; // empty = deposit
+        clsAccountNumber ToAccount;   // empty = withdrawal
+        double Amount = 0;
+        string Reason;                // set when the line itself is malformed
+    };
+
+    struct stBatchResult
+    {
+        bool FileFound = false;
+        bool Committed = false;
+        string OperatorUsername;
+        vector<stInstruction> vInstructions;
+
+        // filled by the last Prepare() / Commit()
+        size_t Posted = 0;
+        size_t AccountsTouched = 0;
+        vector<string> vConflicts; // accounts that kept changing: nothing committed
+        double TotalAmount = 0;
+        vector<stRejectedPosting> vRejected;
+        double Seconds = 0;
+    };
+
+private:
+    enum enPostingType
+    {
+        ptDeposit,
+        ptWithdraw,
+        ptTransfer
+    };
+
+    struct stPosting
+    {
+        enPostingType Type;
+        int FromIndex;
+        int ToIndex;
+        double Amount;
+        double FromBalanceAfter;
+        double ToBalanceAfter;
+    };
+
+    static bool _IsExternal(string_view Field)
+    {
+        return Field == "-";
+    }
+
+    static stInstruction _ParseLine(const string &Line, size_t LineNumber)
+    {
+        stInstruction Instruction;
+        Instruction.LineNumber = LineNumber;
+
+        size_t FirstComma = Line.find(',');
+        size_t SecondComma = (FirstComma == string::npos) ? string::npos : Line.find(',', FirstComma + 1);
+        if (SecondComma == string::npos || Line.find(',', SecondComma + 1) != string::npos)
+        {
+            Instruction.Reason = "malformed line (expected from,to,amount)";
+            return Instruction;
+        }
+
+        string From = clsString::Trim(string_view(Line).substr(0, FirstComma));
+        string To = clsString::Trim(string_view(Line).substr(FirstComma + 1, SecondComma - FirstComma - 1));
+        string Amount = clsString::Trim(string_view(Line).substr(SecondComma + 1));
+
+        if (_IsExternal(From) && _IsExternal(To))
+        {
+            Instruction.Reason = "from and to cannot both be \"-\"";
+            return Instruction;
+        }
+
+        Instruction.FromAccount = _IsExternal(From) ? clsAccountNumber("") : clsAccountNumber(From);
+        Instruction.ToAccount = _IsExternal(To) ? clsAccountNumber("") : clsAccountNumber(To);
+
+        char *End = nullptr;
+        Instruction.Amount = strtod(Amount.c_str(), &End);
+        if (Amount.empty() || *End != '\0' || !isfinite(Instruction.Amount) || !(Instruction.Amount > 0))
+            Instruction.Reason = "invalid amount";
+        else if (From.empty() || To.empty())
+            Instruction.Reason = "missing account";
+        else if (!Instruction.FromAccount.IsValid() || !Instruction.ToAccount.IsValid())
+            Instruction.Reason = "account number too long";
+        else if (From == To)
+            Instruction.Reason = "from and to are the same account";
+
+        return Instruction;
+    }
+
+    static string _Describe(const stInstruction &Instruction)
+    {
+        string From = Instruction.FromAccount.IsEmpty() ? "-" : Instruction.FromAccount.ToString();
+        string To = Instruction.ToAccount.IsEmpty() ? "-" : Instruction.ToAccount.ToString();
+
+        char Amount[32];
+        snprintf(Amount, sizeof(Amount), "%.2f", Instruction.Amount);
+        return From + " -> " + To + " : " + Amount;
+    }
+
+    static bool _ReadInstructions(const string &FilePath, stBatchResult &Result)
+    {
+        // parse every instruction line; malformed lines keep their reason
+        fstream MyFile(FilePath, ios::in); // read Mode
+        if (!MyFile.is_open())
+            return false;
+
+        string Line;
+        size_t LineNumber = 0;
+        while (getline(MyFile, Line))
+        {
+            LineNumber++;
+            if (!Line.empty() && Line.back() == '\r')
+                Line.pop_back();
+
+            string Trimmed = clsString::Trim(Line);
+            if (Trimmed.empty() || Trimmed[0] == '#')
+                continue;
+
+            if (Result.vInstructions.empty() && clsString::LowerAllString(Trimmed).rfind("from,", 0) == 0)
+                continue; // header
+
+            Result.vInstructions.push_back(_ParseLine(Trimmed, LineNumber));
+        }
+        MyFile.close();
+        return true;
+    }
+
+    static void _RejectAll(stBatchResult &Result, const string &Reason)
+    {
+        // nothing was posted: the lines _Apply() accepted join the rejected
+        // ones (both lists are in instruction order)
+        vector<stRejectedPosting> vRejected;
+        vRejected.reserve(Result.vInstructions.size());
+        size_t Next = 0;
+        for (const stInstruction &Instruction : Result.vInstructions)
+        {
+            string Description = _Describe(Instruction);
+            if (Next < Result.vRejected.size() && Result.vRejected[Next].LineNumber == Instruction.LineNumber &&
+                Result.vRejected[Next].Instruction == Description)
+                vRejected.push_back(move(Result.vRejected[Next++]));
+            else
+                vRejected.push_back({Instruction.LineNumber, Description, Reason});
+        }
+
+        Result.vRejected = move(vRejected);
+        Result.Posted = 0;
+        Result.AccountsTouched = 0;
+        Result.TotalAmount = 0;
+    }
+
+    static void _Apply(clsAccountTable &Table, stBatchResult &Result, vector<stPosting> &vPostings)
+    {
+        // _Apply process steps:
+        // 1. Resolve both accounts through the table's hash index.
+        // 2. Reject the line if an account is unknown or the source balance is too low.
+        // 3. Otherwise move the amount in the balance array and remember the
+        //    posting (with both balances after it) for the log.
+        Result.Posted = 0;
+        Result.AccountsTouched = 0;
+        Result.TotalAmount = 0;
+        Result.vRejected.clear();
+        vPostings.clear();
+        vPostings.reserve(Result.vInstructions.size());
+
+        vector<bool> vTouched(Table.Size(), false);
+
+        auto Touch = [&vTouched, &Result](int Index)
+        {
+            if (Index >= 0 && !vTouched[Index])
+            {
+                vTouched[Index] = true;
+                Result.AccountsTouched++;
+            }
+        };
+
+        for (const stInstruction &Instruction : Result.vInstructions)
+        {
+            if (!Instruction.Reason.empty())
+            {
+                Result.vRejected.push_back({Instruction.LineNumber, _Describe(Instruction), Instruction.Reason});
+                continue;
+            }
+
+            int FromIndex = Instruction.FromAccount.IsEmpty() ? -1 : Table.FindIndex(Instruction.FromAccount.View());
+            int ToIndex = Instruction.ToAccount.IsEmpty() ? -1 : Table.FindIndex(Instruction.ToAccount.View());
+
+            string Reason;
+            if (!Instruction.FromAccount.IsEmpty() && FromIndex < 0)
+                Reason = "unknown source account";
+            else if (!Instruction.ToAccount.IsEmpty() && ToIndex < 0)
+                Reason = "unknown destination account";
+            else if (FromIndex >= 0 && Table.GetBalance(FromIndex) < Instruction.Amount)
+                Reason = "insufficient funds";
+
+            if (!Reason.empty())
+            {
+                Result.vRejected.push_back({Instruction.LineNumber, _Describe(Instruction), Reason});
+                continue;
+            }
+
+            stPosting Posting;
+            Posting.Type = (FromIndex < 0) ? ptDeposit : (ToIndex < 0) ? ptWithdraw : ptTransfer;
+            Posting.FromIndex = FromIndex;
+            Posting.ToIndex = ToIndex;
+            Posting.Amount = Instruction.Amount;
+
+            if (FromIndex >= 0)
+                Table.SetBalance(FromIndex, Table.GetBalance(FromIndex) - Instruction.Amount);
+            if (ToIndex >= 0)
+                Table.SetBalance(ToIndex, Table.GetBalance(ToIndex) + Instruction.Amount);
+
+            Posting.FromBalanceAfter = (FromIndex >= 0) ? Table.GetBalance(FromIndex) : 0;
+            Posting.ToBalanceAfter = (ToIndex >= 0) ? Table.GetBalance(ToIndex) : 0;
+
+            Touch(FromIndex);
+            Touch(ToIndex);
+
+            vPostings.push_back(Posting);
+            Result.Posted++;
+            Result.TotalAmount += Instruction.Amount;
+        }
+    }
+
+    static vector<string> _BuildLogLines(const clsAccountTable &Table, const vector<stPosting> &vPostings,
+                                         const string &OperatorUsername)
+    {
+        // every line of the batch carries the same date / time: the commit time
+        typedef clsTransactionLogger Logger;
+
+        string Date = clsDate::DateToString(clsDate::GetSystemDate());
+        string Time = clsDate::GetAccurateTime();
+        bool ByAdmin = !OperatorUsername.empty();
+
+        vector<string> vLines;
+        vLines.reserve(vPostings.size() * 2);
+
+        for (const stPosting &Posting : vPostings)
+        {
+            string From = (Posting.FromIndex >= 0) ? Table.GetAccountNumber(Posting.FromIndex) : "-";
+            string To = (Posting.ToIndex >= 0) ? Table.GetAccountNumber(Posting.ToIndex) : "-";
+
+            switch (Posting.Type)
+            {
+            case ptDeposit:
+                vLines.push_back(Logger::FormatTransactionLine(Date, Time, ByAdmin ? OperatorUsername : To,
+                                                               ByAdmin ? Logger::ADMIN_DEPOSIT : Logger::DEPOSIT,
+                                                               Posting.Amount, "-", To, Posting.ToBalanceAfter));
+                break;
+            case ptWithdraw:
+                vLines.push_back(Logger::FormatTransactionLine(Date, Time, ByAdmin ? OperatorUsername : From,
+                                                               ByAdmin ? Logger::ADMIN_WITHDRAW : Logger::WITHDRAW,
+                                                               Posting.Amount, From, "-", Posting.FromBalanceAfter));
+                break;
+            case ptTransfer:
+                vLines.push_back(Logger::FormatTransactionLine(Date, Time, ByAdmin ? OperatorUsername : From,
+                                                               ByAdmin ? Logger::ADM_TRANS_OUT : Logger::TRANSFER_OUT,
+                                                               Posting.Amount, From, To, Posting.FromBalanceAfter));
+                vLines.push_back(Logger::FormatTransactionLine(Date, Time, ByAdmin ? OperatorUsername : To,
+                                                               ByAdmin ? Logger::ADM_TRANS_IN : Logger::TRANSFER_IN,
+                                                               Posting.Amount, From, To, Posting.ToBalanceAfter));
+                break;
+            }
+        }
+        return vLines;
+    }
+
+public:
+    static stBatchResult Prepare(const string &FilePath, const string &OperatorUsername = "")
+    {
+        // Prepare process steps:
+        // 1. Parse the instruction file.
+        // 2. Copy the published clients table (clsClientTableRcu) and simulate
+        //    the batch on the copy.
+        // Nothing is written.
+        auto Start = chrono::steady_clock::now();
+
+        stBatchResult Result;
+        Result.OperatorUsername = OperatorUsername;
+        Result.FileFound = _ReadInstructions(FilePath, Result);
+        if (!Result.FileFound)
+            return Result;
+
+        clsAccountTable Table = *clsClientTableRcu::clsReadGuard();
+        vector<stPosting> vPostings;
+        _Apply(Table, Result, vPostings);
+
+        Result.Seconds = chrono::duration<double>(chrono::steady_clock::now() - Start).count();
+        return Result;
+    }
+
+    static bool Commit(stBatchResult &Result)
+    {
+        // Commit process steps:
+        // 1. Reload the table (balances may have moved since Prepare) and apply again.
+        // 2. Write all balances with one rewrite of Clients.txt. An account
+        //    changed by another writer since step 1 stops the write: back to
+        //    step 1, at most CommitAttempts times, then nothing is posted.
+        // 3. Write all log lines with one group commit.
+        // In shared mode (clsSharedAccountTable) the whole commit holds the
+        // exclusive lock, so no other process's transaction lands in between.
+        if (!Result.FileFound || Result.Committed)
+            return false;
+
+        auto Start = chrono::steady_clock::now();
+
+        clsSharedAccountTable::clsExclusiveLock SharedLock;
+        clsAccountTable Table;
+        vector<stPosting> vPostings;
+        clsAccountTable::stSaveResult Saved;
+
+        for (int Attempt = 0; Attempt < CommitAttempts; Attempt++)
+        {
+            Table = clsAccountTable::Load();
+            _Apply(Table, Result, vPostings);
+            if (vPostings.empty())
+                break;
+
+            Saved = Table.SaveBalances();
+            if (Saved.vConflicts.empty())
+                break;
+        }
+
+        Result.vConflicts = Saved.vConflicts;
+        if (!Saved.vConflicts.empty())
+        {
+            _RejectAll(Result, "balances changed by another writer, not posted");
+            Result.Seconds = chrono::duration<double>(chrono::steady_clock::now() - Start).count();
+            return false;
+        }
+
+        if (!vPostings.empty())
+            clsTransactionLogger::AppendTransactionLines(_BuildLogLines(Table, vPostings, Result.OperatorUsername));
+
+        Result.Committed = true;
+        Result.Seconds = chrono::duration<double>(chrono::steady_clock::now() - Start).count();
+        return true;
+    }
+
+    static stBatchResult Post(const string &FilePath, const string &OperatorUsername = "")
+    {
+        // non-interactive: no preview, parse and commit directly
+        stBatchResult Result;
+        Result.OperatorUsername = OperatorUsername;
+        Result.FileFound = _ReadInstructions(FilePath, Result);
+
+        Commit(Result);
+        return Result;
+    }
+
+    static stBatchResult Post(vector<stInstruction> vInstructions, const string &OperatorUsername = "")
+    {
+        // instructions built in memory (standing orders...): LineNumber is the
+        // caller's own reference and comes back in vRejected
+        stBatchResult Result;
+        Result.OperatorUsername = OperatorUsername;
+        Result.FileFound = true;
+        Result.vInstructions = move(vInstructions);
+
+        Commit(Result);
+        return Result;
+    }
+};
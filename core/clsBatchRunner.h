@@ -0,0 +1,478 @@
+/*clsBatchRunner Overview
+================================================================================
+                               clsBatchRunner.h
+================================================================================
+Overview:
+---------
+This file defines the clsBatchRunner class, the headless (non-interactive)
+front end of the bank engine. It reads commands from any stream (a command
+file or stdin), runs them directly against the core classes (clsBankClient,
+clsTransactionLogger, clsAccountTable) and writes one JSON line per command.
+
+No screen is drawn and nothing is read from the keyboard, so the same engine
+the menus use can be driven by nightly jobs and throughput tests:
+
+    "SmartBank System & ATM" --batch commands.txt > results.jsonl
+    generate_commands | "SmartBank System & ATM" --batch -
+
+================================================================================
+Command Format:
+---------------
+One command per line, fields separated by spaces or tabs. Blank lines and
+lines starting with '#' are skipped.
+
+    deposit  <account> <amount>
+    withdraw <account> <amount>
+    transfer <from account> <to account> <amount>
+    add      <account> <pin> <balance> <first name> <last name> <email> <phone>
+    find     <account>
+    report
+    standing-orders              (posts the standing orders due today)
+    snapshot                     (writes the binary snapshot now, see clsSnapshot)
+
+Amounts must be positive numbers (an opening balance may be 0). Deposits,
+withdrawals and transfers are logged in AllTransactions.txt exactly like the
+ATM logs them.
+
+================================================================================
+Output Format:
+--------------
+Every command produces one line:
+
+    {"line":3,"command":"deposit","status":"ok","account":"A101","balance":1500.00,"us":412}
+    {"line":4,"command":"withdraw","status":"error","error":"insufficient balance","us":388}
+
+"us" is the execution time of the command in microseconds. After the last
+command a summary line is written:
+
+    {"command":"summary","commands":2,"succeeded":1,"failed":1,"seconds":0.001}
+
+================================================================================
+Public Methods:
+---------------
+    static stSummary Run(istream &Input, ostream &Output)
+    static bool ExecuteLine(const string &Line, size_t LineNumber, string &JsonResult)
+
+================================================================================
+Usage Example:
+--------------
+    ifstream Commands("nightly.txt");
+    clsBatchRunner::stSummary Summary = clsBatchRunner::Run(Commands, cout);
+
+    return (Summary.Failed == 0) ? 0 : 2;
+
+================================================================================
+*/
+
+#pragma once
+
+#include <iostream>
+#include <sstream>
+#include <iomanip>
+#include <string>
+#include <vector>
+#include <chrono>
+#include <cmath>
+
+#include "clsBankClient.h"        // core/clsBankClient.h
+#include "clsTransactionLogger.h" // core/clsTransactionLogger.h
+#include "clsAccountTable.h"      // core/clsAccountTable.h
+#include "clsClientTableRcu.h"    // core/clsClientTableRcu.h
+#include "clsStandingOrders.h"    // core/clsStandingOrders.h
+#include "clsSnapshot.h"          // core/clsSnapshot.h
+#include "../utils/clsString.h"   // utils/clsString.h
+
+using namespace std;
+
+class clsBatchRunner
+{
+public:
+    struct stSummary
+    {
+        size_t Commands = 0;
+        size_t Succeeded = 0;
+        size_t Failed = 0;
+        double Seconds = 0;
+    };
+
+private:
+    static vector<string> _Tokenize(const string &Line)
+    {
+        vector<string> vTokens;
+        istringstream Stream(Line);
+        string Token;
+
+        while (Stream >> Token)
+            vTokens.push_back(move(Token));
+
+        return vTokens;
+    }
+
+    static bool _ReadAmount(const string &Text, double &Amount, bool AllowZero = false)
+    {
+        // the whole token must be a finite number, "12abc" and "inf" are rejected
+        try
+        {
+            size_t Used = 0;
+            Amount = stod(Text, &Used);
+            return Used == Text.size() && isfinite(Amount) && (Amount > 0 || (AllowZero && Amount == 0));
+        }
+        catch (const exception &)
+        {
+            return false;
+        }
+    }
+
+    static bool _IsStorableField(const string &Field)
+    {
+        // fields are written between " || " separators in Clients.txt
+        return Field.find('|') == string::npos && Field.find('#') == string::npos;
+    }
+
+    static string _Escape(const string &Text)
+    {
+        string Result;
+        Result.reserve(Text.size());
+        for (char C : Text)
+        {
+            if (C == '"' || C == '\\')
+                Result += '\\';
+            if ((unsigned char)C < 0x20)
+                continue; // control characters never belong in a field
+            Result += C;
+        }
+        return Result;
+    }
+
+    static string _Money(double Amount)
+    {
+        ostringstream Stream;
+        Stream << fixed << setprecision(2) << Amount;
+        return Stream.str();
+    }
+
+    static string _Error(const string &Message)
+    {
+        return ",\"status\":\"error\",\"error\":\"" + _Escape(Message) + "\"";
+    }
+
+    static string _ClientFields(const clsBankClient &Client)
+    {
+        return ",\"account\":\"" + _Escape(Client.GetAccountNumber()) + "\"" +
+               ",\"balance\":" + _Money(Client.GetAccountBalance());
+    }
+
+    static bool _Deposit(const vector<string> &vTokens, string &Fields)
+    {
+        double Amount;
+        if (vTokens.size() != 3 || !_ReadAmount(vTokens[2], Amount))
+        {
+            Fields = _Error("usage: deposit <account> <amount>");
+            return false;
+        }
+
+        clsBankClient Client = clsBankClient::Find(vTokens[1]);
+        if (Client.IsEmpty())
+        {
+            Fields = _Error("account not found");
+            return false;
+        }
+
+        if (Client.Deposit(Amount) != clsBankClient::enTransactionResults::trSucceeded)
+        {
+            Fields = _Error("account not found");
+            return false;
+        }
+        clsTransactionLogger::LogDeposit(Client, Amount);
+
+        Fields = ",\"status\":\"ok\"" + _ClientFields(Client);
+        return true;
+    }
+
+    static bool _Withdraw(const vector<string> &vTokens, string &Fields)
+    {
+        double Amount;
+        if (vTokens.size() != 3 || !_ReadAmount(vTokens[2], Amount))
+        {
+            Fields = _Error("usage: withdraw <account> <amount>");
+            return false;
+        }
+
+        clsBankClient Client = clsBankClient::Find(vTokens[1]);
+        if (Client.IsEmpty())
+        {
+            Fields = _Error("account not found");
+            return false;
+        }
+
+        switch (Client.Withdraw(Amount))
+        {
+        case clsBankClient::enTransactionResults::trSucceeded:
+            break;
+        case clsBankClient::enTransactionResults::trInsufficientBalance:
+            Fields = _Error("insufficient balance") + _ClientFields(Client);
+            return false;
+        default:
+            Fields = _Error("account not found");
+            return false;
+        }
+        clsTransactionLogger::LogWithdraw(Client, Amount);
+
+        Fields = ",\"status\":\"ok\"" + _ClientFields(Client);
+        return true;
+    }
+
+    static bool _Transfer(const vector<string> &vTokens, string &Fields)
+    {
+        double Amount;
+        if (vTokens.size() != 4 || !_ReadAmount(vTokens[3], Amount))
+        {
+            Fields = _Error("usage: transfer <from account> <to account> <amount>");
+            return false;
+        }
+
+        if (vTokens[1] == vTokens[2])
+        {
+            Fields = _Error("cannot transfer to the same account");
+            return false;
+        }
+
+        clsBankClient FromClient = clsBankClient::Find(vTokens[1]);
+        clsBankClient ToClient = clsBankClient::Find(vTokens[2]);
+        if (FromClient.IsEmpty() || ToClient.IsEmpty())
+        {
+            Fields = _Error(FromClient.IsEmpty() ? "source account not found" : "destination account not found");
+            return false;
+        }
+
+        switch (FromClient.Transfer(Amount, ToClient))
+        {
+        case clsBankClient::enTransactionResults::trSucceeded:
+            break;
+        case clsBankClient::enTransactionResults::trInsufficientBalance:
+            Fields = _Error("insufficient balance") + _ClientFields(FromClient);
+            return false;
+        case clsBankClient::enTransactionResults::trDestinationNotFound:
+            Fields = _Error("destination account not found") + _ClientFields(FromClient);
+            return false;
+        default:
+            Fields = _Error("source account not found");
+            return false;
+        }
+        clsTransactionLogger::LogTransfer(FromClient, ToClient, Amount);
+
+        Fields = ",\"status\":\"ok\"" + _ClientFields(FromClient) +
+                 ",\"to_account\":\"" + _Escape(ToClient.GetAccountNumber()) + "\"" +
+                 ",\"to_balance\":" + _Money(ToClient.GetAccountBalance());
+        return true;
+    }
+
+    static bool _Add(const vector<string> &vTokens, string &Fields)
+    {
+        double Balance;
+        if (vTokens.size() != 8 || !_ReadAmount(vTokens[3], Balance, true))
+        {
+            Fields = _Error("usage: add <account> <pin> <balance> <first name> <last name> <email> <phone>");
+            return false;
+        }
+
+        for (size_t i = 1; i < vTokens.size(); i++)
+        {
+            if (!_IsStorableField(vTokens[i]))
+            {
+                Fields = _Error("fields cannot contain '|' or '#'");
+                return false;
+            }
+        }
+
+        if (vTokens[1].size() > clsAccountNumber::MaxLength || vTokens[2].size() > clsPinCode::MaxLength)
+        {
+            Fields = _Error("account number or pin too long");
+            return false;
+        }
+
+        clsBankClient Client = clsBankClient::GetAddNewClientObject(vTokens[1]);
+        Client.SetPinCode(vTokens[2]);
+        Client.SetAccountBalance((float)Balance);
+        Client.SetFirstName(vTokens[4]);
+        Client.SetLastName(vTokens[5]);
+        Client.SetEmail(vTokens[6]);
+        Client.SetPhone(vTokens[7]);
+
+        switch (Client.Save())
+        {
+        case clsBankClient::enSaveResults::svSucceeded:
+            Fields = ",\"status\":\"ok\"" + _ClientFields(Client);
+            return true;
+        case clsBankClient::enSaveResults::svFaildAccountNumberExists:
+            Fields = _Error("account number already exists");
+            return false;
+        case clsBankClient::enSaveResults::svFaildNotFound:
+            Fields = _Error("account not found");
+            return false;
+        default:
+            Fields = _Error("client could not be saved");
+            return false;
+        }
+    }
+
+    static bool _Find(const vector<string> &vTokens, string &Fields)
+    {
+        if (vTokens.size() != 2)
+        {
+            Fields = _Error("usage: find <account>");
+            return false;
+        }
+
+        clsBankClient Client = clsBankClient::FindReadOnly(vTokens[1]);
+        if (Client.IsEmpty())
+        {
+            Fields = _Error("account not found");
+            return false;
+        }
+
+        // the PIN is never written out
+        Fields = ",\"status\":\"ok\"" + _ClientFields(Client) +
+                 ",\"name\":\"" + _Escape(Client.FullName()) + "\"" +
+                 ",\"email\":\"" + _Escape(Client.GetEmail()) + "\"" +
+                 ",\"phone\":\"" + _Escape(Client.GetPhone()) + "\"";
+        return true;
+    }
+
+    static bool _Report(const vector<string> &vTokens, string &Fields)
+    {
+        if (vTokens.size() != 1)
+        {
+            Fields = _Error("usage: report");
+            return false;
+        }
+
+        clsClientTableRcu::clsReadGuard Table;
+        Fields = ",\"status\":\"ok\",\"clients\":" + to_string(Table->Size()) +
+                 ",\"total_balances\":" + _Money(Table->GetTotalBalances());
+        return true;
+    }
+
+    static bool _StandingOrders(const vector<string> &vTokens, string &Fields)
+    {
+        if (vTokens.size() != 1)
+        {
+            Fields = _Error("usage: standing-orders");
+            return false;
+        }
+
+        clsStandingOrders::stRunResult Result = clsStandingOrders::RunDueOrders();
+        Fields = ",\"status\":\"ok\",\"orders_due\":" + to_string(Result.OrdersDue) +
+                 ",\"payments\":" + to_string(Result.Occurrences) +
+                 ",\"posted\":" + to_string(Result.Posted) +
+                 ",\"rejected\":" + to_string(Result.vRejected.size()) +
+                 ",\"total_amount\":" + _Money(Result.TotalAmount);
+        return true;
+    }
+
+    static bool _Snapshot(const vector<string> &vTokens, string &Fields)
+    {
+        if (vTokens.size() != 1)
+        {
+            Fields = _Error("usage: snapshot");
+            return false;
+        }
+
+        clsSnapshot::stWriteResult Result = clsSnapshot::Write();
+        if (!Result.Written)
+        {
+            Fields = _Error("snapshot not written");
+            return false;
+        }
+
+        Fields = ",\"status\":\"ok\",\"clients\":" + to_string(Result.Clients) +
+                 ",\"admins\":" + to_string(Result.Admins) +
+                 ",\"currencies\":" + to_string(Result.Currencies) +
+                 ",\"bytes\":" + to_string(Result.Bytes);
+        return true;
+    }
+
+public:
+    static bool ExecuteLine(const string &Line, size_t LineNumber, string &JsonResult)
+    {
+        // ExecuteLine process steps:
+        // 1. Split the line into tokens; blank lines and '#' comments give an empty result.
+        // 2. Dispatch on the first token to the matching core operation.
+        // 3. Time the operation and build one JSON object from its fields.
+        // 4. Return true when the command succeeded.
+        JsonResult.clear();
+
+        vector<string> vTokens = _Tokenize(Line);
+        if (vTokens.empty() || vTokens[0][0] == '#')
+            return true;
+
+        string Command = clsString::LowerAllString(vTokens[0]);
+        string Fields;
+        bool Succeeded = false;
+
+        auto Start = chrono::steady_clock::now();
+
+        if (Command == "deposit")
+            Succeeded = _Deposit(vTokens, Fields);
+        else if (Command == "withdraw")
+            Succeeded = _Withdraw(vTokens, Fields);
+        else if (Command == "transfer")
+            Succeeded = _Transfer(vTokens, Fields);
+        else if (Command == "add")
+            Succeeded = _Add(vTokens, Fields);
+        else if (Command == "find")
+            Succeeded = _Find(vTokens, Fields);
+        else if (Command == "report")
+            Succeeded = _Report(vTokens, Fields);
+        else if (Command == "standing-orders")
+            Succeeded = _StandingOrders(vTokens, Fields);
+        else if (Command == "snapshot")
+            Succeeded = _Snapshot(vTokens, Fields);
+        else
+            Fields = _Error("unknown command");
+
+        long long Micros = chrono::duration_cast<chrono::microseconds>(chrono::steady_clock::now() - Start).count();
+
+        JsonResult = "{\"line\":" + to_string(LineNumber) +
+                     ",\"command\":\"" + _Escape(Command) + "\"" +
+                     Fields +
+                     ",\"us\":" + to_string(Micros) + "}";
+        return Succeeded;
+    }
+
+    static stSummary Run(istream &Input, ostream &Output)
+    {
+        // Run process steps:
+        // 1. Read the input line by line (a file, or stdin for "-").
+        // 2. Execute each command and write its JSON line immediately.
+        // 3. Write the summary line and return the counters.
+        stSummary Summary;
+        auto Start = chrono::steady_clock::now();
+
+        string Line, JsonResult;
+        size_t LineNumber = 0;
+
+        while (getline(Input, Line))
+        {
+            LineNumber++;
+            bool Succeeded = ExecuteLine(Line, LineNumber, JsonResult);
+            if (JsonResult.empty())
+                continue;
+
+            Output << JsonResult << '\n';
+            Summary.Commands++;
+            if (Succeeded)
+                Summary.Succeeded++;
+            else
+                Summary.Failed++;
+        }
+
+        Summary.Seconds = chrono::duration<double>(chrono::steady_clock::now() - Start).count();
+
+        Output << "{\"command\":\"summary\",\"commands\":" << Summary.Commands
+               << ",\"succeeded\":" << Summary.Succeeded
+               << ",\"failed\":" << Summary.Failed
+               << ",\"seconds\":" << Summary.Seconds << "}" << endl;
+        return Summary;
+    }
+};
@@ -0,0 +1,586 @@
+/*clsBinaryRecordStore Overview
+================================================================================
+                            clsBinaryRecordStore.h
+================================================================================
+Overview:
+---------
+This file defines clsBinaryRecordStore, a clsRecordStore backed by a binary
+record file ("Clients.sbr", ...) with a hash index in memory. It keeps the
+same " || " lines as the text files, but a lookup or an update touches one
+record instead of the whole file:
+
+- Find() on the key column: one index lookup + one read.
+- Replace(): the new line is written over the old one when it fits in the
+  record's slot (balance updates always do), otherwise the old record is
+  flagged dead and the new one appended.
+- Delete(): one byte (the Live flag) is written.
+- Append(): one write at the end of the file.
+
+================================================================================
+File Format:
+------------
+    stFileHeader (16 bytes)   Magic "SBRECS", Version, KeyColumn, Flags
+    record, record, ...
+
+    record = stRecordHeader (12 bytes) + key bytes + line bytes + free bytes
+             SlotBytes = key + line + free (room to grow in place)
+
+The key is stored next to the line so opening the file rebuilds the index by
+walking record headers and keys only; lines are not read. A record cut short
+by a crash (header or slot past the end of the file) is dropped and the file
+truncated to the last whole record.
+
+================================================================================
+Compaction:
+-----------
+Dead records (deleted or moved) are counted; when their bytes cross
+clsRecordFile::CompactionGarbageRatio the live lines are rewritten into a
+new file (temp file + rename), which is also what ReplaceAll() does.
+
+================================================================================
+Notes:
+------
+- The index lives in this process; one process at a time should write a
+  binary data root (the text backend is the one to share between processes).
+- Every call holds the store's mutex; a ForEach() visitor must not call back
+  into the same store.
+- A key on more than one record (Currencies.txt repeats some codes) maps to
+  the first of them in file order, the line the text store's scan returns.
+  While such keys exist, a delete re-walks the record headers and a move
+  (the line outgrew its slot) rewrites the file, so the order is kept.
+- A file with a wrong magic, version or key column is not touched: IsOpen()
+  is false and every call behaves like an empty, read-only store.
+
+================================================================================
+Public Methods:
+---------------
+    clsRecordStore interface, plus
+    bool IsOpen() const
+    size_t Count()                      live records
+    long long DeadBytes()               bytes waiting for compaction
+
+================================================================================
+*/
+
+#pragma once
+
+#include <string>
+#include <vector>
+#include <fstream>
+#include <unordered_map>
+#include <mutex>
+#include <cstring>
+#include <cstdint>
+#include <cstddef>
+#include <filesystem>
+
+#include "clsRecordStore.h"        // core/clsRecordStore.h
+#include "clsRecordFile.h"         // core/clsRecordFile.h
+#include "../utils/clsMappedFile.h" // utils/clsMappedFile.h
+
+using namespace std;
+
+class clsBinaryRecordStore : public clsRecordStore
+{
+private:
+    struct stFileHeader
+    {
+        char Magic[8];
+        uint32_t Version;
+        int16_t KeyColumn;
+        uint16_t Flags; // 1 = keys ignore case
+    };
+
+    struct stRecordHeader
+    {
+        uint32_t SlotBytes;
+        uint32_t LineBytes;
+        uint16_t KeyBytes;
+        uint8_t Live;
+        uint8_t Reserved;
+    };
+
+    static_assert(sizeof(stFileHeader) == 16, "stFileHeader layout");
+    static_assert(sizeof(stRecordHeader) == 12, "stRecordHeader layout");
+
+    static constexpr const char *_Magic = "SBRECS";
+    static constexpr uint32_t _Version = 1;
+    static constexpr uint32_t _MinFreeBytes = 16;
+
+    string _Path;
+    fstream _File;
+    bool _Open = false;
+    mutex _Mutex;
+
+    unordered_map<string, uint64_t> _Index; // normalized key -> record offset
+    uint64_t _EndOffset = 0;
+    long long _DeadBytes = 0;
+    bool _DuplicateKeys = false; // some key is on more than one live record
+
+    stFileHeader _MakeFileHeader() const
+    {
+        stFileHeader Header{};
+        memcpy(Header.Magic, _Magic, strlen(_Magic));
+        Header.Version = _Version;
+        Header.KeyColumn = _KeyColumn;
+        Header.Flags = _IgnoreCase ? 1 : 0;
+        return Header;
+    }
+
+    static uint32_t _SlotFor(size_t KeyBytes, size_t LineBytes)
+    {
+        size_t Used = KeyBytes + LineBytes;
+        size_t Free = max<size_t>(_MinFreeBytes, LineBytes / 8);
+        return (uint32_t)(Used + Free);
+    }
+
+    static void _AppendRecordBytes(string &Buffer, string_view Key, const string &Line)
+    {
+        stRecordHeader Header{};
+        Header.SlotBytes = _SlotFor(Key.size(), Line.size());
+        Header.LineBytes = (uint32_t)Line.size();
+        Header.KeyBytes = (uint16_t)Key.size();
+        Header.Live = 1;
+
+        Buffer.append((const char *)&Header, sizeof(Header));
+        Buffer.append(Key.data(), Key.size());
+        Buffer += Line;
+        Buffer.append(Header.SlotBytes - Key.size() - Line.size(), '\0');
+    }
+
+    void _IndexKey(string_view Key, uint64_t Offset)
+    {
+        // the first record with a key keeps the index entry
+        if (!_Index.emplace(_NormalizedKey(Key), Offset).second)
+            _DuplicateKeys = true;
+    }
+
+    uint64_t _IndexRecords(const char *Data, uint64_t Size)
+    {
+        // walks the record headers + keys (lines are skipped) and rebuilds the
+        // index; returns the end of the last whole record
+        _Index.clear();
+        _DeadBytes = 0;
+        _DuplicateKeys = false;
+        uint64_t Offset = sizeof(stFileHeader);
+
+        while (Offset + sizeof(stRecordHeader) <= Size)
+        {
+            stRecordHeader Record;
+            memcpy(&Record, Data + Offset, sizeof(Record));
+
+            uint64_t RecordBytes = sizeof(stRecordHeader) + (uint64_t)Record.SlotBytes;
+            if (Record.SlotBytes < (uint64_t)Record.KeyBytes + Record.LineBytes || Offset + RecordBytes > Size)
+                break; // torn write at the end of the file
+
+            if (Record.Live)
+                _IndexKey(string_view(Data + Offset + sizeof(stRecordHeader), Record.KeyBytes), Offset);
+            else
+                _DeadBytes += (long long)RecordBytes;
+            Offset += RecordBytes;
+        }
+        return Offset;
+    }
+
+    bool _Load()
+    {
+        // Load process steps:
+        // 1. Map the file and check the file header.
+        // 2. Walk the records: header + key only, the lines are skipped.
+        // 3. Live records go into the index, dead ones are counted.
+        // 4. Drop a record cut short by a crash (truncate the file there).
+        clsMappedFile Mapped;
+        if (!Mapped.Open(_Path) || Mapped.Size() < sizeof(stFileHeader))
+            return false;
+
+        stFileHeader Expected = _MakeFileHeader();
+        stFileHeader Header;
+        memcpy(&Header, Mapped.Data(), sizeof(Header));
+        if (memcmp(Header.Magic, Expected.Magic, sizeof(Header.Magic)) != 0 || Header.Version != _Version ||
+            Header.KeyColumn != Expected.KeyColumn || Header.Flags != Expected.Flags)
+            return false;
+
+        uint64_t Size = Mapped.Size();
+        uint64_t Offset = _IndexRecords(Mapped.Data(), Size);
+
+        _EndOffset = Offset;
+        Mapped.Close();
+
+        if (Offset < Size)
+        {
+            error_code Error;
+            filesystem::resize_file(_Path, Offset, Error);
+        }
+        return true;
+    }
+
+    bool _OpenFile()
+    {
+        _File.close();
+        _File.clear();
+        _File.open(_Path, ios::in | ios::out | ios::binary);
+        return _File.is_open();
+    }
+
+    bool _ReadRecord(uint64_t Offset, stRecordHeader &Record, string *Line)
+    {
+        _File.clear();
+        _File.seekg((streamoff)Offset);
+        if (!_File.read((char *)&Record, sizeof(Record)))
+            return false;
+
+        if (Line != nullptr)
+        {
+            Line->resize(Record.LineBytes);
+            _File.seekg((streamoff)(Offset + sizeof(Record) + Record.KeyBytes));
+            if (!_File.read(Line->data(), Record.LineBytes))
+                return false;
+        }
+        return true;
+    }
+
+    void _Write(uint64_t Offset, const char *Data, size_t Bytes)
+    {
+        _File.clear();
+        _File.seekp((streamoff)Offset);
+        _File.write(Data, (streamsize)Bytes);
+        _File.flush(); // readers (ForEach maps the file) see the bytes at once
+    }
+
+    void _AppendLocked(const string &Line)
+    {
+        string_view Key = _KeyOf(Line);
+        string Buffer;
+        _AppendRecordBytes(Buffer, Key, Line);
+
+        _Write(_EndOffset, Buffer.data(), Buffer.size());
+        _IndexKey(Key, _EndOffset);
+        _EndOffset += Buffer.size();
+    }
+
+    void _KillLocked(uint64_t Offset, const stRecordHeader &Record)
+    {
+        const uint8_t Dead = 0;
+        _Write(Offset + offsetof(stRecordHeader, Live), (const char *)&Dead, 1);
+        _DeadBytes += (long long)(sizeof(stRecordHeader) + Record.SlotBytes);
+    }
+
+    void _RewriteLocked(const vector<string> &vLines)
+    {
+        // all live lines into "<file>.tmp", then one rename over the file
+        string Buffer;
+        stFileHeader Header = _MakeFileHeader();
+        Buffer.append((const char *)&Header, sizeof(Header));
+
+        unordered_map<string, uint64_t> NewIndex;
+        NewIndex.reserve(vLines.size());
+        bool DuplicateKeys = false;
+        for (const string &Line : vLines)
+        {
+            if (Line.empty() || clsRecordFile::IsTombstone(Line))
+                continue;
+            if (!NewIndex.emplace(_NormalizedKey(_KeyOf(Line)), Buffer.size()).second)
+                DuplicateKeys = true; // the first record with a key keeps the entry
+            _AppendRecordBytes(Buffer, _KeyOf(Line), Line);
+        }
+
+        string TempPath = _Path + ".tmp";
+        {
+            ofstream Target(TempPath, ios::out | ios::binary | ios::trunc);
+            if (!Target.is_open())
+                return;
+            Target.write(Buffer.data(), (streamsize)Buffer.size());
+        }
+
+        _File.close();
+        error_code Error;
+        filesystem::rename(TempPath, _Path, Error);
+        _Open = _OpenFile();
+        if (Error)
+            return; // the old file is still in place, and so is its index
+
+        _Index = move(NewIndex);
+        _EndOffset = Buffer.size();
+        _DeadBytes = 0;
+        _DuplicateKeys = DuplicateKeys;
+    }
+
+    void _CompactIfNeeded()
+    {
+        if (_EndOffset == 0 || (double)_DeadBytes / (double)_EndOffset < clsRecordFile::CompactionGarbageRatio)
+            return;
+
+        vector<string> vLines;
+        _ForEachLocked([&vLines](const string &Line)
+                       {
+                           vLines.push_back(Line);
+                           return false; });
+        _RewriteLocked(vLines);
+    }
+
+    bool _ReplaceLocked(string_view Key, const string &Line)
+    {
+        // Replace process steps:
+        // 1. Find the record through the index and read its header.
+        // 2. Same key and the new line fits the slot: rewrite the record
+        //    header + key + line in place (one write).
+        // 3. Otherwise flag the old record dead and append the new one.
+        auto It = _Index.find(_NormalizedKey(Key));
+        if (It == _Index.end())
+            return false;
+
+        uint64_t Offset = It->second;
+        stRecordHeader Record;
+        if (!_ReadRecord(Offset, Record, nullptr))
+            return false;
+
+        string_view NewKey = _KeyOf(Line);
+        if (_NormalizedKey(NewKey) == It->first && NewKey.size() + Line.size() <= Record.SlotBytes)
+        {
+            Record.LineBytes = (uint32_t)Line.size();
+            Record.KeyBytes = (uint16_t)NewKey.size();
+
+            string Buffer((const char *)&Record, sizeof(Record));
+            Buffer.append(NewKey.data(), NewKey.size());
+            Buffer += Line;
+            _Write(Offset, Buffer.data(), Buffer.size());
+            return true;
+        }
+
+        if (_DuplicateKeys)
+        {
+            // another record may share the key: appending would put this one
+            // behind it, so the file is rewritten with the line in its place
+            vector<string> vLines;
+            _ForEachRecordLocked([&](uint64_t At, const string &Current)
+                                 {
+                                     vLines.push_back(At == Offset ? Line : Current);
+                                     return false; });
+            _RewriteLocked(vLines);
+            return true;
+        }
+
+        _Index.erase(It);
+        _KillLocked(Offset, Record);
+        _AppendLocked(Line);
+        _CompactIfNeeded();
+        return true;
+    }
+
+    void _ReindexLocked()
+    {
+        // after a delete while keys repeat: a later record may be first now
+        clsMappedFile Mapped;
+        if (Mapped.Open(_Path))
+            _IndexRecords(Mapped.Data(), min<uint64_t>(Mapped.Size(), _EndOffset));
+    }
+
+    void _ForEachLocked(const function<bool(const string &Line)> &Visitor)
+    {
+        _ForEachRecordLocked([&Visitor](uint64_t, const string &Line)
+                             { return Visitor(Line); });
+    }
+
+    void _ForEachRecordLocked(const function<bool(uint64_t Offset, const string &Line)> &Visitor)
+    {
+        // one sequential pass over a mapped view of the file
+        clsMappedFile Mapped;
+        if (!Mapped.Open(_Path))
+            return;
+
+        const char *Data = Mapped.Data();
+        uint64_t Size = min<uint64_t>(Mapped.Size(), _EndOffset);
+        uint64_t Offset = sizeof(stFileHeader);
+        string Line;
+
+        while (Offset + sizeof(stRecordHeader) <= Size)
+        {
+            stRecordHeader Record;
+            memcpy(&Record, Data + Offset, sizeof(Record));
+            if (Record.Live)
+            {
+                Line.assign(Data + Offset + sizeof(stRecordHeader) + Record.KeyBytes, Record.LineBytes);
+                if (Visitor(Offset, Line))
+                    return;
+            }
+            Offset += sizeof(stRecordHeader) + Record.SlotBytes;
+        }
+    }
+
+public:
+    clsBinaryRecordStore(const string &Path, short KeyColumn, bool IgnoreCase)
+        : clsRecordStore(KeyColumn, IgnoreCase), _Path(Path)
+    {
+        // Open process steps:
+        // 1. A missing file is created with just the file header.
+        // 2. An existing file is walked once to build the index.
+        // 3. The file stays open for the reads and writes that follow.
+        if (!filesystem::exists(_Path))
+        {
+            ofstream Create(_Path, ios::out | ios::binary | ios::trunc);
+            stFileHeader Header = _MakeFileHeader();
+            Create.write((const char *)&Header, sizeof(Header));
+        }
+
+        _Open = _Load() && _OpenFile();
+    }
+
+    string BackendName() const override { return "binary"; }
+
+    bool IsOpen() const { return _Open; }
+    const string &GetPath() const { return _Path; }
+
+    void ForEach(const function<bool(const string &Line)> &Visitor) override
+    {
+        lock_guard<mutex> Lock(_Mutex);
+        if (_Open)
+            _ForEachLocked(Visitor);
+    }
+
+    bool Find(short Column, string_view Key, string &Line) override
+    {
+        lock_guard<mutex> Lock(_Mutex);
+        if (!_Open)
+            return false;
+
+        if (Column == _KeyColumn)
+        {
+            auto It = _Index.find(_NormalizedKey(Key));
+            if (It == _Index.end())
+                return false;
+
+            stRecordHeader Record;
+            return _ReadRecord(It->second, Record, &Line);
+        }
+
+        bool Found = false;
+        _ForEachLocked([&](const string &Candidate)
+                       {
+                           if (!_KeysEqual(clsString::GetFieldView(Candidate, " || ", Column), Key))
+                               return false;
+                           Line = Candidate;
+                           Found = true;
+                           return true; });
+        return Found;
+    }
+
+    void Append(const string &Line) override
+    {
+        lock_guard<mutex> Lock(_Mutex);
+        if (_Open)
+            _AppendLocked(Line);
+    }
+
+    void AppendAll(const vector<string> &vLines) override
+    {
+        // all records built in memory and written with one write
+        lock_guard<mutex> Lock(_Mutex);
+        if (!_Open || vLines.empty())
+            return;
+
+        string Buffer;
+        vector<pair<string, uint64_t>> vEntries;
+        vEntries.reserve(vLines.size());
+        for (const string &Line : vLines)
+        {
+            vEntries.emplace_back(_NormalizedKey(_KeyOf(Line)), _EndOffset + Buffer.size());
+            _AppendRecordBytes(Buffer, _KeyOf(Line), Line);
+        }
+
+        _Write(_EndOffset, Buffer.data(), Buffer.size());
+        _EndOffset += Buffer.size();
+        for (pair<string, uint64_t> &Entry : vEntries)
+        {
+            if (!_Index.emplace(move(Entry.first), Entry.second).second)
+                _DuplicateKeys = true;
+        }
+    }
+
+    bool Replace(string_view Key, const string &Line) override
+    {
+        lock_guard<mutex> Lock(_Mutex);
+        if (!_Open)
+            return false;
+        return _ReplaceLocked(Key, Line);
+    }
+
+    clsRecordVersion::enReplaceResult ReplaceIfVersion(string_view Key, short VersionColumn, unsigned long long ExpectedVersion,
+                                                       const string &Line, string &CurrentLine) override
+    {
+        // read the stored line through the index, compare its version, replace
+        lock_guard<mutex> Lock(_Mutex);
+        if (!_Open)
+            return clsRecordVersion::rrNotFound;
+
+        auto It = _Index.find(_NormalizedKey(Key));
+        stRecordHeader Record;
+        string Current;
+        if (It == _Index.end() || !_ReadRecord(It->second, Record, &Current))
+            return clsRecordVersion::rrNotFound;
+
+        if (clsRecordVersion::Of(Current, VersionColumn) != ExpectedVersion)
+        {
+            CurrentLine = move(Current);
+            return clsRecordVersion::rrConflict;
+        }
+        return _ReplaceLocked(Key, Line) ? clsRecordVersion::rrReplaced : clsRecordVersion::rrNotFound;
+    }
+
+    void ReplaceAll(const vector<string> &vLines) override
+    {
+        lock_guard<mutex> Lock(_Mutex);
+        if (_Open)
+            _RewriteLocked(vLines);
+    }
+
+    bool Rewrite(const function<bool(vector<string> &vLines)> &Edit) override
+    {
+        lock_guard<mutex> Lock(_Mutex);
+        if (!_Open)
+            return false;
+
+        vector<string> vLines;
+        _ForEachLocked([&vLines](const string &Line)
+                       {
+                           vLines.push_back(Line);
+                           return false; });
+        if (!Edit(vLines))
+            return false;
+        _RewriteLocked(vLines);
+        return true;
+    }
+
+    bool Delete(string_view Key) override
+    {
+        lock_guard<mutex> Lock(_Mutex);
+        if (!_Open)
+            return false;
+
+        auto It = _Index.find(_NormalizedKey(Key));
+        if (It == _Index.end())
+            return false;
+
+        stRecordHeader Record;
+        if (!_ReadRecord(It->second, Record, nullptr))
+            return false;
+
+        _KillLocked(It->second, Record);
+        _Index.erase(It);
+        if (_DuplicateKeys)
+            _ReindexLocked();
+        _CompactIfNeeded();
+        return true;
+    }
+
+    size_t Count()
+    {
+        lock_guard<mutex> Lock(_Mutex);
+        return _Index.size();
+    }
+
+    long long DeadBytes()
+    {
+        lock_guard<mutex> Lock(_Mutex);
+        return _DeadBytes;
+    }
+};
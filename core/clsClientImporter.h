@@ -0,0 +1,334 @@
+/*clsClientImporter Overview
+================================================================================
+                              clsClientImporter.h
+================================================================================
+Overview:
+---------
+This file defines the clsClientImporter class, which adds many clients at once
+from a CSV file (for example when onboarding the clients of an acquired
+branch).
+
+Adding clients one by one through Save() costs one full scan of Clients.txt
+(IsClientExist) plus one append per client, so importing N clients into a bank
+of M clients reads the file N times. The importer instead:
+
+1. Reads the account-number column of the clients store once into a hash set.
+2. Reads the CSV once.
+3. Validates the rows in parallel on the shared thread pool (clsThreadPool):
+   email / phone with clsInputValidate, balance, field lengths, each task on
+   its own slice of rows.
+4. Checks duplicates in one ordered pass against the hash set (both clients
+   already in the bank and repeated rows inside the CSV).
+5. Writes every accepted client with a single buffered append
+   (clsBankClient::AddNewClients -> clsRecordStore::AppendAll).
+
+================================================================================
+CSV Format:
+-----------
+Same column order as Clients.txt, one client per line:
+
+    FirstName,LastName,Email,Phone,AccountNumber,PinCode,Balance
+
+- A first line starting with "FirstName" is treated as a header and skipped.
+- Fields may be quoted ("Abu Hadhoud"); "" inside quotes is a quote.
+- Fields may not contain '|' or '#' (the file and log separators).
+- Rejected rows are reported with their line number and reason; they never
+  stop the valid rows from being imported.
+
+================================================================================
+Public Methods:
+---------------
+    static stImportResult Prepare(const string &CsvPath)
+        Reads and validates the CSV; nothing is written.
+
+    static size_t Commit(stImportResult &Result)
+        Re-checks the accepted clients against the current Clients.txt (another
+        admin may have added one meanwhile) and appends them in one write.
+
+    static stImportResult Import(const string &CsvPath)
+        Prepare() + Commit().
+
+================================================================================
+Usage Example:
+--------------
+    clsClientImporter::stImportResult Result = clsClientImporter::Prepare("../data/branch.csv");
+
+    cout << Result.vClients.size() << " valid, " << Result.vRejected.size() << " rejected";
+    clsClientImporter::Commit(Result);
+
+================================================================================
+*/
+
+#pragma once
+
+#include <iostream>
+#include <fstream>
+#include <string>
+#include <vector>
+#include <unordered_set>
+#include <chrono>
+#include <cmath>
+#include <algorithm>
+
+#include "clsBankClient.h"               // core/clsBankClient.h
+#include "clsStorage.h"                  // core/clsStorage.h
+#include "../utils/clsString.h"          // utils/clsString.h
+#include "../utils/clsFixedString.h"     // utils/clsFixedString.h
+#include "../utils/clsInputValidate.h"   // utils/clsInputValidate.h
+#include "../utils/clsThreadPool.h"      // utils/clsThreadPool.h
+
+using namespace std;
+
+class clsClientImporter
+{
+public:
+    struct stRejectedRow
+    {
+        size_t LineNumber = 0;
+        string AccountNumber;
+        string Reason;
+    };
+
+    struct stImportResult
+    {
+        bool FileFound = false;
+        size_t Rows = 0;                 // data rows read from the CSV
+        vector<clsBankClient> vClients;  // accepted, in CSV order
+        vector<stRejectedRow> vRejected; // in CSV order
+        size_t Imported = 0;             // set by Commit()
+        double Seconds = 0;
+    };
+
+private:
+    static const size_t _ColumnCount = 7;
+    static const size_t _RowsPerTask = 1024; // smaller files are validated on one thread
+
+    struct stRow
+    {
+        size_t LineNumber = 0;
+        vector<string> vFields;
+        double Balance = 0;
+        string Reason; // empty when the row is valid
+    };
+
+    static vector<string> _SplitCsvLine(const string &Line)
+    {
+        vector<string> vFields;
+        string Field;
+        bool InQuotes = false;
+
+        for (size_t i = 0; i < Line.size(); i++)
+        {
+            char C = Line[i];
+
+            if (InQuotes)
+            {
+                if (C == '"' && i + 1 < Line.size() && Line[i + 1] == '"')
+                {
+                    Field += '"';
+                    i++;
+                }
+                else if (C == '"')
+                    InQuotes = false;
+                else
+                    Field += C;
+            }
+            else if (C == '"')
+                InQuotes = true;
+            else if (C == ',')
+            {
+                vFields.push_back(clsString::Trim(Field));
+                Field.clear();
+            }
+            else if (C != '\r')
+                Field += C;
+        }
+        vFields.push_back(clsString::Trim(Field));
+        return vFields;
+    }
+
+    static unordered_set<clsAccountNumber> _LoadExistingAccounts()
+    {
+        // one pass over the clients store, only the account-number column is read
+        unordered_set<clsAccountNumber> Accounts;
+
+        clsStorage::Clients().ForEach([&Accounts](const string &Line)
+                                      {
+                                          Accounts.insert(clsAccountNumber(clsString::GetFieldView(Line, " || ", clsStorage::ClientsKeyColumn)));
+                                          return false; });
+        return Accounts;
+    }
+
+    static string _ValidateRow(stRow &Row)
+    {
+        // only reads the row and the shared (const) regexes: safe on any worker
+        if (Row.vFields.size() != _ColumnCount)
+            return "expected " + to_string(_ColumnCount) + " columns, found " + to_string(Row.vFields.size());
+
+        for (const string &Field : Row.vFields)
+        {
+            if (Field.find('|') != string::npos || Field.find('#') != string::npos)
+                return "fields cannot contain '|' or '#'";
+        }
+
+        const string &FirstName = Row.vFields[0];
+        const string &LastName = Row.vFields[1];
+        const string &Email = Row.vFields[2];
+        const string &Phone = Row.vFields[3];
+        const string &AccountNumber = Row.vFields[4];
+        const string &PinCode = Row.vFields[5];
+
+        if (FirstName.empty() || LastName.empty())
+            return "first and last name are required";
+
+        if (AccountNumber.empty() || AccountNumber.size() > clsAccountNumber::MaxLength)
+            return "account number must be 1 to " + to_string(clsAccountNumber::MaxLength) + " characters";
+
+        if (PinCode.empty() || PinCode.size() > clsPinCode::MaxLength)
+            return "pin code must be 1 to " + to_string(clsPinCode::MaxLength) + " characters";
+
+        if (!clsInputValidate::IsValidEmail(Email))
+            return "invalid email";
+
+        if (!clsInputValidate::IsValidPhone(Phone))
+            return "invalid phone";
+
+        try
+        {
+            size_t Used = 0;
+            Row.Balance = stod(Row.vFields[6], &Used);
+            if (Used != Row.vFields[6].size() || !isfinite(Row.Balance) || Row.Balance < 0)
+                return "invalid balance";
+        }
+        catch (const exception &)
+        {
+            return "invalid balance";
+        }
+
+        return "";
+    }
+
+    static void _ValidateRows(vector<stRow> &vRows)
+    {
+        // every task owns a contiguous slice of rows, so no locking is needed
+        clsThreadPool::Shared().ParallelFor(0, vRows.size(), _RowsPerTask, [&vRows](size_t Begin, size_t End)
+                                            {
+                                                for (size_t i = Begin; i < End; i++)
+                                                    vRows[i].Reason = _ValidateRow(vRows[i]); }, "ImportValidate");
+    }
+
+    static clsBankClient _ToClient(const stRow &Row)
+    {
+        clsBankClient Client = clsBankClient::GetAddNewClientObject(Row.vFields[4]);
+        Client.SetFirstName(Row.vFields[0]);
+        Client.SetLastName(Row.vFields[1]);
+        Client.SetEmail(Row.vFields[2]);
+        Client.SetPhone(Row.vFields[3]);
+        Client.SetPinCode(Row.vFields[5]);
+        Client.SetAccountBalance((float)Row.Balance);
+        return Client;
+    }
+
+public:
+    static stImportResult Prepare(const string &CsvPath)
+    {
+        // Prepare process steps:
+        // 1. Read every CSV line into a row (line number + fields); skip blanks and the header.
+        // 2. Validate all rows in parallel.
+        // 3. In CSV order, reject invalid rows and duplicates (against the hash set of
+        //    existing accounts, which also collects the accounts accepted so far).
+        // 4. Build a clsBankClient (AddNewMode) for every accepted row.
+        auto Start = chrono::steady_clock::now();
+        stImportResult Result;
+
+        fstream CsvFile(CsvPath, ios::in); // read Mode
+        if (!CsvFile.is_open())
+            return Result;
+        Result.FileFound = true;
+
+        vector<stRow> vRows;
+        string Line;
+        size_t LineNumber = 0;
+
+        while (getline(CsvFile, Line))
+        {
+            LineNumber++;
+            if (clsString::Trim(Line).empty())
+                continue;
+
+            stRow Row;
+            Row.LineNumber = LineNumber;
+            Row.vFields = _SplitCsvLine(Line);
+
+            if (vRows.empty() && clsString::LowerAllString(Row.vFields[0]) == "firstname")
+                continue; // header
+
+            vRows.push_back(move(Row));
+        }
+        CsvFile.close();
+
+        Result.Rows = vRows.size();
+
+        _ValidateRows(vRows);
+
+        unordered_set<clsAccountNumber> Accounts = _LoadExistingAccounts();
+        Result.vClients.reserve(vRows.size());
+
+        for (stRow &Row : vRows)
+        {
+            string AccountNumber = (Row.vFields.size() > 4) ? Row.vFields[4] : "";
+
+            if (Row.Reason.empty() && !Accounts.insert(clsAccountNumber(AccountNumber)).second)
+                Row.Reason = "account number already exists";
+
+            if (!Row.Reason.empty())
+            {
+                Result.vRejected.push_back({Row.LineNumber, AccountNumber, Row.Reason});
+                continue;
+            }
+
+            Result.vClients.push_back(_ToClient(Row));
+        }
+
+        Result.Seconds = chrono::duration<double>(chrono::steady_clock::now() - Start).count();
+        return Result;
+    }
+
+    static size_t Commit(stImportResult &Result)
+    {
+        // Commit process steps:
+        // 1. Read the current account numbers once more: clients added since
+        //    Prepare() are moved to the rejected list instead of being duplicated.
+        // 2. Append all remaining clients with one write.
+        if (Result.vClients.empty())
+            return 0;
+
+        auto Start = chrono::steady_clock::now();
+        unordered_set<clsAccountNumber> Accounts = _LoadExistingAccounts();
+
+        vector<clsBankClient> vNewClients;
+        vNewClients.reserve(Result.vClients.size());
+
+        for (clsBankClient &Client : Result.vClients)
+        {
+            if (Accounts.count(Client.GetAccountKey()))
+                Result.vRejected.push_back({0, Client.GetAccountNumber(), "account number was added meanwhile"});
+            else
+                vNewClients.push_back(move(Client));
+        }
+
+        clsBankClient::AddNewClients(vNewClients);
+
+        Result.vClients = move(vNewClients);
+        Result.Imported = Result.vClients.size();
+        Result.Seconds += chrono::duration<double>(chrono::steady_clock::now() - Start).count();
+        return Result.Imported;
+    }
+
+    static stImportResult Import(const string &CsvPath)
+    {
+        stImportResult Result = Prepare(CsvPath);
+        Commit(Result);
+        return Result;
+    }
+};
@@ -0,0 +1,476 @@
+/*clsClientTableRcu Overview
+================================================================================
+                              clsClientTableRcu.h
+================================================================================
+Overview:
+---------
+This file defines clsClientTableRcu, the published, read-only client table of
+the process: immutable clsAccountTable versions shared by read-copy-update.
+
+Reports (client list, total balances, the batch "report" command), the find
+screens and balance inquiries only read clients. Reading the clients store
+for each of them means holding the store's lock for a whole scan while ATM
+withdrawals wait for it. With clsClientTableRcu:
+
+- Readers take the current version with no lock at all: a clsReadGuard
+  announces the reader's epoch in its own slot, then loads one atomic
+  pointer. The version never changes while the guard lives, so a report is
+  one consistent picture of every account, however long it takes.
+- Writers never wait for readers. After a successful write to the clients
+  store a writer queues the change (BalanceChanged / RecordChanged /
+  Removed, a short mutex around a vector) and goes on.
+- Queued changes are published in batches: a copy of the current table gets
+  the changes and replaces it with one atomic store. The next reader
+  publishes what is queued (only if no one else is publishing: a reader
+  never waits), and a writer publishes itself once PublishEveryChanges are
+  queued.
+- A replaced version is retired with the epoch that follows its
+  replacement and deleted only when every reader still inside a guard
+  started after that epoch (epoch-based reclamation), so no reader ever
+  sees freed memory.
+
+================================================================================
+Freshness:
+----------
+- Changes of this process are visible to every reader that starts after
+  they were published; a reader whose publish attempt finds another thread
+  already publishing uses the version that thread is replacing.
+- Bulk rewrites call Invalidate() (clsClientImporter batches) or move
+  clsAccountTable::SaveCount() (SaveBalances): the next version is loaded
+  from the store again.
+- Shared mode (clsSharedAccountTable): other processes change balances
+  behind this process's back, so a version remembers the shared table's
+  Generation() and a newer one makes the next reader load a fresh version
+  (balances from the shared table).
+- clsStorage::Configure() (another data root or backend) does the same.
+- Without shared mode other processes' writes are not seen, as with every
+  other cache of the process; several processes need shared mode anyway.
+
+A change queued while a reload is running may be applied on top of the
+reloaded version again: changes carry the record version
+(clsRecordVersion), and one older than the row's is dropped.
+
+================================================================================
+Public Methods:
+---------------
+    clsReadGuard()                        pin the current version
+        const clsAccountTable &operator* / operator->
+        unsigned long long VersionNumber()
+
+    static void BalanceChanged(Account, Balance, Version)
+    static void RecordChanged(const string &Line)      full line (profile edit, add)
+    static void Removed(Account)
+    static void Invalidate()                            reload from the store
+    static void Publish()                               publish queued changes now
+
+Settings:
+    PublishEveryChanges (default 64)
+    MaxReaders          (256 threads inside a guard at the same time)
+
+================================================================================
+Usage Example:
+--------------
+    clsClientTableRcu::clsReadGuard Table;     // no lock, never blocks a withdrawal
+    double Total = Table->GetTotalBalances();
+    for (size_t i = 0; i < Table->Size(); i++)
+        cout << Table->GetAccountNumber(i) << " " << Table->GetBalance(i) << "\n";
+
+================================================================================
+*/
+
+#pragma once
+
+#include <string>
+#include <string_view>
+#include <vector>
+#include <unordered_map>
+#include <mutex>
+#include <atomic>
+#include <thread>
+#include <climits>
+
+#include "../utils/clsFixedString.h" // utils/clsFixedString.h
+#include "clsStorage.h"              // core/clsStorage.h
+#include "clsAccountTable.h"         // core/clsAccountTable.h
+#include "clsRecordVersion.h"        // core/clsRecordVersion.h
+#include "clsSharedAccountTable.h"   // core/clsSharedAccountTable.h
+
+using namespace std;
+
+class clsClientTableRcu
+{
+public:
+    static const unsigned int MaxReaders = 256;
+    inline static size_t PublishEveryChanges = 64;
+
+private:
+    enum enChange
+    {
+        chBalance = 0,
+        chRecord = 1,
+        chRemove = 2
+    };
+
+    struct stChange
+    {
+        enChange Type;
+        clsAccountNumber Account;
+        double Balance = 0;
+        unsigned long long Version = 0;
+        string Line; // chRecord
+    };
+
+    struct stVersion
+    {
+        clsAccountTable Table;
+        unsigned long long Number = 0;
+        unsigned long long StorageId = 0;        // clsStorage::ConfigurationId()
+        unsigned long long SaveCount = 0;        // clsAccountTable::SaveCount()
+        unsigned long long SharedGeneration = 0; // clsSharedAccountTable::Generation()
+        unordered_map<clsAccountNumber, unsigned long long> Versions; // record versions applied since the load
+    };
+
+    struct alignas(64) stReaderSlot
+    {
+        atomic<bool> Used{false};
+        atomic<unsigned long long> Epoch{0}; // 0 = not reading
+    };
+
+    struct stRetired
+    {
+        const stVersion *Version;
+        unsigned long long Epoch; // freed once every reader started at or after it
+    };
+
+    struct stState
+    {
+        atomic<const stVersion *> Current{nullptr};
+        atomic<unsigned long long> Epoch{1};
+        stReaderSlot Readers[MaxReaders];
+
+        mutex PublishMutex; // one publisher; guards vRetired (readers only try it)
+        vector<stRetired> vRetired;
+
+        mutex PendingMutex; // writers queue changes
+        vector<stChange> vPending;
+        atomic<bool> HasPending{false};
+        atomic<bool> Invalid{false};
+
+        // what Current was built from, readable without pinning it
+        atomic<unsigned long long> StorageId{0};
+        atomic<unsigned long long> SaveCount{0};
+        atomic<unsigned long long> SharedGeneration{0};
+
+        ~stState()
+        {
+            delete Current.load();
+            for (const stRetired &Retired : vRetired)
+                delete Retired.Version;
+        }
+    };
+
+    struct stThreadSlot
+    {
+        stReaderSlot *Slot = nullptr;
+        unsigned int Depth = 0; // nested guards of the thread share the outer epoch
+
+        ~stThreadSlot()
+        {
+            if (Slot != nullptr)
+                Slot->Used.store(false);
+        }
+    };
+
+    static stState &_State()
+    {
+        static stState State;
+        return State;
+    }
+
+    static stThreadSlot &_ThreadSlot()
+    {
+        static thread_local stThreadSlot ThreadSlot;
+        return ThreadSlot;
+    }
+
+    //---------------------------------------------
+    // Readers
+    //---------------------------------------------
+    static void _Enter()
+    {
+        // _Enter process steps:
+        // 1. A thread claims a free reader slot once and keeps it until it exits
+        //    (all slots taken: wait for one, this is the only wait of a reader).
+        // 2. The outermost guard writes the global epoch into the slot; every
+        //    version loaded from now on is kept alive until the slot is cleared.
+        stState &State = _State();
+        stThreadSlot &Thread = _ThreadSlot();
+
+        while (Thread.Slot == nullptr)
+        {
+            for (stReaderSlot &Slot : State.Readers)
+            {
+                bool Free = false;
+                if (Slot.Used.compare_exchange_strong(Free, true))
+                {
+                    Thread.Slot = &Slot;
+                    break;
+                }
+            }
+            if (Thread.Slot == nullptr)
+                this_thread::yield();
+        }
+
+        if (Thread.Depth++ == 0)
+            Thread.Slot->Epoch.store(State.Epoch.load());
+    }
+
+    static void _Leave()
+    {
+        stThreadSlot &Thread = _ThreadSlot();
+        if (--Thread.Depth == 0)
+            Thread.Slot->Epoch.store(0);
+    }
+
+    //---------------------------------------------
+    // Publisher (holds PublishMutex)
+    //---------------------------------------------
+    static bool _IsStale(const stVersion *Version)
+    {
+        if (Version == nullptr || Version->StorageId != clsStorage::ConfigurationId() ||
+            Version->SaveCount != clsAccountTable::SaveCount())
+            return true;
+
+        clsSharedAccountTable *Shared = clsSharedAccountTable::Active();
+        return Shared != nullptr && Shared->Generation() != Version->SharedGeneration;
+    }
+
+    static unsigned long long _RowVersion(const stVersion &Version, const clsAccountNumber &Account, int Index)
+    {
+        // version of the row: the last change applied, else the loaded line's
+        auto It = Version.Versions.find(Account);
+        if (It != Version.Versions.end())
+            return It->second;
+        return Index < 0 ? 0 : clsRecordVersion::Of(Version.Table.GetRecord(Index), clsStorage::ClientsVersionColumn);
+    }
+
+    static void _Apply(stVersion &Version, const stChange &Change)
+    {
+        int Index = Version.Table.FindIndex(Change.Account.View());
+
+        if (Change.Type == chRemove)
+        {
+            Version.Table.RemoveRecord(Change.Account.View());
+            Version.Versions.erase(Change.Account);
+            return;
+        }
+
+        if (Change.Version <= _RowVersion(Version, Change.Account, Index))
+            return; // already in the table (queued during a reload)
+
+        if (Change.Type == chBalance)
+        {
+            if (Index < 0)
+                return; // removed meanwhile
+            Version.Table.SetBalance(Index, Change.Balance);
+        }
+        else
+            Version.Table.SetRecord(Change.Line);
+
+        Version.Versions[Change.Account] = Change.Version;
+    }
+
+    static void _Reclaim(stState &State)
+    {
+        // delete every retired version no reader can still hold
+        unsigned long long Oldest = ULLONG_MAX;
+        for (const stReaderSlot &Slot : State.Readers)
+        {
+            unsigned long long Epoch = Slot.Epoch.load();
+            if (Epoch != 0 && Epoch < Oldest)
+                Oldest = Epoch;
+        }
+
+        size_t Kept = 0;
+        for (const stRetired &Retired : State.vRetired)
+        {
+            if (Retired.Epoch <= Oldest)
+                delete Retired.Version;
+            else
+                State.vRetired[Kept++] = Retired;
+        }
+        State.vRetired.resize(Kept);
+    }
+
+    static bool _NeedsPublish(stState &State)
+    {
+        // called by readers before they pin a version: Current itself is not read
+        if (State.HasPending.load() || State.Invalid.load() || State.Current.load() == nullptr ||
+            State.StorageId.load() != clsStorage::ConfigurationId() || State.SaveCount.load() != clsAccountTable::SaveCount())
+            return true;
+
+        clsSharedAccountTable *Shared = clsSharedAccountTable::Active();
+        return Shared != nullptr && Shared->Generation() != State.SharedGeneration.load();
+    }
+
+    static void _Publish(bool Wait)
+    {
+        // _Publish process steps:
+        // 1. One publisher at a time; a reader that finds one busy goes on
+        //    with the current version instead of waiting.
+        // 2. Take the queued changes.
+        // 3. Build the next version: a fresh load when invalidated or stale,
+        //    otherwise a copy of the current table with the changes applied.
+        // 4. Swap it in with one atomic store, retire the old one with the
+        //    next epoch, and delete the retired versions no reader holds.
+        stState &State = _State();
+        unique_lock<mutex> Lock(State.PublishMutex, defer_lock);
+        if (Wait)
+            Lock.lock();
+        else if (!Lock.try_lock())
+            return;
+
+        if (!_NeedsPublish(State))
+            return; // published by the thread we waited for
+
+        vector<stChange> vChanges;
+        bool Reload;
+        {
+            lock_guard<mutex> PendingLock(State.PendingMutex);
+            vChanges.swap(State.vPending);
+            State.HasPending.store(false);
+            Reload = State.Invalid.exchange(false);
+        }
+
+        // the publisher is the only thread that frees versions: Old stays valid
+        const stVersion *Old = State.Current.load();
+        stVersion *New = new stVersion();
+        New->Number = (Old == nullptr) ? 1 : Old->Number + 1;
+        New->StorageId = clsStorage::ConfigurationId();
+        New->SaveCount = clsAccountTable::SaveCount(); // read before the load, like the generation below
+        if (clsSharedAccountTable *Shared = clsSharedAccountTable::Active())
+            New->SharedGeneration = Shared->Generation(); // read before the load: a change during it shows next time
+
+        if (Reload || _IsStale(Old))
+            New->Table = clsAccountTable::Load();
+        else
+        {
+            New->Table = Old->Table;
+            New->Versions = Old->Versions;
+        }
+
+        for (const stChange &Change : vChanges)
+            _Apply(*New, Change);
+
+        State.StorageId.store(New->StorageId);
+        State.SaveCount.store(New->SaveCount);
+        State.SharedGeneration.store(New->SharedGeneration);
+        State.Current.store(New);
+        if (Old != nullptr)
+            State.vRetired.push_back({Old, State.Epoch.fetch_add(1) + 1});
+        _Reclaim(State);
+    }
+
+    static void _Queue(stChange &&Change)
+    {
+        // shared mode needs no queue: the write moved the shared Generation()
+        stState &State = _State();
+        if (clsSharedAccountTable::Active() != nullptr)
+            return;
+
+        if (State.Current.load() == nullptr)
+        {
+            // nothing published yet (a process that never reads pays nothing);
+            // a first load running right now may miss this write: reload after it
+            State.Invalid.store(true);
+            return;
+        }
+
+        size_t Pending;
+        {
+            lock_guard<mutex> Lock(State.PendingMutex);
+            State.vPending.push_back(move(Change));
+            State.HasPending.store(true);
+            Pending = State.vPending.size();
+        }
+
+        if (Pending >= PublishEveryChanges)
+            _Publish(false);
+    }
+
+public:
+    class clsReadGuard
+    {
+        // Pins the current version: no lock is taken, and no writer waits
+        // for the guard. Keep it for one report, not across user input.
+    private:
+        const stVersion *_Version;
+
+    public:
+        clsReadGuard()
+        {
+            stState &State = _State();
+            if (State.Current.load() == nullptr)
+                _Publish(true); // the very first read loads the store
+            else if (_NeedsPublish(State))
+                _Publish(false);
+
+            _Enter();
+            _Version = State.Current.load();
+        }
+
+        ~clsReadGuard()
+        {
+            _Leave();
+        }
+
+        clsReadGuard(const clsReadGuard &) = delete;
+        clsReadGuard &operator=(const clsReadGuard &) = delete;
+
+        const clsAccountTable &operator*() const { return _Version->Table; }
+        const clsAccountTable *operator->() const { return &_Version->Table; }
+        unsigned long long VersionNumber() const { return _Version->Number; }
+    };
+
+    //---------------------------------------------
+    // Writers (after a successful write to the clients store)
+    //---------------------------------------------
+    static void BalanceChanged(string_view Account, double Balance, unsigned long long Version)
+    {
+        stChange Change;
+        Change.Type = chBalance;
+        Change.Account = clsAccountNumber(Account);
+        Change.Balance = Balance;
+        Change.Version = Version;
+        _Queue(move(Change));
+    }
+
+    static void RecordChanged(const string &Line)
+    {
+        stChange Change;
+        Change.Type = chRecord;
+        Change.Account = clsAccountNumber(clsString::GetFieldView(Line, " || ", clsStorage::ClientsKeyColumn));
+        Change.Version = clsRecordVersion::Of(Line, clsStorage::ClientsVersionColumn);
+        Change.Line = Line;
+        _Queue(move(Change));
+    }
+
+    static void Removed(string_view Account)
+    {
+        stChange Change;
+        Change.Type = chRemove;
+        Change.Account = clsAccountNumber(Account);
+        _Queue(move(Change));
+    }
+
+    static void Invalidate()
+    {
+        _State().Invalid.store(true);
+    }
+
+    static void Publish()
+    {
+        if (_NeedsPublish(_State()))
+            _Publish(true);
+    }
+};
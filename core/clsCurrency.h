@@ -6,14 +6,15 @@ Overview:
 ----------
 This file defines the clsCurrency class, which represents currency information
 and handles CRUD operations (Create, Read, Update, Delete) for currencies stored
-in a text file "Currencies.txt".
+in the currencies store (clsStorage::Currencies(): the text file "Currencies.txt"
+by default, or the memory / binary backend).
 
 Main Features:
 --------------
 1. Holds currency data: country, currency code, currency name, and exchange rate.
 2. Supports adding new currency, updating existing currency, deleting currency,
    and finding currency by code or country.
-3. Reads/writes currency data from/to "Currencies.txt".
+3. Reads/writes currency data through the configured currencies store.
 4. Provides static methods to load all currencies and check existence.
 5. Supports conversion between string lines in the file and clsCurrency objects.
 
@@ -35,7 +36,7 @@ Public Functions:
 - Getters: GetCountry(), GetCurrencyCode(), GetCurrencyName(), GetRate().
 - print() : print currency card
 - UpdateRate(): Updates the rate and saves changes to file.
-- Delete(): Marks the currency for deletion and updates the file.
+- Delete(): Deletes the currency record (text files: in-place tombstone, clsRecordFile).
 - Save(): Saves a new currency to the file.
 - FindByCode(), FindByCountry(): Static functions to find currencies.
 - IsEmpty(): Checks if a currency object is empty.
@@ -67,6 +68,8 @@ Notes:
 #include <fstream>
 
 #include "../utils/clsString.h"  // utils/clsString.h
+#include "clsStorage.h"           // core/clsStorage.h
+#include "clsMetrics.h"           // core/clsMetrics.h
 
 class clsCurrency
 {
@@ -85,21 +88,24 @@ private:
     float _Rate;
     bool _markedForDelete = false;
 
-    static clsCurrency _ConvertLinetoCurrencyObject(string Line, string Seperator = " || ")
+    static clsCurrency _ConvertLinetoCurrencyObject(const string &Line, string_view Seperator = " || ")
     {
-        vector<string> vCurrencyData;
-        vCurrencyData = clsString::Split(Line, Seperator);
+        vector<string> vCurrencyData = clsString::Split(Line, Seperator);
 
-        return clsCurrency(enMode::UpdateMode, vCurrencyData[0], vCurrencyData[1], vCurrencyData[2],
+        return clsCurrency(enMode::UpdateMode, move(vCurrencyData[0]), move(vCurrencyData[1]), move(vCurrencyData[2]),
                            stod(vCurrencyData[3]));
     }
 
-    static string _ConverCurrencyObjectToLine(const clsCurrency &Currency, string Seperator = " || ")
+    static string _ConverCurrencyObjectToLine(const clsCurrency &Currency, string_view Seperator = " || ")
     {
-        string stCurrencyRecord = "";
-        stCurrencyRecord += Currency.GetCountry() + Seperator;
-        stCurrencyRecord += Currency.GetCurrencyCode() + Seperator;
-        stCurrencyRecord += Currency.GetCurrencyName() + Seperator;
+        string stCurrencyRecord;
+        stCurrencyRecord.reserve(64);
+        stCurrencyRecord += Currency.GetCountry();
+        stCurrencyRecord += Seperator;
+        stCurrencyRecord += Currency.GetCurrencyCode();
+        stCurrencyRecord += Seperator;
+        stCurrencyRecord += Currency.GetCurrencyName();
+        stCurrencyRecord += Seperator;
         stCurrencyRecord += to_string(Currency.GetRate());
 
         return stCurrencyRecord;
@@ -109,71 +115,38 @@ private:
     {
         vector<clsCurrency> vCurrencys;
 
-        fstream MyFile;
-        MyFile.open("../data/Currencies.txt", ios::in); // read Mode
-        if (MyFile.is_open())
-        {
-            string Line;
-            while (getline(MyFile, Line))
-            {
-                clsCurrency Currency = _ConvertLinetoCurrencyObject(Line);
-                vCurrencys.push_back(Currency);
-            }
-            MyFile.close();
-        }
+        clsStorage::Currencies().ForEach([&vCurrencys](const string &Line)
+                                         {
+                                             vCurrencys.push_back(_ConvertLinetoCurrencyObject(Line));
+                                             return false; });
         return vCurrencys;
     }
 
     static void _SaveCurrencyDataToFile(const vector<clsCurrency> &vCurrencys)
     {
-        fstream MyFile;
-        MyFile.open("../data/Currencies.txt", ios::out); // overwrite
+        vector<string> vLines;
+        vLines.reserve(vCurrencys.size());
 
-        string DataLine;
-
-        if (MyFile.is_open())
+        for (const clsCurrency &C : vCurrencys)
         {
-
-            for (const clsCurrency &C : vCurrencys)
+            if (!C._markedForDelete)
             {
-                if (!C._markedForDelete)
-                {
-                    DataLine = _ConverCurrencyObjectToLine(C);
-                    MyFile << DataLine << endl;
-                }
+                vLines.push_back(_ConverCurrencyObjectToLine(C));
             }
-
-            MyFile.close();
         }
+
+        clsStorage::Currencies().ReplaceAll(vLines); // overwrite (text store: temp file + rename)
     }
 
-    void _AddDataLineToFile(string stDataLine)
+    void _AddDataLineToFile(const string &stDataLine)
     {
-        fstream MyFile;
-
-        MyFile.open("../data/Currencies.txt", ios::out | ios::app);
-
-        if (MyFile.is_open())
-        {
-            MyFile << stDataLine << endl;
-            MyFile.close();
-        }
+        clsStorage::Currencies().Append(stDataLine);
     }
 
     void _Update()
     {
-        vector<clsCurrency> _vCurrencys;
-        _vCurrencys = _LoadCurrencysDataFromFile();
-
-        for (clsCurrency &C : _vCurrencys)
-        {
-            if (C.GetCurrencyCode() == this->GetCurrencyCode())
-            {
-                C = *this;
-                break;
-            }
-        }
-        _SaveCurrencyDataToFile(_vCurrencys);
+        // replace the record with this currency code in the currencies store
+        clsStorage::Currencies().Replace(_CurrencyCode, _ConverCurrencyObjectToLine(*this));
     }
 
     static clsCurrency _GetEmptyCurrencyObject()
@@ -183,12 +156,8 @@ private:
 
 public:
     clsCurrency(enMode Mode, string Country, string CurrencyCode, string CurrencyName, float Rate)
+        : _Mode(Mode), _Country(move(Country)), _CurrencyCode(move(CurrencyCode)), _CurrencyName(move(CurrencyName)), _Rate(Rate)
     {
-        _Mode = Mode;
-        _Country = Country;
-        _CurrencyCode = CurrencyCode;
-        _CurrencyName = CurrencyName;
-        _Rate = Rate;
     }
     enum enSaveResults
     {
@@ -198,7 +167,7 @@ public:
 
     static clsCurrency GetAddNewCurrencyObject(string Country = "", string CurrencyCode = "", string CurrencyName = "", float Rate = 0.0f)
     {
-        return clsCurrency(enMode::AddMode, Country, CurrencyCode, CurrencyName, Rate);
+        return clsCurrency(enMode::AddMode, move(Country), move(CurrencyCode), move(CurrencyName), Rate);
     }
 
     static vector<clsCurrency> GetAllUSDRates()
@@ -208,17 +177,17 @@ public:
     //---------------------------------------------
     // getters
     //---------------------------------------------
-    string GetCountry() const
+    const string &GetCountry() const
     {
         return _Country;
     }
 
-    string GetCurrencyCode() const
+    const string &GetCurrencyCode() const
     {
         return _CurrencyCode;
     }
 
-    string GetCurrencyName() const
+    const string &GetCurrencyName() const
     {
         return _CurrencyName;
     }
@@ -253,8 +222,9 @@ public:
     //---------------------------------------------
     clsCurrency Delete()
     {
+        // in-place tombstone on the currency line, no full rewrite
         _markedForDelete = true;
-        _Update();
+        clsStorage::Currencies().Delete(_CurrencyCode);
 
         return _GetEmptyCurrencyObject();
     }
@@ -268,6 +238,7 @@ public:
 
     enSaveResults Save()
     {
+        SB_MEASURE(CurrencySave);
         switch (_Mode)
         {
         case enMode::AddMode:
@@ -285,56 +256,28 @@ public:
     //---------------------------------------------
     // Static Find Functions
     //---------------------------------------------
-    static clsCurrency FindByCode(string CurrencyCode)
+    static clsCurrency FindByCode(string_view CurrencyCode)
     {
+        // codes are stored upper case; the currencies store compares keys
+        // case-insensitively (code column only, no split / stod for other lines)
 
-        CurrencyCode = clsString::UpperAllString(CurrencyCode);
-
-        fstream MyFile;
-        MyFile.open("../data/Currencies.txt", ios::in); // read Mode
-
-        if (MyFile.is_open())
-        {
-            string Line;
-            while (getline(MyFile, Line))
-            {
-                clsCurrency Currency = _ConvertLinetoCurrencyObject(Line);
-                if (Currency.GetCurrencyCode() == CurrencyCode)
-                {
-                    MyFile.close();
-                    return Currency;
-                }
-            }
-
-            MyFile.close();
-        }
+        SB_MEASURE(CurrencyFindByCode);
+        string Line;
+        if (!clsStorage::Currencies().Find(clsStorage::CurrenciesKeyColumn, CurrencyCode, Line))
+            return _GetEmptyCurrencyObject();
 
-        return _GetEmptyCurrencyObject();
+        return _ConvertLinetoCurrencyObject(Line);
     }
 
-    static clsCurrency FindByCountry(string Country)
+    static clsCurrency FindByCountry(string_view Country)
     {
-        Country = clsString::UpperAllString(Country);
 
-        fstream MyFile;
-        MyFile.open("../data/Currencies.txt", ios::in); // read Mode
-
-        if (MyFile.is_open())
-        {
-            string Line;
-            while (getline(MyFile, Line))
-            {
-                clsCurrency Currency = _ConvertLinetoCurrencyObject(Line);
-                if (clsString::UpperAllString(Currency.GetCountry()) == Country)
-                {
-                    MyFile.close();
-                    return Currency;
-                }
-            }
+        SB_MEASURE(CurrencyFindByCountry);
+        string Line; // not the key column: every store scans, comparing the country only
+        if (!clsStorage::Currencies().Find(0, Country, Line))
+            return _GetEmptyCurrencyObject();
 
-            MyFile.close();
-        }
-        return _GetEmptyCurrencyObject();
+        return _ConvertLinetoCurrencyObject(Line);
     }
     //---------------------------------------------
     // Check if Currency Object is empty
@@ -346,13 +289,13 @@ public:
     //---------------------------------------------
     // Static Check Functions
     //---------------------------------------------
-    static bool IsCurrencyExist_code(string CurrencyCode)
+    static bool IsCurrencyExist_code(string_view CurrencyCode)
     {
         clsCurrency C1 = clsCurrency::FindByCode(CurrencyCode);
         return (!C1.IsEmpty());
     }
 
-    static bool IsCountryExist_country(string Country)
+    static bool IsCountryExist_country(string_view Country)
     {
         clsCurrency C1 = clsCurrency::FindByCountry(Country);
         return (!C1.IsEmpty());
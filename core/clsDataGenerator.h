@@ -0,0 +1,574 @@
+/*clsDataGenerator Overview
+================================================================================
+                              clsDataGenerator.h
+================================================================================
+Overview:
+---------
+This file defines the clsDataGenerator class, which writes a complete,
+synthetic data folder for load tests and benchmarks:
+
+    Clients.txt            FirstName || LastName || Email || Phone || Account || EncryptedPin || Balance || Version
+    Admins.text            FirstName || LastName || Email || Phone || Username || EncryptedPassword || Permissions || Version
+    AllTransactions.txt    Date#//#Time#//#User#//#Type#//#Amount#//#From#//#To#//#BalanceAfter
+    ClientsSessionLog.txt  Date#//#Time#//#LOGIN|LOGOUT#//#Account#//#FullName#//#Duration
+    AdminsSessionLog.txt   Date#//#Time#//#LOGIN|LOGOUT#//#Username#//#FullName#//#Permissions#//#Duration
+
+Every file uses exactly the format the application writes, so the generated
+folder can replace data/ directly.
+
+================================================================================
+Consistency:
+------------
+- Transactions are replayed against the account balances while they are
+  generated: a withdraw or transfer never overdraws, BalanceAfter is the real
+  running balance, and Clients.txt is written last with the final balances.
+- A transfer produces its TRANSFER_OUT / TRANSFER_IN (or ADM_TRANS_OUT /
+  ADM_TRANS_IN) pair of lines.
+- Logs are in chronological order over the last DaysSpan days (ending today).
+- Every LOGIN has its LOGOUT with a matching duration.
+
+================================================================================
+Randomness And Skew:
+--------------------
+Names, PINs and passwords come from clsUtil::GenerateWord / RandomNumber,
+seeded with clsUtil::Srand(Seed): the same options always produce the same
+files. Which account a transaction or session touches follows a Zipf
+distribution with exponent Skew (0 = uniform, ~1 = a few very hot accounts,
+as in a real bank). Hot ranks are spread over the account range, so the hot
+accounts are not simply the first lines of Clients.txt.
+
+================================================================================
+Speed:
+------
+Rows are formatted into a large in-memory buffer (WriteBufferBytes, 4 MB) and
+written with one write() per full buffer; numbers are formatted with
+to_chars. Ten million transaction rows take a few seconds.
+
+Note: the generated AllTransactions.txt is one large active segment.
+The first append made by the application closes it into a compressed segment
+(see clsSegmentedLog).
+
+================================================================================
+Public Methods:
+---------------
+    static stSummary Generate(const stOptions &Options)
+
+================================================================================
+Usage Example:
+--------------
+    clsDataGenerator::stOptions Options;
+    Options.DataFolder = "../data_generated";
+    Options.Accounts = 100000;
+    Options.Transactions = 10000000;
+    Options.Skew = 0.99;
+    Options.Seed = 42;
+
+    clsDataGenerator::stSummary Summary = clsDataGenerator::Generate(Options);
+
+================================================================================
+*/
+
+#pragma once
+
+#include <iostream>
+#include <fstream>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <algorithm>
+#include <numeric>
+#include <chrono>
+#include <cmath>
+#include <charconv>
+#include <cstring>
+#include <unordered_map>
+#include <filesystem>
+
+#include "../utils/clsUtil.h"   // utils/clsUtil.h
+#include "../utils/clsDate.h"   // utils/clsDate.h
+#include "clsAdmin.h"           // core/clsAdmin.h
+
+using namespace std;
+
+class clsDataGenerator
+{
+public:
+    struct stOptions
+    {
+        string DataFolder = "../data_generated";
+        size_t Accounts = 1000;
+        size_t Admins = 10;
+        size_t Transactions = 10000; // lines in AllTransactions.txt
+        size_t Sessions = 1000;      // client LOGIN/LOGOUT pairs (admins get Sessions / 10)
+        short DaysSpan = 30;         // history covers the last DaysSpan days
+        double Skew = 0.99;          // Zipf exponent, 0 = uniform
+        unsigned int Seed = 1;
+        string FixedPin = "";        // same PIN for every client (benchmarks), empty = random
+    };
+
+    struct stSummary
+    {
+        size_t ClientRows = 0;
+        size_t AdminRows = 0;
+        size_t TransactionRows = 0;
+        size_t ClientSessionRows = 0;
+        size_t AdminSessionRows = 0;
+        double Seconds = 0;
+    };
+
+    static const size_t WriteBufferBytes = 4 * 1024 * 1024;
+
+    static string_view AccountNumber(size_t Index, char (&Text)[16])
+    {
+        // A0000001 ... A9999999, then as many digits as needed (<= clsAccountNumber::MaxLength)
+        char Digits[20];
+        auto Result = to_chars(Digits, Digits + sizeof(Digits), (unsigned long long)Index + 1);
+        size_t Length = (size_t)(Result.ptr - Digits);
+        size_t Zeros = (Length < 7) ? 7 - Length : 0;
+
+        Text[0] = 'A';
+        memset(Text + 1, '0', Zeros);
+        memcpy(Text + 1 + Zeros, Digits, Length);
+        return string_view(Text, 1 + Zeros + Length);
+    }
+
+private:
+    struct stWriter
+    {
+        ofstream File;
+        string Buffer;
+
+        explicit stWriter(const filesystem::path &Path) : File(Path, ios::out | ios::binary | ios::trunc)
+        {
+            Buffer.reserve(WriteBufferBytes + 4096);
+        }
+
+        ~stWriter() { Flush(); }
+
+        void Flush()
+        {
+            if (!Buffer.empty())
+                File.write(Buffer.data(), (streamsize)Buffer.size());
+            Buffer.clear();
+        }
+
+        stWriter &operator<<(string_view Text)
+        {
+            Buffer.append(Text.data(), Text.size());
+            return *this;
+        }
+
+        stWriter &operator<<(long long Number)
+        {
+            char Digits[24];
+            auto Result = to_chars(Digits, Digits + sizeof(Digits), Number);
+            Buffer.append(Digits, Result.ptr);
+            return *this;
+        }
+
+        stWriter &operator<<(char Character)
+        {
+            Buffer += Character;
+            return *this;
+        }
+
+        void AppendTime(long long SecondOfDay) { AppendTime(Buffer, SecondOfDay); }
+
+        static void AppendTime(string &Text, long long SecondOfDay)
+        {
+            // same layout as clsDate::GetAccurateTime(): "hh:mm:ss AM"
+            int Hour = (int)(SecondOfDay / 3600);
+            int Minute = (int)(SecondOfDay / 60 % 60);
+            int Second = (int)(SecondOfDay % 60);
+            int Hour12 = (Hour % 12 == 0) ? 12 : Hour % 12;
+
+            char Time[11] = {char('0' + Hour12 / 10), char('0' + Hour12 % 10), ':',
+                             char('0' + Minute / 10), char('0' + Minute % 10), ':',
+                             char('0' + Second / 10), char('0' + Second % 10), ' ',
+                             Hour < 12 ? 'A' : 'P', 'M'};
+            Text.append(Time, sizeof(Time));
+        }
+
+        void AppendAccountNumber(size_t Index)
+        {
+            char Text[16];
+            Buffer.append(Text, AccountNumber(Index, Text).size());
+        }
+
+        void EndLine()
+        {
+            Buffer += '\n';
+            if (Buffer.size() >= WriteBufferBytes)
+                Flush();
+        }
+    };
+
+    struct stAdmin
+    {
+        string Username;
+        string FullName;
+        int Permissions;
+    };
+
+    //---------------------------------------------
+    // Zipf sampling
+    //---------------------------------------------
+    class clsZipf
+    {
+        // Rejection-inversion sampling (Hoermann & Derflinger): O(1) per draw
+        // and no per-account table, so 10M accounts cost no extra memory.
+    private:
+        size_t _Count;
+        double _Skew;
+        size_t _Stride; // rank -> index permutation (gcd(Stride, Count) == 1)
+        double _HIntegralX1 = 0, _HIntegralN = 0, _S = 0;
+
+        static double _Helper1(double X) { return (fabs(X) > 1e-8) ? log1p(X) / X : 1 - X * (0.5 - X * (1.0 / 3 - 0.25 * X)); }
+        static double _Helper2(double X) { return (fabs(X) > 1e-8) ? expm1(X) / X : 1 + X * 0.5 * (1 + X * (1.0 / 3) * (1 + 0.25 * X)); }
+
+        double _H(double X) const { return exp(-_Skew * log(X)); }
+        double _HIntegral(double X) const
+        {
+            double LogX = log(X);
+            return _Helper2((1 - _Skew) * LogX) * LogX;
+        }
+        double _HIntegralInverse(double X) const
+        {
+            double T = X * (1 - _Skew);
+            if (T < -1)
+                T = -1;
+            return exp(_Helper1(T) * X);
+        }
+
+    public:
+        clsZipf(size_t Count, double Skew) : _Count(Count), _Skew(Skew), _Stride(1)
+        {
+            if (_Skew > 0 && _Count > 1)
+            {
+                _HIntegralX1 = _HIntegral(1.5) - 1;
+                _HIntegralN = _HIntegral((double)_Count + 0.5);
+                _S = 2 - _HIntegralInverse(_HIntegral(2.5) - _H(2));
+            }
+
+            // spread hot ranks over the whole account range
+            _Stride = (_Count > 2) ? (size_t)(_Count * 0.618) | 1 : 1;
+            while (_Stride > 1 && gcd(_Stride, _Count) != 1)
+                _Stride += 2;
+        }
+
+        size_t Next()
+        {
+            size_t Rank; // 0-based
+
+            if (_Skew <= 0 || _Count <= 1)
+            {
+                Rank = (size_t)(((unsigned long long)clsUtil::NextRandom() * _Count) >> 32);
+            }
+            else
+            {
+                while (true)
+                {
+                    double Uniform = (double)clsUtil::NextRandom() / 4294967296.0;
+                    double U = _HIntegralN + Uniform * (_HIntegralX1 - _HIntegralN);
+                    double X = _HIntegralInverse(U);
+
+                    double K = floor(X + 0.5);
+                    if (K < 1)
+                        K = 1;
+                    else if (K > (double)_Count)
+                        K = (double)_Count;
+
+                    if (K - X <= _S || U >= _HIntegral(K + 0.5) - _H(K))
+                    {
+                        Rank = (size_t)K - 1;
+                        break;
+                    }
+                }
+            }
+
+            return (size_t)(((unsigned long long)(Rank + 1) * _Stride) % _Count);
+        }
+    };
+
+    //---------------------------------------------
+    // Field helpers
+    //---------------------------------------------
+    static string _Name()
+    {
+        // "Kmarel": one capital letter + 3..7 small letters
+        return clsUtil::GenerateWord(clsUtil::CapitalLetter, 1) +
+               clsUtil::GenerateWord(clsUtil::SamallLetter, (short)clsUtil::RandomNumber(3, 7));
+    }
+
+    static string _Duration(int Minutes)
+    {
+        if (Minutes < 60)
+            return to_string(Minutes) + " mins";
+        if (Minutes % 60 == 0)
+            return to_string(Minutes / 60) + " hrs";
+        return to_string(Minutes / 60) + " hrs " + to_string(Minutes % 60) + " mins";
+    }
+
+    static vector<string> _Days(short DaysSpan)
+    {
+        // DaysSpan dates ending today, oldest first
+        clsDate Date = clsDate::GetSystemDate();
+        for (short i = 1; i < DaysSpan; i++)
+            Date = clsDate::DecreaseDateByOneDay(Date);
+
+        vector<string> vDays;
+        for (short i = 0; i < DaysSpan; i++)
+        {
+            vDays.push_back(clsDate::DateToString(Date));
+            Date = clsDate::AddOneDay(Date);
+        }
+        return vDays;
+    }
+
+    //---------------------------------------------
+    // Files
+    //---------------------------------------------
+    static vector<long long> _CreateBalances(size_t Accounts)
+    {
+        // balances only (8 bytes per account): the transaction loop touches
+        // random accounts, so keeping this array dense keeps it in cache
+        vector<long long> vBalances(Accounts);
+        for (long long &Balance : vBalances)
+            Balance = clsUtil::RandomNumber(10, 5000) * 10; // opening balance
+        return vBalances;
+    }
+
+    static void _WriteClients(const filesystem::path &Path, const vector<long long> &vBalances, const string &FixedPin,
+                              unordered_map<size_t, string> &FullNamesWanted)
+    {
+        // Written after the transactions, so the balances are final.
+        // Full names are kept only for the accounts the session logs need.
+        stWriter Writer(Path);
+
+        for (size_t i = 0; i < vBalances.size(); i++)
+        {
+            string FirstName = _Name();
+            string LastName = _Name();
+            string Pin = FixedPin.empty() ? clsUtil::GenerateWord(clsUtil::Digit, 4) : FixedPin;
+
+            auto Wanted = FullNamesWanted.find(i);
+            if (Wanted != FullNamesWanted.end())
+                Wanted->second = FirstName + " " + LastName;
+
+            Writer << FirstName << " || " << LastName << " || "
+                   << FirstName << '.' << LastName << "@mail.com || "
+                   << "01" << clsUtil::GenerateWord(clsUtil::Digit, 9) << " || ";
+            Writer.AppendAccountNumber(i);
+            Writer << " || " << clsUtil::EncryptText(Pin) << " || "
+                   << to_string((float)vBalances[i]) << " || 1"; // record version 1
+            Writer.EndLine();
+        }
+    }
+
+    static vector<stAdmin> _WriteAdmins(const filesystem::path &Path, size_t Admins)
+    {
+        // Admin1 has every permission, the others a random subset
+        stWriter Writer(Path);
+        vector<stAdmin> vAdmins;
+
+        for (size_t i = 0; i < Admins; i++)
+        {
+            string FirstName = _Name();
+            string LastName = _Name();
+
+            stAdmin Admin;
+            Admin.Username = "Admin" + to_string(i + 1);
+            Admin.FullName = FirstName + " " + LastName;
+            Admin.Permissions = (i == 0) ? clsAdmin::eAll : clsUtil::RandomNumber(1, 255);
+
+            Writer << FirstName << " || " << LastName << " || "
+                   << FirstName << '.' << LastName << "@bank.com || "
+                   << "01" << clsUtil::GenerateWord(clsUtil::Digit, 9) << " || "
+                   << Admin.Username << " || "
+                   << clsUtil::EncryptText(clsUtil::GenerateWord(clsUtil::Digit, 4)) << " || "
+                   << (long long)Admin.Permissions << " || 1";
+            Writer.EndLine();
+
+            vAdmins.push_back(move(Admin));
+        }
+        return vAdmins;
+    }
+
+    static size_t _WriteTransactions(const filesystem::path &Path, const stOptions &Options,
+                                     vector<long long> &vBalances, const vector<stAdmin> &vAdmins,
+                                     const vector<string> &vDays, clsZipf &Accounts)
+    {
+        // _WriteTransactions process steps:
+        // 1. Spread the rows evenly over the time span (chronological order).
+        // 2. Pick the operation: 40% deposit, 30% withdraw, 20% transfer,
+        //    10% admin operation; pick accounts with the Zipf sampler.
+        // 3. Apply it to the running balance (an overdraft becomes a deposit)
+        //    and write the line(s) with the balance after the operation.
+        stWriter Writer(Path);
+        long long SpanSeconds = (long long)vDays.size() * 86400;
+        size_t Rows = 0;
+
+        double SecondsPerRow = (double)SpanSeconds / (double)Options.Transactions;
+        long long LastSecond = -1;
+        string Stamp; // "date#//#time#//#", rebuilt only when the second changes
+
+        auto WriteLine = [&](string_view User, string_view Type, long long Amount,
+                             string_view From, string_view To, long long BalanceAfter)
+        {
+            long long Second = (long long)((double)Rows * SecondsPerRow);
+            if (Second != LastSecond)
+            {
+                Stamp = vDays[(size_t)(Second / 86400)] + "#//#";
+                stWriter::AppendTime(Stamp, Second % 86400);
+                Stamp += "#//#";
+                LastSecond = Second;
+            }
+
+            Writer << Stamp << User << "#//#" << Type << "#//#" << Amount << "#//#"
+                   << From << "#//#" << To << "#//#" << BalanceAfter;
+            Writer.EndLine();
+            Rows++;
+        };
+
+        while (Rows < Options.Transactions)
+        {
+            int Operation = clsUtil::RandomNumber(1, 100);
+            long long Amount = clsUtil::RandomNumber(1, 100) * 10;
+            bool ByAdmin = (Operation > 90 && !vAdmins.empty());
+            const string *Admin = ByAdmin ? &vAdmins[clsUtil::RandomNumber(0, (int)vAdmins.size() - 1)].Username : nullptr;
+
+            size_t From = Accounts.Next();
+            char FromText[16];
+            string_view FromAccount = AccountNumber(From, FromText);
+            string_view User = ByAdmin ? string_view(*Admin) : FromAccount;
+
+            bool IsTransfer = (Operation > 70 && Operation <= 90) || (ByAdmin && Operation > 97);
+            bool IsWithdraw = (Operation > 40 && Operation <= 70) || (ByAdmin && Operation > 94 && Operation <= 97);
+
+            if (IsTransfer && Rows + 2 <= Options.Transactions && vBalances.size() > 1)
+            {
+                size_t To = Accounts.Next();
+                if (To != From && vBalances[From] >= Amount)
+                {
+                    char ToText[16];
+                    string_view ToAccount = AccountNumber(To, ToText);
+                    vBalances[From] -= Amount;
+                    vBalances[To] += Amount;
+
+                    WriteLine(User, ByAdmin ? "ADM_TRANS_OUT" : "TRANSFER_OUT", Amount, FromAccount, ToAccount, vBalances[From]);
+                    WriteLine(ByAdmin ? User : ToAccount, ByAdmin ? "ADM_TRANS_IN" : "TRANSFER_IN", Amount, FromAccount, ToAccount, vBalances[To]);
+                    continue;
+                }
+            }
+
+            if (IsWithdraw && vBalances[From] >= Amount)
+            {
+                vBalances[From] -= Amount;
+                WriteLine(User, ByAdmin ? "ADMIN_WITHDRAW" : "WITHDRAW", Amount, FromAccount, "-", vBalances[From]);
+                continue;
+            }
+
+            vBalances[From] += Amount;
+            WriteLine(User, ByAdmin ? "ADMIN_DEPOSIT" : "DEPOSIT", Amount, "-", FromAccount, vBalances[From]);
+        }
+        return Rows;
+    }
+
+    template <typename TWriteUser>
+    static size_t _WriteSessions(const filesystem::path &Path, size_t Sessions, const vector<string> &vDays,
+                                 const TWriteUser &WriteUser)
+    {
+        // LOGIN / LOGOUT pairs spread over the span; WriteUser(Writer, Index)
+        // writes the columns that differ between client and admin logs.
+        stWriter Writer(Path);
+        long long SpanSeconds = (long long)vDays.size() * 86400;
+
+        for (size_t i = 0; i < Sessions; i++)
+        {
+            long long Login = (long long)((double)i * (double)SpanSeconds / (double)Sessions);
+            int Minutes = clsUtil::RandomNumber(0, 45);
+            long long Logout = min(Login + Minutes * 60LL, SpanSeconds - 1);
+            Minutes = (int)(Logout / 60 - Login / 60);
+
+            Writer << vDays[(size_t)(Login / 86400)] << "#//#";
+            Writer.AppendTime(Login % 86400);
+            Writer << "#//#LOGIN#//#";
+            WriteUser(Writer, i);
+            Writer << "-";
+            Writer.EndLine();
+
+            Writer << vDays[(size_t)(Logout / 86400)] << "#//#";
+            Writer.AppendTime(Logout % 86400);
+            Writer << "#//#LOGOUT#//#";
+            WriteUser(Writer, i);
+            Writer << _Duration(Minutes);
+            Writer.EndLine();
+        }
+        return Sessions * 2;
+    }
+
+public:
+    static stSummary Generate(const stOptions &Options)
+    {
+        // Generate process steps:
+        // 1. Seed clsUtil and create the output folder.
+        // 2. Admins.text.
+        // 3. AllTransactions.txt, replayed against in-memory balances.
+        // 4. Clients.txt with the final balances.
+        // 5. Client and admin session logs.
+        stSummary Summary;
+        auto Start = chrono::steady_clock::now();
+
+        clsUtil::Srand(Options.Seed);
+        filesystem::path Folder(Options.DataFolder);
+        filesystem::create_directories(Folder);
+
+        vector<string> vDays = _Days(Options.DaysSpan > 0 ? Options.DaysSpan : 1);
+        vector<long long> vBalances = _CreateBalances(Options.Accounts);
+        clsZipf Accounts(max<size_t>(Options.Accounts, 1), Options.Skew);
+
+        vector<stAdmin> vAdmins = _WriteAdmins(Folder / "Admins.text", Options.Admins);
+        Summary.AdminRows = vAdmins.size();
+
+        if (vBalances.empty())
+        {
+            stWriter Empty(Folder / "AllTransactions.txt"); // no accounts, no history
+        }
+        else
+        {
+            Summary.TransactionRows = _WriteTransactions(Folder / "AllTransactions.txt", Options, vBalances, vAdmins, vDays, Accounts);
+        }
+
+        // who logs in is drawn before Clients.txt is written, so only their names are kept
+        size_t ClientSessions = vBalances.empty() ? 0 : Options.Sessions;
+        vector<size_t> vSessionClients(ClientSessions);
+        unordered_map<size_t, string> FullNames;
+        for (size_t &Index : vSessionClients)
+        {
+            Index = Accounts.Next();
+            FullNames[Index];
+        }
+
+        _WriteClients(Folder / "Clients.txt", vBalances, Options.FixedPin, FullNames);
+        Summary.ClientRows = vBalances.size();
+
+        Summary.ClientSessionRows = _WriteSessions(Folder / "ClientsSessionLog.txt", ClientSessions, vDays,
+                                                   [&](stWriter &Writer, size_t i)
+                                                   {
+                                                       Writer.AppendAccountNumber(vSessionClients[i]);
+                                                       Writer << "#//#" << FullNames[vSessionClients[i]] << "#//#";
+                                                   });
+
+        size_t AdminSessions = vAdmins.empty() ? 0 : max<size_t>(Options.Sessions / 10, 1);
+        Summary.AdminSessionRows = _WriteSessions(Folder / "AdminsSessionLog.txt", AdminSessions, vDays,
+                                                  [&](stWriter &Writer, size_t i)
+                                                  {
+                                                      const stAdmin &Admin = vAdmins[i % vAdmins.size()];
+                                                      Writer << Admin.Username << "#//#" << Admin.FullName << "#//#"
+                                                             << (long long)Admin.Permissions << "#//#";
+                                                  });
+
+        Summary.Seconds = chrono::duration<double>(chrono::steady_clock::now() - Start).count();
+        return Summary;
+    }
+};
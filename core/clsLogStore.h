@@ -0,0 +1,88 @@
+/*clsLogStore Overview
+================================================================================
+                                 clsLogStore.h
+================================================================================
+Overview:
+---------
+This file defines clsLogStore, the storage interface behind the append-only
+"#//#" logs: AllTransactions.txt (clsTransactionLogger) and the client and
+admin session logs. Lines keep the format they always had; a line starts
+with its date ("26/11/2025#//#..."), which is what the date ranges compare.
+
+    clsSegmentedLogStore  the segmented text log under the data root (default,
+                          used by the text, memory and binary backends)
+    clsSqliteLogStore     a table in SmartBank.db (sqlite backend)
+
+clsStorage creates one store per log: Transactions(), ClientSessions() and
+AdminSessions().
+
+================================================================================
+Keys:
+-----
+ForEachLineMentioning(Key, Visitor) visits the lines that may mention Key in
+one of the log's key columns (user, from and to account for transactions;
+user for sessions). It may visit more lines than that (the segmented log
+simply visits every line), so callers still apply their exact filter; a store
+with an index visits only the candidates.
+
+================================================================================
+Public Methods:
+---------------
+    virtual string BackendName() const
+    virtual void AppendLine(const string &Line)
+    virtual void AppendLines(const vector<string> &vLines)          one write / commit
+    virtual void ForEachLine(Visitor, int FromDateKey, int ToDateKey) oldest -> newest
+    virtual bool ForEachLineNewestFirst(Visitor)                   true = visitor stopped
+    virtual void ForEachLineMentioning(string_view Key, Visitor)
+
+    vector<string> ReadAllLines(int FromDateKey, int ToDateKey)
+
+================================================================================
+Usage Example:
+--------------
+    clsStorage::Transactions().AppendLine(Line);
+    clsStorage::Transactions().ForEachLineMentioning("A101", [](const string &Line)
+                                                     { cout << Line << endl; });
+
+================================================================================
+*/
+
+#pragma once
+
+#include <string>
+#include <string_view>
+#include <vector>
+#include <climits>
+#include <functional>
+
+using namespace std;
+
+class clsLogStore
+{
+public:
+    virtual ~clsLogStore() {}
+
+    virtual string BackendName() const = 0;
+
+    virtual void AppendLine(const string &Line) = 0;
+    virtual void AppendLines(const vector<string> &vLines) = 0;
+
+    virtual void ForEachLine(const function<void(const string &Line)> &Visitor,
+                             int FromDateKey = 0, int ToDateKey = INT_MAX) = 0;
+    virtual bool ForEachLineNewestFirst(const function<bool(const string &Line)> &Visitor) = 0;
+
+    virtual void ForEachLineMentioning(string_view Key, const function<void(const string &Line)> &Visitor)
+    {
+        // no index: every line is a candidate
+        (void)Key;
+        ForEachLine(Visitor);
+    }
+
+    vector<string> ReadAllLines(int FromDateKey = 0, int ToDateKey = INT_MAX)
+    {
+        vector<string> vLines;
+        ForEachLine([&vLines](const string &Line)
+                    { vLines.push_back(Line); }, FromDateKey, ToDateKey);
+        return vLines;
+    }
+};
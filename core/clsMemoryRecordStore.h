@@ -0,0 +1,270 @@
+/*clsMemoryRecordStore Overview
+================================================================================
+                            clsMemoryRecordStore.h
+================================================================================
+Overview:
+---------
+This file defines clsMemoryRecordStore, a clsRecordStore that keeps its lines
+in memory only. It is meant for tests and benchmarks: nothing touches the
+disk, so results do not depend on the file system, and a run leaves no files
+behind.
+
+- Lines live in one vector in insertion order; a deleted line leaves an
+  empty slot, so positions never move and ForEach() keeps the order.
+- A hash index maps the (normalized) key column to its slot, so Find() on
+  the key column, Replace() and Delete() are O(1). Find() on other columns
+  scans.
+- A key that is on more than one line (Currencies.txt repeats some codes)
+  maps to the first of them, the line the text store's scan returns. When
+  that line goes away the next one with the key takes its place.
+- Every call holds the store's mutex, like clsRecordFile does for files;
+  a ForEach() visitor must not call back into the same store.
+
+clsStorage seeds each memory store once from the text files under the data
+root (when they exist); changes are lost when the process exits.
+
+================================================================================
+Public Methods:
+---------------
+    clsRecordStore interface, plus
+    size_t Count()                      live records
+
+================================================================================
+*/
+
+#pragma once
+
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include <mutex>
+
+#include "clsRecordStore.h" // core/clsRecordStore.h
+
+using namespace std;
+
+class clsMemoryRecordStore : public clsRecordStore
+{
+private:
+    mutex _Mutex;
+    vector<string> _vLines;                 // empty string = deleted slot
+    unordered_map<string, size_t> _Index;   // normalized key -> slot
+    size_t _Deleted = 0;
+    bool _DuplicateKeys = false;            // some key is on more than one line
+
+    void _AppendLocked(const string &Line)
+    {
+        // the first line with a key keeps the index entry
+        if (!_Index.emplace(_NormalizedKey(_KeyOf(Line)), _vLines.size()).second)
+            _DuplicateKeys = true;
+        _vLines.push_back(Line);
+    }
+
+    void _IndexNextDuplicate(const string &Key, size_t FromSlot)
+    {
+        // Key lost its line at FromSlot: a later line with it becomes the first
+        if (!_DuplicateKeys)
+            return;
+
+        for (size_t Slot = FromSlot + 1; Slot < _vLines.size(); Slot++)
+        {
+            if (!_vLines[Slot].empty() && _NormalizedKey(_KeyOf(_vLines[Slot])) == Key)
+            {
+                _Index.emplace(Key, Slot);
+                return;
+            }
+        }
+    }
+
+    void _CompactIfNeeded()
+    {
+        // reclaim the empty slots once they are the majority
+        if (_Deleted * 2 < _vLines.size())
+            return;
+
+        vector<string> vLive;
+        vLive.reserve(_vLines.size() - _Deleted);
+        for (string &Line : _vLines)
+        {
+            if (!Line.empty())
+                vLive.push_back(move(Line));
+        }
+
+        _vLines.clear();
+        _Index.clear();
+        _Deleted = 0;
+        _DuplicateKeys = false;
+        for (const string &Line : vLive)
+            _AppendLocked(Line);
+    }
+
+    void _ReplaceAllLocked(const vector<string> &vLines)
+    {
+        _vLines.clear();
+        _Index.clear();
+        _Deleted = 0;
+        _DuplicateKeys = false;
+
+        _vLines.reserve(vLines.size());
+        for (const string &Line : vLines)
+        {
+            if (!Line.empty())
+                _AppendLocked(Line);
+        }
+    }
+
+    bool _ReplaceLocked(string_view Key, const string &Line)
+    {
+        auto It = _Index.find(_NormalizedKey(Key));
+        if (It == _Index.end())
+            return false;
+
+        size_t Slot = It->second;
+        string NewKey = _NormalizedKey(_KeyOf(Line));
+        if (NewKey != It->first)
+        {
+            // the key itself changed: move the slot to the new key, unless
+            // an earlier line already has that key
+            string OldKey = It->first;
+            _Index.erase(It);
+            auto Added = _Index.emplace(NewKey, Slot);
+            if (!Added.second)
+            {
+                _DuplicateKeys = true;
+                if (Slot < Added.first->second)
+                    Added.first->second = Slot;
+            }
+            _vLines[Slot] = Line;
+            _IndexNextDuplicate(OldKey, Slot);
+            return true;
+        }
+        _vLines[Slot] = Line;
+        return true;
+    }
+
+public:
+    clsMemoryRecordStore(short KeyColumn, bool IgnoreCase) : clsRecordStore(KeyColumn, IgnoreCase)
+    {
+    }
+
+    string BackendName() const override { return "memory"; }
+
+    void ForEach(const function<bool(const string &Line)> &Visitor) override
+    {
+        lock_guard<mutex> Lock(_Mutex);
+        for (const string &Line : _vLines)
+        {
+            if (!Line.empty() && Visitor(Line))
+                break;
+        }
+    }
+
+    bool Find(short Column, string_view Key, string &Line) override
+    {
+        lock_guard<mutex> Lock(_Mutex);
+
+        if (Column == _KeyColumn)
+        {
+            auto It = _Index.find(_NormalizedKey(Key));
+            if (It == _Index.end())
+                return false;
+            Line = _vLines[It->second];
+            return true;
+        }
+
+        for (const string &Candidate : _vLines)
+        {
+            if (!Candidate.empty() && _KeysEqual(clsString::GetFieldView(Candidate, " || ", Column), Key))
+            {
+                Line = Candidate;
+                return true;
+            }
+        }
+        return false;
+    }
+
+    void Append(const string &Line) override
+    {
+        lock_guard<mutex> Lock(_Mutex);
+        _AppendLocked(Line);
+    }
+
+    void AppendAll(const vector<string> &vLines) override
+    {
+        lock_guard<mutex> Lock(_Mutex);
+        _vLines.reserve(_vLines.size() + vLines.size());
+        for (const string &Line : vLines)
+            _AppendLocked(Line);
+    }
+
+    bool Replace(string_view Key, const string &Line) override
+    {
+        lock_guard<mutex> Lock(_Mutex);
+        return _ReplaceLocked(Key, Line);
+    }
+
+    clsRecordVersion::enReplaceResult ReplaceIfVersion(string_view Key, short VersionColumn, unsigned long long ExpectedVersion,
+                                                       const string &Line, string &CurrentLine) override
+    {
+        lock_guard<mutex> Lock(_Mutex);
+
+        auto It = _Index.find(_NormalizedKey(Key));
+        if (It == _Index.end())
+            return clsRecordVersion::rrNotFound;
+
+        if (clsRecordVersion::Of(_vLines[It->second], VersionColumn) != ExpectedVersion)
+        {
+            CurrentLine = _vLines[It->second];
+            return clsRecordVersion::rrConflict;
+        }
+        _ReplaceLocked(Key, Line);
+        return clsRecordVersion::rrReplaced;
+    }
+
+    void ReplaceAll(const vector<string> &vLines) override
+    {
+        lock_guard<mutex> Lock(_Mutex);
+        _ReplaceAllLocked(vLines);
+    }
+
+    bool Rewrite(const function<bool(vector<string> &vLines)> &Edit) override
+    {
+        lock_guard<mutex> Lock(_Mutex);
+        vector<string> vLines;
+        vLines.reserve(_vLines.size() - _Deleted);
+        for (const string &Line : _vLines)
+        {
+            if (!Line.empty())
+                vLines.push_back(Line);
+        }
+
+        if (!Edit(vLines))
+            return false;
+        _ReplaceAllLocked(vLines);
+        return true;
+    }
+
+    bool Delete(string_view Key) override
+    {
+        lock_guard<mutex> Lock(_Mutex);
+
+        auto It = _Index.find(_NormalizedKey(Key));
+        if (It == _Index.end())
+            return false;
+
+        size_t Slot = It->second;
+        string DeletedKey = It->first;
+        _vLines[Slot].clear();
+        _Index.erase(It);
+        _IndexNextDuplicate(DeletedKey, Slot);
+        _Deleted++;
+        _CompactIfNeeded();
+        return true;
+    }
+
+    size_t Count()
+    {
+        lock_guard<mutex> Lock(_Mutex);
+        return _vLines.size() - _Deleted;
+    }
+};
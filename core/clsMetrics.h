@@ -0,0 +1,244 @@
+/*clsMetrics Overview
+================================================================================
+                                 clsMetrics.h
+================================================================================
+Overview:
+---------
+This file defines the clsMetrics class, the in-process latency registry for
+the core banking operations, and the SB_MEASURE instrumentation macro.
+
+Every operation in enOperation owns one clsLatencyHistogram. The set is fixed
+at compile time, so recording never looks anything up by name and never
+takes a lock:
+
+    static clsBankClient Find(const string &AccountNumber)
+    {
+        SB_MEASURE(ClientFind);      // times until the end of the scope
+        ...
+    }
+
+Nested operations are measured separately (Deposit includes its own Save(),
+which is also counted under ClientSave).
+
+Tasks of the shared thread pool (clsThreadPool) are timed through its task
+hook once MeasurePoolTasks() has been called: every task's run time goes to
+PoolTask (the pool creates no thread for it).
+
+================================================================================
+Compile-Time Switch:
+--------------------
+Build with -DSMARTBANK_DISABLE_METRICS to compile the instrumentation out
+entirely: SB_MEASURE expands to nothing, no clock is read, and the metrics
+screen reports that metrics are disabled.
+
+================================================================================
+Startup Budget:
+---------------
+main() calls MarkStartupComplete() once the storage is configured, before
+--shared attaches the shared account table (which reads Clients.txt) and
+before the first screen is drawn. The time from program start to that point
+is kept and shown on the metrics screen against StartupBudgetMs. Nothing
+before it reads a record with the text or memory backend (Global.h builds
+empty session objects), so the figure must not grow with the size of
+Clients.txt or Admins.text; a value over budget points at new start-up I/O.
+
+================================================================================
+Public Methods:
+---------------
+    static string OperationName(enOperation Operation)
+    static clsLatencyHistogram &Histogram(enOperation Operation)
+    static double SecondsSinceStart()
+    static void MarkStartupComplete()
+    static double StartupMilliseconds()   -1 until MarkStartupComplete()
+    static bool IsStartupWithinBudget()
+    static void MarkStartupComplete()
+    {
+        if (_StartupMilliseconds < 0)
+            _StartupMilliseconds = SecondsSinceStart() * 1000.0;
+    }
+
+    static double StartupMilliseconds()
+    {
+        return _StartupMilliseconds;
+    }
+
+    static bool IsStartupWithinBudget()
+    {
+        return _StartupMilliseconds >= 0 && _StartupMilliseconds <= StartupBudgetMs;
+    }
+
+    static void ResetAll()
+    static bool IsEnabled()
+    static void MeasurePoolTasks()      clsThreadPool task hook -> PoolTask
+
+    class clsScope          RAII timer used by SB_MEASURE
+
+================================================================================
+Usage Example:
+--------------
+    SB_MEASURE(ClientTransfer);
+
+    auto Snapshot = clsMetrics::Histogram(clsMetrics::ClientTransfer).GetSnapshot();
+    cout << Snapshot.Count << " transfers, p99 " << Snapshot.Percentile(99) / 1e6 << " ms";
+
+================================================================================
+*/
+
+#pragma once
+
+#include <string>
+#include <chrono>
+
+#include "../utils/clsLatencyHistogram.h" // utils/clsLatencyHistogram.h
+#include "../utils/clsThreadPool.h"       // utils/clsThreadPool.h
+
+using namespace std;
+
+class clsMetrics
+{
+public:
+    enum enOperation
+    {
+        ClientFind = 0,
+        ClientLogin,
+        ClientSave,
+        ClientDelete,
+        ClientDeposit,
+        ClientWithdraw,
+        ClientTransfer,
+        ClientTotalBalances,
+        AdminFind,
+        AdminLogin,
+        AdminSave,
+        AdminDelete,
+        CurrencyFindByCode,
+        CurrencyFindByCountry,
+        CurrencySave,
+        LoggerAppend,
+        LoggerQuery,
+        PoolTask,
+        OperationCount
+    };
+
+private:
+    static clsLatencyHistogram *_Histograms()
+    {
+        static clsLatencyHistogram Histograms[OperationCount];
+        return Histograms;
+    }
+
+    // set during static initialization, i.e. at program start
+    inline static const chrono::steady_clock::time_point _StartTime = chrono::steady_clock::now();
+
+    inline static double _StartupMilliseconds = -1;
+
+public:
+    static const int StartupBudgetMs = 50;
+
+    static string OperationName(enOperation Operation)
+    {
+        switch (Operation)
+        {
+        case ClientFind: return "Client Find";
+        case ClientLogin: return "Client Login (Find + PIN)";
+        case ClientSave: return "Client Save";
+        case ClientDelete: return "Client Delete";
+        case ClientDeposit: return "Client Deposit";
+        case ClientWithdraw: return "Client Withdraw";
+        case ClientTransfer: return "Client Transfer";
+        case ClientTotalBalances: return "Total Balances";
+        case AdminFind: return "Admin Find";
+        case AdminLogin: return "Admin Login (Find + Password)";
+        case AdminSave: return "Admin Save";
+        case AdminDelete: return "Admin Delete";
+        case CurrencyFindByCode: return "Currency Find By Code";
+        case CurrencyFindByCountry: return "Currency Find By Country";
+        case CurrencySave: return "Currency Save";
+        case LoggerAppend: return "Transaction Log Append";
+        case LoggerQuery: return "Transaction Log Query";
+        case PoolTask: return "Thread Pool Task";
+        default: return "Unknown";
+        }
+    }
+
+    static clsLatencyHistogram &Histogram(enOperation Operation)
+    {
+        return _Histograms()[Operation];
+    }
+
+    static double SecondsSinceStart()
+    {
+        return chrono::duration<double>(chrono::steady_clock::now() - _StartTime).count();
+    }
+
+    static void MarkStartupComplete()
+    {
+        if (_StartupMilliseconds < 0)
+            _StartupMilliseconds = SecondsSinceStart() * 1000.0;
+    }
+
+    static double StartupMilliseconds()
+    {
+        return _StartupMilliseconds;
+    }
+
+    static bool IsStartupWithinBudget()
+    {
+        return _StartupMilliseconds >= 0 && _StartupMilliseconds <= StartupBudgetMs;
+    }
+
+    static void ResetAll()
+    {
+        for (int i = 0; i < OperationCount; i++)
+            _Histograms()[i].Reset();
+    }
+
+    static bool IsEnabled()
+    {
+#ifdef SMARTBANK_DISABLE_METRICS
+        return false;
+#else
+        return true;
+#endif
+    }
+
+    static void MeasurePoolTasks()
+    {
+#ifndef SMARTBANK_DISABLE_METRICS
+        clsThreadPool::SetTaskHook([](const clsThreadPool::stTaskTiming &Timing)
+                                   { Histogram(PoolTask).Record(Timing.RunNanos); });
+#endif
+    }
+
+    class clsScope
+    {
+    private:
+        clsLatencyHistogram &_Histogram;
+        chrono::steady_clock::time_point _Start;
+
+    public:
+        explicit clsScope(enOperation Operation)
+            : _Histogram(Histogram(Operation)), _Start(chrono::steady_clock::now())
+        {
+        }
+
+        ~clsScope()
+        {
+            _Histogram.Record((unsigned long long)chrono::duration_cast<chrono::nanoseconds>(
+                                  chrono::steady_clock::now() - _Start)
+                                  .count());
+        }
+
+        clsScope(const clsScope &) = delete;
+        clsScope &operator=(const clsScope &) = delete;
+    };
+};
+
+#define SB_MEASURE_CONCAT_INNER(A, B) A##B
+#define SB_MEASURE_CONCAT(A, B) SB_MEASURE_CONCAT_INNER(A, B)
+
+#ifdef SMARTBANK_DISABLE_METRICS
+#define SB_MEASURE(Operation)
+#else
+#define SB_MEASURE(Operation) clsMetrics::clsScope SB_MEASURE_CONCAT(_MetricsScope, __LINE__)(clsMetrics::Operation)
+#endif
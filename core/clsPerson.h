@@ -103,25 +103,34 @@ private:
 
 public:
     // Constructor set private attributes
+    // (by value + move: callers passing temporaries or std::move pay no copy)
     clsPerson(string FirstName, string LastName, string Email, string Phone)
-        : _FirstName(FirstName), _LastName(LastName), _Email(Email), _Phone(Phone) {}
+        : _FirstName(move(FirstName)), _LastName(move(LastName)), _Email(move(Email)), _Phone(move(Phone)) {}
 
     clsPerson() {}
 
     // Setters
-    void SetFirstName(string FirstName) { _FirstName = FirstName; }
-    void SetLastName(string LastName) { _LastName = LastName; }
-    void SetEmail(string Email) { _Email = Email; }
-    void SetPhone(string Phone) { _Phone = Phone; }
+    void SetFirstName(string FirstName) { _FirstName = move(FirstName); }
+    void SetLastName(string LastName) { _LastName = move(LastName); }
+    void SetEmail(string Email) { _Email = move(Email); }
+    void SetPhone(string Phone) { _Phone = move(Phone); }
 
-    // Getters (const because they don't modify the object)
-    string GetFirstName() const { return _FirstName; }
-    string GetLastName() const { return _LastName; }
-    string GetEmail() const { return _Email; }
-    string GetPhone() const { return _Phone; }
+    // Getters (const because they don't modify the object, by reference: no copy)
+    const string &GetFirstName() const { return _FirstName; }
+    const string &GetLastName() const { return _LastName; }
+    const string &GetEmail() const { return _Email; }
+    const string &GetPhone() const { return _Phone; }
 
     // Full Name
-    string FullName() const { return _FirstName + " " + _LastName; }
+    string FullName() const
+    {
+        string Name;
+        Name.reserve(_FirstName.length() + 1 + _LastName.length());
+        Name += _FirstName;
+        Name += ' ';
+        Name += _LastName;
+        return Name;
+    }
 
     // Print Info
     void Print() const
@@ -0,0 +1,516 @@
+/*clsRecordFile Overview
+================================================================================
+                                clsRecordFile.h
+================================================================================
+Overview:
+---------
+This file defines the clsRecordFile class, the shared write path for the
+" || " record files (Clients.txt, Admins.text, Currencies.txt).
+
+It replaces "load everything, flag one object, rewrite everything" deletes
+with in-place tombstones, and reclaims the space later with a compactor that
+does not block readers or ATM transactions.
+
+================================================================================
+Tombstones:
+-----------
+Deleting a record overwrites its line, in place and with the same length, by
+
+    ~<spaces>
+
+so no other byte of the file moves. Every reader skips lines that start with
+the TombstoneMarker ('~'); IsTombstone() is the single check they use.
+
+The line is found in O(1): each process keeps a key -> byte offset index of
+the file (built by one scan on the first delete, extended by reading only the
+lines appended since). The line at the offset is checked before it is
+overwritten, and the index is rebuilt when another process tombstoned or
+rewrote the file (the generation in the lock file changed).
+
+================================================================================
+Other Processes:
+----------------
+Every write holds "<file>.lock" (clsFileLock) after this process's own
+mutex, so appends, rewrites, tombstones and compactions of all processes on
+one data root take turns. Tombstones and rewrites bump the lock file's
+generation counter.
+
+================================================================================
+Compaction:
+-----------
+Every delete also measures the garbage ratio of the file
+(tombstone bytes / file bytes). When it crosses CompactionGarbageRatio the file
+is compacted, as a background task of the shared thread pool (clsThreadPool)
+by default:
+
+1. Remember the file generation and size (short lock, both locks).
+2. Copy all live lines into "<file>.compact.<pid>" without holding the locks, so
+   Find(), ATM withdrawals and appends continue normally.
+3. Re-take both locks. If the file was rewritten or tombstoned meanwhile, by
+   this process or another one (generation changed), the work is dropped and
+   retried on a later delete. Otherwise the lines appended since step 1 are
+   copied over and the new file replaces the old one with a single rename.
+
+Full rewrites (ReplaceAll) are also written to a temporary file and renamed,
+so readers always see either the old or the new file, never half of one.
+
+================================================================================
+Public Methods:
+---------------
+    static bool IsTombstone(const string& Line)
+    static void AppendLine(const string& Path, const string& Line)
+    static void AppendLines(const string& Path, const vector<string>& vLines)
+    static void ReplaceAll(const string& Path, const vector<string>& vLines)
+    static bool Rewrite(const string& Path, Edit)   read + edit + rewrite under one lock
+    static bool MarkDeleted(const string& Path, short KeyColumn, const string& Key, const string& Separator = " || ")
+    static bool Compact(const string& Path)
+
+Settings:
+    CompactionGarbageRatio (default 0.30)
+    BackgroundCompaction   (default true)
+
+================================================================================
+*/
+
+#pragma once
+
+#include <iostream>
+#include <fstream>
+#include <string>
+#include <vector>
+#include <map>
+#include <unordered_map>
+#include <mutex>
+#include <functional>
+#include <cstdio>
+#include <filesystem>
+
+#include "../utils/clsString.h"     // utils/clsString.h
+#include "../utils/clsThreadPool.h" // utils/clsThreadPool.h
+#include "../utils/clsFileLock.h"   // utils/clsFileLock.h
+
+using namespace std;
+
+class clsRecordFile
+{
+public:
+    static const char TombstoneMarker = '~';
+
+    inline static double CompactionGarbageRatio = 0.30;
+    inline static bool BackgroundCompaction = true;
+
+private:
+    struct stFileState
+    {
+        mutex WriteMutex;
+        unsigned long long Generation = 0; // bumped by every in-place change or rewrite
+        bool CompactionRunning = false;
+
+        // MarkDeleted() index: key -> offset of the first live line with it
+        unordered_map<string, long long> Offsets;
+        short IndexedColumn = -1;
+        string IndexedSeparator;
+        long long IndexedBytes = -1;              // file bytes the index covers, -1 = none
+        unsigned long long IndexedGeneration = 0; // lock file generation it was built at
+        long long GarbageBytes = 0;               // tombstone bytes in the indexed part
+        bool DuplicateKeys = false;               // a key has more than one live line
+    };
+
+    static stFileState &_State(const string &Path)
+    {
+        static mutex MapMutex;
+        static map<string, stFileState> States;
+
+        lock_guard<mutex> Lock(MapMutex);
+        return States[Path]; // std::map never moves its elements
+    }
+
+    static string _LockPath(const string &Path)
+    {
+        // "../data/Clients.txt" -> "../data/Clients.lock"
+        size_t Dot = Path.find_last_of('.');
+        size_t Slash = Path.find_last_of("/\\");
+        if (Dot == string::npos || (Slash != string::npos && Dot < Slash))
+            return Path + ".lock";
+        return Path.substr(0, Dot) + ".lock";
+    }
+
+    static string _CompactPath(const string &Path)
+    {
+        // one per process: compactors of two processes copy at the same time
+#ifdef _WIN32
+        return Path + ".compact." + to_string(GetCurrentProcessId());
+#else
+        return Path + ".compact." + to_string(getpid());
+#endif
+    }
+
+    static bool _ReplaceFile(const string &TempPath, const string &Path)
+    {
+        error_code Error;
+        filesystem::rename(TempPath, Path, Error);
+        if (!Error)
+            return true;
+
+        // Some platforms refuse to rename over a file that is open by a reader:
+        // fall back to copying the content over the original.
+        ifstream Source(TempPath, ios::in | ios::binary);
+        ofstream Target(Path, ios::out | ios::binary | ios::trunc);
+        if (!Source.is_open() || !Target.is_open())
+            return false;
+
+        Target << Source.rdbuf();
+        Source.close();
+        Target.close();
+        filesystem::remove(TempPath, Error);
+        return true;
+    }
+
+    static void _Changed(stFileState &State, clsFileLock &FileLock)
+    {
+        // a rewrite: offsets moved, other processes must notice
+        State.Generation++;
+        State.IndexedBytes = -1;
+        State.Offsets.clear();
+        FileLock.BumpGeneration();
+    }
+
+    static void _WriteAllLocked(stFileState &State, clsFileLock &FileLock, const string &Path, const vector<string> &vLines)
+    {
+        // caller holds State.WriteMutex and the file lock
+        string TempPath = Path + ".tmp";
+        fstream MyFile(TempPath, ios::out | ios::binary | ios::trunc);
+        if (!MyFile.is_open())
+            return;
+
+        for (const string &Line : vLines)
+        {
+            if (!IsTombstone(Line))
+                MyFile << Line << '\n';
+        }
+        MyFile.close();
+
+        _ReplaceFile(TempPath, Path);
+        _Changed(State, FileLock);
+    }
+
+    static void _IndexFrom(stFileState &State, const string &Path, long long From, long long To)
+    {
+        // add the lines in [From, To) to the index
+        ifstream MyFile(Path, ios::in | ios::binary);
+        if (!MyFile.is_open())
+            return;
+        MyFile.seekg(From);
+
+        string Line;
+        long long Offset = From;
+        while (Offset < To && getline(MyFile, Line))
+        {
+            size_t LineBytes = Line.size() + 1;
+            size_t Length = Line.size();
+            if (Length > 0 && Line[Length - 1] == '\r')
+                Length--;
+
+            if (IsTombstone(Line))
+                State.GarbageBytes += (long long)LineBytes;
+            else if (Length > 0)
+            {
+                string_view Key = clsString::GetFieldView(string_view(Line.data(), Length), State.IndexedSeparator, State.IndexedColumn);
+                if (!State.Offsets.emplace(string(Key), Offset).second)
+                    State.DuplicateKeys = true; // the first line wins, like a scan
+            }
+            Offset += (long long)LineBytes;
+        }
+    }
+
+    static long long _RefreshIndex(stFileState &State, clsFileLock &FileLock, const string &Path,
+                                   short KeyColumn, const string &Separator)
+    {
+        // The index covers the whole file when this returns (the file size).
+        // Rebuilt when the key column changed or the file was rewritten or
+        // tombstoned by another process; otherwise only appended lines are read.
+        long long Bytes = 0;
+        {
+            ifstream Probe(Path, ios::in | ios::binary | ios::ate);
+            if (!Probe.is_open())
+                return -1;
+            Bytes = (long long)Probe.tellg();
+        }
+
+        unsigned long long Generation = FileLock.GetGeneration();
+        if (State.IndexedBytes < 0 || State.IndexedColumn != KeyColumn || State.IndexedSeparator != Separator ||
+            State.IndexedGeneration != Generation || Bytes < State.IndexedBytes)
+        {
+            State.Offsets.clear();
+            State.IndexedColumn = KeyColumn;
+            State.IndexedSeparator = Separator;
+            State.IndexedGeneration = Generation;
+            State.IndexedBytes = 0;
+            State.GarbageBytes = 0;
+            State.DuplicateKeys = false;
+        }
+
+        if (Bytes > State.IndexedBytes)
+            _IndexFrom(State, Path, State.IndexedBytes, Bytes);
+        State.IndexedBytes = Bytes;
+        return Bytes;
+    }
+
+    static void _CompactInBackground(const string &Path)
+    {
+        stFileState &State = _State(Path);
+        {
+            lock_guard<mutex> Lock(State.WriteMutex);
+            if (State.CompactionRunning)
+                return;
+            State.CompactionRunning = true;
+        }
+
+        if (BackgroundCompaction)
+        {
+            clsThreadPool::Shared().Submit([Path]()
+                                           { Compact(Path); }, "RecordFileCompaction");
+        }
+        else
+        {
+            Compact(Path);
+        }
+    }
+
+public:
+    static bool IsTombstone(const string &Line)
+    {
+        return !Line.empty() && Line[0] == TombstoneMarker;
+    }
+
+    //---------------------------------------------
+    // Writes
+    //---------------------------------------------
+    static void AppendLine(const string &Path, const string &Line)
+    {
+        stFileState &State = _State(Path);
+        lock_guard<mutex> Lock(State.WriteMutex);
+        clsFileLock FileLock(_LockPath(Path));
+
+        fstream MyFile(Path, ios::out | ios::app | ios::binary);
+        if (MyFile.is_open())
+        {
+            MyFile << Line << '\n';
+            MyFile.close();
+        }
+    }
+
+    static void AppendLines(const string &Path, const vector<string> &vLines)
+    {
+        // Bulk append: all lines are joined in memory and written with one
+        // open / write / close under the file lock (bulk imports, batches).
+        if (vLines.empty())
+            return;
+
+        size_t Bytes = 0;
+        for (const string &Line : vLines)
+            Bytes += Line.size() + 1;
+
+        string Buffer;
+        Buffer.reserve(Bytes);
+        for (const string &Line : vLines)
+        {
+            Buffer += Line;
+            Buffer += '\n';
+        }
+
+        stFileState &State = _State(Path);
+        lock_guard<mutex> Lock(State.WriteMutex);
+        clsFileLock FileLock(_LockPath(Path));
+
+        fstream MyFile(Path, ios::out | ios::app | ios::binary);
+        if (MyFile.is_open())
+        {
+            MyFile.write(Buffer.data(), (streamsize)Buffer.size());
+            MyFile.close();
+        }
+    }
+
+    static void ReplaceAll(const string &Path, const vector<string> &vLines)
+    {
+        // Rewrite the whole file through a temporary file + rename.
+        // Tombstones are not carried over, so a rewrite is also a compaction.
+        stFileState &State = _State(Path);
+        lock_guard<mutex> Lock(State.WriteMutex);
+        clsFileLock FileLock(_LockPath(Path));
+        _WriteAllLocked(State, FileLock, Path, vLines);
+    }
+
+    static bool Rewrite(const string &Path, const function<bool(vector<string> &vLines)> &Edit)
+    {
+        // Rewrite process steps (both locks from read to rename, so no other
+        // write of any process lands between them):
+        // 1. Read the live lines.
+        // 2. Edit() changes them and returns true when the file must be written.
+        // 3. Write them back through a temporary file + rename.
+        stFileState &State = _State(Path);
+        lock_guard<mutex> Lock(State.WriteMutex);
+        clsFileLock FileLock(_LockPath(Path));
+
+        ifstream MyFile(Path, ios::in | ios::binary);
+        if (!MyFile.is_open())
+            return false;
+
+        vector<string> vLines;
+        string Line;
+        while (getline(MyFile, Line))
+        {
+            if (!Line.empty() && !IsTombstone(Line))
+                vLines.push_back(move(Line));
+        }
+        MyFile.close();
+
+        if (!Edit(vLines))
+            return false;
+
+        _WriteAllLocked(State, FileLock, Path, vLines);
+        return true;
+    }
+
+    static bool MarkDeleted(const string &Path, short KeyColumn, const string &Key, const string &Separator = " || ")
+    {
+        // MarkDeleted process steps:
+        // 1. Bring the key -> offset index up to date (_RefreshIndex(): a scan
+        //    only the first time or after another process's rewrite).
+        // 2. Look the key up and check that the line at its offset still holds
+        //    it (otherwise the index is rebuilt once and looked up again).
+        // 3. Overwrite that line in place with "~" + spaces (same length).
+        // 4. If tombstones now exceed CompactionGarbageRatio, start the compactor.
+        stFileState &State = _State(Path);
+        long long GarbageBytes = 0;
+        long long FileBytes = 0;
+        bool Found = false;
+
+        {
+            lock_guard<mutex> Lock(State.WriteMutex);
+            clsFileLock FileLock(_LockPath(Path));
+
+            for (int Attempt = 0; Attempt < 2 && !Found; Attempt++)
+            {
+                FileBytes = _RefreshIndex(State, FileLock, Path, KeyColumn, Separator);
+                if (FileBytes < 0)
+                    return false;
+
+                auto It = State.Offsets.find(Key);
+                if (It == State.Offsets.end())
+                    break;
+
+                fstream MyFile(Path, ios::in | ios::out | ios::binary);
+                if (!MyFile.is_open())
+                    return false;
+
+                string Line;
+                MyFile.seekg(It->second);
+                getline(MyFile, Line);
+                size_t Length = Line.size();
+                if (Length > 0 && Line[Length - 1] == '\r')
+                    Length--;
+
+                if (IsTombstone(Line) || Length == 0 ||
+                    clsString::GetFieldView(string_view(Line.data(), Length), Separator, KeyColumn) != Key)
+                {
+                    State.IndexedBytes = -1; // stale: rebuild and try once more
+                    continue;
+                }
+
+                MyFile.clear();
+                MyFile.seekp(It->second);
+                string Tombstone(Length, ' ');
+                Tombstone[0] = TombstoneMarker;
+                MyFile.write(Tombstone.data(), (streamsize)Tombstone.size());
+                MyFile.close();
+
+                State.Offsets.erase(It);
+                State.GarbageBytes += (long long)Length + 1;
+                State.Generation++;
+                State.IndexedGeneration = FileLock.BumpGeneration();
+                if (State.DuplicateKeys)
+                    State.IndexedBytes = -1; // a later line may hold the key now
+                Found = true;
+            }
+            GarbageBytes = State.GarbageBytes;
+        }
+
+        if (Found && FileBytes > 0 && (double)GarbageBytes / (double)FileBytes >= CompactionGarbageRatio)
+            _CompactInBackground(Path);
+
+        return Found;
+    }
+
+    //---------------------------------------------
+    // Compaction
+    //---------------------------------------------
+    static bool Compact(const string &Path)
+    {
+        stFileState &State = _State(Path);
+        unsigned long long StartGeneration;
+        unsigned long long StartFileGeneration;
+        long long StartBytes = 0;
+
+        {
+            lock_guard<mutex> Lock(State.WriteMutex);
+            clsFileLock FileLock(_LockPath(Path));
+            State.CompactionRunning = true;
+            StartGeneration = State.Generation;
+            StartFileGeneration = FileLock.GetGeneration();
+
+            ifstream Probe(Path, ios::in | ios::binary | ios::ate);
+            if (Probe.is_open())
+                StartBytes = (long long)Probe.tellg();
+        }
+
+        // Step 2: copy live lines without holding the locks
+        string TempPath = _CompactPath(Path);
+        {
+            ifstream Source(Path, ios::in | ios::binary);
+            ofstream Target(TempPath, ios::out | ios::binary | ios::trunc);
+            if (!Source.is_open() || !Target.is_open())
+            {
+                lock_guard<mutex> Lock(State.WriteMutex);
+                State.CompactionRunning = false;
+                return false;
+            }
+
+            string Line;
+            long long Offset = 0;
+            while (Offset < StartBytes && getline(Source, Line))
+            {
+                Offset += (long long)Line.size() + 1;
+                if (!Line.empty() && !IsTombstone(Line))
+                    Target << Line << '\n';
+            }
+        }
+
+        // Step 3: swap in the compacted file unless any process tombstoned or
+        // rewrote the original meanwhile (appends are carried over)
+        lock_guard<mutex> Lock(State.WriteMutex);
+        clsFileLock FileLock(_LockPath(Path));
+        State.CompactionRunning = false;
+
+        if (State.Generation != StartGeneration || FileLock.GetGeneration() != StartFileGeneration)
+        {
+            error_code Error;
+            filesystem::remove(TempPath, Error);
+            return false;
+        }
+
+        {
+            ifstream Source(Path, ios::in | ios::binary);
+            ofstream Target(TempPath, ios::out | ios::binary | ios::app);
+            if (Source.is_open() && Target.is_open())
+            {
+                Source.seekg(StartBytes);
+                Target << Source.rdbuf(); // lines appended while we were copying
+            }
+        }
+
+        bool Replaced = _ReplaceFile(TempPath, Path);
+        _Changed(State, FileLock);
+        return Replaced;
+    }
+};
@@ -0,0 +1,135 @@
+/*clsRecordStore Overview
+================================================================================
+                               clsRecordStore.h
+================================================================================
+Overview:
+---------
+This file defines clsRecordStore, the storage interface behind clsBankClient,
+clsAdmin and clsCurrency. A store holds the " || " record lines of one entity
+(the same lines the classes already build and parse); how and where they are
+kept is up to the implementation:
+
+    clsTextRecordStore    the text files under the data root (default)
+    clsMemoryRecordStore  lines in memory, hash index (tests, benchmarks)
+    clsBinaryRecordStore  binary record file with an in-memory hash index
+    clsSqliteRecordStore  a table in SmartBank.db (SMARTBANK_WITH_SQLITE builds)
+
+clsStorage creates one store per entity for the configured backend; the
+classes only talk to clsStorage::Clients(), Admins() and Currencies().
+
+================================================================================
+Keys:
+-----
+Every store is created with the column that identifies a record
+(KeyColumn) and whether keys compare case-insensitively (IgnoreCase, used for
+currency codes). Find() on KeyColumn can use an index; Find() on any other
+column scans. Keys are unique: Append() of an existing key is the caller's
+mistake, like it was with the text files.
+
+================================================================================
+Public Methods:
+---------------
+    virtual string BackendName() const
+    virtual void ForEach(Visitor)                       live lines, stops when Visitor returns true
+    virtual bool Find(short Column, string_view Key, string &Line)
+    virtual void Append(const string &Line)
+    virtual void AppendAll(const vector<string> &vLines)
+    virtual bool Replace(string_view Key, const string &Line)     record with that key
+    virtual enReplaceResult ReplaceIfVersion(Key, VersionColumn, ExpectedVersion, Line, CurrentLine)
+                                                        compare-and-swap on the version column
+                                                        (clsRecordVersion); on rrConflict
+                                                        CurrentLine is the stored line
+    virtual void ReplaceAll(const vector<string> &vLines)
+    virtual bool Rewrite(Edit)                          read + Edit + write back under one
+                                                        lock (file lock / transaction);
+                                                        Edit returns false to write nothing
+    virtual bool Delete(string_view Key)
+
+    vector<string> ReadAll()
+    short GetKeyColumn() const / bool IsIgnoreCase() const
+
+================================================================================
+Usage Example:
+--------------
+    string Line;
+    if (clsStorage::Clients().Find(4, "A101", Line))
+        Client = _ConvertLinetoClientObject(Line);
+
+================================================================================
+*/
+
+#pragma once
+
+#include <string>
+#include <string_view>
+#include <vector>
+#include <functional>
+
+#include "../utils/clsString.h" // utils/clsString.h
+#include "clsRecordVersion.h"      // core/clsRecordVersion.h
+
+using namespace std;
+
+class clsRecordStore
+{
+protected:
+    short _KeyColumn;
+    bool _IgnoreCase;
+
+    bool _KeysEqual(string_view Left, string_view Right) const
+    {
+        return _IgnoreCase ? clsString::EqualsIgnoreCase(Left, Right) : Left == Right;
+    }
+
+    string _NormalizedKey(string_view Key) const
+    {
+        // index form of a key: upper case when keys ignore case
+        string Normalized(Key);
+        if (_IgnoreCase)
+        {
+            for (char &Ch : Normalized)
+                Ch = (char)toupper((unsigned char)Ch);
+        }
+        return Normalized;
+    }
+
+    string_view _KeyOf(string_view Line) const
+    {
+        return clsString::GetFieldView(Line, " || ", _KeyColumn);
+    }
+
+public:
+    clsRecordStore(short KeyColumn, bool IgnoreCase) : _KeyColumn(KeyColumn), _IgnoreCase(IgnoreCase)
+    {
+    }
+
+    virtual ~clsRecordStore() {}
+
+    virtual string BackendName() const = 0;
+
+    virtual void ForEach(const function<bool(const string &Line)> &Visitor) = 0;
+    virtual bool Find(short Column, string_view Key, string &Line) = 0;
+
+    virtual void Append(const string &Line) = 0;
+    virtual void AppendAll(const vector<string> &vLines) = 0;
+    virtual bool Replace(string_view Key, const string &Line) = 0;
+    virtual clsRecordVersion::enReplaceResult ReplaceIfVersion(string_view Key, short VersionColumn,
+                                                               unsigned long long ExpectedVersion,
+                                                               const string &Line, string &CurrentLine) = 0;
+    virtual void ReplaceAll(const vector<string> &vLines) = 0;
+    virtual bool Rewrite(const function<bool(vector<string> &vLines)> &Edit) = 0;
+    virtual bool Delete(string_view Key) = 0;
+
+    vector<string> ReadAll()
+    {
+        vector<string> vLines;
+        ForEach([&vLines](const string &Line)
+                {
+                    vLines.push_back(Line);
+                    return false; });
+        return vLines;
+    }
+
+    short GetKeyColumn() const { return _KeyColumn; }
+    bool IsIgnoreCase() const { return _IgnoreCase; }
+};
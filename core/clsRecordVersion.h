@@ -0,0 +1,116 @@
+/*clsRecordVersion Overview
+================================================================================
+                              clsRecordVersion.h
+================================================================================
+Overview:
+---------
+This file defines clsRecordVersion, the helpers behind optimistic concurrency
+for client and admin records.
+
+Every client and admin line ends with a version column:
+
+    ... || Balance || Version         (Clients.txt, column 7)
+    ... || Permissions || Version     (Admins.text, column 7)
+
+- A new record starts at version 1; lines written before the column existed
+  read as version 0 (the column is simply missing).
+- Every write of a record stores Version + 1.
+- An object remembers the version it was read with. Save() is a
+  compare-and-swap: the store replaces the line only when the stored version
+  is still the one the object was read with
+  (clsRecordStore::ReplaceIfVersion), otherwise it reports a conflict and
+  hands back the current line, so the caller refreshes from it without a
+  second read.
+- No lock is held between reading a record and saving it (user think-time);
+  only the compare-and-replace itself is done under the store's lock.
+
+================================================================================
+Public Methods:
+---------------
+    static unsigned long long Of(string_view Line, short VersionColumn)
+    static string WithField(string_view Line, short Column, string_view Value)
+    static string WithVersion(string_view Line, short VersionColumn, unsigned long long Version)
+
+    enum enReplaceResult { rrReplaced, rrNotFound, rrConflict }
+
+================================================================================
+Usage Example:
+--------------
+    string Current;
+    switch (clsStorage::Clients().ReplaceIfVersion("A101", clsStorage::ClientsVersionColumn,
+                                                   Version, NewLine, Current))
+    {
+    case clsRecordVersion::rrConflict:   // someone saved first: refresh from Current
+        ...
+    }
+
+================================================================================
+*/
+
+#pragma once
+
+#include <string>
+#include <string_view>
+#include <cstdlib>
+
+#include "../utils/clsString.h" // utils/clsString.h
+
+using namespace std;
+
+class clsRecordVersion
+{
+public:
+    enum enReplaceResult
+    {
+        rrReplaced = 0,
+        rrNotFound = 1,
+        rrConflict = 2 // the stored version is not the expected one; nothing written
+    };
+
+    static unsigned long long Of(string_view Line, short VersionColumn)
+    {
+        // missing column (older line) -> 0
+        string_view Field = clsString::GetFieldView(Line, " || ", VersionColumn);
+        if (Field.empty())
+            return 0;
+        return strtoull(string(Field).c_str(), nullptr, 10);
+    }
+
+    static string WithField(string_view Line, short Column, string_view Value)
+    {
+        // Line with field Column replaced by Value; a line with fewer fields
+        // gets empty fields up to Column (an older line gains its version column)
+        string Result;
+        Result.reserve(Line.size() + Value.size() + 8);
+
+        size_t Start = 0;
+        short Field = 0;
+        while (Field < Column)
+        {
+            size_t Separator = Line.find(" || ", Start);
+            if (Separator == string_view::npos)
+            {
+                Result.append(Line);
+                for (; Field < Column; Field++)
+                    Result += " || ";
+                Result.append(Value);
+                return Result;
+            }
+            Start = Separator + 4;
+            Field++;
+        }
+
+        Result.append(Line.substr(0, Start));
+        Result.append(Value);
+
+        size_t End = Line.find(" || ", Start);
+        if (End != string_view::npos)
+            Result.append(Line.substr(End));
+        return Result;
+    }
+
+    static string WithVersion(string_view Line, short VersionColumn, unsigned long long Version)
+    {
+        return WithField(Line, VersionColumn, to_string(Version));
+    }
+};
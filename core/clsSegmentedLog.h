@@ -0,0 +1,797 @@
+/*clsSegmentedLog Overview
+================================================================================
+                              clsSegmentedLog.h
+================================================================================
+Overview:
+---------
+This file defines the clsSegmentedLog class, which turns the ever-growing log
+files (AllTransactions.txt, ClientsSessionLog.txt, AdminsSessionLog.txt) into
+a series of time-based segments described by a small manifest file.
+
+The "active" segment is always the original file (e.g. AllTransactions.txt),
+so new lines are appended exactly where they always were. When the active
+segment starts a new day, or grows past MaxSegmentBytes, it is closed:
+
+- Its lines are moved into a numbered segment file next to it.
+- The closed segment is compressed (clsCompressor) and check-summed (CRC-32).
+- One line describing it is added to the manifest.
+- The active file starts empty again.
+
+================================================================================
+Crash Safety And Other Processes:
+---------------------------------
+Appends and rotations hold "<log>.lock" (clsFileLock), so every process
+appending to the same log takes turns, and each one notices a rotation done
+by another (the active file and manifest sizes are checked on every append).
+
+A rotation is journaled, so a crash at any step is finished or undone by the
+next process that touches the log:
+
+1. "<log>.rotating" records the segment number, the rotated byte count of the
+   active file and their CRC-32 (written atomically).
+2. The segment is written to a temporary file, synced and renamed.
+3. The manifest is replaced (temporary file + sync + rename): the commit.
+4. The active file is truncated and synced; the journal is removed.
+
+Readers take the lock only to load the manifest and the active file together
+(_ReadView), then visit the lines without it: a rotation moves lines from the
+active file into a segment and the manifest, so reading the two at different
+moments could skip or repeat them. Closed segments never change.
+
+Recovery: journal present and segment in the manifest -> the rotated bytes
+are cut from the front of the active file if still there (truncate
+finished); segment not in the manifest -> the segment file is deleted and
+the active file is left alone (rotation undone). No line is ever lost or
+counted twice.
+
+================================================================================
+Files On Disk:
+--------------
+For the active file "../data/AllTransactions.txt":
+
+    ../data/AllTransactions.txt             <- active (hot) segment
+    ../data/AllTransactions.manifest        <- one line per closed segment
+    ../data/AllTransactions.lock            <- cross-process lock (empty)
+    ../data/AllTransactions.rotating        <- only while a rotation runs
+    ../data/AllTransactions.000001.seg      <- closed segment (compressed)
+    ../data/AllTransactions.000002.seg      ...
+
+Manifest line format:
+
+    Seq#//#FirstDate#//#LastDate#//#Lines#//#RawBytes#//#Crc32#//#Compressed#//#FileName
+
+Dates are stored as yyyymmdd keys so range checks are integer compares.
+
+================================================================================
+Query Model:
+------------
+- ForEachLine(Path, Visitor, FromDateKey, ToDateKey)
+    Visits lines oldest -> newest. Closed segments whose [FirstDate, LastDate]
+    does not intersect the requested range are skipped without being opened.
+
+- ForEachLineNewestFirst(Path, Visitor)
+    Visits the active segment first, then closed segments newest -> oldest,
+    and stops as soon as the visitor returns true. "Last login" style lookups
+    therefore touch only the most recent segment in the common case.
+
+Full history is always available: a query without a range visits everything.
+
+- GetEndPosition(Path) / ForEachLineAfter(Path, Position, Visitor)
+    Remembers where the log ends now, and later visits only the lines written
+    after that point (clsSnapshot replays the transaction log tail this way).
+
+- AppendLines(Path, vLines)
+    Group commit: many lines are written with one lock and one open/write
+    per segment they land in (batch postings), instead of one per line.
+
+================================================================================
+Policy (static settings):
+-------------------------
+- MaxSegmentBytes         : size limit of the active segment (default 4 MB).
+- CompressClosedSegments  : compress closed segments (default true).
+- VerifyChecksums         : verify CRC-32 when reading a closed segment (default true).
+
+================================================================================
+Usage Example:
+--------------
+    clsSegmentedLog::AppendLine("../data/AllTransactions.txt", Line);
+
+    clsSegmentedLog::ForEachLine("../data/AllTransactions.txt",
+        [](const string &Line) { cout << Line << endl; },
+        clsSegmentedLog::DateKey("1/11/2025"), clsSegmentedLog::DateKey("30/11/2025"));
+
+================================================================================
+*/
+
+#pragma once
+
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <map>
+#include <mutex>
+#include <climits>
+#include <cstdio>
+#include <functional>
+#include <filesystem>
+
+#include "../utils/clsString.h"      // utils/clsString.h
+#include "../utils/clsCompressor.h"  // utils/clsCompressor.h
+#include "../utils/clsFileLock.h"    // utils/clsFileLock.h
+#include "../utils/clsDurableFile.h" // utils/clsDurableFile.h
+
+using namespace std;
+
+class clsSegmentedLog
+{
+public:
+    struct stSegmentInfo
+    {
+        int Seq = 0;
+        int FirstDateKey = 0;
+        int LastDateKey = 0;
+        long long Lines = 0;
+        long long RawBytes = 0;
+        unsigned int Checksum = 0;
+        bool Compressed = false;
+        string FileName;
+    };
+
+    struct stLogPosition
+    {
+        // end of the log at some moment: last closed segment + active file size
+        int ClosedSeq = 0;
+        long long ActiveBytes = 0;
+    };
+
+    // Policy
+    inline static size_t MaxSegmentBytes = 4 * 1024 * 1024;
+    inline static bool CompressClosedSegments = true;
+    inline static bool VerifyChecksums = true;
+
+private:
+    struct stActiveState
+    {
+        bool Loaded = false;
+        int FirstDateKey = 0; // date of the first line in the active segment (0 = empty)
+        long long Bytes = 0;
+        long long ManifestBytes = 0; // a rotation by any process changes it
+    };
+
+    struct stReadView
+    {
+        vector<stSegmentInfo> vSegments; // closed segments, oldest first
+        string ActiveRaw;                // the active file at the same moment
+    };
+
+    static mutex &_Mutex()
+    {
+        static mutex Mutex;
+        return Mutex;
+    }
+
+    static map<string, stActiveState> &_ActiveStates()
+    {
+        static map<string, stActiveState> States;
+        return States;
+    }
+
+    static string _BasePath(const string &ActivePath)
+    {
+        // "../data/AllTransactions.txt" -> "../data/AllTransactions"
+        size_t Dot = ActivePath.find_last_of('.');
+        size_t Slash = ActivePath.find_last_of("/\\");
+        if (Dot == string::npos || (Slash != string::npos && Dot < Slash))
+            return ActivePath;
+        return ActivePath.substr(0, Dot);
+    }
+
+    static string _DirectoryOf(const string &Path)
+    {
+        size_t Slash = Path.find_last_of("/\\");
+        return (Slash == string::npos) ? "" : Path.substr(0, Slash + 1);
+    }
+
+    static string _ManifestPath(const string &ActivePath)
+    {
+        return _BasePath(ActivePath) + ".manifest";
+    }
+
+    static string _LockPath(const string &ActivePath)
+    {
+        return _BasePath(ActivePath) + ".lock";
+    }
+
+    static string _JournalPath(const string &ActivePath)
+    {
+        return _BasePath(ActivePath) + ".rotating";
+    }
+
+    static long long _FileBytes(const string &Path)
+    {
+        error_code Error;
+        uintmax_t Bytes = filesystem::file_size(Path, Error);
+        return Error ? 0 : (long long)Bytes;
+    }
+
+    static string _SegmentFileName(const string &ActivePath, int Seq)
+    {
+        // file name only, the manifest stores it relative to the data folder
+        string Base = _BasePath(ActivePath);
+        size_t Slash = Base.find_last_of("/\\");
+        if (Slash != string::npos)
+            Base = Base.substr(Slash + 1);
+
+        char SeqBuffer[16];
+        snprintf(SeqBuffer, sizeof(SeqBuffer), "%06d", Seq);
+        return Base + "." + SeqBuffer + ".seg";
+    }
+
+    static string _ReadWholeFile(const string &Path)
+    {
+        ifstream MyFile(Path, ios::in | ios::binary);
+        if (!MyFile.is_open())
+            return "";
+
+        ostringstream Buffer;
+        Buffer << MyFile.rdbuf();
+        return Buffer.str();
+    }
+
+    static void _SplitLines(const string &Text, vector<string> &vLines)
+    {
+        size_t Start = 0;
+        while (Start < Text.size())
+        {
+            size_t End = Text.find('\n', Start);
+            if (End == string::npos)
+                End = Text.size();
+
+            size_t Length = End - Start;
+            if (Length > 0 && Text[Start + Length - 1] == '\r')
+                Length--;
+            if (Length > 0)
+                vLines.push_back(Text.substr(Start, Length));
+
+            Start = End + 1;
+        }
+    }
+
+    static int _LineDateKey(const string &Line)
+    {
+        // every log line starts with "d/m/yyyy#//#"
+        size_t End = Line.find("#//#");
+        return DateKey(End == string::npos ? Line : Line.substr(0, End));
+    }
+
+    static stSegmentInfo _ParseManifestLine(const string &Line)
+    {
+        vector<string> vData = clsString::Split(Line, "#//#");
+        stSegmentInfo Info;
+        if (vData.size() < 8)
+            return Info;
+
+        Info.Seq = stoi(vData[0]);
+        Info.FirstDateKey = stoi(vData[1]);
+        Info.LastDateKey = stoi(vData[2]);
+        Info.Lines = stoll(vData[3]);
+        Info.RawBytes = stoll(vData[4]);
+        Info.Checksum = (unsigned int)stoul(vData[5]);
+        Info.Compressed = (vData[6] == "1");
+        Info.FileName = vData[7];
+        return Info;
+    }
+
+    static string _ConvertSegmentInfoToLine(const stSegmentInfo &Info)
+    {
+        return to_string(Info.Seq) + "#//#" +
+               to_string(Info.FirstDateKey) + "#//#" +
+               to_string(Info.LastDateKey) + "#//#" +
+               to_string(Info.Lines) + "#//#" +
+               to_string(Info.RawBytes) + "#//#" +
+               to_string(Info.Checksum) + "#//#" +
+               (Info.Compressed ? "1" : "0") + "#//#" +
+               Info.FileName;
+    }
+
+    static stActiveState &_LoadActiveState(const string &ActivePath)
+    {
+        // Caller holds _Mutex() and the log's file lock.
+        // The cached state is used while the active file and the manifest
+        // still have the sizes this process left them with; any other
+        // process's append or rotation changes one of them and the state is
+        // read again (first line and size of the active segment).
+        _RecoverLocked(ActivePath);
+
+        stActiveState &State = _ActiveStates()[ActivePath];
+        long long Bytes = _FileBytes(ActivePath);
+        long long ManifestBytes = _FileBytes(_ManifestPath(ActivePath));
+        if (State.Loaded && State.Bytes == Bytes && State.ManifestBytes == ManifestBytes)
+            return State;
+
+        State.Loaded = true;
+        State.FirstDateKey = 0;
+        State.Bytes = Bytes;
+        State.ManifestBytes = ManifestBytes;
+
+        ifstream MyFile(ActivePath, ios::in | ios::binary);
+        if (MyFile.is_open())
+        {
+            string Line;
+            if (getline(MyFile, Line) && !Line.empty())
+                State.FirstDateKey = _LineDateKey(Line);
+            MyFile.close();
+        }
+        return State;
+    }
+
+    static bool _ReadSegmentRaw(const string &ActivePath, const stSegmentInfo &Info, string &Raw)
+    {
+        string Stored = _ReadWholeFile(_DirectoryOf(ActivePath) + Info.FileName);
+
+        if (Info.Compressed)
+        {
+            if (!clsCompressor::Decompress(Stored, Raw))
+            {
+                cerr << "Error: Log segment " << Info.FileName << " is corrupted.\n";
+                return false;
+            }
+        }
+        else
+        {
+            Raw.swap(Stored);
+        }
+
+        if (VerifyChecksums && clsCompressor::Crc32(Raw) != Info.Checksum)
+        {
+            cerr << "Error: Checksum mismatch in log segment " << Info.FileName << ".\n";
+            return false;
+        }
+        return true;
+    }
+
+    static bool _ReadSegmentLines(const string &ActivePath, const stSegmentInfo &Info, vector<string> &vLines)
+    {
+        string Raw;
+        if (!_ReadSegmentRaw(ActivePath, Info, Raw))
+            return false;
+
+        _SplitLines(Raw, vLines);
+        return true;
+    }
+
+    static void _RecoverLocked(const string &ActivePath)
+    {
+        // Finish or undo a rotation a crashed process left behind (caller
+        // holds _Mutex() and the log's file lock). See "Crash Safety".
+        string Journal = _ReadWholeFile(_JournalPath(ActivePath));
+        if (Journal.empty())
+            return;
+
+        vector<string> vData = clsString::Split(Journal, "#//#");
+        if (vData.size() >= 3)
+        {
+            int Seq = stoi(vData[0]);
+            size_t RotatedBytes = (size_t)stoull(vData[1]);
+            unsigned int Checksum = (unsigned int)stoul(vData[2]);
+
+            bool Committed = false;
+            for (const stSegmentInfo &Info : LoadManifest(ActivePath))
+                Committed = Committed || Info.Seq == Seq;
+
+            if (Committed)
+            {
+                // the segment is in the manifest: its bytes must leave the active file
+                string Raw = _ReadWholeFile(ActivePath);
+                if (Raw.size() >= RotatedBytes && clsCompressor::Crc32(Raw.substr(0, RotatedBytes)) == Checksum)
+                    clsDurableFile::WriteAtomically(ActivePath, Raw.substr(RotatedBytes));
+            }
+            else
+            {
+                // not committed: the active file still holds every line
+                error_code Error;
+                filesystem::remove(_DirectoryOf(ActivePath) + _SegmentFileName(ActivePath, Seq), Error);
+            }
+        }
+
+        error_code Error;
+        filesystem::remove(_JournalPath(ActivePath), Error);
+        clsDurableFile::SyncDirectory(ActivePath);
+    }
+
+    static void _RotateLocked(const string &ActivePath)
+    {
+        // Rotate process steps (caller holds _Mutex() and the log's file lock):
+        // 1. Read the whole active segment (it is small by construction).
+        // 2. Build the manifest entry: first/last date, line count, size, CRC-32.
+        // 3. Journal the rotation (segment number, rotated bytes, CRC-32).
+        // 4. Write the closed segment file (compressed when enabled) through a
+        //    synced temporary file.
+        // 5. Replace the manifest with one that lists the segment (commit).
+        // 6. Truncate the active segment so new lines start a fresh segment,
+        //    sync it and remove the journal.
+        string Raw = _ReadWholeFile(ActivePath);
+        if (Raw.empty())
+            return;
+
+        vector<string> vLines;
+        _SplitLines(Raw, vLines);
+        if (vLines.empty())
+            return;
+
+        vector<stSegmentInfo> vSegments = LoadManifest(ActivePath);
+
+        stSegmentInfo Info;
+        Info.Seq = vSegments.empty() ? 1 : vSegments.back().Seq + 1;
+        Info.FirstDateKey = _LineDateKey(vLines.front());
+        Info.LastDateKey = _LineDateKey(vLines.back());
+        Info.Lines = (long long)vLines.size();
+        Info.RawBytes = (long long)Raw.size();
+        Info.Checksum = clsCompressor::Crc32(Raw);
+        Info.Compressed = CompressClosedSegments;
+        Info.FileName = _SegmentFileName(ActivePath, Info.Seq);
+
+        string Journal = to_string(Info.Seq) + "#//#" + to_string(Info.RawBytes) + "#//#" + to_string(Info.Checksum);
+        if (!clsDurableFile::WriteAtomically(_JournalPath(ActivePath), Journal))
+        {
+            cerr << "Error: Cannot start the rotation of " << ActivePath << ".\n";
+            return;
+        }
+
+        string Stored = Info.Compressed ? clsCompressor::Compress(Raw) : Raw;
+        if (!clsDurableFile::WriteAtomically(_DirectoryOf(ActivePath) + Info.FileName, Stored))
+        {
+            cerr << "Error: Cannot create log segment " << Info.FileName << ".\n";
+            _RecoverLocked(ActivePath); // undo
+            return;
+        }
+
+        string Manifest = _ReadWholeFile(_ManifestPath(ActivePath));
+        if (!Manifest.empty() && Manifest.back() != '\n')
+            Manifest += '\n';
+        Manifest += _ConvertSegmentInfoToLine(Info) + "\n";
+        if (!clsDurableFile::WriteAtomically(_ManifestPath(ActivePath), Manifest))
+        {
+            cerr << "Error: Cannot update the manifest of " << ActivePath << ".\n";
+            _RecoverLocked(ActivePath); // undo
+            return;
+        }
+
+        fstream Active(ActivePath, ios::out | ios::trunc); // start a fresh active segment
+        Active.close();
+        clsDurableFile::Sync(ActivePath);
+
+        error_code Error;
+        filesystem::remove(_JournalPath(ActivePath), Error);
+
+        stActiveState &State = _ActiveStates()[ActivePath];
+        State.Loaded = true;
+        State.FirstDateKey = 0;
+        State.Bytes = 0;
+        State.ManifestBytes = (long long)Manifest.size();
+    }
+
+    static stReadView _ReadView(const string &ActivePath)
+    {
+        // readers: the manifest and the active file under one lock, so no
+        // rotation falls between them (and an unfinished one is recovered);
+        // the active file is small by construction (MaxSegmentBytes)
+        lock_guard<mutex> Lock(_Mutex());
+        clsFileLock FileLock(_LockPath(ActivePath));
+        _RecoverLocked(ActivePath);
+
+        stReadView View;
+        View.vSegments = LoadManifest(ActivePath);
+        View.ActiveRaw = _ReadWholeFile(ActivePath);
+        return View;
+    }
+
+public:
+    //---------------------------------------------
+    // Date key helper: "26/11/2025" -> 20251126
+    //---------------------------------------------
+    static int DateKey(const string &Date)
+    {
+        int Parts[3] = {0, 0, 0};
+        short Index = 0;
+        for (char Ch : Date)
+        {
+            if (Ch == '/')
+            {
+                if (++Index > 2)
+                    break;
+            }
+            else if (Ch >= '0' && Ch <= '9')
+            {
+                Parts[Index] = Parts[Index] * 10 + (Ch - '0');
+            }
+            else
+            {
+                break;
+            }
+        }
+        return Parts[2] * 10000 + Parts[1] * 100 + Parts[0];
+    }
+
+    //---------------------------------------------
+    // Manifest
+    //---------------------------------------------
+    static vector<stSegmentInfo> LoadManifest(const string &ActivePath)
+    {
+        vector<stSegmentInfo> vSegments;
+        fstream MyFile(_ManifestPath(ActivePath), ios::in);
+
+        if (MyFile.is_open())
+        {
+            string Line;
+            while (getline(MyFile, Line))
+            {
+                stSegmentInfo Info = _ParseManifestLine(Line);
+                if (Info.Seq > 0)
+                    vSegments.push_back(Info);
+            }
+            MyFile.close();
+        }
+        return vSegments;
+    }
+
+    //---------------------------------------------
+    // Append (rotates when the policy says so)
+    //---------------------------------------------
+    static void AppendLine(const string &ActivePath, const string &Line)
+    {
+        lock_guard<mutex> Lock(_Mutex());
+        clsFileLock FileLock(_LockPath(ActivePath));
+
+        stActiveState &State = _LoadActiveState(ActivePath);
+        int LineDateKey = _LineDateKey(Line);
+
+        bool NewDay = (State.FirstDateKey != 0 && LineDateKey != State.FirstDateKey);
+        bool TooBig = (State.Bytes > 0 && State.Bytes + (long long)Line.size() + 1 > (long long)MaxSegmentBytes);
+
+        if (NewDay || TooBig)
+            _RotateLocked(ActivePath);
+
+        fstream MyFile(ActivePath, ios::out | ios::app);
+        if (MyFile.is_open())
+        {
+            MyFile << Line << endl;
+            MyFile.close();
+
+            if (State.FirstDateKey == 0)
+                State.FirstDateKey = LineDateKey;
+            State.Bytes += (long long)Line.size() + 1;
+        }
+        else
+        {
+            cerr << "Error: Cannot open " << ActivePath << " to append log entry.\n";
+        }
+    }
+
+    static void AppendLines(const string &ActivePath, const vector<string> &vLines)
+    {
+        // AppendLines process steps (same rotation rules as AppendLine):
+        // 1. Take the lock once for the whole group.
+        // 2. Collect lines into one buffer while they fit the active segment.
+        // 3. When a line starts a new day or overflows the segment, write the
+        //    buffer, rotate, and keep collecting into the fresh segment.
+        // 4. Write what is left with a single open/write/close.
+        if (vLines.empty())
+            return;
+
+        lock_guard<mutex> Lock(_Mutex());
+        clsFileLock FileLock(_LockPath(ActivePath));
+        stActiveState &State = _LoadActiveState(ActivePath);
+
+        string Buffer;
+        Buffer.reserve(MaxSegmentBytes < 1024 * 1024 ? MaxSegmentBytes : 1024 * 1024);
+
+        auto Flush = [&ActivePath, &Buffer]()
+        {
+            if (Buffer.empty())
+                return true;
+
+            fstream MyFile(ActivePath, ios::out | ios::app); // text mode, like AppendLine
+            if (!MyFile.is_open())
+            {
+                cerr << "Error: Cannot open " << ActivePath << " to append log entries.\n";
+                return false;
+            }
+            MyFile.write(Buffer.data(), (streamsize)Buffer.size());
+            MyFile.close();
+            Buffer.clear();
+            return true;
+        };
+
+        for (const string &Line : vLines)
+        {
+            int LineDateKey = _LineDateKey(Line);
+
+            bool NewDay = (State.FirstDateKey != 0 && LineDateKey != State.FirstDateKey);
+            bool TooBig = (State.Bytes > 0 && State.Bytes + (long long)Line.size() + 1 > (long long)MaxSegmentBytes);
+
+            if (NewDay || TooBig)
+            {
+                if (!Flush())
+                    return;
+                _RotateLocked(ActivePath);
+            }
+
+            Buffer += Line;
+            Buffer += '\n';
+
+            if (State.FirstDateKey == 0)
+                State.FirstDateKey = LineDateKey;
+            State.Bytes += (long long)Line.size() + 1;
+        }
+        Flush();
+    }
+
+    static void Rotate(const string &ActivePath)
+    {
+        lock_guard<mutex> Lock(_Mutex());
+        clsFileLock FileLock(_LockPath(ActivePath));
+        _LoadActiveState(ActivePath);
+        _RotateLocked(ActivePath);
+    }
+
+    //---------------------------------------------
+    // Queries
+    //---------------------------------------------
+    static void ForEachLine(const string &ActivePath, const function<void(const string &)> &Visitor,
+                            int FromDateKey = 0, int ToDateKey = INT_MAX)
+    {
+        bool Ranged = (FromDateKey != 0 || ToDateKey != INT_MAX);
+        stReadView View = _ReadView(ActivePath);
+
+        for (const stSegmentInfo &Info : View.vSegments)
+        {
+            if (Info.LastDateKey < FromDateKey || Info.FirstDateKey > ToDateKey)
+                continue; // segment is completely outside the requested range
+
+            bool FullyInside = (Info.FirstDateKey >= FromDateKey && Info.LastDateKey <= ToDateKey);
+
+            vector<string> vLines;
+            if (!_ReadSegmentLines(ActivePath, Info, vLines))
+                continue;
+
+            for (const string &Line : vLines)
+            {
+                if (FullyInside || !Ranged)
+                    Visitor(Line);
+                else
+                {
+                    int Key = _LineDateKey(Line);
+                    if (Key >= FromDateKey && Key <= ToDateKey)
+                        Visitor(Line);
+                }
+            }
+        }
+
+        vector<string> vLines;
+        _SplitLines(View.ActiveRaw, vLines);
+        for (const string &Line : vLines)
+        {
+            if (Ranged)
+            {
+                int Key = _LineDateKey(Line);
+                if (Key < FromDateKey || Key > ToDateKey)
+                    continue;
+            }
+            Visitor(Line);
+        }
+    }
+
+    static bool ForEachLineNewestFirst(const string &ActivePath, const function<bool(const string &)> &Visitor)
+    {
+        // Returns true when the visitor stopped the scan (found what it wanted).
+        stReadView View = _ReadView(ActivePath);
+        vector<string> vLines;
+        _SplitLines(View.ActiveRaw, vLines);
+
+        for (auto It = vLines.rbegin(); It != vLines.rend(); ++It)
+        {
+            if (Visitor(*It))
+                return true;
+        }
+
+        for (auto Seg = View.vSegments.rbegin(); Seg != View.vSegments.rend(); ++Seg)
+        {
+            vLines.clear();
+            if (!_ReadSegmentLines(ActivePath, *Seg, vLines))
+                continue;
+
+            for (auto It = vLines.rbegin(); It != vLines.rend(); ++It)
+            {
+                if (Visitor(*It))
+                    return true;
+            }
+        }
+        return false;
+    }
+
+    //---------------------------------------------
+    // Positions (snapshots replay the log after one)
+    //---------------------------------------------
+    static stLogPosition GetEndPosition(const string &ActivePath)
+    {
+        // the active file is measured on disk, not from the cached state,
+        // so lines appended by another process are counted too
+        lock_guard<mutex> Lock(_Mutex());
+        clsFileLock FileLock(_LockPath(ActivePath));
+        _RecoverLocked(ActivePath);
+
+        stLogPosition Position;
+        vector<stSegmentInfo> vSegments = LoadManifest(ActivePath);
+        Position.ClosedSeq = vSegments.empty() ? 0 : vSegments.back().Seq;
+
+        ifstream MyFile(ActivePath, ios::in | ios::binary | ios::ate);
+        if (MyFile.is_open())
+            Position.ActiveBytes = (long long)MyFile.tellg();
+        return Position;
+    }
+
+    static bool ForEachLineAfter(const string &ActivePath, const stLogPosition &Position,
+                                 const function<void(const string &)> &Visitor)
+    {
+        // ForEachLineAfter process steps:
+        // 1. Closed segments up to Position.ClosedSeq are older: skipped unopened.
+        // 2. The segment right after it was the active file at Position, so its
+        //    first ActiveBytes bytes are skipped.
+        // 3. Later segments and the active file are visited whole (the active
+        //    file is skipped like step 2 when nothing was closed since).
+        // Returns false when the log no longer holds the position (a segment is
+        // missing or corrupted, or the active file is shorter than recorded).
+        bool Rotated = false;
+        stReadView View = _ReadView(ActivePath);
+
+        for (const stSegmentInfo &Info : View.vSegments)
+        {
+            if (Info.Seq <= Position.ClosedSeq)
+                continue;
+
+            string Raw;
+            if (!_ReadSegmentRaw(ActivePath, Info, Raw))
+                return false;
+
+            size_t Skip = 0;
+            if (!Rotated)
+            {
+                if (Info.Seq != Position.ClosedSeq + 1 || (long long)Raw.size() < Position.ActiveBytes)
+                    return false;
+                Skip = (size_t)Position.ActiveBytes;
+            }
+            Rotated = true;
+
+            vector<string> vLines;
+            _SplitLines(Raw.substr(Skip), vLines);
+            for (const string &Line : vLines)
+                Visitor(Line);
+        }
+
+        string &Raw = View.ActiveRaw;
+        size_t Skip = 0;
+        if (!Rotated)
+        {
+            if ((long long)Raw.size() < Position.ActiveBytes)
+                return false;
+            Skip = (size_t)Position.ActiveBytes;
+        }
+
+        vector<string> vLines;
+        _SplitLines(Raw.substr(Skip), vLines);
+        for (const string &Line : vLines)
+            Visitor(Line);
+        return true;
+    }
+
+    static vector<string> ReadAllLines(const string &ActivePath, int FromDateKey = 0, int ToDateKey = INT_MAX)
+    {
+        vector<string> vLines;
+        ForEachLine(ActivePath, [&vLines](const string &Line)
+                    { vLines.push_back(Line); }, FromDateKey, ToDateKey);
+        return vLines;
+    }
+};
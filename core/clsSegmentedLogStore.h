@@ -0,0 +1,68 @@
+/*clsSegmentedLogStore Overview
+================================================================================
+                            clsSegmentedLogStore.h
+================================================================================
+Overview:
+---------
+This file defines clsSegmentedLogStore, the clsLogStore backed by a
+clsSegmentedLog under the data root (active text file + closed, compressed
+segments). It only remembers the path of the active file and forwards every
+call, so the logs behave exactly as before the store existed: rotation,
+date-range segment skipping and the newest-first scan are clsSegmentedLog's.
+
+clsSnapshot keeps using clsSegmentedLog directly for AllTransactions.txt,
+since it records byte positions inside the segments.
+
+================================================================================
+Usage Example:
+--------------
+    clsSegmentedLogStore Sessions("../data/ClientsSessionLog.txt");
+    Sessions.AppendLine(Line);
+
+================================================================================
+*/
+
+#pragma once
+
+#include <string>
+
+#include "clsLogStore.h"     // core/clsLogStore.h
+#include "clsSegmentedLog.h" // core/clsSegmentedLog.h
+
+using namespace std;
+
+class clsSegmentedLogStore : public clsLogStore
+{
+private:
+    string _Path;
+
+public:
+    explicit clsSegmentedLogStore(const string &Path) : _Path(Path)
+    {
+    }
+
+    string BackendName() const override { return "text"; }
+
+    const string &GetPath() const { return _Path; }
+
+    void AppendLine(const string &Line) override
+    {
+        clsSegmentedLog::AppendLine(_Path, Line);
+    }
+
+    void AppendLines(const vector<string> &vLines) override
+    {
+        clsSegmentedLog::AppendLines(_Path, vLines);
+    }
+
+    void ForEachLine(const function<void(const string &Line)> &Visitor,
+                     int FromDateKey = 0, int ToDateKey = INT_MAX) override
+    {
+        clsSegmentedLog::ForEachLine(_Path, Visitor, FromDateKey, ToDateKey);
+    }
+
+    bool ForEachLineNewestFirst(const function<bool(const string &Line)> &Visitor) override
+    {
+        return clsSegmentedLog::ForEachLineNewestFirst(_Path, Visitor);
+    }
+};
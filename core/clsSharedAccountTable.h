@@ -0,0 +1,1001 @@
+/*clsSharedAccountTable Overview
+================================================================================
+                            clsSharedAccountTable.h
+================================================================================
+Overview:
+---------
+This file defines clsSharedAccountTable, the account balances of one data
+root kept in POSIX shared memory, so several terminal processes on one host
+can transact on the same accounts without losing each other's updates.
+
+Without it every process reads Clients.txt, changes its own copy of a
+balance and rewrites the file: the last writer wins. With it (shared mode):
+
+- The balance of every account lives once, in the shared segment. Deposit
+  and Withdraw change it in place under the account's shard mutex, so two
+  withdrawals on one account can never both spend the same money.
+- The shard mutexes are process-shared and robust: a process that dies while
+  holding one does not block the others (the next locker marks it
+  consistent; a balance is one 8-byte store, never half written).
+- Clients.txt is no longer rewritten per transaction. A checkpoint writes all
+  shared balances into it in one rewrite, every CheckpointEveryChanges
+  balance changes, when a bulk job saves balances, and when a process
+  detaches. Every write to the clients store (checkpoint, profile edit, add,
+  delete) holds an exclusive flock() on <data root>/SmartBank.lock, so no
+  rewrite overwrites another process's change.
+- Reads (Find, lists, reports through clsAccountTable) take the balance
+  from the shared table, so they never see a balance older than the last
+  transaction of any process.
+- Each account also carries its record version (clsRecordVersion): every
+  change bumps it, and a client Save() is a CompareAndSet() on it, so a
+  stale object cannot overwrite a newer balance. Checkpoints write balance
+  and version into the line.
+
+================================================================================
+Life Cycle:
+-----------
+Attach() (under the flock):
+    segment "/smartbank.<hash of the data root>" exists and is ready -> map it
+    otherwise -> create it, load the balances from the clients store, replay
+                 the transaction log after the last checkpoint, write a
+                 checkpoint marker (SmartBank.checkpoint)
+Detach() (under the flock):
+    checkpoint when balances changed; the last process to detach removes the
+    segment and the marker, since Clients.txt now holds every balance
+
+The segment outlives crashed processes (balances are not lost when a terminal
+dies); Attach() and Detach() drop processes that no longer exist from the
+attached list, so the last live one still cleans up. If the machine restarts
+before a checkpoint, the next Attach() finds the marker, so the balances are
+rebuilt from Clients.txt plus the BalanceAfter of every logged transaction
+written since (like clsSnapshot), and written back by the next checkpoint.
+
+================================================================================
+Limits:
+-------
+- Text backend only: the binary and memory stores keep per-process state,
+  and the segment replaces exactly the text file rewrite it protects.
+- Every process working on the data root must use shared mode.
+- Capacity (accounts) is fixed when the segment is created, with room for
+  the existing accounts plus AddedAccountsHeadroom new ones; an account that
+  does not fit is handled like before (directly in the store).
+- POSIX only (shm_open, pthread robust mutexes, flock); Attach() fails on
+  Windows.
+
+================================================================================
+Public Methods:
+---------------
+    static bool Attach(string &Error)             join / create the segment
+    static void Detach()                          checkpoint and leave
+    static clsSharedAccountTable *Active()        nullptr when not in shared mode
+
+    enUpdateResult Deposit(Account, Amount, stAccount &After)
+    enUpdateResult Withdraw(Account, Amount, stAccount &After)
+    enUpdateResult CompareAndSet(Account, ExpectedVersion, Balance, stAccount &Current)
+    bool GetAccount(Account, stAccount &Current) / bool GetBalance(Account, double &Balance)
+    bool SetBalance(Account, Balance)
+    bool AddAccount(Account, Balance, Version) / bool RemoveAccount(Account)
+    void Checkpoint()
+    unsigned long long Generation()   changes with every balance change or
+                                      clients store write of any process
+
+    clsWriteGuard          RAII: exclusive flock for a clients store write
+                           (does nothing when shared mode is off)
+    clsExclusiveLock       RAII: file lock + every shard mutex (bulk jobs)
+
+================================================================================
+Usage Example:
+--------------
+    string Error;
+    if (!clsSharedAccountTable::Attach(Error))
+        cerr << Error << endl;
+
+    clsSharedAccountTable::stAccount After;
+    if (clsSharedAccountTable::Active()->Withdraw("A101", 50, After) ==
+        clsSharedAccountTable::urDone)
+        ...
+
+    clsSharedAccountTable::Detach();
+
+================================================================================
+*/
+
+#pragma once
+
+#include <string>
+#include <string_view>
+#include <vector>
+#include <unordered_set>
+#include <memory>
+#include <mutex>
+#include <atomic>
+#include <fstream>
+#include <cstdio>
+#include <cstring>
+#include <climits>
+#include <filesystem>
+#include <type_traits>
+
+#ifndef _WIN32
+#include <pthread.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/file.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <signal.h>
+#include <cerrno>
+#endif
+
+#include "../utils/clsString.h"      // utils/clsString.h
+#include "../utils/clsFixedString.h" // utils/clsFixedString.h
+#include "clsStorage.h"              // core/clsStorage.h
+#include "clsSegmentedLog.h"         // core/clsSegmentedLog.h
+#include "clsTransactionLogger.h"    // core/clsTransactionLogger.h
+#include "clsSnapshot.h"             // core/clsSnapshot.h
+#include "clsRecordVersion.h"        // core/clsRecordVersion.h
+
+using namespace std;
+
+class clsSharedAccountTable
+{
+public:
+    enum enUpdateResult
+    {
+        urDone = 0,
+        urInsufficient = 1, // withdraw: balance too low, nothing changed
+        urNotShared = 2,    // account not in the table: use the store directly
+        urConflict = 3      // CompareAndSet: the record changed since it was read
+    };
+
+    struct stAccount
+    {
+        double Balance = 0;
+        unsigned long long Version = 0; // record version (clsRecordVersion)
+    };
+
+    static const unsigned int ShardCount = 64;
+    static const unsigned int MaxProcesses = 256;
+    static constexpr const char *LockFile = "SmartBank.lock";
+    static constexpr const char *CheckpointFile = "SmartBank.checkpoint";
+
+    inline static size_t CheckpointEveryChanges = 1000;
+    inline static size_t AddedAccountsHeadroom = 4096;
+
+private:
+#ifdef _WIN32
+    typedef long long tSharedMutex; // never used: Attach() fails on Windows
+#else
+    typedef pthread_mutex_t tSharedMutex;
+#endif
+
+    static const unsigned int _LayoutVersion = 3;
+
+    enum enSlotState
+    {
+        ssEmpty = 0,
+        ssUsed = 1,
+        ssDeleted = 2 // kept as a tombstone, never reused: lookups stay lock-free
+    };
+
+    struct stSlot
+    {
+        atomic<unsigned int> State;
+        unsigned int Shard;
+        clsAccountNumber Account;   // written before State becomes ssUsed
+        double Balance;             // guarded by the shard mutex
+        unsigned long long Version; // record version, +1 on every change (shard mutex)
+    };
+
+    struct stHeader
+    {
+        char Magic[8];
+        unsigned int Version;
+        unsigned int Shards;
+        unsigned long long Capacity;           // slots
+        atomic<unsigned int> Ready;            // set last, after the balances are loaded
+        int Processes[MaxProcesses];           // attached pids, 0 = free (changed under the flock)
+        atomic<unsigned long long> Accounts;   // used slots
+        atomic<unsigned long long> Changes;    // balance changes since the last checkpoint
+        atomic<unsigned long long> Recovered;  // shard locks taken over from dead owners
+        atomic<unsigned long long> Generation; // +1 per balance change and per clients store write
+        tSharedMutex InsertMutex;              // adding / removing accounts
+        tSharedMutex ShardMutex[ShardCount];
+    };
+
+    static_assert(is_trivially_copyable<clsAccountNumber>::value, "account keys are stored in shared memory");
+    static_assert(atomic<unsigned long long>::is_always_lock_free, "shared counters must be lock-free");
+
+    string _DataRoot;
+    string _SegmentName;
+    int _SegmentFd = -1;
+    int _LockFd = -1;
+    size_t _MappedBytes = 0;
+    stHeader *_Header = nullptr;
+    stSlot *_Slots = nullptr;
+
+    recursive_mutex _FileMutex; // threads of this process; flock() covers the others
+    int _FileLockDepth = 0;
+
+    static unique_ptr<clsSharedAccountTable> &_Instance()
+    {
+        static unique_ptr<clsSharedAccountTable> Instance;
+        return Instance;
+    }
+
+    static unsigned long long _Hash(string_view Text)
+    {
+        // FNV-1a, 64 bit
+        unsigned long long Hash = 14695981039346656037ull;
+        for (char Ch : Text)
+        {
+            Hash ^= (unsigned char)Ch;
+            Hash *= 1099511628211ull;
+        }
+        return Hash;
+    }
+
+    static size_t _SegmentBytes(unsigned long long Capacity)
+    {
+        return sizeof(stHeader) + (size_t)Capacity * sizeof(stSlot);
+    }
+
+    //---------------------------------------------
+    // Locks
+    //---------------------------------------------
+    bool _LockMutex(tSharedMutex &Mutex)
+    {
+#ifdef _WIN32
+        (void)Mutex;
+        return false;
+#else
+        int Result = pthread_mutex_lock(&Mutex);
+        if (Result == EOWNERDEAD)
+        {
+            // the owner died holding the lock; balances are single stores,
+            // so the data it guards is consistent
+            pthread_mutex_consistent(&Mutex);
+            _Header->Recovered++;
+            return true;
+        }
+        return Result == 0;
+#endif
+    }
+
+    void _UnlockMutex(tSharedMutex &Mutex)
+    {
+#ifndef _WIN32
+        pthread_mutex_unlock(&Mutex);
+#else
+        (void)Mutex;
+#endif
+    }
+
+    static bool _InitMutex(tSharedMutex &Mutex)
+    {
+#ifdef _WIN32
+        (void)Mutex;
+        return false;
+#else
+        // process-shared (lives in the segment), robust (survives a dead owner),
+        // recursive (clsExclusiveLock holders may still call SetBalance)
+        pthread_mutexattr_t Attributes;
+        pthread_mutexattr_init(&Attributes);
+        pthread_mutexattr_setpshared(&Attributes, PTHREAD_PROCESS_SHARED);
+        pthread_mutexattr_setrobust(&Attributes, PTHREAD_MUTEX_ROBUST);
+        pthread_mutexattr_settype(&Attributes, PTHREAD_MUTEX_RECURSIVE);
+        bool Initialized = (pthread_mutex_init(&Mutex, &Attributes) == 0);
+        pthread_mutexattr_destroy(&Attributes);
+        return Initialized;
+#endif
+    }
+
+    bool _LockFiles(bool Wait)
+    {
+        // in-process mutex first, then flock() once per outermost lock
+        if (Wait)
+            _FileMutex.lock();
+        else if (!_FileMutex.try_lock())
+            return false;
+
+#ifndef _WIN32
+        if (_FileLockDepth == 0 && flock(_LockFd, Wait ? LOCK_EX : (LOCK_EX | LOCK_NB)) != 0)
+        {
+            _FileMutex.unlock();
+            return false;
+        }
+#endif
+        _FileLockDepth++;
+        return true;
+    }
+
+    void _UnlockFiles()
+    {
+#ifndef _WIN32
+        if (--_FileLockDepth == 0)
+            flock(_LockFd, LOCK_UN);
+#else
+        --_FileLockDepth;
+#endif
+        _FileMutex.unlock();
+    }
+
+    //---------------------------------------------
+    // Slots
+    //---------------------------------------------
+    stSlot *_Find(string_view Account)
+    {
+        // linear probing; stops at the first never-used slot
+        clsAccountNumber Key(Account);
+        if (!Key.IsValid() || Key.IsEmpty())
+            return nullptr;
+
+        unsigned long long Capacity = _Header->Capacity;
+        unsigned long long Index = _Hash(Key.View()) % Capacity;
+
+        for (unsigned long long Probe = 0; Probe < Capacity; Probe++)
+        {
+            stSlot &Slot = _Slots[(Index + Probe) % Capacity];
+            unsigned int State = Slot.State.load(memory_order_acquire);
+            if (State == ssEmpty)
+                return nullptr;
+            if (State == ssUsed && Slot.Account == Key)
+                return &Slot;
+        }
+        return nullptr;
+    }
+
+    bool _InsertUnlocked(string_view Account, double Balance, unsigned long long Version)
+    {
+        // caller holds InsertMutex (or is the creator, alone in the segment)
+        clsAccountNumber Key(Account);
+        if (!Key.IsValid() || Key.IsEmpty())
+            return false;
+
+        unsigned long long Hash = _Hash(Key.View());
+        unsigned long long Capacity = _Header->Capacity;
+
+        // keep a quarter of the slots free so probes stay short
+        if ((_Header->Accounts + 1) * 4 > Capacity * 3)
+            return false;
+
+        for (unsigned long long Probe = 0; Probe < Capacity; Probe++)
+        {
+            stSlot &Slot = _Slots[(Hash + Probe) % Capacity];
+            unsigned int State = Slot.State.load(memory_order_acquire);
+            if (State == ssUsed && Slot.Account == Key)
+                return true; // duplicate account line: the first one counts, as in the store
+            if (State == ssEmpty)
+            {
+                Slot.Account = Key;
+                Slot.Shard = (unsigned int)((Hash >> 32) % ShardCount);
+                Slot.Balance = Balance;
+                Slot.Version = Version;
+                Slot.State.store(ssUsed, memory_order_release);
+                _Header->Accounts++;
+                return true;
+            }
+        }
+        return false;
+    }
+
+    class clsShardLock
+    {
+    private:
+        clsSharedAccountTable &_Table;
+        tSharedMutex &_Mutex;
+        bool _Locked;
+
+    public:
+        clsShardLock(clsSharedAccountTable &Table, const stSlot &Slot)
+            : _Table(Table), _Mutex(Table._Header->ShardMutex[Slot.Shard])
+        {
+            _Locked = _Table._LockMutex(_Mutex);
+        }
+
+        ~clsShardLock()
+        {
+            if (_Locked)
+                _Table._UnlockMutex(_Mutex);
+        }
+
+        bool IsLocked() const { return _Locked; }
+    };
+
+    static double _Stored(double Balance)
+    {
+        // the value Clients.txt would give back (a float with 6 decimals),
+        // so a balance does not change when it goes through a checkpoint
+        return stod(to_string((float)Balance));
+    }
+
+    //---------------------------------------------
+    // Load / replay / checkpoint
+    //---------------------------------------------
+    string _LogPath() const { return _DataRoot + clsStorage::TransactionsFile; }
+    string _CheckpointPath() const { return _DataRoot + CheckpointFile; }
+
+    void _WriteCheckpointMarker(const clsSegmentedLog::stLogPosition &Position)
+    {
+        string TempPath = _CheckpointPath() + ".tmp";
+        {
+            ofstream Marker(TempPath, ios::out | ios::trunc);
+            Marker << Position.ClosedSeq << " " << Position.ActiveBytes << "\n";
+        }
+        error_code Error;
+        filesystem::rename(TempPath, _CheckpointPath(), Error);
+    }
+
+    bool _ReadCheckpointMarker(clsSegmentedLog::stLogPosition &Position)
+    {
+        ifstream Marker(_CheckpointPath());
+        return Marker.is_open() && (Marker >> Position.ClosedSeq >> Position.ActiveBytes);
+    }
+
+    size_t _ReplayLogAfter(const clsSegmentedLog::stLogPosition &Position)
+    {
+        // BalanceAfter of every line -> balance of the account it belongs to
+        // (the same rule clsSnapshot uses to replay its log tail)
+        typedef clsTransactionLogger Logger;
+        size_t Replayed = 0;
+
+        clsSegmentedLog::ForEachLineAfter(_LogPath(), Position, [this, &Replayed](const string &Line)
+                                          {
+                                              unsigned int Bit = Logger::TypeBit(Logger::OperationTypeFromString(clsString::GetFieldView(Line, "#//#", 3)));
+
+                                              string_view Account;
+                                              if (Bit & Logger::FromSideMask)
+                                                  Account = clsString::GetFieldView(Line, "#//#", 5);
+                                              else if (Bit & Logger::ToSideMask)
+                                                  Account = clsString::GetFieldView(Line, "#//#", 6);
+                                              else
+                                                  return;
+
+                                              stSlot *Slot = _Find(Account);
+                                              if (Slot == nullptr)
+                                                  return;
+
+                                              Slot->Balance = _Stored(strtod(string(clsString::GetFieldView(Line, "#//#", 7)).c_str(), nullptr));
+                                              Slot->Version++;
+                                              Replayed++; });
+        return Replayed;
+    }
+
+    bool _Create(unsigned long long Capacity)
+    {
+        // _Create process steps (caller holds the flock, nobody else is attached):
+        // 1. Size the segment and map it; initialize every mutex.
+        // 2. Load account -> balance from the clients store.
+        // 3. A checkpoint marker means the last session did not end with a
+        //    clean Detach(): replay the log written after it.
+        // 4. Write a fresh marker (log end now) and publish Ready.
+#ifdef _WIN32
+        (void)Capacity;
+        return false;
+#else
+        size_t Bytes = _SegmentBytes(Capacity);
+        if (ftruncate(_SegmentFd, 0) != 0 || ftruncate(_SegmentFd, (off_t)Bytes) != 0)
+            return false;
+
+        void *Address = mmap(nullptr, Bytes, PROT_READ | PROT_WRITE, MAP_SHARED, _SegmentFd, 0);
+        if (Address == MAP_FAILED)
+            return false;
+
+        _MappedBytes = Bytes;
+        _Header = (stHeader *)Address;
+        _Slots = (stSlot *)((char *)Address + sizeof(stHeader));
+        memset(Address, 0, Bytes); // all slots ssEmpty, counters 0
+
+        memcpy(_Header->Magic, "SBSHARE", 8);
+        _Header->Version = _LayoutVersion;
+        _Header->Shards = ShardCount;
+        _Header->Capacity = Capacity;
+
+        bool Initialized = _InitMutex(_Header->InsertMutex);
+        for (unsigned int i = 0; i < ShardCount; i++)
+            Initialized = Initialized && _InitMutex(_Header->ShardMutex[i]);
+        if (!Initialized)
+            return false;
+
+        clsStorage::Clients().ForEach([this](const string &Line)
+                                      {
+                                          string_view Balance = clsString::GetFieldView(Line, " || ", 6);
+                                          _InsertUnlocked(clsString::GetFieldView(Line, " || ", clsStorage::ClientsKeyColumn),
+                                                          Balance.empty() ? 0.0 : stod(string(Balance)),
+                                                          clsRecordVersion::Of(Line, clsStorage::ClientsVersionColumn));
+                                          return false; });
+
+        clsSegmentedLog::stLogPosition Position;
+        if (_ReadCheckpointMarker(Position))
+            _Header->Changes = _ReplayLogAfter(Position); // Detach() writes them back
+
+        _WriteCheckpointMarker(clsSegmentedLog::GetEndPosition(_LogPath()));
+        _Header->Ready.store(1, memory_order_release);
+        return true;
+#endif
+    }
+
+    bool _Map()
+    {
+        // _Map process steps: map the header, check it, then map the whole segment
+#ifdef _WIN32
+        return false;
+#else
+        struct stat Info;
+        if (fstat(_SegmentFd, &Info) != 0 || (size_t)Info.st_size < sizeof(stHeader))
+            return false;
+
+        void *Address = mmap(nullptr, (size_t)Info.st_size, PROT_READ | PROT_WRITE, MAP_SHARED, _SegmentFd, 0);
+        if (Address == MAP_FAILED)
+            return false;
+
+        stHeader *Header = (stHeader *)Address;
+        if (memcmp(Header->Magic, "SBSHARE", 8) != 0 || Header->Version != _LayoutVersion ||
+            Header->Shards != ShardCount || Header->Ready.load(memory_order_acquire) != 1 ||
+            _SegmentBytes(Header->Capacity) != (size_t)Info.st_size)
+        {
+            munmap(Address, (size_t)Info.st_size);
+            return false;
+        }
+
+        _MappedBytes = (size_t)Info.st_size;
+        _Header = Header;
+        _Slots = (stSlot *)((char *)Address + sizeof(stHeader));
+        return true;
+#endif
+    }
+
+    void _Unmap()
+    {
+#ifndef _WIN32
+        if (_Header != nullptr)
+            munmap(_Header, _MappedBytes);
+        if (_SegmentFd >= 0)
+            close(_SegmentFd);
+        if (_LockFd >= 0)
+            close(_LockFd);
+#endif
+        _Header = nullptr;
+        _Slots = nullptr;
+        _SegmentFd = -1;
+        _LockFd = -1;
+    }
+
+    void _WriteCheckpoint()
+    {
+        // _WriteCheckpoint process steps (caller holds the file lock):
+        // 1. Note the log end first: any later line is replayed after a restart
+        //    (replay sets balances, so replaying a line twice is harmless).
+        // 2. Rewrite the clients store once, every balance and record version
+        //    from the segment.
+        // 3. Drop the binary snapshot (Clients.txt changed) and move the marker.
+        clsSegmentedLog::stLogPosition Position = clsSegmentedLog::GetEndPosition(_LogPath());
+        _Header->Changes.store(0);
+
+        vector<string> vLines;
+        unordered_set<clsAccountNumber> Written; // duplicates: only the first line is the shared one
+        clsStorage::Clients().ForEach([this, &vLines, &Written](const string &Line)
+                                      {
+                                          stAccount Current;
+                                          string_view Account = clsString::GetFieldView(Line, " || ", clsStorage::ClientsKeyColumn);
+                                          if (!Written.insert(clsAccountNumber(Account)).second || !GetAccount(Account, Current))
+                                              vLines.push_back(Line);
+                                          else
+                                              vLines.push_back(clsRecordVersion::WithVersion(
+                                                  clsRecordVersion::WithField(Line, clsStorage::ClientsBalanceColumn, to_string((float)Current.Balance)),
+                                                  clsStorage::ClientsVersionColumn, Current.Version));
+                                          return false; });
+
+        clsStorage::Clients().ReplaceAll(vLines);
+        clsSnapshot::Invalidate();
+        _WriteCheckpointMarker(Position);
+    }
+
+    //---------------------------------------------
+    // Attached processes (caller holds the flock)
+    //---------------------------------------------
+    size_t _AttachedProcesses() const
+    {
+        size_t Count = 0;
+        for (unsigned int i = 0; i < MaxProcesses; i++)
+            Count += (_Header->Processes[i] != 0) ? 1 : 0;
+        return Count;
+    }
+
+    void _ForgetDeadProcesses()
+    {
+        // a killed terminal never detaches; its slot is freed here, so the
+        // last live process still removes the segment
+#ifndef _WIN32
+        for (unsigned int i = 0; i < MaxProcesses; i++)
+            if (_Header->Processes[i] != 0 && kill(_Header->Processes[i], 0) != 0 && errno == ESRCH)
+                _Header->Processes[i] = 0;
+#endif
+    }
+
+    bool _Register()
+    {
+#ifdef _WIN32
+        return false;
+#else
+        _ForgetDeadProcesses();
+        for (unsigned int i = 0; i < MaxProcesses; i++)
+            if (_Header->Processes[i] == 0)
+            {
+                _Header->Processes[i] = (int)getpid();
+                return true;
+            }
+        return false;
+#endif
+    }
+
+    size_t _Unregister()
+    {
+#ifndef _WIN32
+        for (unsigned int i = 0; i < MaxProcesses; i++)
+            if (_Header->Processes[i] == (int)getpid())
+                _Header->Processes[i] = 0;
+#endif
+        _ForgetDeadProcesses();
+        return _AttachedProcesses();
+    }
+
+    void _NoteChange()
+    {
+        // checkpoint inline once enough changes piled up; a process already
+        // checkpointing (flock busy) makes this one skip it, and so does a
+        // caller of this thread holding the file lock (it writes afterwards)
+        _Header->Generation++;
+        if (_Header->Changes.fetch_add(1) + 1 < CheckpointEveryChanges)
+            return;
+
+        if (_LockFiles(false))
+        {
+            if (_FileLockDepth == 1 && _Header->Changes.load() >= CheckpointEveryChanges)
+                _WriteCheckpoint();
+            _UnlockFiles();
+        }
+    }
+
+public:
+    //---------------------------------------------
+    // Attach / Detach
+    //---------------------------------------------
+    static bool Attach(string &Error)
+    {
+        // Attach process steps:
+        // 1. Shared mode needs the text backend (see Limits).
+        // 2. Take the data root's flock, so creating and joining never overlap.
+        // 3. Map a ready segment, or create it from the store.
+        // 4. Record this process in the attached process list.
+#ifdef _WIN32
+        Error = "Shared mode needs POSIX shared memory (not available on Windows).";
+        return false;
+#else
+        if (_Instance())
+            return true;
+
+        if (clsStorage::GetBackend() != clsStorage::bkText)
+        {
+            Error = "Shared mode works with the text storage backend only.";
+            return false;
+        }
+
+        unique_ptr<clsSharedAccountTable> Table(new clsSharedAccountTable());
+        Table->_DataRoot = clsStorage::GetDataRoot();
+
+        error_code PathError;
+        filesystem::path Root = filesystem::weakly_canonical(filesystem::absolute(Table->_DataRoot), PathError);
+        char Name[40];
+        snprintf(Name, sizeof(Name), "/smartbank.%016llx", _Hash(Root.string()));
+        Table->_SegmentName = Name;
+
+        Table->_LockFd = open((Table->_DataRoot + LockFile).c_str(), O_RDWR | O_CREAT, 0600);
+        if (Table->_LockFd < 0)
+        {
+            Error = "Cannot open " + Table->_DataRoot + LockFile;
+            return false;
+        }
+        Table->_LockFiles(true);
+
+        Table->_SegmentFd = shm_open(Table->_SegmentName.c_str(), O_RDWR | O_CREAT, 0600);
+        bool Ready = Table->_SegmentFd >= 0 && Table->_Map();
+        if (!Ready && Table->_SegmentFd >= 0)
+        {
+            size_t Accounts = 0;
+            clsStorage::Clients().ForEach([&Accounts](const string &)
+                                          {
+                                              Accounts++;
+                                              return false; });
+
+            // 4 / 3 of the accounts that may exist, rounded up to a power of two
+            unsigned long long Capacity = 1024;
+            while (Capacity * 3 < (Accounts + AddedAccountsHeadroom) * 4)
+                Capacity *= 2;
+
+            Ready = Table->_Create(Capacity);
+        }
+
+        if (!Ready)
+        {
+            Error = "Cannot create the shared account table " + Table->_SegmentName;
+            Table->_UnlockFiles();
+            Table->_Unmap();
+            return false;
+        }
+
+        if (!Table->_Register())
+        {
+            Error = "Too many processes attached to " + Table->_SegmentName;
+            Table->_UnlockFiles();
+            Table->_Unmap();
+            return false;
+        }
+        Table->_UnlockFiles();
+        _Instance() = move(Table);
+        return true;
+#endif
+    }
+
+    static void Detach()
+    {
+        // Detach process steps:
+        // 1. Checkpoint when a balance changed since the last one.
+        // 2. The last process removes the segment and the marker: the clients
+        //    store holds every balance now.
+        unique_ptr<clsSharedAccountTable> &Instance = _Instance();
+        if (!Instance)
+            return;
+
+        clsSharedAccountTable &Table = *Instance;
+        Table._LockFiles(true);
+
+        if (Table._Header->Changes.load() > 0)
+            Table._WriteCheckpoint();
+
+        if (Table._Unregister() == 0)
+        {
+#ifndef _WIN32
+            shm_unlink(Table._SegmentName.c_str());
+#endif
+            error_code Error;
+            filesystem::remove(Table._CheckpointPath(), Error);
+        }
+
+        Table._UnlockFiles();
+        Table._Unmap();
+        Instance.reset();
+    }
+
+    static clsSharedAccountTable *Active()
+    {
+        return _Instance().get();
+    }
+
+    //---------------------------------------------
+    // Balances
+    //---------------------------------------------
+    enUpdateResult Deposit(string_view Account, double Amount, stAccount &After)
+    {
+        stSlot *Slot = _Find(Account);
+        if (Slot == nullptr)
+            return urNotShared;
+
+        {
+            clsShardLock Lock(*this, *Slot);
+            if (!Lock.IsLocked())
+                return urNotShared;
+
+            Slot->Balance = _Stored((float)Slot->Balance + Amount);
+            Slot->Version++;
+            After.Balance = Slot->Balance;
+            After.Version = Slot->Version;
+        }
+        _NoteChange();
+        return urDone;
+    }
+
+    enUpdateResult Withdraw(string_view Account, double Amount, stAccount &After)
+    {
+        // the check and the change happen under one lock: no double spend
+        stSlot *Slot = _Find(Account);
+        if (Slot == nullptr)
+            return urNotShared;
+
+        {
+            clsShardLock Lock(*this, *Slot);
+            if (!Lock.IsLocked())
+                return urNotShared;
+
+            After.Balance = Slot->Balance;
+            After.Version = Slot->Version;
+            if ((float)Slot->Balance < Amount)
+                return urInsufficient;
+
+            Slot->Balance = _Stored((float)Slot->Balance - Amount);
+            Slot->Version++;
+            After.Balance = Slot->Balance;
+            After.Version = Slot->Version;
+        }
+        _NoteChange();
+        return urDone;
+    }
+
+    bool GetAccount(string_view Account, stAccount &Current)
+    {
+        stSlot *Slot = _Find(Account);
+        if (Slot == nullptr)
+            return false;
+
+        clsShardLock Lock(*this, *Slot);
+        if (!Lock.IsLocked())
+            return false;
+        Current.Balance = Slot->Balance;
+        Current.Version = Slot->Version;
+        return true;
+    }
+
+    bool GetBalance(string_view Account, double &Balance)
+    {
+        stAccount Current;
+        if (!GetAccount(Account, Current))
+            return false;
+        Balance = Current.Balance;
+        return true;
+    }
+
+    enUpdateResult CompareAndSet(string_view Account, unsigned long long ExpectedVersion, double Balance, stAccount &Current)
+    {
+        // Save() of a client read at ExpectedVersion: set the balance and move
+        // to the next version only if nobody changed the record since;
+        // Current is the new (urDone) or the stored (urConflict) state
+        stSlot *Slot = _Find(Account);
+        if (Slot == nullptr)
+            return urNotShared;
+
+        {
+            clsShardLock Lock(*this, *Slot);
+            if (!Lock.IsLocked())
+                return urNotShared;
+
+            if (Slot->Version != ExpectedVersion)
+            {
+                Current.Balance = Slot->Balance;
+                Current.Version = Slot->Version;
+                return urConflict;
+            }
+
+            Slot->Balance = _Stored(Balance);
+            Slot->Version++;
+            Current.Balance = Slot->Balance;
+            Current.Version = Slot->Version;
+        }
+        _NoteChange();
+        return urDone;
+    }
+
+    bool SetBalance(string_view Account, double Balance)
+    {
+        // bulk jobs (clsAccountTable::SaveBalances): a changed balance is a new version
+        stSlot *Slot = _Find(Account);
+        if (Slot == nullptr)
+            return false;
+
+        {
+            clsShardLock Lock(*this, *Slot);
+            if (!Lock.IsLocked())
+                return false;
+
+            double Stored = _Stored(Balance);
+            if (Stored == Slot->Balance)
+                return true;
+            Slot->Balance = Stored;
+            Slot->Version++;
+        }
+        _NoteChange();
+        return true;
+    }
+
+    bool AddAccount(string_view Account, double Balance, unsigned long long Version)
+    {
+        if (!_LockMutex(_Header->InsertMutex))
+            return false;
+        bool Added = _InsertUnlocked(Account, _Stored(Balance), Version);
+        _UnlockMutex(_Header->InsertMutex);
+        return Added;
+    }
+
+    bool RemoveAccount(string_view Account)
+    {
+        if (!_LockMutex(_Header->InsertMutex))
+            return false;
+
+        stSlot *Slot = _Find(Account);
+        if (Slot != nullptr)
+        {
+            Slot->State.store(ssDeleted, memory_order_release);
+            _Header->Accounts--;
+        }
+        _UnlockMutex(_Header->InsertMutex);
+        return Slot != nullptr;
+    }
+
+    void Checkpoint()
+    {
+        _LockFiles(true);
+        _WriteCheckpoint();
+        _UnlockFiles();
+    }
+
+    size_t Accounts() const { return (size_t)_Header->Accounts.load(); }
+    size_t Capacity() const { return (size_t)_Header->Capacity; }
+    size_t AttachedProcesses() const { return _AttachedProcesses(); }
+    size_t RecoveredLocks() const { return (size_t)_Header->Recovered.load(); }
+    unsigned long long Generation() const { return _Header->Generation.load(); }
+    const string &SegmentName() const { return _SegmentName; }
+
+    //---------------------------------------------
+    // Guards
+    //---------------------------------------------
+    class clsWriteGuard
+    {
+        // Held around every write to the clients store in shared mode, so it
+        // cannot interleave with a checkpoint (or another process's write).
+    private:
+        clsSharedAccountTable *_Table;
+
+    public:
+        clsWriteGuard() : _Table(Active())
+        {
+            if (_Table != nullptr)
+                _Table->_LockFiles(true);
+        }
+
+        ~clsWriteGuard()
+        {
+            // the store changed: caches of it (clsClientTableRcu) reload
+            if (_Table != nullptr)
+            {
+                _Table->_Header->Generation++;
+                _Table->_UnlockFiles();
+            }
+        }
+
+        clsWriteGuard(const clsWriteGuard &) = delete;
+        clsWriteGuard &operator=(const clsWriteGuard &) = delete;
+    };
+
+    class clsExclusiveLock
+    {
+        // The file lock, then every shard mutex in order: no balance changes
+        // until it is released. Bulk jobs (batch postings) hold it from Load()
+        // to SaveBalances(). Always file lock first, shards second (as
+        // clsWriteGuard + SetBalance and checkpoints do), so no two holders
+        // wait on each other.
+    private:
+        clsSharedAccountTable *_Table;
+        unsigned int _Locked = 0;
+
+    public:
+        clsExclusiveLock() : _Table(Active())
+        {
+            if (_Table == nullptr)
+                return;
+            _Table->_LockFiles(true);
+            while (_Locked < ShardCount && _Table->_LockMutex(_Table->_Header->ShardMutex[_Locked]))
+                _Locked++;
+        }
+
+        ~clsExclusiveLock()
+        {
+            if (_Table == nullptr)
+                return;
+            while (_Locked > 0)
+                _Table->_UnlockMutex(_Table->_Header->ShardMutex[--_Locked]);
+            _Table->_UnlockFiles();
+        }
+
+        clsExclusiveLock(const clsExclusiveLock &) = delete;
+        clsExclusiveLock &operator=(const clsExclusiveLock &) = delete;
+    };
+};
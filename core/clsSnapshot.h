@@ -0,0 +1,722 @@
+/*clsSnapshot Overview
+================================================================================
+                                 clsSnapshot.h
+================================================================================
+Overview:
+---------
+This file defines the clsSnapshot class, a versioned binary image of the
+record files (Clients.txt, Admins.text, Currencies.txt) plus the running
+totals, so a terminal can come up without parsing millions of text lines.
+
+A snapshot is opened with clsMappedFile (mmap / MapViewOfFile, copy-on-write):
+rows are used where they lie in the file, nothing is split, converted or
+copied, and only the pages that are touched are read from disk.
+
+================================================================================
+Load = Snapshot + Log Tail:
+---------------------------
+The snapshot remembers where AllTransactions.txt ended when it was written
+(clsSegmentedLog::stLogPosition). Load() maps the image and replays only the
+transaction lines written after that point:
+
+    BalanceAfter of every line -> balance of the account it belongs to
+    (FromAccount for WITHDRAW / *_OUT, ToAccount for DEPOSIT / *_IN)
+
+Replay sets balances (it never adds), so a line whose balance was already in
+the snapshot is harmless. Replayed rows are patched in the private mapping;
+the file on disk is not changed.
+
+Changes that are not in the transaction log make a snapshot stale:
+
+- clients added, deleted, or saved through Save() (profile edits, balances
+  typed by an admin): clsBankClient calls Invalidate() after the write, which
+  removes the snapshot file. Deposit / Withdraw are logged, so they are
+  replayed instead.
+- Admins.text / Currencies.txt: their size and write time are stored, and
+  AdminsCurrent() / CurrenciesCurrent() tell whether those sections still
+  match the files.
+
+Load() returns nullptr when there is no usable snapshot (missing, other
+version, damaged, or the log no longer holds its position); callers then read
+the text files as before.
+
+================================================================================
+File Layout (native byte order, 8-byte aligned sections):
+---------------------------------------------------------
+    stHeader                      magic "SBSNAP", version, counts, totals,
+                                  log position, file stamps, section offsets,
+                                  CRC-32 of the header and of the body
+    stClientRow   [Clients]       account key, balance, text offset / length
+    unsigned int  [Clients]       row numbers sorted by account (binary search)
+    stLineRow     [Admins]        text offset / length
+    stLineRow     [Currencies]    text offset / length
+    text                          the record lines, as stored in the files
+
+Client rows keep the order of Clients.txt, so a table built from a snapshot
+writes the file back in the same order.
+
+The snapshot lives under clsStorage's data root and describes the text
+backend only: with the memory or binary backend Load() returns nullptr and
+Write() / WriteIfDue() do nothing.
+
+================================================================================
+Writing:
+--------
+Write() reads the three files once and writes "<snapshot>.tmp", then renames
+it over the snapshot. WriteIfDue() is called from the start-up loop and writes
+(as a background task of the shared thread pool, clsThreadPool, by default)
+when:
+
+- there is no snapshot, or a stamped file changed, or
+- SnapshotEveryLogBytes of transaction log were written since the last one, or
+- the log grew and the snapshot is older than MaxSnapshotAgeSeconds.
+
+An Invalidate() that happens while a snapshot is being written cancels that
+snapshot, so a write never publishes data older than the change. Snapshots
+are written by the process that runs the start-up loop; writers in other
+processes are not coordinated.
+
+================================================================================
+Public Methods:
+---------------
+    static shared_ptr<const clsSnapshot> Load()
+    static stWriteResult Write()
+    static bool WriteIfDue()
+    static void Invalidate()
+
+    size_t ClientCount() const
+    const stClientRow &ClientRow(size_t Index) const
+    string_view ClientLine(size_t Index) const    stored line (balance column may be older)
+    int FindClient(string_view AccountNumber) const
+    double TotalBalances() const
+    size_t AdminCount() const / string_view AdminLine(size_t Index) const
+    size_t CurrencyCount() const / string_view CurrencyLine(size_t Index) const
+    bool AdminsCurrent() const / bool CurrenciesCurrent() const
+    size_t ReplayedRecords() const
+    long long CreatedAt() const
+
+Settings:
+    SnapshotFileName       (default "SmartBank.snapshot", under clsStorage's data root)
+    SnapshotEveryLogBytes  (default 1 MB)
+    MaxSnapshotAgeSeconds  (default 3600)
+    BackgroundSnapshots    (default true)
+    VerifyChecksum         (default true, once per snapshot file per process)
+
+================================================================================
+Usage Example:
+--------------
+    shared_ptr<const clsSnapshot> Snapshot = clsSnapshot::Load();
+    if (Snapshot)
+    {
+        int Row = Snapshot->FindClient("A101");
+        double Balance = (Row >= 0) ? Snapshot->ClientRow(Row).Balance : 0;
+    }
+
+================================================================================
+*/
+
+#pragma once
+
+#include <iostream>
+#include <fstream>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <memory>
+#include <mutex>
+#include <atomic>
+#include <chrono>
+#include <ctime>
+#include <cstring>
+#include <cstddef>
+#include <algorithm>
+#include <filesystem>
+
+#include "../utils/clsString.h"       // utils/clsString.h
+#include "../utils/clsFixedString.h"  // utils/clsFixedString.h
+#include "../utils/clsCompressor.h"   // utils/clsCompressor.h
+#include "../utils/clsMappedFile.h"   // utils/clsMappedFile.h
+#include "../utils/clsThreadPool.h"   // utils/clsThreadPool.h
+#include "clsRecordFile.h"            // core/clsRecordFile.h
+#include "clsStorage.h"               // core/clsStorage.h
+#include "clsSegmentedLog.h"          // core/clsSegmentedLog.h
+#include "clsTransactionLogger.h"     // core/clsTransactionLogger.h
+
+using namespace std;
+
+class clsSnapshot
+{
+public:
+    static const unsigned int FormatVersion = 1;
+
+    // Policy
+    inline static string SnapshotFileName = "SmartBank.snapshot"; // under the data root
+    inline static long long SnapshotEveryLogBytes = 1024 * 1024;
+    inline static long long MaxSnapshotAgeSeconds = 3600;
+    inline static bool BackgroundSnapshots = true;
+    inline static bool VerifyChecksum = true;
+
+    struct stClientRow
+    {
+        clsAccountNumber Account;
+        double Balance;
+        unsigned long long TextOffset;
+        unsigned int TextLength;
+        unsigned int Reserved;
+    };
+
+    struct stLineRow
+    {
+        unsigned long long TextOffset;
+        unsigned int TextLength;
+        unsigned int Reserved;
+    };
+
+    struct stWriteResult
+    {
+        bool Written = false;
+        size_t Clients = 0;
+        size_t Admins = 0;
+        size_t Currencies = 0;
+        long long Bytes = 0;
+        double Seconds = 0;
+    };
+
+private:
+    struct stFileStamp
+    {
+        long long Bytes = -1;
+        long long WriteTime = 0;
+
+        bool operator==(const stFileStamp &Other) const
+        {
+            return Bytes == Other.Bytes && WriteTime == Other.WriteTime;
+        }
+    };
+
+    struct stHeader
+    {
+        char Magic[8];
+        unsigned int Version;
+        unsigned int HeaderBytes;
+        long long CreatedAt;
+        unsigned long long ClientCount;
+        unsigned long long AdminCount;
+        unsigned long long CurrencyCount;
+        double TotalBalances;
+        long long LogActiveBytes;
+        int LogClosedSeq;
+        unsigned int Reserved;
+        stFileStamp AdminsStamp;
+        stFileStamp CurrenciesStamp;
+        unsigned long long ClientRowsOffset;
+        unsigned long long ClientIndexOffset;
+        unsigned long long AdminRowsOffset;
+        unsigned long long CurrencyRowsOffset;
+        unsigned long long TextOffset;
+        unsigned long long FileBytes;
+        unsigned int BodyChecksum;
+        unsigned int HeaderChecksum; // CRC-32 of every header byte before this field
+    };
+
+    static_assert(sizeof(stClientRow) == 40, "snapshot client row layout is part of the file format");
+    static_assert(sizeof(stLineRow) == 16, "snapshot line row layout is part of the file format");
+    static_assert(sizeof(stHeader) % 8 == 0, "snapshot sections are 8-byte aligned");
+
+    static constexpr const char *_Magic = "SBSNAP";
+    static string _SnapshotPath() { return clsStorage::Path(SnapshotFileName); }
+    static string _ClientsPath() { return clsStorage::Path(clsStorage::ClientsFile); }
+    static string _AdminsPath() { return clsStorage::Path(clsStorage::AdminsFile); }
+    static string _CurrenciesPath() { return clsStorage::Path(clsStorage::CurrenciesFile); }
+    static string _TransactionsPath() { return clsStorage::Path("AllTransactions.txt"); }
+
+    clsMappedFile _File;
+    stHeader _Header;
+    stClientRow *_ClientRows = nullptr;
+    const unsigned int *_ClientIndex = nullptr;
+    const stLineRow *_AdminRows = nullptr;
+    const stLineRow *_CurrencyRows = nullptr;
+    const char *_Text = nullptr;
+    double _TotalBalances = 0;
+    size_t _ReplayedRecords = 0;
+    bool _AdminsCurrent = false;
+    bool _CurrenciesCurrent = false;
+
+    clsSnapshot() {}
+
+    //---------------------------------------------
+    // Process-wide state
+    //---------------------------------------------
+    struct stState
+    {
+        mutex Mutex;
+        unsigned long long Generation = 0; // bumped by Invalidate()
+        stFileStamp VerifiedStamp;         // snapshot file whose body CRC was checked
+        atomic<bool> Writing{false};
+    };
+
+    static stState &_State()
+    {
+        static stState State;
+        return State;
+    }
+
+    //---------------------------------------------
+    // Helpers
+    //---------------------------------------------
+    static stFileStamp _StampOf(const string &Path)
+    {
+        stFileStamp Stamp;
+        error_code Error;
+        uintmax_t Bytes = filesystem::file_size(Path, Error);
+        if (Error)
+            return Stamp;
+
+        filesystem::file_time_type WriteTime = filesystem::last_write_time(Path, Error);
+        if (Error)
+            return Stamp;
+
+        Stamp.Bytes = (long long)Bytes;
+        Stamp.WriteTime = (long long)WriteTime.time_since_epoch().count();
+        return Stamp;
+    }
+
+    static unsigned int _HeaderChecksum(const stHeader &Header)
+    {
+        return clsCompressor::Crc32(string_view((const char *)&Header, offsetof(stHeader, HeaderChecksum)));
+    }
+
+    static void _ReadLiveLines(const string &Path, vector<string> &vLines)
+    {
+        ifstream MyFile(Path, ios::in | ios::binary);
+        if (!MyFile.is_open())
+            return;
+
+        string Line;
+        while (getline(MyFile, Line))
+        {
+            if (!Line.empty() && Line.back() == '\r')
+                Line.pop_back();
+            if (Line.empty() || clsRecordFile::IsTombstone(Line))
+                continue;
+            vLines.push_back(move(Line));
+        }
+    }
+
+    static void _Pad(string &Body)
+    {
+        Body.append((8 - Body.size() % 8) % 8, '\0');
+    }
+
+    template <typename T>
+    static void _AppendRaw(string &Body, const T &Value)
+    {
+        Body.append((const char *)&Value, sizeof(T));
+    }
+
+    static long long _LogBytesSince(const clsSegmentedLog::stLogPosition &Since)
+    {
+        // bytes of transaction log written after Since (closed segments + active file)
+        clsSegmentedLog::stLogPosition Now = clsSegmentedLog::GetEndPosition(_TransactionsPath());
+        if (Now.ClosedSeq == Since.ClosedSeq)
+            return Now.ActiveBytes - Since.ActiveBytes;
+
+        long long Bytes = Now.ActiveBytes - Since.ActiveBytes;
+        for (const clsSegmentedLog::stSegmentInfo &Info : clsSegmentedLog::LoadManifest(_TransactionsPath()))
+        {
+            if (Info.Seq > Since.ClosedSeq)
+                Bytes += Info.RawBytes;
+        }
+        return Bytes;
+    }
+
+    static bool _ReadHeader(stHeader &Header)
+    {
+        // header only: WriteIfDue() runs on every pass of the start-up loop
+        ifstream MyFile(_SnapshotPath(), ios::in | ios::binary);
+        if (!MyFile.is_open() || !MyFile.read((char *)&Header, sizeof(stHeader)))
+            return false;
+
+        return strncmp(Header.Magic, _Magic, sizeof(Header.Magic)) == 0 &&
+               Header.Version == FormatVersion &&
+               Header.HeaderBytes == sizeof(stHeader) &&
+               Header.HeaderChecksum == _HeaderChecksum(Header);
+    }
+
+    bool _Attach()
+    {
+        // validate the mapped image and point the section pointers into it
+        if (_File.Size() < sizeof(stHeader))
+            return false;
+
+        memcpy(&_Header, _File.Data(), sizeof(stHeader));
+        if (strncmp(_Header.Magic, _Magic, sizeof(_Header.Magic)) != 0 ||
+            _Header.Version != FormatVersion ||
+            _Header.HeaderBytes != sizeof(stHeader) ||
+            _Header.HeaderChecksum != _HeaderChecksum(_Header) ||
+            _Header.FileBytes != _File.Size())
+            return false;
+
+        unsigned long long Size = _File.Size();
+        if (_Header.ClientRowsOffset + _Header.ClientCount * sizeof(stClientRow) > Size ||
+            _Header.ClientIndexOffset + _Header.ClientCount * sizeof(unsigned int) > Size ||
+            _Header.AdminRowsOffset + _Header.AdminCount * sizeof(stLineRow) > Size ||
+            _Header.CurrencyRowsOffset + _Header.CurrencyCount * sizeof(stLineRow) > Size ||
+            _Header.TextOffset > Size)
+            return false;
+
+        if (VerifyChecksum)
+        {
+            // the body is checked once per snapshot file and process: later
+            // loads of the same file only map it
+            stFileStamp Stamp = _StampOf(_SnapshotPath());
+            stState &State = _State();
+            lock_guard<mutex> Lock(State.Mutex);
+
+            if (!(State.VerifiedStamp == Stamp))
+            {
+                string_view Body(_File.Data() + sizeof(stHeader), _File.Size() - sizeof(stHeader));
+                if (clsCompressor::Crc32(Body) != _Header.BodyChecksum)
+                {
+                    cerr << "Error: Snapshot " << _SnapshotPath() << " is corrupted, reading the data files.\n";
+                    return false;
+                }
+                State.VerifiedStamp = Stamp;
+            }
+        }
+
+        char *Base = _File.Data();
+        _ClientRows = (stClientRow *)(Base + _Header.ClientRowsOffset);
+        _ClientIndex = (const unsigned int *)(Base + _Header.ClientIndexOffset);
+        _AdminRows = (const stLineRow *)(Base + _Header.AdminRowsOffset);
+        _CurrencyRows = (const stLineRow *)(Base + _Header.CurrencyRowsOffset);
+        _Text = Base + _Header.TextOffset;
+        _TotalBalances = _Header.TotalBalances;
+        return true;
+    }
+
+    bool _ReplayLogTail()
+    {
+        // Replay process steps:
+        // 1. Visit the transaction lines written after the snapshot's log position.
+        // 2. Pick the account whose balance the line carries (From or To side).
+        // 3. Set that row's balance to BalanceAfter, stored like Clients.txt stores
+        //    it (a float with 6 decimals), and move the running total by the difference.
+        // An account missing from the snapshot means a change the log does not
+        // describe: the snapshot is not used.
+        clsSegmentedLog::stLogPosition Position;
+        Position.ClosedSeq = _Header.LogClosedSeq;
+        Position.ActiveBytes = _Header.LogActiveBytes;
+
+        bool Consistent = true;
+        bool Complete = clsSegmentedLog::ForEachLineAfter(_TransactionsPath(), Position, [this, &Consistent](const string &Line)
+                                                          {
+                                                              typedef clsTransactionLogger Logger;
+                                                              unsigned int Bit = Logger::TypeBit(Logger::OperationTypeFromString(clsString::GetFieldView(Line, "#//#", 3)));
+
+                                                              string_view Account;
+                                                              if (Bit & Logger::FromSideMask)
+                                                                  Account = clsString::GetFieldView(Line, "#//#", 5);
+                                                              else if (Bit & Logger::ToSideMask)
+                                                                  Account = clsString::GetFieldView(Line, "#//#", 6);
+                                                              else
+                                                                  return;
+
+                                                              int Row = FindClient(Account);
+                                                              if (Row < 0)
+                                                              {
+                                                                  Consistent = false;
+                                                                  return;
+                                                              }
+
+                                                              double BalanceAfter = strtod(string(clsString::GetFieldView(Line, "#//#", 7)).c_str(), nullptr);
+                                                              double Stored = stod(to_string((float)BalanceAfter));
+
+                                                              _TotalBalances += Stored - _ClientRows[Row].Balance;
+                                                              _ClientRows[Row].Balance = Stored;
+                                                              _ReplayedRecords++;
+                                                          });
+        return Complete && Consistent;
+    }
+
+    string_view _LineAt(const stLineRow &Row) const
+    {
+        return string_view(_Text + Row.TextOffset, Row.TextLength);
+    }
+
+public:
+    //---------------------------------------------
+    // Load
+    //---------------------------------------------
+    static shared_ptr<const clsSnapshot> Load()
+    {
+        // Load process steps:
+        // 1. Map the snapshot file (nothing is read yet).
+        // 2. Check magic, version, header CRC, section bounds; the body CRC once per file.
+        // 3. Replay the transaction log written after the snapshot.
+        // 4. Compare the stored Admins / Currencies stamps with the files.
+        if (clsStorage::GetBackend() != clsStorage::bkText)
+            return nullptr; // the snapshot describes the text files only
+
+        shared_ptr<clsSnapshot> Snapshot(new clsSnapshot());
+
+        if (!Snapshot->_File.Open(_SnapshotPath()) || !Snapshot->_Attach() || !Snapshot->_ReplayLogTail())
+            return nullptr;
+
+        Snapshot->_AdminsCurrent = (Snapshot->_Header.AdminsStamp == _StampOf(_AdminsPath()));
+        Snapshot->_CurrenciesCurrent = (Snapshot->_Header.CurrenciesStamp == _StampOf(_CurrenciesPath()));
+        return Snapshot;
+    }
+
+    //---------------------------------------------
+    // Write
+    //---------------------------------------------
+    static stWriteResult Write()
+    {
+        // Write process steps:
+        // 1. Remember the invalidation generation, the end of the transaction
+        //    log and the stamps of Admins / Currencies BEFORE reading anything,
+        //    so whatever changes during the read is replayed or detected later.
+        // 2. Read the live lines of the three files.
+        // 3. Build the image in memory: client rows (file order), the sorted
+        //    account index, admin / currency rows, the text, then both CRCs.
+        // 4. Write "<snapshot>.tmp" and rename it over the snapshot, unless
+        //    Invalidate() ran since step 1.
+        auto Start = chrono::steady_clock::now();
+        stWriteResult Result;
+        stState &State = _State();
+        if (clsStorage::GetBackend() != clsStorage::bkText)
+            return Result;
+
+        unsigned long long StartGeneration;
+        {
+            lock_guard<mutex> Lock(State.Mutex);
+            StartGeneration = State.Generation;
+        }
+
+        stHeader Header{};
+        strncpy(Header.Magic, _Magic, sizeof(Header.Magic));
+        Header.Version = FormatVersion;
+        Header.HeaderBytes = sizeof(stHeader);
+        Header.CreatedAt = (long long)time(nullptr);
+
+        clsSegmentedLog::stLogPosition LogEnd = clsSegmentedLog::GetEndPosition(_TransactionsPath());
+        Header.LogClosedSeq = LogEnd.ClosedSeq;
+        Header.LogActiveBytes = LogEnd.ActiveBytes;
+        Header.AdminsStamp = _StampOf(_AdminsPath());
+        Header.CurrenciesStamp = _StampOf(_CurrenciesPath());
+
+        vector<string> vClients, vAdmins, vCurrencies;
+        _ReadLiveLines(_ClientsPath(), vClients);
+        _ReadLiveLines(_AdminsPath(), vAdmins);
+        _ReadLiveLines(_CurrenciesPath(), vCurrencies);
+
+        Header.ClientCount = vClients.size();
+        Header.AdminCount = vAdmins.size();
+        Header.CurrencyCount = vCurrencies.size();
+
+        // section offsets
+        unsigned long long Offset = sizeof(stHeader);
+        Header.ClientRowsOffset = Offset;
+        Offset += vClients.size() * sizeof(stClientRow);
+        Header.ClientIndexOffset = Offset;
+        Offset += vClients.size() * sizeof(unsigned int);
+        Offset += (8 - Offset % 8) % 8;
+        Header.AdminRowsOffset = Offset;
+        Offset += vAdmins.size() * sizeof(stLineRow);
+        Header.CurrencyRowsOffset = Offset;
+        Offset += vCurrencies.size() * sizeof(stLineRow);
+        Header.TextOffset = Offset;
+
+        string Body;
+        unsigned long long TextBytes = 0;
+        for (const vector<string> *vLines : {&vClients, &vAdmins, &vCurrencies})
+            for (const string &Line : *vLines)
+                TextBytes += Line.size();
+        Body.reserve((size_t)(Offset + TextBytes));
+        Body.append(sizeof(stHeader), '\0'); // header is filled in last
+
+        // client rows, in file order
+        vector<stClientRow> vRows(vClients.size()); // value-initialized: no stray bytes in the file
+        unsigned long long TextOffset = 0;
+        for (size_t i = 0; i < vClients.size(); i++)
+        {
+            string_view Balance = clsString::GetFieldView(vClients[i], " || ", 6);
+
+            stClientRow &Row = vRows[i];
+            Row.Account = clsAccountNumber(clsString::GetFieldView(vClients[i], " || ", 4));
+            Row.Balance = Balance.empty() ? 0.0 : stod(string(Balance));
+            Row.TextOffset = TextOffset;
+            Row.TextLength = (unsigned int)vClients[i].size();
+            TextOffset += vClients[i].size();
+
+            Header.TotalBalances += Row.Balance;
+        }
+        Body.append((const char *)vRows.data(), vRows.size() * sizeof(stClientRow));
+
+        // account index
+        vector<unsigned int> vIndex(vClients.size());
+        for (size_t i = 0; i < vIndex.size(); i++)
+            vIndex[i] = (unsigned int)i;
+        sort(vIndex.begin(), vIndex.end(), [&vRows](unsigned int Left, unsigned int Right)
+             { return vRows[Left].Account.View() < vRows[Right].Account.View(); });
+        Body.append((const char *)vIndex.data(), vIndex.size() * sizeof(unsigned int));
+        _Pad(Body);
+
+        // admin / currency rows
+        for (const vector<string> *vLines : {&vAdmins, &vCurrencies})
+        {
+            for (const string &Line : *vLines)
+            {
+                stLineRow Row{};
+                Row.TextOffset = TextOffset;
+                Row.TextLength = (unsigned int)Line.size();
+                TextOffset += Line.size();
+                _AppendRaw(Body, Row);
+            }
+        }
+
+        // text
+        for (const vector<string> *vLines : {&vClients, &vAdmins, &vCurrencies})
+            for (const string &Line : *vLines)
+                Body += Line;
+
+        Header.FileBytes = Body.size();
+        Header.BodyChecksum = clsCompressor::Crc32(string_view(Body).substr(sizeof(stHeader)));
+        Header.HeaderChecksum = _HeaderChecksum(Header);
+        memcpy(&Body[0], &Header, sizeof(stHeader));
+
+        string TempPath = _SnapshotPath() + ".tmp";
+        {
+            ofstream MyFile(TempPath, ios::out | ios::binary | ios::trunc);
+            if (!MyFile.is_open() || !MyFile.write(Body.data(), (streamsize)Body.size()))
+            {
+                cerr << "Error: Cannot write snapshot " << TempPath << ".\n";
+                return Result;
+            }
+        }
+
+        {
+            lock_guard<mutex> Lock(State.Mutex);
+            error_code Error;
+            if (State.Generation != StartGeneration)
+            {
+                filesystem::remove(TempPath, Error); // data changed while we were reading it
+                return Result;
+            }
+
+            filesystem::rename(TempPath, _SnapshotPath(), Error);
+            if (Error)
+            {
+                filesystem::remove(TempPath, Error);
+                return Result;
+            }
+        }
+
+        Result.Written = true;
+        Result.Clients = vClients.size();
+        Result.Admins = vAdmins.size();
+        Result.Currencies = vCurrencies.size();
+        Result.Bytes = (long long)Body.size();
+        Result.Seconds = chrono::duration<double>(chrono::steady_clock::now() - Start).count();
+        return Result;
+    }
+
+    static bool WriteIfDue()
+    {
+        // Returns true when a snapshot write was started (or done, when
+        // BackgroundSnapshots is off). Only the header is read to decide.
+        if (clsStorage::GetBackend() != clsStorage::bkText)
+            return false;
+
+        stHeader Header;
+        bool Due = true;
+
+        if (_ReadHeader(Header))
+        {
+            clsSegmentedLog::stLogPosition Since;
+            Since.ClosedSeq = Header.LogClosedSeq;
+            Since.ActiveBytes = Header.LogActiveBytes;
+
+            long long LogBytes = _LogBytesSince(Since);
+            long long AgeSeconds = (long long)time(nullptr) - Header.CreatedAt;
+
+            Due = !(Header.AdminsStamp == _StampOf(_AdminsPath())) ||
+                  !(Header.CurrenciesStamp == _StampOf(_CurrenciesPath())) ||
+                  LogBytes < 0 || LogBytes >= SnapshotEveryLogBytes ||
+                  (LogBytes > 0 && AgeSeconds >= MaxSnapshotAgeSeconds);
+        }
+
+        if (!Due)
+            return false;
+
+        stState &State = _State();
+        if (State.Writing.exchange(true))
+            return false; // one writer at a time
+
+        if (BackgroundSnapshots)
+        {
+            clsThreadPool::Shared().Submit([]()
+                                           {
+                                               Write();
+                                               _State().Writing = false; }, "SnapshotWrite");
+        }
+        else
+        {
+            Write();
+            State.Writing = false;
+        }
+        return true;
+    }
+
+    static void Invalidate()
+    {
+        // called after a change the transaction log does not describe
+        stState &State = _State();
+        lock_guard<mutex> Lock(State.Mutex);
+
+        State.Generation++;
+        error_code Error;
+        filesystem::remove(_SnapshotPath(), Error);
+    }
+
+    //---------------------------------------------
+    // Access
+    //---------------------------------------------
+    size_t ClientCount() const { return (size_t)_Header.ClientCount; }
+    const stClientRow &ClientRow(size_t Index) const { return _ClientRows[Index]; }
+
+    string_view ClientLine(size_t Index) const
+    {
+        const stClientRow &Row = _ClientRows[Index];
+        return string_view(_Text + Row.TextOffset, Row.TextLength);
+    }
+
+    int FindClient(string_view AccountNumber) const
+    {
+        // binary search through the sorted index, keys compared in place
+        const unsigned int *First = _ClientIndex;
+        const unsigned int *Last = _ClientIndex + _Header.ClientCount;
+
+        const unsigned int *It = lower_bound(First, Last, AccountNumber, [this](unsigned int Row, string_view Key)
+                                             { return _ClientRows[Row].Account.View() < Key; });
+
+        if (It == Last || _ClientRows[*It].Account != AccountNumber)
+            return -1;
+        return (int)*It;
+    }
+
+    double TotalBalances() const { return _TotalBalances; }
+
+    size_t AdminCount() const { return (size_t)_Header.AdminCount; }
+    string_view AdminLine(size_t Index) const { return _LineAt(_AdminRows[Index]); }
+
+    size_t CurrencyCount() const { return (size_t)_Header.CurrencyCount; }
+    string_view CurrencyLine(size_t Index) const { return _LineAt(_CurrencyRows[Index]); }
+
+    bool AdminsCurrent() const { return _AdminsCurrent; }
+    bool CurrenciesCurrent() const { return _CurrenciesCurrent; }
+
+    size_t ReplayedRecords() const { return _ReplayedRecords; }
+    long long CreatedAt() const { return _Header.CreatedAt; }
+};
@@ -0,0 +1,259 @@
+/*clsSqliteDatabase Overview
+================================================================================
+                             clsSqliteDatabase.h
+================================================================================
+Overview:
+---------
+This file defines clsSqliteDatabase, the one SQLite connection behind the
+optional "sqlite" storage backend (clsSqliteRecordStore, clsSqliteLogStore).
+It is only compiled when SMARTBANK_WITH_SQLITE is defined, so the default
+build needs neither sqlite3.h nor the library:
+
+    g++ -std=c++17 -DSMARTBANK_WITH_SQLITE "SmartBank System & ATM.cpp" -lsqlite3
+
+- The database is opened in WAL journal mode with synchronous=NORMAL: a
+  commit appends to the -wal file without waiting for fsync, readers never
+  block the writer, and other processes on the same data root wait up to
+  BusyTimeoutMs for the write lock instead of failing.
+- clsStatement wraps a prepared statement. Stores prepare their statements
+  once and only bind / step / reset them per call; SQL text is never built
+  from record data.
+- clsTransaction groups many writes into one commit (batched commits):
+  AppendAll(), ReplaceAll(), AppendLines() and the migration tool write whole
+  batches inside one transaction; a single write commits on its own.
+- One connection is shared by every store of a data root. GetMutex() is
+  recursive, so a ForEach() visitor of one store may use another store; a
+  visitor must not call back into the store it is visiting.
+
+================================================================================
+Public Methods:
+---------------
+    clsSqliteDatabase(const string &Path)       opens (or creates) the file
+    bool IsOpen() const
+    bool Execute(const string &Sql)             statements without results
+    string LastError()
+    recursive_mutex &GetMutex()
+    sqlite3 *Handle()
+
+    clsStatement(clsSqliteDatabase &Database, const string &Sql)
+        Bind(Index, string_view) / Bind(Index, long long) / BindNull(Index)
+        bool Step()                             true while a row is available
+        bool Run()                              step to the end, true when done
+        string_view ColumnText(Index) / long long ColumnInt(Index)
+        int Changes() / void Reset()
+
+    clsTransaction(clsSqliteDatabase &Database)  BEGIN IMMEDIATE
+        bool Commit()                           not committed -> ROLLBACK
+
+================================================================================
+Usage Example:
+--------------
+    clsSqliteDatabase Database("../data/SmartBank.db");
+    clsSqliteDatabase::clsStatement Insert(Database, "INSERT INTO T(Line) VALUES(?1)");
+
+    clsSqliteDatabase::clsTransaction Batch(Database);
+    for (const string &Line : vLines)
+        Insert.Bind(1, Line).Run();
+    Batch.Commit();
+
+================================================================================
+*/
+
+#pragma once
+
+#ifdef SMARTBANK_WITH_SQLITE
+
+#include <string>
+#include <string_view>
+#include <mutex>
+#include <sqlite3.h>
+
+using namespace std;
+
+class clsSqliteDatabase
+{
+private:
+    sqlite3 *_Database = nullptr;
+    recursive_mutex _Mutex;
+
+public:
+    static const int BusyTimeoutMs = 5000;
+
+    class clsStatement
+    {
+    private:
+        sqlite3_stmt *_Statement = nullptr;
+        sqlite3 *_Database = nullptr;
+
+    public:
+        clsStatement(clsSqliteDatabase &Database, const string &Sql) : _Database(Database.Handle())
+        {
+            if (_Database != nullptr)
+                sqlite3_prepare_v3(_Database, Sql.c_str(), (int)Sql.size() + 1, SQLITE_PREPARE_PERSISTENT,
+                                   &_Statement, nullptr);
+        }
+
+        ~clsStatement()
+        {
+            sqlite3_finalize(_Statement);
+        }
+
+        clsStatement(const clsStatement &) = delete;
+        clsStatement &operator=(const clsStatement &) = delete;
+
+        bool IsValid() const { return _Statement != nullptr; }
+
+        clsStatement &Bind(int Index, string_view Text)
+        {
+            // SQLITE_TRANSIENT: sqlite copies the text, the caller's buffer may go away
+            sqlite3_bind_text(_Statement, Index, Text.data(), (int)Text.size(), SQLITE_TRANSIENT);
+            return *this;
+        }
+
+        clsStatement &Bind(int Index, long long Value)
+        {
+            sqlite3_bind_int64(_Statement, Index, Value);
+            return *this;
+        }
+
+        clsStatement &BindNull(int Index)
+        {
+            sqlite3_bind_null(_Statement, Index);
+            return *this;
+        }
+
+        bool Step()
+        {
+            return _Statement != nullptr && sqlite3_step(_Statement) == SQLITE_ROW;
+        }
+
+        bool Run()
+        {
+            // Run process steps:
+            // 1. Step until the statement is done (writes return no rows).
+            // 2. Reset it, so the next call starts clean and no read
+            //    transaction stays open.
+            if (_Statement == nullptr)
+                return false;
+
+            int Result;
+            while ((Result = sqlite3_step(_Statement)) == SQLITE_ROW)
+            {
+            }
+            Reset();
+            return Result == SQLITE_DONE;
+        }
+
+        string_view ColumnText(int Index)
+        {
+            const char *Text = (const char *)sqlite3_column_text(_Statement, Index);
+            if (Text == nullptr)
+                return string_view();
+            return string_view(Text, (size_t)sqlite3_column_bytes(_Statement, Index));
+        }
+
+        long long ColumnInt(int Index)
+        {
+            return sqlite3_column_int64(_Statement, Index);
+        }
+
+        int Changes()
+        {
+            return sqlite3_changes(_Database);
+        }
+
+        void Reset()
+        {
+            sqlite3_reset(_Statement);
+            sqlite3_clear_bindings(_Statement);
+        }
+    };
+
+    class clsTransaction
+    {
+    private:
+        clsSqliteDatabase &_Database;
+        lock_guard<recursive_mutex> _Lock;
+        bool _Open = false;
+
+    public:
+        explicit clsTransaction(clsSqliteDatabase &Database) : _Database(Database), _Lock(Database.GetMutex())
+        {
+            // IMMEDIATE: take the write lock now instead of failing half way through
+            _Open = _Database.Execute("BEGIN IMMEDIATE");
+        }
+
+        ~clsTransaction()
+        {
+            if (_Open)
+                _Database.Execute("ROLLBACK");
+        }
+
+        clsTransaction(const clsTransaction &) = delete;
+        clsTransaction &operator=(const clsTransaction &) = delete;
+
+        bool Commit()
+        {
+            if (!_Open)
+                return false;
+            _Open = false;
+            return _Database.Execute("COMMIT");
+        }
+    };
+
+    explicit clsSqliteDatabase(const string &Path)
+    {
+        // clsSqliteDatabase process steps:
+        // 1. Open (or create) the file; the connection is used from several
+        //    threads, always under GetMutex().
+        // 2. WAL + synchronous=NORMAL, and wait for other writers.
+        // 3. A file that is not a database (or cannot switch to WAL) is
+        //    reported by IsOpen() == false.
+        if (sqlite3_open_v2(Path.c_str(), &_Database,
+                            SQLITE_OPEN_READWRITE | SQLITE_OPEN_CREATE | SQLITE_OPEN_FULLMUTEX, nullptr) != SQLITE_OK)
+        {
+            sqlite3_close(_Database);
+            _Database = nullptr;
+            return;
+        }
+
+        sqlite3_busy_timeout(_Database, BusyTimeoutMs);
+
+        if (!Execute("PRAGMA journal_mode=WAL") || !Execute("PRAGMA synchronous=NORMAL"))
+        {
+            sqlite3_close(_Database);
+            _Database = nullptr;
+        }
+    }
+
+    ~clsSqliteDatabase()
+    {
+        // every clsStatement of this connection must be gone by now
+        sqlite3_close(_Database);
+    }
+
+    clsSqliteDatabase(const clsSqliteDatabase &) = delete;
+    clsSqliteDatabase &operator=(const clsSqliteDatabase &) = delete;
+
+    bool IsOpen() const { return _Database != nullptr; }
+
+    sqlite3 *Handle() { return _Database; }
+
+    recursive_mutex &GetMutex() { return _Mutex; }
+
+    bool Execute(const string &Sql)
+    {
+        if (_Database == nullptr)
+            return false;
+
+        lock_guard<recursive_mutex> Lock(_Mutex);
+        return sqlite3_exec(_Database, Sql.c_str(), nullptr, nullptr, nullptr) == SQLITE_OK;
+    }
+
+    string LastError()
+    {
+        return _Database == nullptr ? "database is not open" : sqlite3_errmsg(_Database);
+    }
+};
+
+#endif // SMARTBANK_WITH_SQLITE
@@ -0,0 +1,226 @@
+/*clsSqliteLogStore Overview
+================================================================================
+                             clsSqliteLogStore.h
+================================================================================
+Overview:
+---------
+This file defines clsSqliteLogStore, a clsLogStore kept in one table of the
+SQLite database (clsSqliteDatabase). Only compiled with SMARTBANK_WITH_SQLITE.
+
+Every log line is stored unchanged, next to the values the queries filter on:
+
+    CREATE TABLE <Table> (Seq     INTEGER PRIMARY KEY,   -- append order
+                          DateKey INTEGER NOT NULL,      -- yyyymmdd of the line
+                          Key1 TEXT, Key2 TEXT, Key3 TEXT,
+                          Line    TEXT NOT NULL)
+
+- DateKey is indexed: ForEachLine(Visitor, From, To) reads only the range;
+  without a range the table is read in Seq order.
+- Key1..Key3 hold the log's key columns (KeyColumns, at most three; e.g.
+  user, from and to account for AllTransactions) and each one is indexed, so
+  ForEachLineMentioning("A101") reads the lines of one account instead of the
+  whole history.
+- AppendLines() inserts the whole group in one transaction.
+
+================================================================================
+Public Methods:
+---------------
+    clsLogStore interface, plus
+    bool IsOpen()                       table exists and statements prepared
+    size_t Count()                      lines in the table
+
+================================================================================
+Usage Example:
+--------------
+    clsSqliteDatabase Database("../data/SmartBank.db");
+    clsSqliteLogStore Transactions(Database, "AllTransactions", {2, 5, 6});
+    Transactions.ForEachLineMentioning("A101", Visitor);
+
+================================================================================
+*/
+
+#pragma once
+
+#ifdef SMARTBANK_WITH_SQLITE
+
+#include <string>
+#include <vector>
+#include <memory>
+
+#include "clsLogStore.h"          // core/clsLogStore.h
+#include "clsSegmentedLog.h"      // core/clsSegmentedLog.h
+#include "clsSqliteDatabase.h"    // core/clsSqliteDatabase.h
+#include "../utils/clsString.h"   // utils/clsString.h
+
+using namespace std;
+
+class clsSqliteLogStore : public clsLogStore
+{
+private:
+    typedef clsSqliteDatabase::clsStatement clsStatement;
+
+    static const size_t MaxKeyColumns = 3;
+
+    clsSqliteDatabase &_Database;
+    string _Table;
+    vector<short> _vKeyColumns;
+    bool _Open = false;
+
+    unique_ptr<clsStatement> _Insert;
+    unique_ptr<clsStatement> _SelectAll;
+    unique_ptr<clsStatement> _SelectRange;
+    unique_ptr<clsStatement> _SelectNewestFirst;
+    unique_ptr<clsStatement> _SelectMentioning;
+    unique_ptr<clsStatement> _CountAll;
+
+    bool _InsertLocked(const string &Line)
+    {
+        if (Line.empty())
+            return true;
+
+        _Insert->Bind(1, (long long)clsSegmentedLog::DateKey(string(clsString::GetFieldView(Line, "#//#", 0))));
+        for (size_t i = 0; i < MaxKeyColumns; i++)
+        {
+            if (i < _vKeyColumns.size())
+                _Insert->Bind((int)i + 2, clsString::GetFieldView(Line, "#//#", _vKeyColumns[i]));
+            else
+                _Insert->BindNull((int)i + 2);
+        }
+        return _Insert->Bind(5, Line).Run();
+    }
+
+    void _Visit(clsStatement &Select, const function<bool(const string &Line)> &Visitor)
+    {
+        // caller holds the database mutex and bound the parameters
+        string Line;
+        while (Select.Step())
+        {
+            Line.assign(Select.ColumnText(0));
+            if (Visitor(Line))
+                break;
+        }
+        Select.Reset();
+    }
+
+public:
+    clsSqliteLogStore(clsSqliteDatabase &Database, const string &Table, const vector<short> &vKeyColumns)
+        : _Database(Database), _Table(Table), _vKeyColumns(vKeyColumns)
+    {
+        // clsSqliteLogStore process steps:
+        // 1. Create the table, the DateKey index and one index per key column.
+        // 2. Prepare every statement once. The "mentioning" query is an OR of
+        //    the key columns, which sqlite answers from the key indexes.
+        if (_vKeyColumns.size() > MaxKeyColumns)
+            _vKeyColumns.resize(MaxKeyColumns);
+
+        bool Created = _Database.Execute("CREATE TABLE IF NOT EXISTS " + _Table +
+                                         " (Seq INTEGER PRIMARY KEY, DateKey INTEGER NOT NULL,"
+                                         " Key1 TEXT, Key2 TEXT, Key3 TEXT, Line TEXT NOT NULL)") &&
+                       _Database.Execute("CREATE INDEX IF NOT EXISTS " + _Table + "_DateKey ON " + _Table + " (DateKey)");
+
+        string Mentioning = "";
+        for (size_t i = 1; i <= _vKeyColumns.size(); i++)
+        {
+            string Column = "Key" + to_string(i);
+            Created = Created && _Database.Execute("CREATE INDEX IF NOT EXISTS " + _Table + "_" + Column +
+                                                   " ON " + _Table + " (" + Column + ")");
+            Mentioning += (Mentioning.empty() ? "" : " OR ") + Column + " = ?1";
+        }
+        if (!Created)
+            return;
+
+        _Insert = make_unique<clsStatement>(_Database, "INSERT INTO " + _Table +
+                                                           " (DateKey, Key1, Key2, Key3, Line) VALUES (?1, ?2, ?3, ?4, ?5)");
+        _SelectAll = make_unique<clsStatement>(_Database, "SELECT Line FROM " + _Table + " ORDER BY Seq");
+        _SelectRange = make_unique<clsStatement>(_Database, "SELECT Line FROM " + _Table +
+                                                                " WHERE DateKey BETWEEN ?1 AND ?2 ORDER BY Seq");
+        _SelectNewestFirst = make_unique<clsStatement>(_Database, "SELECT Line FROM " + _Table + " ORDER BY Seq DESC");
+        _SelectMentioning = make_unique<clsStatement>(_Database, "SELECT Line FROM " + _Table + " WHERE " +
+                                                                     (Mentioning.empty() ? "0" : Mentioning) + " ORDER BY Seq");
+        _CountAll = make_unique<clsStatement>(_Database, "SELECT COUNT(*) FROM " + _Table);
+
+        _Open = _Insert->IsValid() && _SelectAll->IsValid() && _SelectRange->IsValid() && _SelectNewestFirst->IsValid() &&
+                _SelectMentioning->IsValid() && _CountAll->IsValid();
+    }
+
+    string BackendName() const override { return "sqlite"; }
+
+    bool IsOpen() const { return _Open; }
+
+    void AppendLine(const string &Line) override
+    {
+        if (!_Open)
+            return;
+
+        lock_guard<recursive_mutex> Lock(_Database.GetMutex());
+        _InsertLocked(Line);
+    }
+
+    void AppendLines(const vector<string> &vLines) override
+    {
+        // group commit: one transaction for the whole batch
+        if (!_Open || vLines.empty())
+            return;
+
+        clsSqliteDatabase::clsTransaction Batch(_Database);
+        for (const string &Line : vLines)
+            _InsertLocked(Line);
+        Batch.Commit();
+    }
+
+    void ForEachLine(const function<void(const string &Line)> &Visitor,
+                     int FromDateKey = 0, int ToDateKey = INT_MAX) override
+    {
+        if (!_Open)
+            return;
+
+        // the whole history is read in table order, a range through the DateKey index
+        bool Ranged = (FromDateKey != 0 || ToDateKey != INT_MAX);
+
+        lock_guard<recursive_mutex> Lock(_Database.GetMutex());
+        if (Ranged)
+            _SelectRange->Bind(1, (long long)FromDateKey).Bind(2, (long long)ToDateKey);
+        _Visit(Ranged ? *_SelectRange : *_SelectAll, [&Visitor](const string &Line)
+               {
+                   Visitor(Line);
+                   return false; });
+    }
+
+    bool ForEachLineNewestFirst(const function<bool(const string &Line)> &Visitor) override
+    {
+        if (!_Open)
+            return false;
+
+        bool Stopped = false;
+        lock_guard<recursive_mutex> Lock(_Database.GetMutex());
+        _Visit(*_SelectNewestFirst, [&Visitor, &Stopped](const string &Line)
+               { return Stopped = Visitor(Line); });
+        return Stopped;
+    }
+
+    void ForEachLineMentioning(string_view Key, const function<void(const string &Line)> &Visitor) override
+    {
+        if (!_Open)
+            return;
+
+        lock_guard<recursive_mutex> Lock(_Database.GetMutex());
+        _SelectMentioning->Bind(1, Key);
+        _Visit(*_SelectMentioning, [&Visitor](const string &Line)
+               {
+                   Visitor(Line);
+                   return false; });
+    }
+
+    size_t Count()
+    {
+        if (!_Open)
+            return 0;
+
+        lock_guard<recursive_mutex> Lock(_Database.GetMutex());
+        size_t Lines = _CountAll->Step() ? (size_t)_CountAll->ColumnInt(0) : 0;
+        _CountAll->Reset();
+        return Lines;
+    }
+};
+
+#endif // SMARTBANK_WITH_SQLITE
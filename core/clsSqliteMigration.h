@@ -0,0 +1,189 @@
+/*clsSqliteMigration Overview
+================================================================================
+                             clsSqliteMigration.h
+================================================================================
+Overview:
+---------
+This file defines clsSqliteMigration, which builds SmartBank.db (the sqlite
+backend, see clsStorage) from the text files of a data root. Only compiled
+with SMARTBANK_WITH_SQLITE. "SmartBank Migrate" is its command-line front end;
+the benchmark uses it to prepare its sqlite runs.
+
+What is imported (the source files are only read, never changed):
+
+    Clients.txt / Admins.text / Currencies.txt   " || " records -> tables
+    AllTransactions.txt (+ closed segments)      "#//#" lines   -> AllTransactions
+    ClientsSessionLog.txt / AdminsSessionLog.txt "#//#" lines   -> ...SessionLog
+
+- Lines are copied unchanged; deleted (tombstoned) records are skipped.
+- Logs are read oldest -> newest through clsSegmentedLog, so the closed,
+  compressed segments are imported too, and written in batches of
+  BatchLines lines, one transaction (one commit) per batch.
+- The database is built as SmartBank.db.tmp and renamed over SmartBank.db
+  only when every table was written, so a failed import never leaves a
+  half-filled database behind. Run it while the application is stopped.
+
+================================================================================
+Public Methods:
+---------------
+    static stResult Import(const string &DataRoot, bool ReplaceExisting)
+
+================================================================================
+Usage Example:
+--------------
+    clsSqliteMigration::stResult Result = clsSqliteMigration::Import("../data/", false);
+    if (!Result.Success)
+        cerr << Result.Error << endl;
+
+================================================================================
+*/
+
+#pragma once
+
+#ifdef SMARTBANK_WITH_SQLITE
+
+#include <string>
+#include <vector>
+#include <chrono>
+#include <filesystem>
+
+#include "clsStorage.h"           // core/clsStorage.h
+#include "clsTextRecordStore.h"   // core/clsTextRecordStore.h
+#include "clsSegmentedLog.h"      // core/clsSegmentedLog.h
+#include "clsSqliteDatabase.h"    // core/clsSqliteDatabase.h
+#include "clsSqliteRecordStore.h" // core/clsSqliteRecordStore.h
+#include "clsSqliteLogStore.h"    // core/clsSqliteLogStore.h
+
+using namespace std;
+
+class clsSqliteMigration
+{
+public:
+    static const size_t BatchLines = 50000;
+
+    struct stResult
+    {
+        bool Success = false;
+        string Error = "";
+        string DatabasePath = "";
+        size_t Clients = 0;
+        size_t Admins = 0;
+        size_t Currencies = 0;
+        size_t Transactions = 0;
+        size_t ClientSessions = 0;
+        size_t AdminSessions = 0;
+        double Seconds = 0;
+    };
+
+private:
+    static bool _ImportRecords(clsSqliteDatabase &Database, const string &Root, const char *FileName,
+                               short KeyColumn, bool IgnoreCase, size_t &Count)
+    {
+        clsTextRecordStore Source(Root + FileName, KeyColumn, IgnoreCase);
+        clsSqliteRecordStore Target(Database, clsStorage::StoreName(FileName), KeyColumn, IgnoreCase);
+        if (!Target.IsOpen())
+            return false;
+
+        Target.ReplaceAll(Source.ReadAll());
+        Count = Target.Count();
+        return true;
+    }
+
+    static bool _ImportLog(clsSqliteDatabase &Database, const string &Root, const char *FileName,
+                           const vector<short> &vKeyColumns, size_t &Count)
+    {
+        clsSqliteLogStore Target(Database, clsStorage::StoreName(FileName), vKeyColumns);
+        if (!Target.IsOpen())
+            return false;
+
+        vector<string> vBatch;
+        vBatch.reserve(BatchLines);
+        clsSegmentedLog::ForEachLine(Root + FileName, [&](const string &Line)
+                                     {
+                                         vBatch.push_back(Line);
+                                         if (vBatch.size() == BatchLines)
+                                         {
+                                             Target.AppendLines(vBatch);
+                                             vBatch.clear();
+                                         } });
+        Target.AppendLines(vBatch);
+
+        Count = Target.Count();
+        return true;
+    }
+
+    static void _RemoveDatabase(const string &Path)
+    {
+        // the database and the WAL side files that belong to it
+        error_code Error;
+        filesystem::remove(Path, Error);
+        filesystem::remove(Path + "-wal", Error);
+        filesystem::remove(Path + "-shm", Error);
+    }
+
+public:
+    static stResult Import(const string &DataRoot, bool ReplaceExisting)
+    {
+        // Import process steps:
+        // 1. Check the data root; an existing SmartBank.db is kept unless
+        //    ReplaceExisting.
+        // 2. Build SmartBank.db.tmp: three record tables, then the three logs.
+        // 3. Close it (sqlite folds the WAL back into the file), then replace
+        //    SmartBank.db and its stale WAL files with it.
+        stResult Result;
+        auto Start = chrono::steady_clock::now();
+
+        string Root = DataRoot;
+        if (!Root.empty() && Root.back() != '/' && Root.back() != '\\')
+            Root += '/';
+
+        Result.DatabasePath = Root + clsStorage::DatabaseFile;
+        string TempPath = Result.DatabasePath + ".tmp";
+
+        error_code Error;
+        if (!Root.empty() && !filesystem::is_directory(Root, Error))
+        {
+            Result.Error = "Data root not found: " + Root;
+            return Result;
+        }
+        if (!ReplaceExisting && filesystem::exists(Result.DatabasePath, Error))
+        {
+            Result.Error = Result.DatabasePath + " already exists";
+            return Result;
+        }
+
+        _RemoveDatabase(TempPath);
+        {
+            clsSqliteDatabase Database(TempPath);
+            bool Imported = Database.IsOpen() &&
+                            _ImportRecords(Database, Root, clsStorage::ClientsFile, clsStorage::ClientsKeyColumn, false, Result.Clients) &&
+                            _ImportRecords(Database, Root, clsStorage::AdminsFile, clsStorage::AdminsKeyColumn, false, Result.Admins) &&
+                            _ImportRecords(Database, Root, clsStorage::CurrenciesFile, clsStorage::CurrenciesKeyColumn, true, Result.Currencies) &&
+                            _ImportLog(Database, Root, clsStorage::TransactionsFile, clsStorage::TransactionsKeyColumns(), Result.Transactions) &&
+                            _ImportLog(Database, Root, clsStorage::ClientSessionsFile, clsStorage::SessionsKeyColumns(), Result.ClientSessions) &&
+                            _ImportLog(Database, Root, clsStorage::AdminSessionsFile, clsStorage::SessionsKeyColumns(), Result.AdminSessions);
+            if (!Imported)
+                Result.Error = "Cannot write " + TempPath + ": " + Database.LastError();
+        }
+
+        if (!Result.Error.empty())
+        {
+            _RemoveDatabase(TempPath);
+            return Result;
+        }
+
+        _RemoveDatabase(Result.DatabasePath);
+        filesystem::rename(TempPath, Result.DatabasePath, Error);
+        if (Error)
+        {
+            Result.Error = "Cannot rename " + TempPath + ": " + Error.message();
+            return Result;
+        }
+
+        Result.Success = true;
+        Result.Seconds = chrono::duration<double>(chrono::steady_clock::now() - Start).count();
+        return Result;
+    }
+};
+
+#endif // SMARTBANK_WITH_SQLITE
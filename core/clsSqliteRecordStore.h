@@ -0,0 +1,274 @@
+/*clsSqliteRecordStore Overview
+================================================================================
+                            clsSqliteRecordStore.h
+================================================================================
+Overview:
+---------
+This file defines clsSqliteRecordStore, a clsRecordStore kept in one table of
+the SQLite database (clsSqliteDatabase). Only compiled with
+SMARTBANK_WITH_SQLITE.
+
+Every record is still the " || " line the classes build and parse; the table
+adds the key next to it so the database can index it:
+
+    CREATE TABLE <Table> (Seq       INTEGER PRIMARY KEY,   -- insertion order
+                          RecordKey TEXT NOT NULL,         -- key column (indexed)
+                          Line      TEXT NOT NULL)
+
+- RecordKey holds the normalized key (upper case when keys ignore case), so
+  Find() on the key column, Replace() and Delete() are one indexed lookup.
+  Find() on any other column scans, like the other backends.
+- The index is not UNIQUE: Currencies.txt lists one code for several
+  countries. As with the text file, Find(), Replace() and Delete() act on the
+  first line (lowest Seq) with the key.
+- ForEach() returns the lines in Seq order, the order the text file had.
+- Every call runs one prepared statement; AppendAll() and ReplaceAll() write
+  all lines in one transaction (one commit for the whole batch).
+- ReplaceIfVersion() and Rewrite() read and update in one IMMEDIATE
+  transaction, so the compare-and-swap holds across processes too.
+
+================================================================================
+Public Methods:
+---------------
+    clsRecordStore interface, plus
+    bool IsOpen()                       table exists and statements prepared
+    size_t Count()                      records in the table
+
+================================================================================
+Usage Example:
+--------------
+    clsSqliteDatabase Database("../data/SmartBank.db");
+    clsSqliteRecordStore Clients(Database, "Clients", 4, false);
+    Clients.Append(Line);
+
+================================================================================
+*/
+
+#pragma once
+
+#ifdef SMARTBANK_WITH_SQLITE
+
+#include <string>
+#include <vector>
+#include <memory>
+
+#include "clsRecordStore.h"    // core/clsRecordStore.h
+#include "clsSqliteDatabase.h" // core/clsSqliteDatabase.h
+
+using namespace std;
+
+class clsSqliteRecordStore : public clsRecordStore
+{
+private:
+    typedef clsSqliteDatabase::clsStatement clsStatement;
+
+    clsSqliteDatabase &_Database;
+    string _Table;
+    bool _Open = false;
+
+    unique_ptr<clsStatement> _SelectAll;
+    unique_ptr<clsStatement> _SelectByKey;
+    unique_ptr<clsStatement> _Insert;
+    unique_ptr<clsStatement> _Update;
+    unique_ptr<clsStatement> _DeleteByKey;
+    unique_ptr<clsStatement> _DeleteAll;
+    unique_ptr<clsStatement> _CountAll;
+
+    bool _InsertLocked(const string &Line)
+    {
+        if (Line.empty())
+            return true;
+        return _Insert->Bind(1, _NormalizedKey(_KeyOf(Line))).Bind(2, Line).Run();
+    }
+
+public:
+    clsSqliteRecordStore(clsSqliteDatabase &Database, const string &Table, short KeyColumn, bool IgnoreCase)
+        : clsRecordStore(KeyColumn, IgnoreCase), _Database(Database), _Table(Table)
+    {
+        // clsSqliteRecordStore process steps:
+        // 1. Create the table when it does not exist yet.
+        // 2. Prepare every statement once; calls only bind and step.
+        if (!_Database.Execute("CREATE TABLE IF NOT EXISTS " + _Table +
+                               " (Seq INTEGER PRIMARY KEY, RecordKey TEXT NOT NULL, Line TEXT NOT NULL)") ||
+            !_Database.Execute("CREATE INDEX IF NOT EXISTS " + _Table + "_RecordKey ON " + _Table + " (RecordKey)"))
+            return;
+
+        string FirstWithKey = "(SELECT Seq FROM " + _Table + " WHERE RecordKey = ?1 ORDER BY Seq LIMIT 1)";
+
+        _SelectAll = make_unique<clsStatement>(_Database, "SELECT Line FROM " + _Table + " ORDER BY Seq");
+        _SelectByKey = make_unique<clsStatement>(_Database, "SELECT Line FROM " + _Table + " WHERE RecordKey = ?1 ORDER BY Seq LIMIT 1");
+        _Insert = make_unique<clsStatement>(_Database, "INSERT INTO " + _Table + " (RecordKey, Line) VALUES (?1, ?2)");
+        _Update = make_unique<clsStatement>(_Database, "UPDATE " + _Table + " SET RecordKey = ?2, Line = ?3 WHERE Seq = " + FirstWithKey);
+        _DeleteByKey = make_unique<clsStatement>(_Database, "DELETE FROM " + _Table + " WHERE Seq = " + FirstWithKey);
+        _DeleteAll = make_unique<clsStatement>(_Database, "DELETE FROM " + _Table);
+        _CountAll = make_unique<clsStatement>(_Database, "SELECT COUNT(*) FROM " + _Table);
+
+        _Open = _SelectAll->IsValid() && _SelectByKey->IsValid() && _Insert->IsValid() && _Update->IsValid() &&
+                _DeleteByKey->IsValid() && _DeleteAll->IsValid() && _CountAll->IsValid();
+    }
+
+    string BackendName() const override { return "sqlite"; }
+
+    bool IsOpen() const { return _Open; }
+
+    void ForEach(const function<bool(const string &Line)> &Visitor) override
+    {
+        if (!_Open)
+            return;
+
+        lock_guard<recursive_mutex> Lock(_Database.GetMutex());
+        string Line;
+        while (_SelectAll->Step())
+        {
+            Line.assign(_SelectAll->ColumnText(0));
+            if (Visitor(Line))
+                break;
+        }
+        _SelectAll->Reset();
+    }
+
+    bool Find(short Column, string_view Key, string &Line) override
+    {
+        if (!_Open)
+            return false;
+
+        if (Column != _KeyColumn)
+        {
+            bool Found = false;
+            ForEach([&](const string &Candidate)
+                    {
+                        if (!_KeysEqual(clsString::GetFieldView(Candidate, " || ", Column), Key))
+                            return false;
+                        Line = Candidate;
+                        Found = true;
+                        return true; });
+            return Found;
+        }
+
+        lock_guard<recursive_mutex> Lock(_Database.GetMutex());
+        bool Found = _SelectByKey->Bind(1, _NormalizedKey(Key)).Step();
+        if (Found)
+            Line.assign(_SelectByKey->ColumnText(0));
+        _SelectByKey->Reset();
+        return Found;
+    }
+
+    void Append(const string &Line) override
+    {
+        if (!_Open)
+            return;
+
+        lock_guard<recursive_mutex> Lock(_Database.GetMutex());
+        _InsertLocked(Line);
+    }
+
+    void AppendAll(const vector<string> &vLines) override
+    {
+        if (!_Open)
+            return;
+
+        clsSqliteDatabase::clsTransaction Batch(_Database);
+        for (const string &Line : vLines)
+            _InsertLocked(Line);
+        Batch.Commit();
+    }
+
+    bool Replace(string_view Key, const string &Line) override
+    {
+        if (!_Open)
+            return false;
+
+        lock_guard<recursive_mutex> Lock(_Database.GetMutex());
+        if (!_Update->Bind(1, _NormalizedKey(Key)).Bind(2, _NormalizedKey(_KeyOf(Line))).Bind(3, Line).Run())
+            return false;
+        return _Update->Changes() > 0;
+    }
+
+    clsRecordVersion::enReplaceResult ReplaceIfVersion(string_view Key, short VersionColumn, unsigned long long ExpectedVersion,
+                                                       const string &Line, string &CurrentLine) override
+    {
+        // read, compare and update in one IMMEDIATE transaction: other
+        // processes on the same database cannot write in between
+        if (!_Open)
+            return clsRecordVersion::rrNotFound;
+
+        clsSqliteDatabase::clsTransaction Batch(_Database);
+        string Normalized = _NormalizedKey(Key);
+
+        string Current;
+        bool Found = _SelectByKey->Bind(1, Normalized).Step();
+        if (Found)
+            Current.assign(_SelectByKey->ColumnText(0));
+        _SelectByKey->Reset();
+
+        if (!Found)
+            return clsRecordVersion::rrNotFound;
+
+        if (clsRecordVersion::Of(Current, VersionColumn) != ExpectedVersion)
+        {
+            CurrentLine = move(Current);
+            return clsRecordVersion::rrConflict;
+        }
+
+        if (!_Update->Bind(1, Normalized).Bind(2, _NormalizedKey(_KeyOf(Line))).Bind(3, Line).Run() || !Batch.Commit())
+            return clsRecordVersion::rrNotFound;
+        return clsRecordVersion::rrReplaced;
+    }
+
+    void ReplaceAll(const vector<string> &vLines) override
+    {
+        // one transaction: readers see either the old or the new table
+        if (!_Open)
+            return;
+
+        clsSqliteDatabase::clsTransaction Batch(_Database);
+        if (!_DeleteAll->Run())
+            return; // rolled back
+        for (const string &Line : vLines)
+            _InsertLocked(Line);
+        Batch.Commit();
+    }
+
+    bool Rewrite(const function<bool(vector<string> &vLines)> &Edit) override
+    {
+        // read, edit and write back in one IMMEDIATE transaction
+        if (!_Open)
+            return false;
+
+        clsSqliteDatabase::clsTransaction Batch(_Database);
+        vector<string> vLines;
+        while (_SelectAll->Step())
+            vLines.emplace_back(_SelectAll->ColumnText(0));
+        _SelectAll->Reset();
+
+        if (!Edit(vLines) || !_DeleteAll->Run())
+            return false; // rolled back
+        for (const string &Line : vLines)
+            _InsertLocked(Line);
+        return Batch.Commit();
+    }
+
+    bool Delete(string_view Key) override
+    {
+        if (!_Open)
+            return false;
+
+        lock_guard<recursive_mutex> Lock(_Database.GetMutex());
+        if (!_DeleteByKey->Bind(1, _NormalizedKey(Key)).Run())
+            return false;
+        return _DeleteByKey->Changes() > 0;
+    }
+
+    size_t Count()
+    {
+        if (!_Open)
+            return 0;
+
+        lock_guard<recursive_mutex> Lock(_Database.GetMutex());
+        size_t Records = _CountAll->Step() ? (size_t)_CountAll->ColumnInt(0) : 0;
+        _CountAll->Reset();
+        return Records;
+    }
+};
+
+#endif // SMARTBANK_WITH_SQLITE
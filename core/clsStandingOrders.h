@@ -0,0 +1,477 @@
+/*clsStandingOrders Overview
+================================================================================
+                              clsStandingOrders.h
+================================================================================
+Overview:
+---------
+This file defines the clsStandingOrders class: persistent recurring transfers
+("every month on the 1st, 500 from A101 to A102") and the scheduler that
+posts them when they fall due.
+
+Orders are kept in memory as small fixed-size records (account numbers and
+the creator are clsFixedString keys, the next due date is a day number) and
+are scheduled in a clsTimerWheel by due day. Checking for due orders is
+therefore O(1) on a day with nothing due, and otherwise touches only the
+orders that are due; the order list is never scanned per check.
+
+================================================================================
+Storage:
+--------
+StandingOrders.txt under the data root (clsStorage), one order per line (" || " separated):
+
+    Id || FromAccount || ToAccount || Amount || Frequency || Day || NextDue || CreatedBy
+
+    3 || A101 || A102 || 500.000000 || M || 31 || 29/2/2028 || Admin
+
+- Frequency : M (monthly) or W (weekly)
+- Day       : the preferred day of month of a monthly order; months that are
+              shorter use their last day (31 -> 29/2 -> 31/3, no drift)
+- NextDue   : the next date the order has to be posted
+
+Cancelled orders are tombstoned in place (clsRecordFile::MarkDeleted).
+
+Several processes (ATMs, the daemon, batch runs) share the file. Add, Cancel,
+GetAllOrders and RunDueOrders hold "StandingOrdersScheduler.lock"
+(clsFileLock) from the load to the end of the write; RunDueOrders keeps it
+until the batch is posted, so an occurrence is posted by one process only
+and two processes never hand out the same id. Every write bumps the lock's
+generation: the file is re-read under the lock only when the generation or
+the write time (the compactor) changed, never per check.
+
+================================================================================
+Running Due Orders:
+-------------------
+RunDueOrders(Today) advances the wheel to Today. Every order that fires:
+
+1. Counts its missed occurrences directly with month arithmetic
+   (clsDate::AddMonthsOnDay), so an order that was due 14 months ago is
+   caught up in one step instead of 14 wheel rounds.
+2. Adds one transfer per occurrence to the batch.
+3. Moves NextDue past Today and is rescheduled in the wheel.
+
+All transfers of the run are sorted by due date and posted in ONE batch
+through clsBatchPaymentEngine (one Clients.txt rewrite, one log group commit,
+logged as TRANSFER_OUT / TRANSFER_IN of the source client). An occurrence
+without enough funds is rejected and skipped; the order keeps running.
+
+The new NextDue dates are written BEFORE the batch is posted: a crash in
+between can miss one run, but can never post the same occurrence twice.
+
+================================================================================
+Public Methods:
+---------------
+    static int Add(From, To, Amount, Frequency, FirstDueDate, CreatedBy)
+        Returns the new order id, or -1 when the order is invalid.
+    static bool Cancel(int Id)
+    static vector<stStandingOrder> GetAllOrders()        (by id)
+    static stRunResult RunDueOrders(const clsDate &Today = system date)
+    static string FrequencyName(enFrequency Frequency)
+
+================================================================================
+Usage Example:
+--------------
+    clsStandingOrders::Add("A101", "A102", 500, clsStandingOrders::fMonthly,
+                           clsDate(1, 11, 2026), "Admin");
+
+    clsStandingOrders::stRunResult Result = clsStandingOrders::RunDueOrders();
+    cout << Result.Posted << " standing order payment(s) posted";
+
+================================================================================
+*/
+
+#pragma once
+
+#include <iostream>
+#include <fstream>
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include <algorithm>
+#include <mutex>
+#include <chrono>
+#include <filesystem>
+
+#include "clsRecordFile.h"               // core/clsRecordFile.h
+#include "clsStorage.h"                  // core/clsStorage.h
+#include "clsBatchPaymentEngine.h"       // core/clsBatchPaymentEngine.h
+#include "../utils/clsDate.h"            // utils/clsDate.h
+#include "../utils/clsString.h"          // utils/clsString.h
+#include "../utils/clsFixedString.h"     // utils/clsFixedString.h
+#include "../utils/clsTimerWheel.h"      // utils/clsTimerWheel.h
+#include "../utils/clsFileLock.h"        // utils/clsFileLock.h
+
+using namespace std;
+
+class clsStandingOrders
+{
+public:
+    enum enFrequency : char
+    {
+        fWeekly = 'W',
+        fMonthly = 'M'
+    };
+
+    struct stStandingOrder
+    {
+        int Id = 0;
+        clsAccountNumber FromAccount;
+        clsAccountNumber ToAccount;
+        double Amount = 0;
+        enFrequency Frequency = fMonthly;
+        short Day = 1;        // preferred day of month (monthly orders)
+        int NextDueDay = 0;   // clsDate::ToDayNumber
+        clsAdminUsername CreatedBy;
+
+        clsDate NextDueDate() const
+        {
+            return clsDate::FromDayNumber(NextDueDay);
+        }
+    };
+
+    struct stRunResult
+    {
+        size_t OrdersDue = 0;    // orders that fired
+        size_t Occurrences = 0;  // payments attempted (missed periods included)
+        size_t Posted = 0;
+        double TotalAmount = 0;
+        vector<clsBatchPaymentEngine::stRejectedPosting> vRejected; // LineNumber = order id
+        double Seconds = 0;
+    };
+
+private:
+    static string _FilePath() { return clsStorage::Path("StandingOrders.txt"); }
+    // not "StandingOrders.lock": clsRecordFile takes that one for each write
+    static string _LockPath() { return clsStorage::Path("StandingOrdersScheduler.lock"); }
+
+    struct stSchedulerState
+    {
+        mutex Mutex;
+        bool Loaded = false;
+        bool FileExists = false;
+        filesystem::file_time_type Stamp;
+        unsigned long long Generation = 0; // of the scheduler lock, when loaded or written
+        unordered_map<int, stStandingOrder> Orders;
+        clsTimerWheel<int> Wheel; // order ids by due day
+        int NextId = 1;
+    };
+
+    struct stDuePayment
+    {
+        int DueDay;
+        int OrderId;
+        double Amount;
+        clsAccountNumber FromAccount;
+        clsAccountNumber ToAccount;
+    };
+
+    static stSchedulerState &_State()
+    {
+        static stSchedulerState State;
+        return State;
+    }
+
+    static bool _ConvertLineToOrder(const string &Line, stStandingOrder &Order)
+    {
+        vector<string> vFields = clsString::Split(Line, " || ");
+        if (vFields.size() != 8 || (vFields[4] != "M" && vFields[4] != "W"))
+            return false;
+
+        vector<string> vDate = clsString::Split(vFields[6], "/");
+        if (vDate.size() != 3)
+            return false;
+
+        try
+        {
+            Order.Id = stoi(vFields[0]);
+            Order.FromAccount = clsAccountNumber(vFields[1]);
+            Order.ToAccount = clsAccountNumber(vFields[2]);
+            Order.Amount = stod(vFields[3]);
+            Order.Frequency = (enFrequency)vFields[4][0];
+            Order.Day = (short)stoi(vFields[5]);
+            Order.NextDueDay = clsDate::ToDayNumber(clsDate((short)stoi(vDate[0]), (short)stoi(vDate[1]), (short)stoi(vDate[2])));
+            Order.CreatedBy = clsAdminUsername(vFields[7]);
+        }
+        catch (const exception &)
+        {
+            return false;
+        }
+        return true;
+    }
+
+    static string _ConvertOrderToLine(const stStandingOrder &Order, string_view Seperator = " || ")
+    {
+        string Line;
+        Line.reserve(96);
+        Line += to_string(Order.Id);
+        Line += Seperator;
+        Line += Order.FromAccount.View();
+        Line += Seperator;
+        Line += Order.ToAccount.View();
+        Line += Seperator;
+        Line += to_string(Order.Amount);
+        Line += Seperator;
+        Line += (char)Order.Frequency;
+        Line += Seperator;
+        Line += to_string(Order.Day);
+        Line += Seperator;
+        Line += clsDate::DateToString(Order.NextDueDate());
+        Line += Seperator;
+        Line += Order.CreatedBy.View();
+        return Line;
+    }
+
+    static void _RememberFileStamp(stSchedulerState &State)
+    {
+        error_code Error;
+        State.FileExists = filesystem::exists(_FilePath(), Error);
+        if (State.FileExists)
+            State.Stamp = filesystem::last_write_time(_FilePath(), Error);
+    }
+
+    static bool _FileChanged(const stSchedulerState &State)
+    {
+        error_code Error;
+        bool Exists = filesystem::exists(_FilePath(), Error);
+        if (Exists != State.FileExists)
+            return true;
+        return Exists && filesystem::last_write_time(_FilePath(), Error) != State.Stamp;
+    }
+
+    static void _Load(stSchedulerState &State, int TodayNumber)
+    {
+        // one pass over the file: orders into the map, ids into the wheel
+        State.Orders.clear();
+        State.Wheel = clsTimerWheel<int>(TodayNumber);
+        State.NextId = 1;
+
+        fstream MyFile(_FilePath(), ios::in); // read Mode
+        if (MyFile.is_open())
+        {
+            string Line;
+            stStandingOrder Order;
+            while (getline(MyFile, Line))
+            {
+                if (Line.empty() || clsRecordFile::IsTombstone(Line) || !_ConvertLineToOrder(Line, Order))
+                    continue;
+
+                State.Orders[Order.Id] = Order;
+                State.Wheel.Schedule(Order.NextDueDay, Order.Id);
+                State.NextId = max(State.NextId, Order.Id + 1);
+            }
+            MyFile.close();
+        }
+
+        State.Loaded = true;
+        _RememberFileStamp(State);
+    }
+
+    static void _EnsureLoaded(stSchedulerState &State, int TodayNumber, const clsFileLock &FileLock)
+    {
+        // called with the scheduler lock held: another process's write since
+        // this one last loaded or wrote shows up as a new generation
+        unsigned long long Generation = FileLock.GetGeneration();
+        if (!State.Loaded || Generation != State.Generation || _FileChanged(State))
+            _Load(State, TodayNumber);
+        State.Generation = Generation;
+    }
+
+    static void _Written(stSchedulerState &State, clsFileLock &FileLock)
+    {
+        State.Generation = FileLock.BumpGeneration();
+        _RememberFileStamp(State);
+    }
+
+    static void _SaveAll(stSchedulerState &State, clsFileLock &FileLock)
+    {
+        vector<int> vIds;
+        vIds.reserve(State.Orders.size());
+        for (const auto &Entry : State.Orders)
+            vIds.push_back(Entry.first);
+        sort(vIds.begin(), vIds.end());
+
+        vector<string> vLines;
+        vLines.reserve(vIds.size());
+        for (int Id : vIds)
+            vLines.push_back(_ConvertOrderToLine(State.Orders[Id]));
+
+        clsRecordFile::ReplaceAll(_FilePath(), vLines); // overwrite (temp file + rename)
+        _Written(State, FileLock);
+    }
+
+    static int _CollectOccurrences(stStandingOrder &Order, int TodayNumber, vector<stDuePayment> &vPayments)
+    {
+        // every due date from NextDueDay up to Today gets a payment; NextDueDay
+        // then moves to the first date after Today (month arithmetic, no day walking)
+        int Count = 0;
+
+        if (Order.Frequency == fWeekly)
+        {
+            Count = (TodayNumber - Order.NextDueDay) / 7 + 1;
+            for (int i = 0; i < Count; i++)
+                vPayments.push_back({Order.NextDueDay + i * 7, Order.Id, Order.Amount, Order.FromAccount, Order.ToAccount});
+
+            Order.NextDueDay += Count * 7;
+            return Count;
+        }
+
+        clsDate Due = Order.NextDueDate();
+        clsDate Today = clsDate::FromDayNumber(TodayNumber);
+
+        int Months = (Today.GetYear() - Due.GetYear()) * 12 + (Today.GetMonth() - Due.GetMonth());
+        if (clsDate::ToDayNumber(clsDate::AddMonthsOnDay(Due, Months, Order.Day)) > TodayNumber)
+            Months--;
+        Count = Months + 1;
+
+        for (int i = 0; i < Count; i++)
+        {
+            int DueDay = (i == 0) ? Order.NextDueDay : clsDate::ToDayNumber(clsDate::AddMonthsOnDay(Due, i, Order.Day));
+            vPayments.push_back({DueDay, Order.Id, Order.Amount, Order.FromAccount, Order.ToAccount});
+        }
+
+        Order.NextDueDay = clsDate::ToDayNumber(clsDate::AddMonthsOnDay(Due, Count, Order.Day));
+        return Count;
+    }
+
+public:
+    static string FrequencyName(enFrequency Frequency)
+    {
+        return (Frequency == fWeekly) ? "Weekly" : "Monthly";
+    }
+
+    static int Add(const string &FromAccount, const string &ToAccount, double Amount, enFrequency Frequency,
+                   const clsDate &FirstDueDate, const string &CreatedBy)
+    {
+        // Add process steps:
+        // 1. Validate the order (the screen checks that both clients exist).
+        // 2. Under the scheduler lock, load the newest file, give the order the
+        //    next id, append its line and schedule it in the wheel.
+        stStandingOrder Order;
+        Order.FromAccount = clsAccountNumber(FromAccount);
+        Order.ToAccount = clsAccountNumber(ToAccount);
+        Order.CreatedBy = clsAdminUsername(CreatedBy);
+
+        if (!Order.FromAccount.IsValid() || !Order.ToAccount.IsValid() || Order.FromAccount.IsEmpty() ||
+            Order.ToAccount.IsEmpty() || Order.FromAccount == Order.ToAccount || !Order.CreatedBy.IsValid() ||
+            !(Amount > 0) || !FirstDueDate.IsValid())
+            return -1;
+
+        Order.Amount = Amount;
+        Order.Frequency = Frequency;
+        Order.Day = FirstDueDate.GetDay();
+        Order.NextDueDay = clsDate::ToDayNumber(FirstDueDate);
+
+        stSchedulerState &State = _State();
+        lock_guard<mutex> Lock(State.Mutex);
+        clsFileLock FileLock(_LockPath());
+
+        _EnsureLoaded(State, clsDate::ToDayNumber(clsDate::GetSystemDate()), FileLock);
+
+        Order.Id = State.NextId++;
+        State.Orders[Order.Id] = Order;
+        State.Wheel.Schedule(Order.NextDueDay, Order.Id);
+
+        clsRecordFile::AppendLine(_FilePath(), _ConvertOrderToLine(Order));
+        _Written(State, FileLock);
+        return Order.Id;
+    }
+
+    static bool Cancel(int Id)
+    {
+        // the wheel entry stays: it is dropped when it fires (lazy cancellation)
+        stSchedulerState &State = _State();
+        lock_guard<mutex> Lock(State.Mutex);
+        clsFileLock FileLock(_LockPath());
+
+        _EnsureLoaded(State, clsDate::ToDayNumber(clsDate::GetSystemDate()), FileLock);
+
+        if (State.Orders.erase(Id) == 0)
+            return false;
+
+        clsRecordFile::MarkDeleted(_FilePath(), 0, to_string(Id));
+        _Written(State, FileLock);
+        return true;
+    }
+
+    static vector<stStandingOrder> GetAllOrders()
+    {
+        stSchedulerState &State = _State();
+        lock_guard<mutex> Lock(State.Mutex);
+        clsFileLock FileLock(_LockPath());
+
+        _EnsureLoaded(State, clsDate::ToDayNumber(clsDate::GetSystemDate()), FileLock);
+
+        vector<stStandingOrder> vOrders;
+        vOrders.reserve(State.Orders.size());
+        for (const auto &Entry : State.Orders)
+            vOrders.push_back(Entry.second);
+
+        sort(vOrders.begin(), vOrders.end(),
+             [](const stStandingOrder &A, const stStandingOrder &B) { return A.Id < B.Id; });
+        return vOrders;
+    }
+
+    static stRunResult RunDueOrders(const clsDate &Today = clsDate::GetSystemDate())
+    {
+        // RunDueOrders process steps:
+        // 1. Nothing to do when the wheel has already been advanced past Today.
+        // 2. Advance the wheel to Today; each fired order adds all its missed
+        //    occurrences to the batch and is rescheduled after Today.
+        // 3. Save the new due dates, then post the whole batch (sorted by due
+        //    date) through clsBatchPaymentEngine in one commit.
+        // Steps 1-3 hold the scheduler lock: another process running at the
+        // same time waits, then loads the moved due dates and finds nothing due.
+        auto Start = chrono::steady_clock::now();
+        stRunResult Result;
+
+        int TodayNumber = clsDate::ToDayNumber(Today);
+
+        stSchedulerState &State = _State();
+        lock_guard<mutex> Lock(State.Mutex);
+        clsFileLock FileLock(_LockPath());
+
+        _EnsureLoaded(State, TodayNumber, FileLock);
+        if (TodayNumber < State.Wheel.GetCurrentTick())
+            return Result;
+
+        vector<stDuePayment> vPayments;
+
+        State.Wheel.Advance(TodayNumber, [&](long long, vector<int> &vDueIds)
+        {
+            for (int Id : vDueIds)
+            {
+                auto Order = State.Orders.find(Id);
+                if (Order == State.Orders.end() || Order->second.NextDueDay > TodayNumber)
+                    continue; // cancelled, or already run by another process
+
+                Result.OrdersDue++;
+                Result.Occurrences += _CollectOccurrences(Order->second, TodayNumber, vPayments);
+                State.Wheel.Schedule(Order->second.NextDueDay, Id);
+            }
+        });
+
+        if (vPayments.empty())
+            return Result;
+
+        _SaveAll(State, FileLock);
+
+        stable_sort(vPayments.begin(), vPayments.end(),
+                    [](const stDuePayment &A, const stDuePayment &B) { return A.DueDay < B.DueDay; });
+
+        vector<clsBatchPaymentEngine::stInstruction> vInstructions(vPayments.size());
+        for (size_t i = 0; i < vPayments.size(); i++)
+        {
+            vInstructions[i].LineNumber = (size_t)vPayments[i].OrderId;
+            vInstructions[i].FromAccount = vPayments[i].FromAccount;
+            vInstructions[i].ToAccount = vPayments[i].ToAccount;
+            vInstructions[i].Amount = vPayments[i].Amount;
+        }
+
+        clsBatchPaymentEngine::stBatchResult Batch = clsBatchPaymentEngine::Post(move(vInstructions));
+
+        Result.Posted = Batch.Posted;
+        Result.TotalAmount = Batch.TotalAmount;
+        Result.vRejected = move(Batch.vRejected);
+        Result.Seconds = chrono::duration<double>(chrono::steady_clock::now() - Start).count();
+        return Result;
+    }
+};
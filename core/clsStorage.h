@@ -0,0 +1,436 @@
+/*clsStorage Overview
+================================================================================
+                                 clsStorage.h
+================================================================================
+Overview:
+---------
+This file defines the clsStorage class, the one place that knows where the
+data lives and how it is stored:
+
+- Data root: the folder every data file is resolved against (default
+  "../data/", the folder the program always used). clsStorage::Path() turns
+  a file name into a path under it; logs, session logs, standing orders and
+  the snapshot use it.
+- Backend: how clients, admins and currencies are kept. clsBankClient,
+  clsAdmin and clsCurrency only talk to the stores returned by Clients(),
+  Admins() and Currencies().
+- Logs: AllTransactions.txt and the two session logs are clsLogStores
+  (Transactions(), ClientSessions(), AdminSessions()). They are segmented
+  text logs for every backend except sqlite.
+
+================================================================================
+Backends:
+---------
+    text     Clients.txt / Admins.text / Currencies.txt          (default)
+    memory   in memory only, seeded once from the text files
+    binary   Clients.sbr / Admins.sbr / Currencies.sbr, hash indexed;
+             a missing .sbr file is created from the text file once
+    sqlite   SmartBank.db (records and logs), only in builds with
+             -DSMARTBANK_WITH_SQLITE ... -lsqlite3; the database is
+             created from the text files by "SmartBank Migrate"
+
+A data root is meant to stay on one backend: once the .sbr files exist the
+binary backend no longer reads or updates the text files, and once
+SmartBank.db exists the sqlite backend uses it alone. Only the text
+backend is described by the binary snapshot (clsSnapshot), so the snapshot is
+not used with the others.
+
+================================================================================
+Configuration:
+--------------
+Configure(Backend, DataRoot) is called once at start-up, before any store is
+used (it drops the stores that exist). The application reads it from:
+
+    --data-root <folder>   or   SMARTBANK_DATA_ROOT
+    --storage text|memory|binary|sqlite   or   SMARTBANK_STORAGE
+
+so several instances can run side by side on their own data roots, and
+benchmarks can point the program at a scratch folder (tmpfs) instead of
+changing the working directory.
+
+================================================================================
+Public Methods:
+---------------
+    static bool Configure(enBackend Backend, const string &DataRoot)
+    static bool ConfigureFromEnvironment()
+    static bool ParseBackend(string_view Name, enBackend &Backend)
+    static string BackendName(enBackend Backend)
+    static enBackend GetBackend()
+    static string GetDataRoot()
+    static unsigned long long ConfigurationId()   changes with every Configure()
+    static string Path(string_view FileName)
+    static string StoreName(const string &FileName)
+
+    static clsRecordStore &Clients()
+    static clsRecordStore &Admins()
+    static clsRecordStore &Currencies()
+
+    static clsLogStore &Transactions()
+    static clsLogStore &ClientSessions()
+    static clsLogStore &AdminSessions()
+
+================================================================================
+Usage Example:
+--------------
+    clsStorage::Configure(clsStorage::bkBinary, "/dev/shm/smartbank/data");
+
+    string Line;
+    clsStorage::Clients().Find(clsStorage::ClientsKeyColumn, "A101", Line);
+    clsStorage::Transactions().AppendLine(Entry);
+
+================================================================================
+*/
+
+#pragma once
+
+#include <string>
+#include <string_view>
+#include <vector>
+#include <memory>
+#include <mutex>
+#include <atomic>
+#include <cstdlib>
+#include <filesystem>
+
+#include "clsRecordStore.h"       // core/clsRecordStore.h
+#include "clsTextRecordStore.h"   // core/clsTextRecordStore.h
+#include "clsMemoryRecordStore.h" // core/clsMemoryRecordStore.h
+#include "clsBinaryRecordStore.h" // core/clsBinaryRecordStore.h
+#include "clsLogStore.h"          // core/clsLogStore.h
+#include "clsSegmentedLogStore.h" // core/clsSegmentedLogStore.h
+#include "clsSqliteRecordStore.h" // core/clsSqliteRecordStore.h (SMARTBANK_WITH_SQLITE)
+#include "clsSqliteLogStore.h"    // core/clsSqliteLogStore.h (SMARTBANK_WITH_SQLITE)
+
+using namespace std;
+
+class clsStorage
+{
+public:
+    enum enBackend
+    {
+        bkText = 1,
+        bkMemory = 2,
+        bkBinary = 3,
+        bkSqlite = 4 // only usable in builds with SMARTBANK_WITH_SQLITE
+    };
+
+    static constexpr const char *ClientsFile = "Clients.txt";
+    static constexpr const char *AdminsFile = "Admins.text";
+    static constexpr const char *CurrenciesFile = "Currencies.txt";
+    static constexpr const char *TransactionsFile = "AllTransactions.txt";
+    static constexpr const char *ClientSessionsFile = "ClientsSessionLog.txt";
+    static constexpr const char *AdminSessionsFile = "AdminsSessionLog.txt";
+    static constexpr const char *DatabaseFile = "SmartBank.db";
+
+    static constexpr short ClientsKeyColumn = 4;    // account number
+    static constexpr short AdminsKeyColumn = 4;     // user name
+    static constexpr short CurrenciesKeyColumn = 1; // currency code (any case)
+
+    static constexpr short ClientsBalanceColumn = 6;
+    static constexpr short ClientsVersionColumn = 7; // see clsRecordVersion
+    static constexpr short AdminsVersionColumn = 7;
+
+    // log columns ForEachLineMentioning() looks at
+    static vector<short> TransactionsKeyColumns() { return {2, 5, 6}; } // user, from, to
+    static vector<short> SessionsKeyColumns() { return {3}; }           // account / user name
+
+private:
+    struct stState
+    {
+        mutex Mutex;
+        string DataRoot = "../data/";
+        enBackend Backend = bkText;
+        atomic<unsigned long long> ConfigurationId{1}; // caches of store data compare it
+#ifdef SMARTBANK_WITH_SQLITE
+        unique_ptr<clsSqliteDatabase> Database; // declared first: destroyed after the stores using it
+#endif
+        unique_ptr<clsRecordStore> Clients;
+        unique_ptr<clsRecordStore> Admins;
+        unique_ptr<clsRecordStore> Currencies;
+        unique_ptr<clsLogStore> Transactions;
+        unique_ptr<clsLogStore> ClientSessions;
+        unique_ptr<clsLogStore> AdminSessions;
+    };
+
+    static stState &_State()
+    {
+        static stState State;
+        return State;
+    }
+
+    static string _NormalizeRoot(string Root)
+    {
+        if (!Root.empty() && Root.back() != '/' && Root.back() != '\\')
+            Root += '/';
+        return Root;
+    }
+
+    static string _BinaryFileName(const string &TextFileName)
+    {
+        // "Clients.txt" -> "Clients.sbr"
+        return StoreName(TextFileName) + ".sbr";
+    }
+
+    static void _ResetStores(stState &State)
+    {
+        State.Clients.reset();
+        State.Admins.reset();
+        State.Currencies.reset();
+        State.Transactions.reset();
+        State.ClientSessions.reset();
+        State.AdminSessions.reset();
+#ifdef SMARTBANK_WITH_SQLITE
+        State.Database.reset();
+#endif
+    }
+
+    static unique_ptr<clsRecordStore> _MakeStore(const stState &State, const string &FileName, short KeyColumn, bool IgnoreCase)
+    {
+        // _MakeStore process steps:
+        // 1. text: the store reads and writes the text file directly.
+        // 2. memory: an empty store filled with the lines of the text file.
+        // 3. binary: open (or create) the .sbr file; a newly created one is
+        //    filled with the lines of the text file, so switching an existing
+        //    data root to binary keeps its data.
+        // 4. sqlite: the table of the same name in SmartBank.db.
+        string TextPath = State.DataRoot + FileName;
+#ifdef SMARTBANK_WITH_SQLITE
+        if (State.Backend == bkSqlite)
+            return make_unique<clsSqliteRecordStore>(*State.Database, StoreName(FileName), KeyColumn, IgnoreCase);
+#endif
+        if (State.Backend == bkText)
+            return make_unique<clsTextRecordStore>(TextPath, KeyColumn, IgnoreCase);
+
+        clsTextRecordStore Source(TextPath, KeyColumn, IgnoreCase);
+
+        if (State.Backend == bkMemory)
+        {
+            unique_ptr<clsMemoryRecordStore> Store = make_unique<clsMemoryRecordStore>(KeyColumn, IgnoreCase);
+            Store->AppendAll(Source.ReadAll());
+            return Store;
+        }
+
+        string BinaryPath = State.DataRoot + _BinaryFileName(FileName);
+        bool Created = !filesystem::exists(BinaryPath);
+
+        unique_ptr<clsBinaryRecordStore> Store = make_unique<clsBinaryRecordStore>(BinaryPath, KeyColumn, IgnoreCase);
+        if (Created && Store->IsOpen())
+            Store->ReplaceAll(Source.ReadAll());
+        return Store;
+    }
+
+    static unique_ptr<clsLogStore> _MakeLog(const stState &State, const string &FileName, const vector<short> &vKeyColumns)
+    {
+        // sqlite keeps the log in SmartBank.db, every other backend in the segmented text log
+#ifdef SMARTBANK_WITH_SQLITE
+        if (State.Backend == bkSqlite)
+            return make_unique<clsSqliteLogStore>(*State.Database, StoreName(FileName), vKeyColumns);
+#endif
+        (void)vKeyColumns;
+        return make_unique<clsSegmentedLogStore>(State.DataRoot + FileName);
+    }
+
+    static clsRecordStore &_Store(unique_ptr<clsRecordStore> stState::*Member, const char *FileName, short KeyColumn, bool IgnoreCase)
+    {
+        stState &State = _State();
+        lock_guard<mutex> Lock(State.Mutex);
+
+        unique_ptr<clsRecordStore> &Store = State.*Member;
+        if (!Store)
+            Store = _MakeStore(State, FileName, KeyColumn, IgnoreCase);
+        return *Store;
+    }
+
+    static clsLogStore &_Log(unique_ptr<clsLogStore> stState::*Member, const char *FileName, const vector<short> &vKeyColumns)
+    {
+        stState &State = _State();
+        lock_guard<mutex> Lock(State.Mutex);
+
+        unique_ptr<clsLogStore> &Store = State.*Member;
+        if (!Store)
+            Store = _MakeLog(State, FileName, vKeyColumns);
+        return *Store;
+    }
+
+#ifdef SMARTBANK_WITH_SQLITE
+    static bool _OpenSqlite()
+    {
+        // every table is created (if needed) and its statements prepared now
+        return ((clsSqliteRecordStore &)Clients()).IsOpen() &&
+               ((clsSqliteRecordStore &)Admins()).IsOpen() &&
+               ((clsSqliteRecordStore &)Currencies()).IsOpen() &&
+               ((clsSqliteLogStore &)Transactions()).IsOpen() &&
+               ((clsSqliteLogStore &)ClientSessions()).IsOpen() &&
+               ((clsSqliteLogStore &)AdminSessions()).IsOpen();
+    }
+#endif
+
+public:
+    static bool Configure(enBackend Backend, const string &DataRoot)
+    {
+        // Configure process steps:
+        // 1. The data root must be an existing folder.
+        // 2. Drop the current stores; they are created again, for the new
+        //    backend and root, the first time they are used.
+        // 3. binary: open the three stores now, so a damaged .sbr file is
+        //    reported here instead of behaving like an empty store later.
+        // 4. sqlite: SmartBank.db must exist (see "SmartBank Migrate"); it is
+        //    opened and every table checked now, for the same reason.
+        string Root = _NormalizeRoot(DataRoot);
+        error_code Error;
+        if (!Root.empty() && !filesystem::is_directory(Root, Error))
+            return false;
+
+#ifdef SMARTBANK_WITH_SQLITE
+        unique_ptr<clsSqliteDatabase> Database;
+        if (Backend == bkSqlite)
+        {
+            if (!filesystem::is_regular_file(Root + DatabaseFile, Error))
+                return false;
+            Database = make_unique<clsSqliteDatabase>(Root + DatabaseFile);
+            if (!Database->IsOpen())
+                return false;
+        }
+#else
+        if (Backend == bkSqlite)
+            return false;
+#endif
+
+        stState &State = _State();
+        {
+            lock_guard<mutex> Lock(State.Mutex);
+            _ResetStores(State);
+            State.DataRoot = Root;
+            State.Backend = Backend;
+            State.ConfigurationId++;
+#ifdef SMARTBANK_WITH_SQLITE
+            State.Database = move(Database);
+#endif
+        }
+
+#ifdef SMARTBANK_WITH_SQLITE
+        if (Backend == bkSqlite)
+            return _OpenSqlite();
+#endif
+        if (Backend != bkBinary)
+            return true;
+
+        return ((clsBinaryRecordStore &)Clients()).IsOpen() &&
+               ((clsBinaryRecordStore &)Admins()).IsOpen() &&
+               ((clsBinaryRecordStore &)Currencies()).IsOpen();
+    }
+
+    static bool ConfigureFromEnvironment()
+    {
+        // SMARTBANK_DATA_ROOT / SMARTBANK_STORAGE; unset values keep the defaults
+        const char *Root = getenv("SMARTBANK_DATA_ROOT");
+        const char *Name = getenv("SMARTBANK_STORAGE");
+        if (Root == nullptr && Name == nullptr)
+            return true;
+
+        enBackend Backend = GetBackend();
+        if (Name != nullptr && !ParseBackend(Name, Backend))
+            return false;
+
+        return Configure(Backend, Root != nullptr ? string(Root) : GetDataRoot());
+    }
+
+    static bool ParseBackend(string_view Name, enBackend &Backend)
+    {
+        if (clsString::EqualsIgnoreCase(Name, "text"))
+            Backend = bkText;
+        else if (clsString::EqualsIgnoreCase(Name, "memory"))
+            Backend = bkMemory;
+        else if (clsString::EqualsIgnoreCase(Name, "binary"))
+            Backend = bkBinary;
+#ifdef SMARTBANK_WITH_SQLITE
+        else if (clsString::EqualsIgnoreCase(Name, "sqlite"))
+            Backend = bkSqlite;
+#endif
+        else
+            return false;
+        return true;
+    }
+
+    static string BackendName(enBackend Backend)
+    {
+        switch (Backend)
+        {
+        case bkMemory:
+            return "memory";
+        case bkBinary:
+            return "binary";
+        case bkSqlite:
+            return "sqlite";
+        default:
+            return "text";
+        }
+    }
+
+    static enBackend GetBackend()
+    {
+        stState &State = _State();
+        lock_guard<mutex> Lock(State.Mutex);
+        return State.Backend;
+    }
+
+    static unsigned long long ConfigurationId()
+    {
+        // no lock: read on every clsClientTableRcu read
+        return _State().ConfigurationId.load();
+    }
+
+    static string GetDataRoot()
+    {
+        stState &State = _State();
+        lock_guard<mutex> Lock(State.Mutex);
+        return State.DataRoot;
+    }
+
+    static string Path(string_view FileName)
+    {
+        return GetDataRoot() + string(FileName);
+    }
+
+    static string StoreName(const string &FileName)
+    {
+        // "Clients.txt" -> "Clients": the .sbr file and the sqlite table name
+        return FileName.substr(0, FileName.find('.'));
+    }
+
+    //---------------------------------------------
+    // Record stores
+    //---------------------------------------------
+    static clsRecordStore &Clients()
+    {
+        return _Store(&stState::Clients, ClientsFile, ClientsKeyColumn, false);
+    }
+
+    static clsRecordStore &Admins()
+    {
+        return _Store(&stState::Admins, AdminsFile, AdminsKeyColumn, false);
+    }
+
+    static clsRecordStore &Currencies()
+    {
+        return _Store(&stState::Currencies, CurrenciesFile, CurrenciesKeyColumn, true);
+    }
+
+    //---------------------------------------------
+    // Log stores
+    //---------------------------------------------
+    static clsLogStore &Transactions()
+    {
+        return _Log(&stState::Transactions, TransactionsFile, TransactionsKeyColumns());
+    }
+
+    static clsLogStore &ClientSessions()
+    {
+        return _Log(&stState::ClientSessions, ClientSessionsFile, SessionsKeyColumns());
+    }
+
+    static clsLogStore &AdminSessions()
+    {
+        return _Log(&stState::AdminSessions, AdminSessionsFile, SessionsKeyColumns());
+    }
+};
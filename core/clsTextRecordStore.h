@@ -0,0 +1,160 @@
+/*clsTextRecordStore Overview
+================================================================================
+                             clsTextRecordStore.h
+================================================================================
+Overview:
+---------
+This file defines clsTextRecordStore, the clsRecordStore backed by one
+" || " text file (Clients.txt, Admins.text, Currencies.txt). It is the
+default backend and behaves exactly like the classes did before the store
+existed:
+
+- Find() scans the file and compares only the requested column
+  (clsString::GetFieldView); no other line is split or decoded.
+- Appends, rewrites (temp file + rename) and tombstone deletes go through
+  clsRecordFile, so compaction and concurrent writers keep working.
+- Replace() and ReplaceIfVersion() read and rewrite under one file lock
+  (clsRecordFile::Rewrite); across processes the version check is as strong
+  as the caller's lock (clsSharedAccountTable::clsWriteGuard in shared mode).
+- Nothing is cached: every call reads the file, so several processes can
+  share one data root.
+
+================================================================================
+Usage Example:
+--------------
+    clsTextRecordStore Clients("../data/Clients.txt", 4, false);
+    Clients.Append(Line);
+
+================================================================================
+*/
+
+#pragma once
+
+#include <string>
+#include <fstream>
+
+#include "clsRecordStore.h" // core/clsRecordStore.h
+#include "clsRecordFile.h"  // core/clsRecordFile.h
+
+using namespace std;
+
+class clsTextRecordStore : public clsRecordStore
+{
+private:
+    string _Path;
+
+public:
+    clsTextRecordStore(const string &Path, short KeyColumn, bool IgnoreCase)
+        : clsRecordStore(KeyColumn, IgnoreCase), _Path(Path)
+    {
+    }
+
+    string BackendName() const override { return "text"; }
+
+    const string &GetPath() const { return _Path; }
+
+    void ForEach(const function<bool(const string &Line)> &Visitor) override
+    {
+        fstream MyFile(_Path, ios::in); // read Mode
+        if (!MyFile.is_open())
+            return;
+
+        string Line;
+        while (getline(MyFile, Line))
+        {
+            if (Line.empty() || clsRecordFile::IsTombstone(Line))
+                continue; // deleted record, reclaimed later by compaction
+
+            if (Visitor(Line))
+                break;
+        }
+        MyFile.close();
+    }
+
+    bool Find(short Column, string_view Key, string &Line) override
+    {
+        // key column only: non-matching lines are never split or parsed
+        bool Found = false;
+        ForEach([&](const string &Candidate)
+                {
+                    if (!_KeysEqual(clsString::GetFieldView(Candidate, " || ", Column), Key))
+                        return false;
+                    Line = Candidate;
+                    Found = true;
+                    return true; });
+        return Found;
+    }
+
+    void Append(const string &Line) override
+    {
+        clsRecordFile::AppendLine(_Path, Line);
+    }
+
+    void AppendAll(const vector<string> &vLines) override
+    {
+        clsRecordFile::AppendLines(_Path, vLines);
+    }
+
+    bool Replace(string_view Key, const string &Line) override
+    {
+        // Replace process steps:
+        // 1. Read the file line by line; only the key column is compared.
+        // 2. The first live line with that key is replaced, every other line
+        //    is moved through unchanged.
+        // 3. Write the lines back with one rewrite (temp file + rename), under
+        //    the same file lock as the read (clsRecordFile::Rewrite).
+        return clsRecordFile::Rewrite(_Path, [&](vector<string> &vLines)
+                                      {
+                                          for (string &Current : vLines)
+                                          {
+                                              if (_KeysEqual(_KeyOf(Current), Key))
+                                              {
+                                                  Current = Line;
+                                                  return true;
+                                              }
+                                          }
+                                          return false; });
+    }
+
+    clsRecordVersion::enReplaceResult ReplaceIfVersion(string_view Key, short VersionColumn, unsigned long long ExpectedVersion,
+                                                       const string &Line, string &CurrentLine) override
+    {
+        // as Replace(), but the line is only replaced while its version is ExpectedVersion
+        clsRecordVersion::enReplaceResult Result = clsRecordVersion::rrNotFound;
+        clsRecordFile::Rewrite(_Path, [&](vector<string> &vLines)
+                               {
+                                   for (string &Current : vLines)
+                                   {
+                                       if (!_KeysEqual(_KeyOf(Current), Key))
+                                           continue;
+
+                                       if (clsRecordVersion::Of(Current, VersionColumn) != ExpectedVersion)
+                                       {
+                                           CurrentLine = Current;
+                                           Result = clsRecordVersion::rrConflict;
+                                           return false;
+                                       }
+                                       Current = Line;
+                                       Result = clsRecordVersion::rrReplaced;
+                                       return true;
+                                   }
+                                   return false; });
+        return Result;
+    }
+
+    void ReplaceAll(const vector<string> &vLines) override
+    {
+        clsRecordFile::ReplaceAll(_Path, vLines);
+    }
+
+    bool Rewrite(const function<bool(vector<string> &vLines)> &Edit) override
+    {
+        // the file lock is held from the read to the rename
+        return clsRecordFile::Rewrite(_Path, Edit);
+    }
+
+    bool Delete(string_view Key) override
+    {
+        return clsRecordFile::MarkDeleted(_Path, _KeyColumn, string(Key));
+    }
+};
@@ -33,6 +33,57 @@ Fields:
 7. ToAccount: Destination account (or "-" if N/A)
 8. BalanceAfter: Account balance after transaction
 
+Storage:
+--------
+The log is clsStorage::Transactions(). By default AllTransactions.txt is the
+active segment of a clsSegmentedLog: older days are closed into compressed,
+check-summed segments listed in AllTransactions.manifest, and
+GetTransactionsBetween() skips segments outside the requested date range.
+With the sqlite backend it is the AllTransactions table of SmartBank.db, and
+account history (GetAccountTransactions / QueryAccountTransactions) reads
+only the rows of that account through the key indexes.
+GetAllTransactions() returns the full history either way.
+
+Records:
+--------
+stTransactionRecord carries the operation as enOperationType and every text
+field as a clsSymbolTable id, so a record is five ints, one enum and two doubles.
+Filters are integer / bitmask tests:
+
+    TypeBit(Record.OperationType) & AdminOperationsMask
+    clsSymbolTable::TryFind("A101", Id) && Record.ToAccountId == Id
+
+Date(), Time(), Username(), FromAccount(), ToAccount() and OperationName()
+return the text for display.
+
+The symbol table only holds values read from or written to the log, never a
+query string. Before an account query the lines appended since the last
+query are interned (only those: clsSegmentedLog::ForEachLineAfter), so an
+account number the table does not know appears in no line, and the query
+returns an empty result without scanning the log.
+
+Arena Queries (reports and batch jobs):
+---------------------------------------
+The Get...() functions return a std::vector. The Query...() functions fill an
+stQueryResult instead: the matching records are stored in a pmr::vector inside
+the result's clsArena and released in one shot when it goes out of scope.
+
+    clsTransactionLogger::stQueryResult Result;
+    clsTransactionLogger::QueryAccountTransactions(Result, "A101");
+    for (const auto &Record : Result.Records)
+        cout << Record.Date() << " " << Record.Amount;
+
+Group Commit (batch postings):
+------------------------------
+FormatTransactionLine() builds a log line for a given date/time without
+writing it; AppendTransactionLines() writes a whole group of them with one
+lock and one file write, or one sqlite transaction (clsLogStore::AppendLines):
+
+    vector<string> vLines;
+    vLines.push_back(clsTransactionLogger::FormatTransactionLine(Date, Time, "A101",
+                     clsTransactionLogger::DEPOSIT, 500, "-", "A101", 1500));
+    clsTransactionLogger::AppendTransactionLines(vLines);
+
 Usage Example:
 --------------
 // Client deposit
@@ -59,9 +110,20 @@ clsTransactionLogger::LogAdminTransfer(CurrentAdmin, FromClient, ToClient, 500);
 #include <fstream>
 #include <string>
 #include <vector>
+#include <sstream>
+#include <climits>
+#include <cstdlib>
+#include <cstdio>
+#include <functional>
+#include <mutex>
 
 #include "../utils/clsDate.h"
 #include "../utils/clsString.h"
+#include "../utils/clsArena.h"
+#include "../utils/clsSymbolTable.h"
+#include "clsSegmentedLog.h"
+#include "clsStorage.h"
+#include "clsMetrics.h"
 
 using namespace std;
 
@@ -77,23 +139,54 @@ public:
         ADMIN_DEPOSIT,
         ADMIN_WITHDRAW,
         ADM_TRANS_OUT,
-        ADM_TRANS_IN  
+        ADM_TRANS_IN,
+        UNKNOWN_OPERATION // line written by a newer/older version, kept but never matched by type filters
     };
 
+    // one bit per operation type, for filters: (Mask & TypeBit(Record.OperationType))
+    static unsigned int TypeBit(enOperationType Type) { return 1u << Type; }
+
+    static const unsigned int ClientOperationsMask = (1u << DEPOSIT) | (1u << WITHDRAW) |
+                                                     (1u << TRANSFER_OUT) | (1u << TRANSFER_IN);
+    static const unsigned int AdminOperationsMask = (1u << ADMIN_DEPOSIT) | (1u << ADMIN_WITHDRAW) |
+                                                    (1u << ADM_TRANS_OUT) | (1u << ADM_TRANS_IN);
+
+    // whose balance BalanceAfter is: FromAccount for these types...
+    static const unsigned int FromSideMask = (1u << WITHDRAW) | (1u << TRANSFER_OUT) |
+                                             (1u << ADMIN_WITHDRAW) | (1u << ADM_TRANS_OUT);
+    // ...and ToAccount for these
+    static const unsigned int ToSideMask = (1u << DEPOSIT) | (1u << TRANSFER_IN) |
+                                           (1u << ADMIN_DEPOSIT) | (1u << ADM_TRANS_IN);
+
     struct stTransactionRecord
     {
-        string Date;
-        string Time;
-        string Username;
-        string OperationType;
+        // Text fields are clsSymbolTable ids (4 bytes each); the record is
+        // 40 bytes and copying it never allocates.
+        unsigned int DateId;
+        unsigned int TimeId;
+        unsigned int UserId;        // admin username or client account
+        enOperationType OperationType;
+        unsigned int FromAccountId; // "-" when N/A
+        unsigned int ToAccountId;   // "-" when N/A
         double Amount;
-        string FromAccount;
-        string ToAccount;
         double BalanceAfter;
+
+        string_view Date() const { return clsSymbolTable::Name(DateId); }
+        string_view Time() const { return clsSymbolTable::Name(TimeId); }
+        string_view Username() const { return clsSymbolTable::Name(UserId); }
+        string_view FromAccount() const { return clsSymbolTable::Name(FromAccountId); }
+        string_view ToAccount() const { return clsSymbolTable::Name(ToAccountId); }
+        string OperationName() const { return OperationTypeToString(OperationType); }
     };
 
-private:
-    static string _OperationTypeToString(enOperationType Type)
+    struct stQueryResult
+    {
+        // records live in the arena and are released with it in one shot
+        clsArena Arena;
+        pmr::vector<stTransactionRecord> Records{&Arena};
+    };
+
+    static string OperationTypeToString(enOperationType Type)
     {
         switch (Type)
         {
@@ -109,32 +202,216 @@ private:
         }
     }
 
-    static void _WriteTransactionToFile(string Username, enOperationType Type,
-                                        double Amount, string FromAccount,
-                                        string ToAccount, double BalanceAfter)
+    static enOperationType OperationTypeFromString(string_view Name)
+    {
+        for (int Type = DEPOSIT; Type < UNKNOWN_OPERATION; Type++)
+        {
+            if (Name == OperationTypeToString((enOperationType)Type))
+                return (enOperationType)Type;
+        }
+        return UNKNOWN_OPERATION;
+    }
+
+private:
+    static void _AppendNumber(string &Line, double Value)
+    {
+        // "%g" prints exactly what ostream << double prints (6 significant digits).
+        // Balances are floats: when 6 digits do not give the same float back
+        // (1234567.5 -> "1.23457e+06") 9 digits are written, so clsSnapshot can
+        // replay BalanceAfter exactly.
+        char Buffer[32];
+        int Length = snprintf(Buffer, sizeof(Buffer), "%g", Value);
+        if ((float)strtod(Buffer, nullptr) != (float)Value)
+            Length = snprintf(Buffer, sizeof(Buffer), "%.9g", Value);
+        Line.append(Buffer, (size_t)Length);
+    }
+
+    static void _WriteTransactionToFile(const string &Username, enOperationType Type,
+                                        double Amount, const string &FromAccount,
+                                        const string &ToAccount, double BalanceAfter)
     {
-        fstream MyFile("../data/AllTransactions.txt", ios::out | ios::app);
+        SB_MEASURE(LoggerAppend);
+        string Date = clsDate::DateToString(clsDate::GetSystemDate());
+        string Time = clsDate::GetAccurateTime();
 
-        if (MyFile.is_open())
+        // appended to the active segment, older days live in closed segments
+        clsStorage::Transactions().AppendLine(FormatTransactionLine(Date, Time, Username, Type, Amount,
+                                                                    FromAccount, ToAccount, BalanceAfter));
+    }
+
+    static bool _ConvertLineToTransactionRecord(const string &Line, stTransactionRecord &Record)
+    {
+        // Splits the line into field views (no copies, no vector) and interns
+        // the text fields; only values never seen before allocate.
+        // The two numbers are parsed in place with strtod (std::string is
+        // NUL terminated, and each number is followed by "#//#" or the end).
+        string_view vData[8];
+        size_t Start = 0;
+
+        for (short i = 0; i < 8; i++)
         {
-            string Date = clsDate::DateToString(clsDate::GetSystemDate());
-            string Time = clsDate::GetAccurateTime();
-
-            MyFile << Date << "#//#"
-                   << Time << "#//#"
-                   << Username << "#//#"
-                   << _OperationTypeToString(Type) << "#//#"
-                   << Amount << "#//#"
-                   << FromAccount << "#//#"
-                   << ToAccount << "#//#"
-                   << BalanceAfter
-                   << endl;
-
-            MyFile.close();
+            size_t pos = (i < 7) ? Line.find("#//#", Start) : Line.size();
+            if (pos == string::npos)
+                return false;
+
+            vData[i] = string_view(Line).substr(Start, pos - Start);
+            Start = pos + 4;
         }
+
+        Record.DateId = clsSymbolTable::Intern(vData[0]);
+        Record.TimeId = clsSymbolTable::Intern(vData[1]);
+        Record.UserId = clsSymbolTable::Intern(vData[2]);
+        Record.OperationType = OperationTypeFromString(vData[3]);
+        Record.Amount = strtod(vData[4].data(), nullptr);
+        Record.FromAccountId = clsSymbolTable::Intern(vData[5]);
+        Record.ToAccountId = clsSymbolTable::Intern(vData[6]);
+        Record.BalanceAfter = strtod(vData[7].data(), nullptr);
+        return true;
+    }
+
+    static bool _InvolvesAccount(const stTransactionRecord &Record, unsigned int AccountId)
+    {
+        // integer compares only: the caller looked the account id up once
+        if (Record.UserId == AccountId)
+            return true;
+
+        unsigned int Bit = TypeBit(Record.OperationType);
+
+        return ((FromSideMask & Bit) && Record.FromAccountId == AccountId) ||
+               ((ToSideMask & Bit) && Record.ToAccountId == AccountId);
+    }
+
+    template <typename TVector>
+    static void _Collect(TVector &vTransactions, const function<bool(const stTransactionRecord &)> &Filter,
+                         int FromDateKey, int ToDateKey)
+    {
+        // Records are a few machine words: they are filtered as they are parsed
+        // and only the matching ones are stored (no "load all, then copy" pass).
+        SB_MEASURE(LoggerQuery);
+        clsStorage::Transactions().ForEachLine([&vTransactions, &Filter](const string &Line)
+                                               {
+                                                   stTransactionRecord Record;
+                                                   if (_ConvertLineToTransactionRecord(Line, Record) &&
+                                                       (!Filter || Filter(Record)))
+                                                       vTransactions.push_back(Record);
+                                               },
+                                               FromDateKey, ToDateKey);
+    }
+
+    template <typename TVector>
+    static void _CollectAccount(TVector &vTransactions, string_view AccountNumber)
+    {
+        // Only the lines that mention the account are read when the store
+        // has an index (sqlite); the exact filter still decides, since a
+        // "mention" in the wrong column (e.g. FromAccount of a deposit) is
+        // not the account's transaction.
+        SB_MEASURE(LoggerQuery);
+        unsigned int AccountId;
+        if (!_FindAccountId(AccountNumber, AccountId))
+            return; // no line of the log mentions it
+
+        function<bool(const stTransactionRecord &)> Filter = _AccountFilter(AccountId);
+        clsStorage::Transactions().ForEachLineMentioning(AccountNumber, [&vTransactions, &Filter](const string &Line)
+                                                         {
+                                                             stTransactionRecord Record;
+                                                             if (_ConvertLineToTransactionRecord(Line, Record) && Filter(Record))
+                                                                 vTransactions.push_back(Record);
+                                                         });
+    }
+
+    static void _InternNewLines(string_view AccountNumber)
+    {
+        // Brings the symbol table up to date with the log: parsing a line
+        // interns its fields. sqlite reads only the lines that mention the
+        // account (index); the segmented log reads the lines appended since
+        // the last call, by any process (the whole log the first time).
+        auto Intern = [](const string &Line)
+        {
+            stTransactionRecord Record;
+            _ConvertLineToTransactionRecord(Line, Record);
+        };
+
+        if (clsStorage::GetBackend() == clsStorage::bkSqlite)
+        {
+            clsStorage::Transactions().ForEachLineMentioning(AccountNumber, Intern);
+            return;
+        }
+
+        static mutex Mutex;
+        static clsSegmentedLog::stLogPosition Interned;
+        static unsigned long long ConfigurationId = 0;
+        lock_guard<mutex> Lock(Mutex);
+
+        if (ConfigurationId != clsStorage::ConfigurationId())
+        {
+            ConfigurationId = clsStorage::ConfigurationId();
+            Interned = clsSegmentedLog::stLogPosition();
+        }
+
+        string Path = clsStorage::Path("AllTransactions.txt");
+        clsSegmentedLog::stLogPosition End = clsSegmentedLog::GetEndPosition(Path);
+        if (End.ClosedSeq == Interned.ClosedSeq && End.ActiveBytes == Interned.ActiveBytes)
+            return;
+
+        if (!clsSegmentedLog::ForEachLineAfter(Path, Interned, Intern))
+            clsStorage::Transactions().ForEachLine(Intern); // position lost: read it all once
+        Interned = End;
+    }
+
+    static bool _FindAccountId(string_view AccountNumber, unsigned int &AccountId)
+    {
+        // the query string itself is never interned
+        if (clsSymbolTable::TryFind(AccountNumber, AccountId))
+            return true;
+
+        _InternNewLines(AccountNumber);
+        return clsSymbolTable::TryFind(AccountNumber, AccountId);
+    }
+
+    static function<bool(const stTransactionRecord &)> _AccountFilter(unsigned int AccountId)
+    {
+        return [AccountId](const stTransactionRecord &Record)
+        { return _InvolvesAccount(Record, AccountId); };
+    }
+
+    static function<bool(const stTransactionRecord &)> _TypeMaskFilter(unsigned int TypeMask)
+    {
+        return [TypeMask](const stTransactionRecord &Record)
+        { return (TypeMask & TypeBit(Record.OperationType)) != 0; };
     }
 
 public:
+    static string FormatTransactionLine(string_view Date, string_view Time, string_view Username,
+                                        enOperationType Type, double Amount, string_view FromAccount,
+                                        string_view ToAccount, double BalanceAfter)
+    {
+        string Line;
+        Line.reserve(96);
+        Line += Date;
+        Line += "#//#";
+        Line += Time;
+        Line += "#//#";
+        Line += Username;
+        Line += "#//#";
+        Line += OperationTypeToString(Type);
+        Line += "#//#";
+        _AppendNumber(Line, Amount);
+        Line += "#//#";
+        Line += FromAccount;
+        Line += "#//#";
+        Line += ToAccount;
+        Line += "#//#";
+        _AppendNumber(Line, BalanceAfter);
+        return Line;
+    }
+
+    static void AppendTransactionLines(const vector<string> &vLines)
+    {
+        // group commit: one lock and one write for the whole batch
+        SB_MEASURE(LoggerAppend);
+        clsStorage::Transactions().AppendLines(vLines);
+    }
+
     // Client Operations
     template <typename T>
     static void LogDeposit(const T &Client, double Amount)
@@ -202,93 +479,72 @@ public:
 
     static vector<stTransactionRecord> GetAllTransactions()
     {
-        vector<stTransactionRecord> vTransactions;
-        fstream MyFile("../data/AllTransactions.txt", ios::in);
+        // full history: every closed segment + the active segment
+        return GetTransactionsBetween(0, INT_MAX);
+    }
 
-        if (MyFile.is_open())
-        {
-            string Line;
-            while (getline(MyFile, Line))
-            {
-                vector<string> vData = clsString::Split(Line, "#//#");
-
-                if (vData.size() >= 8)
-                {
-                    stTransactionRecord Record;
-                    Record.Date = vData[0];
-                    Record.Time = vData[1];
-                    Record.Username = vData[2];
-                    Record.OperationType = vData[3];
-                    Record.Amount = stod(vData[4]);
-                    Record.FromAccount = vData[5];
-                    Record.ToAccount = vData[6];
-                    Record.BalanceAfter = stod(vData[7]);
-
-                    vTransactions.push_back(Record);
-                }
-            }
-            MyFile.close();
-        }
+    static vector<stTransactionRecord> GetTransactionsBetween(const clsDate &From, const clsDate &To)
+    {
+        return GetTransactionsBetween(clsSegmentedLog::DateKey(clsDate::DateToString(From)),
+                                      clsSegmentedLog::DateKey(clsDate::DateToString(To)));
+    }
 
+    static vector<stTransactionRecord> GetTransactionsBetween(int FromDateKey, int ToDateKey)
+    {
+        // Closed segments outside [FromDateKey, ToDateKey] are skipped
+        // using the manifest, so recent-history queries stay cheap.
+        vector<stTransactionRecord> vTransactions;
+        _Collect(vTransactions, nullptr, FromDateKey, ToDateKey);
         return vTransactions;
     }
 
-    static vector<stTransactionRecord> GetAccountTransactions(string AccountNumber)
+    static vector<stTransactionRecord> GetAccountTransactions(const string &AccountNumber)
     {
         vector<stTransactionRecord> vTransactions;
-        vector<stTransactionRecord> vAllTransactions = GetAllTransactions();
-
-        for (const stTransactionRecord &Record : vAllTransactions)
-        {
-            if (Record.Username == AccountNumber ||
-                (Record.OperationType == "TRANSFER_OUT" && Record.FromAccount == AccountNumber) ||
-                (Record.OperationType == "TRANSFER_IN" && Record.ToAccount == AccountNumber) ||
-                (Record.OperationType == "ADMIN_DEPOSIT" && Record.ToAccount == AccountNumber) ||
-                (Record.OperationType == "ADMIN_WITHDRAW" && Record.FromAccount == AccountNumber) ||
-                (Record.OperationType == "ADM_TRANS_OUT" && Record.FromAccount == AccountNumber) ||
-                (Record.OperationType == "ADM_TRANS_IN" && Record.ToAccount == AccountNumber)
-                )
-            {
-                vTransactions.push_back(Record);
-            }
-        }
-
+        _CollectAccount(vTransactions, AccountNumber);
         return vTransactions;
     }
 
-    static vector<stTransactionRecord> GetTransactionsByType(string Type)
+    static vector<stTransactionRecord> GetTransactionsByType(enOperationType Type)
     {
-        vector<stTransactionRecord> vTransactions;
-        vector<stTransactionRecord> vAllTransactions = GetAllTransactions();
+        return GetTransactionsByTypes(TypeBit(Type));
+    }
 
-        for (const stTransactionRecord &Record : vAllTransactions)
-        {
-            if (Record.OperationType == Type)
-            {
-                vTransactions.push_back(Record);
-            }
-        }
+    static vector<stTransactionRecord> GetTransactionsByType(const string &Type)
+    {
+        return GetTransactionsByType(OperationTypeFromString(Type));
+    }
 
+    static vector<stTransactionRecord> GetTransactionsByTypes(unsigned int TypeMask)
+    {
+        // TypeMask: OR of TypeBit(...) values, e.g. AdminOperationsMask
+        vector<stTransactionRecord> vTransactions;
+        _Collect(vTransactions, _TypeMaskFilter(TypeMask), 0, INT_MAX);
         return vTransactions;
     }
+
     static vector<stTransactionRecord> GetAllAdminTransactions()
     {
-        vector<stTransactionRecord> vAdminTransactions;
-        vector<stTransactionRecord> vAllTransactions = GetAllTransactions();
-    
-        for (const stTransactionRecord &Record : vAllTransactions)
-        {
-            // Include only admin operations
-            if (Record.OperationType == "ADMIN_DEPOSIT" ||
-                Record.OperationType == "ADMIN_WITHDRAW" ||
-                Record.OperationType == "ADM_TRANS_OUT" ||
-                Record.OperationType == "ADM_TRANS_IN")
-            {
-                vAdminTransactions.push_back(Record);
-            }
-        }
-    
-        return vAdminTransactions;
+        return GetTransactionsByTypes(AdminOperationsMask);
+    }
+
+    //---------------------------------------------
+    // Arena-backed queries (see "Arena Queries" above)
+    //---------------------------------------------
+    static void QueryTransactions(stQueryResult &Result,
+                                  const function<bool(const stTransactionRecord &)> &Filter = nullptr,
+                                  int FromDateKey = 0, int ToDateKey = INT_MAX)
+    {
+        _Collect(Result.Records, Filter, FromDateKey, ToDateKey);
     }
 
+    static void QueryAccountTransactions(stQueryResult &Result, string_view AccountNumber)
+    {
+        _CollectAccount(Result.Records, AccountNumber);
+    }
+
+    static void QueryAdminTransactions(stQueryResult &Result)
+    {
+        QueryTransactions(Result, _TypeMaskFilter(AdminOperationsMask));
+    }
 };
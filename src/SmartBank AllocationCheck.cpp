@@ -0,0 +1,234 @@
+/*SmartBank AllocationCheck Overview
+================================================================================
+                         SmartBank AllocationCheck.cpp
+================================================================================
+Overview:
+---------
+Command-line check that Deposit, Withdraw and Transfer stay inside their heap
+allocation budget once the program is warmed up (stores open, indexes built,
+buffers grown). The global operator new / delete are replaced by counting
+versions; every other part of the program is the one the application uses.
+
+The check runs on a scratch copy of the data root:
+
+1. Open the storage, find two accounts (clsBankClient::Find).
+2. Warm-up: every operation --warmup times, not counted.
+3. Every operation --operations times, counted: allocations per operation
+   are compared with the budget of the backend (BudgetOf() below).
+
+Each operation prints one line; the exit code is 0 when every operation was
+inside its budget, 1 otherwise (2 when the scratch copy or the storage cannot
+be opened). A budget is a ceiling, not a target: lower it when a change
+removes allocations, so the next regression is caught.
+
+================================================================================
+Command Line:
+-------------
+    --data-root ../data          folder to copy
+    --storage text|memory|binary the backend to check (default: memory)
+    --operations 2000            counted operations (each kind)
+    --warmup 200                 operations before counting (each kind)
+    --scratch <folder>           where the copy goes (default: the system
+                                 temp folder); removed afterwards
+
+Build (from src/, same as the application):
+    g++ -std=c++17 -O2 "SmartBank AllocationCheck.cpp" -o "SmartBank AllocationCheck" -lpthread
+
+================================================================================
+*/
+
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <atomic>
+#include <new>
+#include <cstdlib>
+#include <functional>
+#include <filesystem>
+
+#include "../core/clsStorage.h"
+#include "../core/clsBankClient.h"
+#include "../core/clsAccountTable.h"
+
+using namespace std;
+
+//---------------------------------------------
+// Counting operator new / delete
+//---------------------------------------------
+atomic<unsigned long long> Allocations{0};
+
+void *CountedAllocate(size_t Size)
+{
+    Allocations.fetch_add(1, memory_order_relaxed);
+    if (void *Block = malloc(Size ? Size : 1))
+        return Block;
+    throw bad_alloc();
+}
+
+void *operator new(size_t Size) { return CountedAllocate(Size); }
+void *operator new[](size_t Size) { return CountedAllocate(Size); }
+void *operator new(size_t Size, const nothrow_t &) noexcept
+{
+    Allocations.fetch_add(1, memory_order_relaxed);
+    return malloc(Size ? Size : 1);
+}
+void *operator new[](size_t Size, const nothrow_t &) noexcept
+{
+    Allocations.fetch_add(1, memory_order_relaxed);
+    return malloc(Size ? Size : 1);
+}
+void operator delete(void *Block) noexcept { free(Block); }
+void operator delete[](void *Block) noexcept { free(Block); }
+void operator delete(void *Block, size_t) noexcept { free(Block); }
+void operator delete[](void *Block, size_t) noexcept { free(Block); }
+void operator delete(void *Block, const nothrow_t &) noexcept { free(Block); }
+void operator delete[](void *Block, const nothrow_t &) noexcept { free(Block); }
+
+//---------------------------------------------
+// Budgets (allocations per operation, steady state)
+//---------------------------------------------
+struct stBudget
+{
+    double Deposit;
+    double Withdraw;
+    double Transfer;
+};
+
+stBudget BudgetOf(clsStorage::enBackend Backend, size_t Clients)
+{
+    // the text store reads and rewrites Clients.txt on every save: about one
+    // allocation per line (a Transfer saves twice); memory and binary replace
+    // the one record in place. The fraction covers amortized buffer growth.
+    switch (Backend)
+    {
+    case clsStorage::bkText:
+    {
+        double Save = 24 + 1.1 * Clients;
+        return {Save, Save, 2 * Save};
+    }
+    case clsStorage::bkBinary:
+        return {5.1, 5.1, 9.1};
+    default:
+        return {2.1, 2.1, 3.1};
+    }
+}
+
+int Failures = 0;
+
+void PrintUsage()
+{
+    cerr << "Usage: \"SmartBank AllocationCheck\" [--data-root ../data] [--storage text|memory|binary]\n"
+            "                                  [--operations 2000] [--warmup 200] [--scratch <folder>]"
+         << endl;
+}
+
+double AllocationsPerOperation(const function<void()> &Operation, int Warmup, int Operations)
+{
+    for (int i = 0; i < Warmup; i++)
+        Operation();
+
+    unsigned long long Before = Allocations.load();
+    for (int i = 0; i < Operations; i++)
+        Operation();
+    return (double)(Allocations.load() - Before) / Operations;
+}
+
+void Check(const string &Name, double PerOperation, double Budget)
+{
+    bool Passed = PerOperation <= Budget;
+    cout << (Passed ? "ok    " : "FAIL  ") << left << setw(10) << Name << right << fixed << setprecision(2)
+         << setw(8) << PerOperation << " allocations/op  (budget " << Budget << ")" << endl;
+    if (!Passed)
+        Failures++;
+}
+
+int main(int argc, char *argv[])
+{
+    string DataRoot = "../data";
+    filesystem::path Scratch = filesystem::temp_directory_path();
+    clsStorage::enBackend Backend = clsStorage::bkMemory;
+    int Operations = 2000;
+    int Warmup = 200;
+
+    for (int i = 1; i < argc; i++)
+    {
+        string Option = argv[i];
+        if (i + 1 >= argc)
+        {
+            PrintUsage();
+            return 1;
+        }
+        string Value = argv[++i];
+        if (Option == "--data-root")
+            DataRoot = Value;
+        else if (Option == "--scratch")
+            Scratch = Value;
+        else if (Option == "--operations")
+            Operations = max(1, atoi(Value.c_str()));
+        else if (Option == "--warmup")
+            Warmup = max(0, atoi(Value.c_str()));
+        else if (Option != "--storage" || !clsStorage::ParseBackend(Value, Backend) ||
+                 Backend == clsStorage::bkSqlite)
+        {
+            PrintUsage();
+            return 1;
+        }
+    }
+
+    // AllocationCheck process steps:
+    // 1. Copy the data root into a scratch folder and open the storage on it.
+    // 2. Find two accounts; count Deposit, Withdraw and Transfer after warm-up.
+    // 3. Remove the scratch folder.
+    filesystem::path Folder = Scratch / "smartbank-allocationcheck";
+    error_code Error;
+    filesystem::remove_all(Folder, Error);
+    filesystem::copy(DataRoot, Folder, filesystem::copy_options::recursive, Error);
+    if (Error)
+    {
+        cerr << "Cannot copy " << DataRoot << " to " << Folder.string() << ": " << Error.message() << endl;
+        return 2;
+    }
+
+    string Root = Folder.string() + "/";
+    if (!clsStorage::Configure(Backend, Root))
+    {
+        cerr << "Cannot open the " << clsStorage::BackendName(Backend) << " storage in " << Root << endl;
+        return 2;
+    }
+
+    clsAccountTable Table = clsAccountTable::Load();
+    if (Table.Size() < 2)
+    {
+        cerr << "The data root needs at least two clients." << endl;
+        return 2;
+    }
+
+    {
+        clsBankClient Source = clsBankClient::Find(Table.GetAccountNumber(0));
+        clsBankClient Destination = clsBankClient::Find(Table.GetAccountNumber(1));
+        Source.Deposit(1000000); // Withdraw and Transfer never run out
+
+        stBudget Budget = BudgetOf(Backend, Table.Size());
+        cout << "Storage: " << clsStorage::BackendName(Backend) << ", " << Table.Size() << " clients, " << Operations << " operations after "
+             << Warmup << " warm-up" << endl;
+
+        Check("Deposit", AllocationsPerOperation([&]
+                                                 { Source.Deposit(1); },
+                                                 Warmup, Operations),
+              Budget.Deposit);
+        Check("Withdraw", AllocationsPerOperation([&]
+                                                  { Source.Withdraw(1); },
+                                                  Warmup, Operations),
+              Budget.Withdraw);
+        Check("Transfer", AllocationsPerOperation([&]
+                                                  { Source.Transfer(1, Destination); },
+                                                  Warmup, Operations),
+              Budget.Transfer);
+    }
+
+    clsStorage::Configure(clsStorage::bkText, Root); // closes the scratch stores (text opens nothing)
+    filesystem::remove_all(Folder, Error);
+
+    cout << (Failures == 0 ? "All operations within budget." : to_string(Failures) + " operation(s) over budget.") << endl;
+    return (Failures == 0) ? 0 : 1;
+}
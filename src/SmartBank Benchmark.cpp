@@ -0,0 +1,415 @@
+/*SmartBank Benchmark Overview
+================================================================================
+                            SmartBank Benchmark.cpp
+================================================================================
+Overview:
+---------
+Separate executable that measures the core banking operations at several data
+sizes and prints one JSON line per benchmark (see utils/clsBenchmark.h).
+
+It never touches the real data/ folder. For every size it builds a scratch
+data root with clsDataGenerator (in the system temp directory, or --scratch):
+
+    <scratch>/smartbank_bench_<accounts>/data/Clients.txt        (N accounts, PIN 1234)
+    <scratch>/smartbank_bench_<accounts>/data/AllTransactions.txt (N history lines)
+    <scratch>/smartbank_bench_<accounts>/data/...SessionLog.txt   (N / 10 sessions)
+    <scratch>/smartbank_bench_<accounts>/data/Currencies.txt     (copied or generated)
+
+and points clsStorage at it (data root + the --storage backend), so core/
+reads and writes the scratch files exactly like in the application. Results
+of a non-text backend carry it in the name, e.g. "clsBankClient::Find [binary]".
+
+--storage takes a list: every backend runs on a freshly generated copy of the
+same data, one after the other, so "--storage text,sqlite" compares Find,
+transfer and the history queries head to head. For sqlite the scratch text
+files are imported into SmartBank.db first (clsSqliteMigration).
+
+================================================================================
+Benchmarks:
+-----------
+micro:
+    clsBankClient::Find                 clsBankClient::Find(Account, Pin)
+    clsBankClient::Deposit              clsBankClient::Withdraw
+    transfer (Withdraw + Deposit + LogTransfer)
+    clsTransactionLogger::LogDeposit    clsTransactionLogger::GetAccountTransactions
+    clsTransactionLogger::QueryAccountTransactions
+    clsString::Split                    clsCurrency::FindByCode
+    clsDate::GetDifferenceInDays
+macro:
+    atm_session: login, check balance, withdraw, deposit, transfer,
+                 transfer history, logout (the ATM menu flow without the UI)
+    batch_payments(10000 postings): clsBatchPaymentEngine::Post of a file of
+                 10,000 random transfers (postings/s = ops_per_sec * 10,000)
+    cold_start(text) / cold_start(snapshot): clsAccountTable::Load() from
+                 Clients.txt, then from a fresh clsSnapshot
+                 (cold_start(memory) / cold_start(binary) with those backends)
+    report_aggregation(workers=N): total balances, accounts below a threshold
+                 and a 0% interest run over the loaded clsAccountTable, on
+                 the shared thread pool (clsThreadPool) with N workers; run
+                 the benchmark with --workers 1 and --workers <cores> to see
+                 how a report scales
+
+================================================================================
+Command Line:
+-------------
+    --sizes 1000,100000,1000000   account counts to run (default)
+    --budget-ms 1000              time budget per benchmark
+    --min-iterations 5            samples taken even when over budget
+    --output results.jsonl        append results to a file instead of stdout
+    --keep                        keep the scratch folders for inspection
+    --storage text                storage backend(s): text, memory, binary, sqlite
+                                  (comma separated list, e.g. text,sqlite)
+    --scratch /dev/shm            folder for the scratch data roots (e.g. tmpfs)
+    --workers 8                   threads of the shared thread pool (default: one
+                                  per hardware thread, 1 = serial)
+
+Build (from src/, same as the application):
+    g++ -std=c++17 -O2 "SmartBank Benchmark.cpp" -o "SmartBank Benchmark"
+with the sqlite backend:
+    g++ -std=c++17 -O2 -DSMARTBANK_WITH_SQLITE "SmartBank Benchmark.cpp" -o "SmartBank Benchmark" -lsqlite3
+
+================================================================================
+*/
+
+#include <iostream>
+#include <fstream>
+#include <string>
+#include <vector>
+#include <random>
+#include <filesystem>
+
+#include "../core/clsBankClient.h"
+#include "../core/clsCurrency.h"
+#include "../core/clsBatchPaymentEngine.h"
+#include "../core/clsTransactionLogger.h"
+#include "../core/clsDataGenerator.h"
+#include "../core/clsSnapshot.h"
+#include "../core/clsStorage.h"
+#include "../core/clsSqliteMigration.h"
+#include "../utils/clsDate.h"
+#include "../utils/clsString.h"
+#include "../utils/clsUtil.h"
+#include "../utils/clsBenchmark.h"
+#include "../utils/clsThreadPool.h"
+
+using namespace std;
+
+struct stBenchmarkSettings
+{
+    vector<size_t> vSizes{1000, 100000, 1000000};
+    clsBenchmark::stOptions Options;
+    string OutputPath = "";
+    bool KeepData = false;
+    vector<clsStorage::enBackend> vBackends{clsStorage::bkText};
+    filesystem::path ScratchFolder = filesystem::temp_directory_path();
+};
+
+const string BenchmarkPin = "1234";
+
+string AccountNumberOf(size_t Index)
+{
+    // same numbering as the generated Clients.txt: A0000001, A0000002, ...
+    char Text[16];
+    return string(clsDataGenerator::AccountNumber(Index, Text));
+}
+
+void WriteScratchData(const filesystem::path &Root, size_t Accounts, const filesystem::path &CurrenciesSource)
+{
+    // WriteScratchData process steps:
+    // 1. Start from an empty <Root>.
+    // 2. Generate <Root>/data with clsDataGenerator: N accounts sharing one
+    //    PIN, N history lines, uniform account choice, fixed seed.
+    // 3. Copy the real Currencies.txt, or generate codes when it is missing.
+    filesystem::remove_all(Root);
+    filesystem::create_directories(Root);
+
+    clsDataGenerator::stOptions Options;
+    Options.DataFolder = (Root / "data").string();
+    Options.Accounts = Accounts;
+    Options.Transactions = Accounts;
+    Options.Sessions = max<size_t>(Accounts / 10, 1);
+    Options.Skew = 0;
+    Options.Seed = 20251126;
+    Options.FixedPin = BenchmarkPin;
+    clsDataGenerator::Generate(Options);
+
+    error_code Error;
+    if (!filesystem::copy_file(CurrenciesSource, Root / "data" / "Currencies.txt", Error))
+    {
+        ofstream Currencies(Root / "data" / "Currencies.txt", ios::out | ios::trunc);
+        for (char A = 'A'; A <= 'F'; A++)
+            for (char B = 'A'; B <= 'Z'; B++)
+                Currencies << "Country " << A << B << " || " << A << B << 'X' << " || Currency " << A << B << " || 1.500000\n";
+    }
+}
+
+void RunSize(const stBenchmarkSettings &Settings, clsStorage::enBackend Backend, size_t Accounts, ostream &Out,
+             const filesystem::path &CurrenciesSource)
+{
+    filesystem::path Root = Settings.ScratchFolder / ("smartbank_bench_" + to_string(Accounts));
+    filesystem::path DataRoot = Root / "data";
+
+    cerr << "Preparing " << Accounts << " accounts in " << Root.string() << " ..." << endl;
+    WriteScratchData(Root, Accounts, CurrenciesSource);
+#ifdef SMARTBANK_WITH_SQLITE
+    if (Backend == clsStorage::bkSqlite)
+    {
+        clsSqliteMigration::stResult Import = clsSqliteMigration::Import(DataRoot.string(), true);
+        if (!Import.Success)
+            cerr << Import.Error << endl;
+    }
+#endif
+    if (!clsStorage::Configure(Backend, DataRoot.string()))
+    {
+        cerr << "Cannot open the " << clsStorage::BackendName(Backend) << " storage in " << DataRoot.string() << endl;
+        return;
+    }
+
+    const clsBenchmark::stOptions &Options = Settings.Options;
+    mt19937 Random(20251126); // fixed seed: every run picks the same accounts
+    uniform_int_distribution<size_t> PickAccount(0, Accounts - 1);
+
+    string BackendSuffix = (Backend == clsStorage::bkText) ? "" : " [" + clsStorage::BackendName(Backend) + "]";
+    auto Report = [&](clsBenchmark::stBenchmarkResult Result)
+    {
+        Result.Name += BackendSuffix;
+        Out << clsBenchmark::ToJson(Result) << endl;
+    };
+
+    //---------------------------------------------
+    // Micro: clients
+    //---------------------------------------------
+    Report(clsBenchmark::Run("micro", "clsBankClient::Find", Accounts, [&]()
+                             { clsBenchmark::KeepValue(clsBankClient::Find(AccountNumberOf(PickAccount(Random)))); }, Options));
+
+    Report(clsBenchmark::Run("micro", "clsBankClient::Find(Account, Pin)", Accounts, [&]()
+                             { clsBenchmark::KeepValue(clsBankClient::Find(AccountNumberOf(PickAccount(Random)), BenchmarkPin)); }, Options));
+
+    Report(clsBenchmark::Run("micro", "clsBankClient::Deposit", Accounts, [&]()
+                             {
+                                 clsBankClient Client = clsBankClient::Find(AccountNumberOf(PickAccount(Random)));
+                                 Client.Deposit(10); }, Options));
+
+    Report(clsBenchmark::Run("micro", "clsBankClient::Withdraw", Accounts, [&]()
+                             {
+                                 clsBankClient Client = clsBankClient::Find(AccountNumberOf(PickAccount(Random)));
+                                 Client.Withdraw(10); }, Options));
+
+    Report(clsBenchmark::Run("micro", "transfer", Accounts, [&]()
+                             {
+                                 clsBankClient From = clsBankClient::Find(AccountNumberOf(PickAccount(Random)));
+                                 clsBankClient To = clsBankClient::Find(AccountNumberOf(PickAccount(Random)));
+                                 if (From.Withdraw(5) == clsBankClient::enTransactionResults::trSucceeded)
+                                 {
+                                     To.Deposit(5);
+                                     clsTransactionLogger::LogTransfer(From, To, 5);
+                                 } }, Options));
+
+    //---------------------------------------------
+    // Micro: transaction log
+    //---------------------------------------------
+    // queries first, so the history they scan is the seeded N lines
+    Report(clsBenchmark::Run("micro", "clsTransactionLogger::GetAccountTransactions", Accounts, [&]()
+                             { clsBenchmark::KeepValue(clsTransactionLogger::GetAccountTransactions(AccountNumberOf(PickAccount(Random)))); }, Options));
+
+    Report(clsBenchmark::Run("micro", "clsTransactionLogger::QueryAccountTransactions", Accounts, [&]()
+                             {
+                                 clsTransactionLogger::stQueryResult Result;
+                                 clsTransactionLogger::QueryAccountTransactions(Result, AccountNumberOf(PickAccount(Random)));
+                                 clsBenchmark::KeepValue(Result.Records.size()); }, Options));
+
+    clsBankClient LogClient = clsBankClient::Find(AccountNumberOf(0));
+
+    Report(clsBenchmark::Run("micro", "clsTransactionLogger::LogDeposit", Accounts, [&]()
+                             { clsTransactionLogger::LogDeposit(LogClient, 1); }, Options));
+
+    //---------------------------------------------
+    // Micro: utilities (independent of the account count)
+    //---------------------------------------------
+    string ClientLine = "Mohammed || Abu Hadhoud || mo.abuhadhoud@gmail.com || 0799997886 || A101 || 3456 || 4400.000000";
+    Report(clsBenchmark::Run("micro", "clsString::Split", Accounts, [&]()
+                             { clsBenchmark::KeepValue(clsString::Split(ClientLine, " || ")); }, Options));
+
+    vector<clsCurrency> vCurrencies = clsCurrency::GetAllUSDRates();
+    uniform_int_distribution<size_t> PickCurrency(0, vCurrencies.empty() ? 0 : vCurrencies.size() - 1);
+    Report(clsBenchmark::Run("micro", "clsCurrency::FindByCode", Accounts, [&]()
+                             {
+                                 string Code = vCurrencies.empty() ? "USD" : vCurrencies[PickCurrency(Random)].GetCurrencyCode();
+                                 clsBenchmark::KeepValue(clsCurrency::FindByCode(Code)); }, Options));
+
+    uniform_int_distribution<int> PickYear(1990, 2030), PickMonth(1, 12), PickDay(1, 28);
+    Report(clsBenchmark::Run("micro", "clsDate::GetDifferenceInDays", Accounts, [&]()
+                             {
+                                 clsDate Date1((short)PickDay(Random), (short)PickMonth(Random), (short)PickYear(Random));
+                                 clsDate Date2((short)PickDay(Random), (short)PickMonth(Random), (short)PickYear(Random));
+                                 clsBenchmark::KeepValue(clsDate::GetDifferenceInDays(Date1, Date2)); }, Options));
+
+    //---------------------------------------------
+    // Macro: one full ATM session
+    //---------------------------------------------
+    Report(clsBenchmark::Run("macro", "atm_session", Accounts, [&]()
+                             {
+                                 // login
+                                 clsBankClient Client = clsBankClient::Find(AccountNumberOf(PickAccount(Random)), BenchmarkPin);
+                                 if (Client.IsEmpty())
+                                     return;
+                                 clsBankClient::RegisterClientSession(Client, "LOGIN");
+
+                                 // check balance
+                                 clsBenchmark::KeepValue(Client.GetAccountBalance());
+
+                                 // quick withdraw + deposit
+                                 if (Client.Withdraw(100) == clsBankClient::enTransactionResults::trSucceeded)
+                                     clsTransactionLogger::LogWithdraw(Client, 100);
+                                 Client.Deposit(100);
+                                 clsTransactionLogger::LogDeposit(Client, 100);
+
+                                 // transfer
+                                 clsBankClient To = clsBankClient::Find(AccountNumberOf(PickAccount(Random)));
+                                 if (!To.IsEmpty() && Client.Withdraw(50) == clsBankClient::enTransactionResults::trSucceeded)
+                                 {
+                                     To.Deposit(50);
+                                     clsTransactionLogger::LogTransfer(Client, To, 50);
+                                 }
+
+                                 // transfer history
+                                 clsTransactionLogger::stQueryResult History;
+                                 clsTransactionLogger::QueryAccountTransactions(History, Client.GetAccountNumber());
+                                 clsBenchmark::KeepValue(History.Records.size());
+
+                                 // logout
+                                 clsBankClient::RegisterClientSession(Client, "LOGOUT"); }, Options));
+
+    //---------------------------------------------
+    // Macro: batch posting (payroll style)
+    //---------------------------------------------
+    const size_t BatchPostings = 10000;
+    const string BatchPath = (DataRoot / "batch_payments.csv").string();
+    {
+        ofstream Instructions(BatchPath, ios::out | ios::trunc);
+        for (size_t i = 0; i < BatchPostings; i++)
+            Instructions << AccountNumberOf(PickAccount(Random)) << ',' << AccountNumberOf(PickAccount(Random)) << ",1\n";
+    }
+
+    Report(clsBenchmark::Run("macro", "batch_payments(" + to_string(BatchPostings) + " postings)", Accounts, [&]()
+                             { clsBenchmark::KeepValue(clsBatchPaymentEngine::Post(BatchPath).Posted); }, Options));
+
+    //---------------------------------------------
+    // Macro: cold start (text files vs binary snapshot + log tail)
+    //---------------------------------------------
+    clsSnapshot::Invalidate();
+    string ColdStartName = "cold_start(" + clsStorage::BackendName(Backend) + ")";
+    Report(clsBenchmark::Run("macro", ColdStartName, Accounts, [&]()
+                             { clsBenchmark::KeepValue(clsAccountTable::Load().Size()); }, Options));
+
+    if (Backend == clsStorage::bkText) // the snapshot describes the text files only
+    {
+        clsSnapshot::Write();
+        Report(clsBenchmark::Run("macro", "cold_start(snapshot)", Accounts, [&]()
+                                 { clsBenchmark::KeepValue(clsAccountTable::Load().Size()); }, Options));
+    }
+
+    //---------------------------------------------
+    // Macro: report aggregation on the thread pool
+    //---------------------------------------------
+    clsAccountTable Table = clsAccountTable::Load();
+    string ReportName = "report_aggregation(workers=" + to_string(clsThreadPool::Shared().WorkerCount()) + ")";
+    Report(clsBenchmark::Run("macro", ReportName, Accounts, [&]()
+                             {
+                                 clsBenchmark::KeepValue(Table.GetTotalBalances());
+                                 clsBenchmark::KeepValue(Table.CountAccountsBelow(1000));
+                                 clsBenchmark::KeepValue(Table.ApplyInterest(0)); }, Options));
+
+    if (!Settings.KeepData)
+    {
+        error_code Error;
+        filesystem::remove_all(Root, Error);
+    }
+}
+
+bool ReadBackends(const string &List, vector<clsStorage::enBackend> &vBackends)
+{
+    // "text,sqlite" -> {bkText, bkSqlite}; any unknown name rejects the list
+    vector<clsStorage::enBackend> vParsed;
+    for (const string &Name : clsString::Split(List, ","))
+    {
+        clsStorage::enBackend Backend;
+        if (!clsStorage::ParseBackend(Name, Backend))
+            return false;
+        vParsed.push_back(Backend);
+    }
+    if (vParsed.empty())
+        return false;
+
+    vBackends = vParsed;
+    return true;
+}
+
+bool ReadSettings(int argc, char *argv[], stBenchmarkSettings &Settings)
+{
+    for (int i = 1; i < argc; i++)
+    {
+        string Argument = argv[i];
+        bool HasValue = (i + 1 < argc);
+
+        if (Argument == "--sizes" && HasValue)
+        {
+            Settings.vSizes.clear();
+            for (const string &Size : clsString::Split(argv[++i], ","))
+                if (!Size.empty() && stoull(Size) > 0)
+                    Settings.vSizes.push_back((size_t)stoull(Size));
+        }
+        else if (Argument == "--budget-ms" && HasValue)
+            Settings.Options.TimeBudgetMs = stod(argv[++i]);
+        else if (Argument == "--min-iterations" && HasValue)
+            Settings.Options.MinIterations = (size_t)stoull(argv[++i]);
+        else if (Argument == "--output" && HasValue)
+            Settings.OutputPath = argv[++i];
+        else if (Argument == "--keep")
+            Settings.KeepData = true;
+        else if (Argument == "--storage" && HasValue && ReadBackends(argv[i + 1], Settings.vBackends))
+            i++;
+        else if (Argument == "--scratch" && HasValue && filesystem::is_directory(argv[i + 1]))
+            Settings.ScratchFolder = argv[++i];
+        else if (Argument == "--workers" && HasValue)
+            clsThreadPool::SharedWorkers = (size_t)stoull(argv[++i]);
+        else
+        {
+            cerr << "Usage: \"SmartBank Benchmark\" [--sizes 1000,100000,1000000] [--budget-ms 1000]"
+                 << " [--min-iterations 5] [--output results.jsonl] [--keep]"
+                 << " [--storage text,memory,binary,sqlite] [--scratch /dev/shm] [--workers 8]" << endl;
+            return false;
+        }
+    }
+    return !Settings.vSizes.empty();
+}
+
+int main(int argc, char *argv[])
+{
+    stBenchmarkSettings Settings;
+    if (!ReadSettings(argc, argv, Settings))
+        return 1;
+
+    // the real currency list, when the benchmark is started from src/ like the application
+    // (or from SMARTBANK_DATA_ROOT)
+    clsStorage::ConfigureFromEnvironment();
+    filesystem::path CurrenciesSource = filesystem::absolute(clsStorage::Path(clsStorage::CurrenciesFile));
+
+    ofstream OutputFile;
+    if (!Settings.OutputPath.empty())
+    {
+        OutputFile.open(filesystem::absolute(Settings.OutputPath), ios::out | ios::app);
+        if (!OutputFile.is_open())
+        {
+            cerr << "Cannot open " << Settings.OutputPath << endl;
+            return 1;
+        }
+    }
+    ostream &Out = OutputFile.is_open() ? OutputFile : cout;
+
+    for (size_t Accounts : Settings.vSizes)
+        for (clsStorage::enBackend Backend : Settings.vBackends)
+            RunSize(Settings, Backend, Accounts, Out, CurrenciesSource);
+
+    return 0;
+}
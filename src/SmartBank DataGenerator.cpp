@@ -0,0 +1,129 @@
+/*SmartBank DataGenerator Overview
+================================================================================
+                          SmartBank DataGenerator.cpp
+================================================================================
+Overview:
+---------
+Command-line tool that writes a synthetic data folder with
+clsDataGenerator (core/clsDataGenerator.h) for load tests:
+Clients.txt, Admins.text, AllTransactions.txt, ClientsSessionLog.txt and
+AdminsSessionLog.txt, plus a copy of the real Currencies.txt when found.
+
+The same options and seed always produce the same files, and the folder can
+be used directly as a data root:
+
+    "SmartBank System & ATM" --data-root ../data_generated [--storage binary]
+
+================================================================================
+Command Line:
+-------------
+    --out ../data_generated      output folder (never defaults to ../data)
+    --accounts 1000              number of clients
+    --admins 10                  number of admins (Admin1 has all permissions)
+    --transactions 10000         lines in AllTransactions.txt
+    --sessions 1000              client LOGIN/LOGOUT pairs
+    --days 30                    history covers the last N days
+    --skew 0.99                  Zipf exponent for hot accounts (0 = uniform)
+    --seed 1                     random seed
+    --pin 1234                   same PIN for every client (default: random)
+
+Example (10M-row history over 1M accounts):
+    "SmartBank DataGenerator" --accounts 1000000 --transactions 10000000 --seed 42
+
+Build (from src/, same as the application):
+    g++ -std=c++17 -O2 "SmartBank DataGenerator.cpp" -o "SmartBank DataGenerator"
+
+================================================================================
+*/
+
+#include <iostream>
+#include <string>
+#include <filesystem>
+
+#include "../core/clsDataGenerator.h"
+#include "../core/clsStorage.h"
+
+using namespace std;
+
+void PrintUsage()
+{
+    cerr << "Usage: \"SmartBank DataGenerator\" [--out ../data_generated] [--accounts 1000] [--admins 10]\n"
+         << "       [--transactions 10000] [--sessions 1000] [--days 30] [--skew 0.99] [--seed 1] [--pin 1234]" << endl;
+}
+
+bool ReadOptions(int argc, char *argv[], clsDataGenerator::stOptions &Options)
+{
+    for (int i = 1; i < argc; i++)
+    {
+        string Argument = argv[i];
+        if (i + 1 >= argc)
+            return false;
+
+        string Value = argv[++i];
+
+        if (Argument == "--out")
+            Options.DataFolder = Value;
+        else if (Argument == "--accounts")
+            Options.Accounts = (size_t)stoull(Value);
+        else if (Argument == "--admins")
+            Options.Admins = (size_t)stoull(Value);
+        else if (Argument == "--transactions")
+            Options.Transactions = (size_t)stoull(Value);
+        else if (Argument == "--sessions")
+            Options.Sessions = (size_t)stoull(Value);
+        else if (Argument == "--days")
+            Options.DaysSpan = (short)stoi(Value);
+        else if (Argument == "--skew")
+            Options.Skew = stod(Value);
+        else if (Argument == "--seed")
+            Options.Seed = (unsigned int)stoul(Value);
+        else if (Argument == "--pin")
+            Options.FixedPin = Value;
+        else
+            return false;
+    }
+    return true;
+}
+
+int main(int argc, char *argv[])
+{
+    clsDataGenerator::stOptions Options;
+
+    try
+    {
+        if (!ReadOptions(argc, argv, Options))
+        {
+            PrintUsage();
+            return 1;
+        }
+    }
+    catch (const exception &)
+    {
+        PrintUsage();
+        return 1;
+    }
+
+    if (Options.Accounts > 99999999999999ULL) // "A" + 14 digits = clsAccountNumber::MaxLength
+    {
+        cerr << "Too many accounts." << endl;
+        return 1;
+    }
+
+    clsDataGenerator::stSummary Summary = clsDataGenerator::Generate(Options);
+    clsStorage::ConfigureFromEnvironment(); // where the real Currencies.txt is
+
+    // currencies are reference data, not generated
+    error_code Error;
+    filesystem::copy_file(clsStorage::Path(clsStorage::CurrenciesFile), filesystem::path(Options.DataFolder) / "Currencies.txt",
+                          filesystem::copy_options::overwrite_existing, Error);
+
+    cout << "Data written to " << filesystem::absolute(Options.DataFolder).string() << "\n"
+         << "  Clients.txt           : " << Summary.ClientRows << " rows\n"
+         << "  Admins.text           : " << Summary.AdminRows << " rows\n"
+         << "  AllTransactions.txt   : " << Summary.TransactionRows << " rows\n"
+         << "  ClientsSessionLog.txt : " << Summary.ClientSessionRows << " rows\n"
+         << "  AdminsSessionLog.txt  : " << Summary.AdminSessionRows << " rows\n"
+         << "  Time                  : " << Summary.Seconds << " s" << endl;
+
+    return 0;
+}
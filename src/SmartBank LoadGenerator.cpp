@@ -0,0 +1,309 @@
+/*SmartBank LoadGenerator Overview
+================================================================================
+                          SmartBank LoadGenerator.cpp
+================================================================================
+Overview:
+---------
+Command-line load generator for the bank daemon
+("SmartBank System & ATM" --serve <address>). It opens N connections through
+clsBankServiceClient (core/clsBankServiceClient.h), keeps Depth pipelined
+requests in flight on each, and measures requests per second and the latency
+of every request from the moment it was sent to the moment its response
+arrived (clsLatencyHistogram).
+
+The result is one JSON line, like the benchmark suite:
+
+    {"suite":"daemon","operation":"balance","connections":4,"depth":32,
+     "requests":812345,"errors":0,"rejected":0,"seconds":10.001,
+     "requests_per_sec":81226.3,"p50_us":...,"p99_us":...,"p999_us":...,"max_us":...}
+
+errors: connection lost or rsBadRequest / rsUnknownOperation / rsFailed.
+rejected: answered with a business status (not found, insufficient balance,
+same account) - expected with random transfers / withdrawals.
+
+================================================================================
+Command Line:
+-------------
+    --address unix:/tmp/smartbank.sock     daemon address (or tcp:<port>)
+    --connections 4                         parallel connections (one thread each)
+    --depth 32                              requests in flight per connection
+    --seconds 10                            run time
+    --operation balance                     ping|find|balance|deposit|withdraw|transfer|
+                                            history|convert|mixed
+    --accounts A101,A102                    accounts to use
+    --generated 1000                        without --accounts: A0000001 ... (the
+                                            accounts of "SmartBank DataGenerator")
+    --seed 1                                random seed
+
+mixed: 60% balance, 15% deposit, 10% withdraw, 10% transfer, 5% history.
+deposit / withdraw / transfer change the balances of the data root the daemon
+serves: point it at a copy or a generated folder, not at ../data.
+
+Build (from src/, same as the application):
+    g++ -std=c++17 -O2 "SmartBank LoadGenerator.cpp" -o "SmartBank LoadGenerator" -lpthread
+
+================================================================================
+*/
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include <deque>
+#include <thread>
+#include <atomic>
+#include <chrono>
+#include <random>
+#include <cstdio>
+
+#include "../core/clsBankServiceClient.h"
+#include "../core/clsDataGenerator.h"
+#include "../utils/clsLatencyHistogram.h"
+
+using namespace std;
+
+struct stOptions
+{
+    string Address = "unix:/tmp/smartbank.sock";
+    size_t Connections = 4;
+    size_t Depth = 32;
+    double Seconds = 10;
+    string Operation = "balance";
+    vector<string> vAccounts;
+    size_t Generated = 1000;
+    unsigned int Seed = 1;
+};
+
+struct stTotals
+{
+    atomic<unsigned long long> Requests{0};
+    atomic<unsigned long long> Errors{0};
+    atomic<unsigned long long> Rejected{0};
+};
+
+void PrintUsage()
+{
+    cerr << "Usage: \"SmartBank LoadGenerator\" [--address unix:/tmp/smartbank.sock | tcp:<port>] [--connections 4]\n"
+         << "       [--depth 32] [--seconds 10] [--operation ping|find|balance|deposit|withdraw|transfer|history|convert|mixed]\n"
+         << "       [--accounts A101,A102 | --generated 1000] [--seed 1]" << endl;
+}
+
+bool IsOperation(const string &Operation)
+{
+    for (const char *Name : {"ping", "find", "balance", "deposit", "withdraw", "transfer", "history", "convert", "mixed"})
+    {
+        if (Operation == Name)
+            return true;
+    }
+    return false;
+}
+
+bool ReadOptions(int argc, char *argv[], stOptions &Options)
+{
+    for (int i = 1; i < argc; i++)
+    {
+        string Argument = argv[i];
+        if (i + 1 >= argc)
+            return false;
+
+        string Value = argv[++i];
+
+        if (Argument == "--address")
+            Options.Address = Value;
+        else if (Argument == "--connections")
+            Options.Connections = (size_t)stoull(Value);
+        else if (Argument == "--depth")
+            Options.Depth = (size_t)stoull(Value);
+        else if (Argument == "--seconds")
+            Options.Seconds = stod(Value);
+        else if (Argument == "--operation" && IsOperation(Value))
+            Options.Operation = Value;
+        else if (Argument == "--accounts")
+        {
+            size_t Start = 0;
+            while (Start <= Value.size())
+            {
+                size_t Comma = Value.find(',', Start);
+                if (Comma == string::npos)
+                    Comma = Value.size();
+                if (Comma > Start)
+                    Options.vAccounts.push_back(Value.substr(Start, Comma - Start));
+                Start = Comma + 1;
+            }
+        }
+        else if (Argument == "--generated")
+            Options.Generated = (size_t)stoull(Value);
+        else if (Argument == "--seed")
+            Options.Seed = (unsigned int)stoul(Value);
+        else
+            return false;
+    }
+    return Options.Connections > 0 && Options.Depth > 0 && Options.Seconds > 0;
+}
+
+uint32_t QueueRequest(clsBankServiceClient &Client, const string &Operation, const vector<string> &vAccounts, mt19937 &Random)
+{
+    // one request of Operation on random accounts ("mixed" draws the operation too)
+    uniform_int_distribution<size_t> PickAccount(0, vAccounts.size() - 1);
+    const string &Account = vAccounts[PickAccount(Random)];
+
+    string Chosen = Operation;
+    if (Operation == "mixed")
+    {
+        unsigned int Roll = Random() % 100;
+        Chosen = (Roll < 60) ? "balance" : (Roll < 75) ? "deposit" : (Roll < 85) ? "withdraw" : (Roll < 95) ? "transfer" : "history";
+    }
+
+    if (Chosen == "ping")
+        return Client.QueuePing();
+    if (Chosen == "find")
+        return Client.QueueFind(Account);
+    if (Chosen == "balance")
+        return Client.QueueBalance(Account);
+    if (Chosen == "deposit")
+        return Client.QueueDeposit(Account, 10);
+    if (Chosen == "withdraw")
+        return Client.QueueWithdraw(Account, 10);
+    if (Chosen == "transfer")
+        return Client.QueueTransfer(Account, vAccounts[PickAccount(Random)], 10);
+    if (Chosen == "history")
+        return Client.QueueHistory(Account, 10);
+    return Client.QueueConvert("USD", "EUR", 100);
+}
+
+void RunConnection(const stOptions &Options, const vector<string> &vAccounts, size_t Index,
+                   chrono::steady_clock::time_point Deadline, clsLatencyHistogram &Latency, stTotals &Totals)
+{
+    // RunConnection process steps:
+    // 1. Fill the pipeline up to Depth requests and send them in one write.
+    // 2. Take one response, record its latency, queue one more; repeat.
+    // 3. After the deadline stop queueing and drain what is in flight.
+    clsBankServiceClient Client;
+    string Error;
+    if (!Client.Connect(Options.Address, Error))
+    {
+        cerr << Error << endl;
+        Totals.Errors++;
+        return;
+    }
+
+    mt19937 Random(Options.Seed + (unsigned int)Index);
+    deque<chrono::steady_clock::time_point> dSentAt;
+
+    while (true)
+    {
+        bool Running = chrono::steady_clock::now() < Deadline;
+        if (Running)
+        {
+            while (dSentAt.size() < Options.Depth)
+            {
+                QueueRequest(Client, Options.Operation, vAccounts, Random);
+                dSentAt.push_back(chrono::steady_clock::now());
+            }
+            if (!Client.Flush())
+                break;
+        }
+        if (dSentAt.empty())
+            break;
+
+        clsBankServiceClient::stResponse Response;
+        if (!Client.Receive(Response))
+            break;
+
+        // responses come back in request order: the oldest send time is this one's
+        auto Elapsed = chrono::steady_clock::now() - dSentAt.front();
+        dSentAt.pop_front();
+        Latency.Record((unsigned long long)chrono::duration_cast<chrono::nanoseconds>(Elapsed).count());
+
+        Totals.Requests++;
+        if (Response.Status == clsBankProtocol::rsNotFound || Response.Status == clsBankProtocol::rsInsufficientBalance ||
+            Response.Status == clsBankProtocol::rsSameAccount)
+            Totals.Rejected++;
+        else if (Response.Status != clsBankProtocol::rsOk)
+            Totals.Errors++;
+    }
+
+    // requests that never got a response
+    Totals.Errors += dSentAt.size();
+}
+
+string Number(double Value)
+{
+    char Buffer[32];
+    snprintf(Buffer, sizeof(Buffer), "%.3f", Value);
+    return Buffer;
+}
+
+int main(int argc, char *argv[])
+{
+    stOptions Options;
+
+    try
+    {
+        if (!ReadOptions(argc, argv, Options))
+        {
+            PrintUsage();
+            return 1;
+        }
+    }
+    catch (const exception &)
+    {
+        PrintUsage();
+        return 1;
+    }
+
+    // without --accounts: the first N account numbers of "SmartBank DataGenerator"
+    vector<string> vAccounts = Options.vAccounts;
+    if (vAccounts.empty())
+    {
+        char Text[16];
+        for (size_t i = 0; i < Options.Generated; i++)
+            vAccounts.push_back(string(clsDataGenerator::AccountNumber(i, Text)));
+    }
+    if (vAccounts.empty())
+    {
+        PrintUsage();
+        return 1;
+    }
+
+    // one blocking round trip first: fail fast when nothing listens
+    {
+        clsBankServiceClient Probe;
+        string Error;
+        if (!Probe.Connect(Options.Address, Error) || Probe.Ping() != clsBankProtocol::rsOk)
+        {
+            cerr << (Error.empty() ? "The daemon did not answer a ping." : Error) << endl;
+            return 1;
+        }
+    }
+
+    clsLatencyHistogram Latency;
+    stTotals Totals;
+    auto Start = chrono::steady_clock::now();
+    auto Deadline = Start + chrono::duration_cast<chrono::steady_clock::duration>(chrono::duration<double>(Options.Seconds));
+
+    vector<thread> vThreads;
+    for (size_t i = 0; i < Options.Connections; i++)
+        vThreads.emplace_back(RunConnection, cref(Options), cref(vAccounts), i, Deadline, ref(Latency), ref(Totals));
+    for (thread &Thread : vThreads)
+        Thread.join();
+
+    double Seconds = chrono::duration<double>(chrono::steady_clock::now() - Start).count();
+    clsLatencyHistogram::stSnapshot Snapshot = Latency.GetSnapshot();
+    unsigned long long Requests = Totals.Requests;
+
+    cout << "{\"suite\":\"daemon\""
+         << ",\"operation\":\"" << Options.Operation << "\""
+         << ",\"connections\":" << Options.Connections
+         << ",\"depth\":" << Options.Depth
+         << ",\"requests\":" << Requests
+         << ",\"errors\":" << Totals.Errors
+         << ",\"rejected\":" << Totals.Rejected
+         << ",\"seconds\":" << Number(Seconds)
+         << ",\"requests_per_sec\":" << Number(Seconds > 0 ? (double)Requests / Seconds : 0)
+         << ",\"p50_us\":" << Number(Snapshot.Percentile(50) / 1000.0)
+         << ",\"p99_us\":" << Number(Snapshot.Percentile(99) / 1000.0)
+         << ",\"p999_us\":" << Number(Snapshot.Percentile(99.9) / 1000.0)
+         << ",\"max_us\":" << Number((double)Snapshot.MaxNanos / 1000.0) << "}" << endl;
+
+    return (Totals.Errors == 0) ? 0 : 2;
+}
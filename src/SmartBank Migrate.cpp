@@ -0,0 +1,92 @@
+/*SmartBank Migrate Overview
+================================================================================
+                             SmartBank Migrate.cpp
+================================================================================
+Overview:
+---------
+Command-line tool that imports the text files of a data root into
+SmartBank.db, the database of the optional sqlite storage backend
+(core/clsSqliteMigration.h):
+
+    Clients.txt, Admins.text, Currencies.txt            " || " records
+    AllTransactions.txt, ClientsSessionLog.txt,
+    AdminsSessionLog.txt (with their closed segments)   "#//#" log lines
+
+The text files are not changed. Afterwards the application can run on the
+database:
+
+    "SmartBank System & ATM" --data-root ../data --storage sqlite
+
+Run it while the application is stopped; an existing SmartBank.db is only
+replaced with --force.
+
+================================================================================
+Command Line:
+-------------
+    --data-root ../data          data root to import (default: SMARTBANK_DATA_ROOT
+                                 or ../data, like the application)
+    --force                      replace an existing SmartBank.db
+
+Build (from src/; needs sqlite3.h and the sqlite3 library):
+    g++ -std=c++17 -O2 -DSMARTBANK_WITH_SQLITE "SmartBank Migrate.cpp" -o "SmartBank Migrate" -lsqlite3
+
+================================================================================
+*/
+
+#ifndef SMARTBANK_WITH_SQLITE
+#error "SmartBank Migrate needs the sqlite backend: build with -DSMARTBANK_WITH_SQLITE ... -lsqlite3"
+#endif
+
+#include <iostream>
+#include <string>
+
+#include "../core/clsStorage.h"
+#include "../core/clsSqliteMigration.h"
+
+using namespace std;
+
+void PrintUsage()
+{
+    cerr << "Usage: \"SmartBank Migrate\" [--data-root ../data] [--force]" << endl;
+}
+
+int main(int argc, char *argv[])
+{
+    // the application's default data root (or SMARTBANK_DATA_ROOT)
+    clsStorage::ConfigureFromEnvironment();
+    string DataRoot = clsStorage::GetDataRoot();
+    bool Force = false;
+
+    for (int i = 1; i < argc; i++)
+    {
+        string Argument = argv[i];
+        if (Argument == "--data-root" && i + 1 < argc)
+            DataRoot = argv[++i];
+        else if (Argument == "--force")
+            Force = true;
+        else
+        {
+            PrintUsage();
+            return 1;
+        }
+    }
+
+    cerr << "Importing " << DataRoot << " ..." << endl;
+    clsSqliteMigration::stResult Result = clsSqliteMigration::Import(DataRoot, Force);
+    if (!Result.Success)
+    {
+        cerr << Result.Error << endl;
+        if (!Force && filesystem::exists(Result.DatabasePath))
+            cerr << "Use --force to replace it." << endl;
+        return 1;
+    }
+
+    cout << "Written " << Result.DatabasePath << " in " << Result.Seconds << " s\n"
+         << "  Clients:          " << Result.Clients << "\n"
+         << "  Admins:           " << Result.Admins << "\n"
+         << "  Currencies:       " << Result.Currencies << "\n"
+         << "  Transactions:     " << Result.Transactions << "\n"
+         << "  Client sessions:  " << Result.ClientSessions << "\n"
+         << "  Admin sessions:   " << Result.AdminSessions << endl;
+    return 0;
+}
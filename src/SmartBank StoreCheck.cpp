@@ -0,0 +1,211 @@
+/*SmartBank StoreCheck Overview
+================================================================================
+                           SmartBank StoreCheck.cpp
+================================================================================
+Overview:
+---------
+Command-line check that the record stores answer like the text store, which
+is the reference: clsTextRecordStore scans the file and returns the first
+line with a key. The memory and binary stores keep a hash index, and a key
+on more than one line must map to that same first line.
+
+Currencies.txt repeats codes (USD, EUR, AUD, CHF, XAF, XCD, XOF, ...), so
+the check runs on a scratch copy of it, one store per backend:
+
+1. Find() of every code gives the same line in every store.
+2. Delete() of a repeated code: the next line with it is found.
+3. Replace() of a repeated code with a longer line (moves the binary record)
+   is found, and still after the binary store is opened again.
+
+Each step prints one line; the exit code is 0 when every store agreed, 1
+otherwise (2 when the scratch copy cannot be made).
+
+================================================================================
+Command Line:
+-------------
+    --data-root ../data          folder with the Currencies.txt to copy
+    --scratch <folder>           where the copies go (default: the system
+                                 temp folder); removed afterwards
+
+Build (from src/, same as the application):
+    g++ -std=c++17 -O2 "SmartBank StoreCheck.cpp" -o "SmartBank StoreCheck" -lpthread
+
+================================================================================
+*/
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include <map>
+#include <memory>
+#include <filesystem>
+
+#include "../core/clsStorage.h"
+#include "../core/clsTextRecordStore.h"
+#include "../core/clsMemoryRecordStore.h"
+#include "../core/clsBinaryRecordStore.h"
+
+using namespace std;
+
+struct stStores
+{
+    unique_ptr<clsTextRecordStore> Text;
+    unique_ptr<clsMemoryRecordStore> Memory;
+    unique_ptr<clsBinaryRecordStore> Binary;
+};
+
+int Failures = 0;
+
+void PrintUsage()
+{
+    cerr << "Usage: \"SmartBank StoreCheck\" [--data-root ../data] [--scratch <folder>]" << endl;
+}
+
+void Report(const string &Check, bool Passed, const string &Detail = "")
+{
+    cout << (Passed ? "ok    " : "FAIL  ") << Check;
+    if (!Detail.empty())
+        cout << "  (" << Detail << ")";
+    cout << endl;
+    if (!Passed)
+        Failures++;
+}
+
+string FindIn(clsRecordStore &Store, const string &Code)
+{
+    string Line;
+    if (!Store.Find(clsStorage::CurrenciesKeyColumn, Code, Line))
+        return "<not found>";
+    return Line;
+}
+
+bool SameEverywhere(stStores &Stores, const string &Code, string &Detail)
+{
+    // the text store is the reference
+    string Expected = FindIn(*Stores.Text, Code);
+    string Memory = FindIn(*Stores.Memory, Code);
+    string Binary = FindIn(*Stores.Binary, Code);
+
+    if (Memory == Expected && Binary == Expected)
+        return true;
+
+    Detail = Code + ": text \"" + Expected + "\", memory \"" + Memory + "\", binary \"" + Binary + "\"";
+    return false;
+}
+
+map<string, size_t> CountCodes(const vector<string> &vLines)
+{
+    map<string, size_t> Counts;
+    for (const string &Line : vLines)
+        Counts[string(clsString::GetFieldView(Line, " || ", clsStorage::CurrenciesKeyColumn))]++;
+    return Counts;
+}
+
+void CheckEveryCode(stStores &Stores, const map<string, size_t> &Counts, const string &Step)
+{
+    string Detail;
+    size_t Mismatches = 0;
+    for (const auto &Entry : Counts)
+    {
+        string Current;
+        if (!SameEverywhere(Stores, Entry.first, Current))
+        {
+            Mismatches++;
+            if (Detail.empty())
+                Detail = Current;
+        }
+    }
+    Report(Step + ": every code finds the same line", Mismatches == 0, Detail);
+}
+
+int main(int argc, char *argv[])
+{
+    string DataRoot = "../data";
+    filesystem::path Scratch = filesystem::temp_directory_path();
+
+    for (int i = 1; i < argc; i++)
+    {
+        string Option = argv[i];
+        if (i + 1 >= argc)
+        {
+            PrintUsage();
+            return 1;
+        }
+        if (Option == "--data-root")
+            DataRoot = argv[++i];
+        else if (Option == "--scratch")
+            Scratch = argv[++i];
+        else
+        {
+            PrintUsage();
+            return 1;
+        }
+    }
+
+    // StoreCheck process steps:
+    // 1. Copy Currencies.txt into a scratch folder; open the three stores.
+    // 2. Run the checks; every one compares memory and binary with text.
+    // 3. Remove the scratch folder.
+    filesystem::path Folder = Scratch / "smartbank-storecheck";
+    error_code Error;
+    filesystem::remove_all(Folder, Error);
+    filesystem::create_directories(Folder, Error);
+
+    filesystem::path Source = filesystem::path(DataRoot) / clsStorage::CurrenciesFile;
+    filesystem::path TextPath = Folder / clsStorage::CurrenciesFile;
+    filesystem::copy_file(Source, TextPath, Error);
+    if (Error)
+    {
+        cerr << "Cannot copy " << Source.string() << " to " << TextPath.string() << ": " << Error.message() << endl;
+        return 2;
+    }
+
+    string BinaryPath = (Folder / "Currencies.sbr").string();
+    stStores Stores;
+    Stores.Text = make_unique<clsTextRecordStore>(TextPath.string(), clsStorage::CurrenciesKeyColumn, true);
+    vector<string> vLines = Stores.Text->ReadAll();
+
+    Stores.Memory = make_unique<clsMemoryRecordStore>(clsStorage::CurrenciesKeyColumn, true);
+    Stores.Memory->AppendAll(vLines);
+    Stores.Binary = make_unique<clsBinaryRecordStore>(BinaryPath, clsStorage::CurrenciesKeyColumn, true);
+    Stores.Binary->AppendAll(vLines);
+
+    // a repeated code for steps 2 and 3 (USD when the file still has it twice)
+    map<string, size_t> Counts = CountCodes(vLines);
+    string Repeated;
+    for (const auto &Entry : Counts)
+    {
+        if (Entry.second > 1 && (Repeated.empty() || Entry.first == "USD"))
+            Repeated = Entry.first;
+    }
+    Report("Currencies.txt repeats a code", !Repeated.empty(), Repeated.empty() ? "" : Repeated + " x" + to_string(Counts[Repeated]));
+
+    CheckEveryCode(Stores, Counts, "load");
+
+    if (!Repeated.empty())
+    {
+        string Detail;
+        bool Deleted = Stores.Text->Delete(Repeated) && Stores.Memory->Delete(Repeated) && Stores.Binary->Delete(Repeated);
+        Report("delete " + Repeated + ": the next line with it is found", Deleted && SameEverywhere(Stores, Repeated, Detail), Detail);
+
+        // longer than the slot: the binary store cannot rewrite it in place
+        string Current = FindIn(*Stores.Text, Repeated);
+        string Longer = Current + string(64, ' ') + "|| moved";
+        bool Replaced = Stores.Text->Replace(Repeated, Longer) && Stores.Memory->Replace(Repeated, Longer) &&
+                        Stores.Binary->Replace(Repeated, Longer);
+        Detail.clear();
+        Report("replace " + Repeated + " with a longer line", Replaced && SameEverywhere(Stores, Repeated, Detail) &&
+                                                                   FindIn(*Stores.Text, Repeated) == Longer,
+               Detail);
+
+        Stores.Binary.reset();
+        Stores.Binary = make_unique<clsBinaryRecordStore>(BinaryPath, clsStorage::CurrenciesKeyColumn, true);
+        CheckEveryCode(Stores, Counts, "binary store opened again");
+    }
+
+    Stores = stStores();
+    filesystem::remove_all(Folder, Error);
+
+    cout << (Failures == 0 ? "All stores agree." : to_string(Failures) + " check(s) failed.") << endl;
+    return (Failures == 0) ? 0 : 1;
+}
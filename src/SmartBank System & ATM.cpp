@@ -1,7 +1,3 @@
-#include <windows.h>
-#include <rpc.h>
-#include <rpcndr.h>
-
 #include <iostream>
 #include <iomanip>
 #include <vector>
@@ -9,11 +5,185 @@
 #include <fstream>
 
 #include "../Welcome_Screen/clsStartUpBankSystem.h"
+#include "../core/clsBatchRunner.h"
+#include "../core/clsBankServer.h"
+#include "../core/clsStandingOrders.h"
+#include "../core/clsMetrics.h"
+#include "../core/clsSnapshot.h"
+#include "../core/clsStorage.h"
+#include "../core/clsSharedAccountTable.h"
+#include "../utils/clsTerminal.h"
+#include "../utils/clsThreadPool.h"
+
+// Headless mode: "SmartBank System & ATM" --batch <file | ->
+// runs the commands through clsBatchRunner, prints JSON lines, draws no screen.
+int RunBatch(const string &Source)
+{
+    ios::sync_with_stdio(false);
+
+    clsBatchRunner::stSummary Summary;
+    if (Source == "-")
+    {
+        Summary = clsBatchRunner::Run(cin, cout);
+    }
+    else
+    {
+        ifstream Commands(Source);
+        if (!Commands.is_open())
+        {
+            cerr << "Cannot open command file: " << Source << endl;
+            return 1;
+        }
+        Summary = clsBatchRunner::Run(Commands, cout);
+    }
+
+    return (Summary.Failed == 0) ? 0 : 2;
+}
 
-int main()
+// Daemon mode: "SmartBank System & ATM" --serve unix:<path> | tcp:<port>
+// serves the core operations in the binary protocol of clsBankProtocol until
+// SIGINT / SIGTERM; draws no screen.
+int RunServer(const string &Address)
 {
+    string Error;
+    if (!clsBankServer::Run(Address, Error))
+    {
+        cerr << Error << endl;
+        return 1;
+    }
+    return 0;
+}
+
+// Storage: SMARTBANK_DATA_ROOT / SMARTBANK_STORAGE, overridden by
+// --data-root <folder> and --storage text|memory|binary|sqlite (see clsStorage).
+// sqlite needs a build with -DSMARTBANK_WITH_SQLITE ... -lsqlite3 and a
+// SmartBank.db made by "SmartBank Migrate".
+// --shared (or SMARTBANK_SHARED=1): several processes on one data root share
+// the balances through clsSharedAccountTable (text storage only).
+// --workers <n> (or SMARTBANK_WORKERS): threads of the shared thread pool
+// (clsThreadPool); 0 or unset = one per hardware thread, 1 = serial.
+bool ParseWorkers(const string &Value)
+{
+    if (Value.empty() || Value.find_first_not_of("0123456789") != string::npos || Value.size() > 4)
+        return false;
+    clsThreadPool::SharedWorkers = (size_t)stoul(Value);
+    return true;
+}
+
+bool ConfigureStorage(int argc, char *argv[], string &BatchSource, string &ServeAddress, bool &Shared)
+{
+    if (!clsStorage::ConfigureFromEnvironment())
+    {
+        cerr << "Invalid SMARTBANK_DATA_ROOT / SMARTBANK_STORAGE.\n";
+        return false;
+    }
+
+    string DataRoot = clsStorage::GetDataRoot();
+    clsStorage::enBackend Backend = clsStorage::GetBackend();
+    bool Changed = false;
+
+    for (int i = 1; i < argc; i++)
+    {
+        string Option = argv[i];
+        if (Option == "--shared")
+        {
+            Shared = true;
+            continue;
+        }
+        if (i + 1 >= argc)
+        {
+            cerr << "Missing value for " << Option << endl;
+            return false;
+        }
+
+        string Value = argv[++i];
+        if (Option == "--batch")
+            BatchSource = Value;
+        else if (Option == "--serve")
+            ServeAddress = Value;
+        else if (Option == "--data-root")
+        {
+            DataRoot = Value;
+            Changed = true;
+        }
+        else if (Option == "--storage" && clsStorage::ParseBackend(Value, Backend))
+            Changed = true;
+        else if (Option == "--workers" && ParseWorkers(Value))
+            continue;
+        else
+        {
+            cerr << "Usage: \"SmartBank System & ATM\" [--data-root <folder>] [--storage text|memory|binary|sqlite] [--shared] [--workers <n>] [--batch <file | -> | --serve <address>]\n";
+            return false;
+        }
+    }
+
+    if (Changed && !clsStorage::Configure(Backend, DataRoot))
+    {
+        cerr << "Cannot open the " << clsStorage::BackendName(Backend) << " storage in " << DataRoot << endl;
+        if (Backend == clsStorage::bkSqlite)
+            cerr << "Create it with: \"SmartBank Migrate\" --data-root " << DataRoot << endl;
+        return false;
+    }
+    return true;
+}
+
+int main(int argc, char *argv[])
+{
+    string BatchSource;
+    string ServeAddress;
+    const char *SharedVariable = getenv("SMARTBANK_SHARED");
+    bool Shared = (SharedVariable != nullptr && string(SharedVariable) == "1");
+
+    const char *WorkersVariable = getenv("SMARTBANK_WORKERS");
+    if (WorkersVariable != nullptr && !ParseWorkers(WorkersVariable))
+    {
+        cerr << "Invalid SMARTBANK_WORKERS.\n";
+        return 1;
+    }
+
+    if (!ConfigureStorage(argc, argv, BatchSource, ServeAddress, Shared))
+        return 1;
+
+    // pool task run times go to the metrics screen (no thread is started here)
+    clsMetrics::MeasurePoolTasks();
+
+    // everything up to here is start-up cost. text / memory have not read a
+    // record yet (binary indexes its .sbr files in Configure()); --shared
+    // then reads Clients.txt into shared memory, which is data loading
+    clsMetrics::MarkStartupComplete();
+
+    // shared mode: Detach() on every way out (here and on "Exit" in the
+    // start-up menu); the last process to leave writes the balances back
+    string Error;
+    if (Shared && !clsSharedAccountTable::Attach(Error))
+    {
+        cerr << Error << endl;
+        return 1;
+    }
+
+    if (!BatchSource.empty())
+    {
+        int Result = RunBatch(BatchSource);
+        clsSharedAccountTable::Detach();
+        return Result;
+    }
+
+    if (!ServeAddress.empty())
+    {
+        int Result = RunServer(ServeAddress);
+        clsSharedAccountTable::Detach();
+        return Result;
+    }
+
+    // screens are composed in memory and written once per frame
+    clsTerminal::EnableFrameOutput();
+
     while (true) // Infinite loop to keep the application running
     {
+        // posts the standing orders that fell due (O(1) when none did)
+        clsStandingOrders::RunDueOrders();
+        // refreshes the binary snapshot in the background when it is due
+        clsSnapshot::WriteIfDue();
         clsStartUpBankSystem::ShowStartUpMenu();
     }
     return 0;
@@ -0,0 +1,172 @@
+/*clsArena Overview
+================================================================================
+                                   clsArena.h
+================================================================================
+Overview:
+---------
+This file defines the clsArena class, a bump ("monotonic") allocator used for
+short-lived bulk data: transaction report queries and batch jobs.
+
+Loading a large report as vector<record-with-six-std::string> costs one heap
+allocation per field per record, and as many frees when the report is closed.
+An arena instead hands out memory from big chunks by moving a pointer forward:
+
+    chunk 1: [rec][line text][rec][line text]....[free]
+    chunk 2: [vector storage ........................][free]
+
+Nothing is freed individually. When the arena is destroyed (or Release() is
+called) every chunk goes back to the heap at once.
+
+================================================================================
+Integration:
+------------
+clsArena derives from std::pmr::memory_resource, so standard pmr containers
+can live inside it:
+
+    clsArena Arena;
+    pmr::vector<stRecord> vRecords(&Arena);
+
+Strings are copied in with CopyString(), which returns a string_view that stays
+valid for the life of the arena (the copy is NUL terminated, so numeric fields
+can be parsed in place with strtod / strtol).
+
+================================================================================
+Rules:
+------
+- Only trivially destructible objects may be created with New<T>():
+  destructors are never run.
+- Everything allocated from an arena dies with it; do not keep views or
+  pointers longer than the arena.
+- An arena is not thread-safe; use one per query / per job.
+
+================================================================================
+Public Methods:
+---------------
+    clsArena(size_t FirstChunkSize = 64 KB)
+    string_view CopyString(string_view Text)
+    T* New<T>(Args...)
+    void Release()
+    size_t BytesUsed() const
+    size_t BytesReserved() const
+    size_t ChunkCount() const
+
+================================================================================
+*/
+
+#pragma once
+
+#include <cstddef>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+#include <string_view>
+#include <vector>
+#include <memory_resource>
+#include <type_traits>
+
+using namespace std;
+
+class clsArena : public pmr::memory_resource
+{
+private:
+    static const size_t _MaxChunkSize = 16 * 1024 * 1024;
+
+    vector<char *> _Chunks;
+    char *_Current = nullptr;
+    size_t _Remaining = 0;
+    size_t _NextChunkSize;
+    size_t _BytesUsed = 0;
+    size_t _BytesReserved = 0;
+
+    void _AddChunk(size_t MinBytes)
+    {
+        // chunks grow geometrically so a million-record query needs only a few
+        size_t Size = _NextChunkSize;
+        while (Size < MinBytes)
+            Size *= 2;
+
+        char *Chunk = (char *)malloc(Size);
+        if (Chunk == nullptr)
+            throw bad_alloc();
+
+        _Chunks.push_back(Chunk);
+        _Current = Chunk;
+        _Remaining = Size;
+        _BytesReserved += Size;
+
+        if (_NextChunkSize < _MaxChunkSize)
+            _NextChunkSize *= 2;
+    }
+
+protected:
+    void *do_allocate(size_t Bytes, size_t Alignment) override
+    {
+        size_t Padding = (Alignment - ((size_t)_Current & (Alignment - 1))) & (Alignment - 1);
+
+        if (_Current == nullptr || Padding + Bytes > _Remaining)
+        {
+            _AddChunk(Bytes + Alignment);
+            Padding = (Alignment - ((size_t)_Current & (Alignment - 1))) & (Alignment - 1);
+        }
+
+        char *Result = _Current + Padding;
+        _Current += Padding + Bytes;
+        _Remaining -= Padding + Bytes;
+        _BytesUsed += Bytes;
+        return Result;
+    }
+
+    void do_deallocate(void *, size_t, size_t) override
+    {
+        // monotonic: memory comes back only when the whole arena is released
+    }
+
+    bool do_is_equal(const pmr::memory_resource &Other) const noexcept override
+    {
+        return this == &Other;
+    }
+
+public:
+    explicit clsArena(size_t FirstChunkSize = 64 * 1024) : _NextChunkSize(FirstChunkSize < 256 ? 256 : FirstChunkSize) {}
+
+    clsArena(const clsArena &) = delete;
+    clsArena &operator=(const clsArena &) = delete;
+
+    ~clsArena()
+    {
+        Release();
+    }
+
+    string_view CopyString(string_view Text)
+    {
+        char *Copy = (char *)allocate(Text.size() + 1, 1);
+        if (!Text.empty())
+            memcpy(Copy, Text.data(), Text.size());
+        Copy[Text.size()] = '\0';
+        return string_view(Copy, Text.size());
+    }
+
+    template <typename T, typename... Args>
+    T *New(Args &&...Arguments)
+    {
+        static_assert(is_trivially_destructible<T>::value, "arena objects are never destroyed");
+        return new (allocate(sizeof(T), alignof(T))) T(std::forward<Args>(Arguments)...);
+    }
+
+    void Release()
+    {
+        // one pass over the chunk list frees everything that was allocated
+        for (char *Chunk : _Chunks)
+            free(Chunk);
+
+        _Chunks.clear();
+        _Current = nullptr;
+        _Remaining = 0;
+        _BytesUsed = 0;
+        _BytesReserved = 0;
+    }
+
+    size_t BytesUsed() const { return _BytesUsed; }
+    size_t BytesReserved() const { return _BytesReserved; }
+    size_t ChunkCount() const { return _Chunks.size(); }
+};
@@ -0,0 +1,210 @@
+/*clsBenchmark Overview
+================================================================================
+                                clsBenchmark.h
+================================================================================
+Overview:
+---------
+This file defines the clsBenchmark class, a small timing harness used by
+"src/SmartBank Benchmark.cpp" to measure the core banking operations.
+
+Every iteration of an operation is timed on its own with steady_clock, so the
+result carries the latency distribution and not only an average:
+
+    iterations, total time, throughput (ops/s), p50, p99 and max latency
+
+================================================================================
+How A Benchmark Runs:
+---------------------
+1. Warm-up: WarmupIterations calls that are not recorded (file cache, first
+   allocations, symbol table).
+2. Measure: keep calling the operation until TimeBudgetMs has passed AND at
+   least MinIterations were recorded, or MaxIterations is reached.
+   Slow operations (a Save() that rewrites a 1M-row file) therefore stop after
+   MinIterations, fast ones (Split) collect up to MaxIterations samples.
+3. Sort the samples once and read p50 / p99 / max from them.
+
+================================================================================
+Output:
+-------
+ToJson() formats one result as a single JSON line, for example
+
+    {"suite":"micro","benchmark":"clsBankClient::Find","accounts":1000,
+     "iterations":5000,"total_ms":812.4,"ops_per_sec":6154.6,
+     "p50_us":158.2,"p99_us":231.7,"max_us":402.9}
+
+so a run can be appended to a file and compared with jq / a spreadsheet.
+
+================================================================================
+Public Methods:
+---------------
+    static stBenchmarkResult Run(Suite, Name, Accounts, Operation, Options)
+    static string ToJson(const stBenchmarkResult &Result)
+    static void KeepValue(const T &Value)
+
+================================================================================
+Usage Example:
+--------------
+    clsBenchmark::stOptions Options;
+    Options.TimeBudgetMs = 500;
+
+    auto Result = clsBenchmark::Run("micro", "clsString::Split", 0, [&]()
+    {
+        clsBenchmark::KeepValue(clsString::Split(Line, " || "));
+    }, Options);
+
+    cout << clsBenchmark::ToJson(Result) << endl;
+
+================================================================================
+*/
+
+#pragma once
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include <chrono>
+#include <algorithm>
+#include <functional>
+#include <cstdio>
+
+using namespace std;
+
+class clsBenchmark
+{
+public:
+    struct stOptions
+    {
+        size_t WarmupIterations = 3;
+        size_t MinIterations = 5;
+        size_t MaxIterations = 100000;
+        double TimeBudgetMs = 1000;
+    };
+
+    struct stBenchmarkResult
+    {
+        string Suite;
+        string Name;
+        size_t Accounts = 0;
+        size_t Iterations = 0;
+        double TotalMs = 0;
+        double OpsPerSecond = 0;
+        double P50Micros = 0;
+        double P99Micros = 0;
+        double MaxMicros = 0;
+    };
+
+private:
+    static double _Percentile(const vector<double> &vSortedSamples, double Percent)
+    {
+        if (vSortedSamples.empty())
+            return 0;
+
+        // nearest-rank percentile
+        size_t Rank = (size_t)((Percent / 100.0) * (double)vSortedSamples.size() + 0.5);
+        if (Rank == 0)
+            Rank = 1;
+        if (Rank > vSortedSamples.size())
+            Rank = vSortedSamples.size();
+
+        return vSortedSamples[Rank - 1];
+    }
+
+    static string _Number(double Value)
+    {
+        char Buffer[32];
+        snprintf(Buffer, sizeof(Buffer), "%.3f", Value);
+        return Buffer;
+    }
+
+    static string _Escape(const string &Text)
+    {
+        string Result;
+        Result.reserve(Text.size());
+        for (char C : Text)
+        {
+            if (C == '"' || C == '\\')
+                Result += '\\';
+            Result += C;
+        }
+        return Result;
+    }
+
+public:
+    template <typename T>
+    static void KeepValue(const T &Value)
+    {
+        // stops the optimizer from dropping a call whose result is unused:
+        // the compiler must assume the empty asm reads Value through memory
+#if defined(__GNUC__) || defined(__clang__)
+        asm volatile("" : : "g"(&Value) : "memory");
+#else
+        const volatile char *Bytes = reinterpret_cast<const volatile char *>(&Value);
+        char First = Bytes[0];
+        (void)First;
+#endif
+    }
+
+    static stBenchmarkResult Run(const string &Suite, const string &Name, size_t Accounts,
+                                 const function<void()> &Operation, const stOptions &Options)
+    {
+        // Run process steps:
+        // 1. Call the operation WarmupIterations times without recording.
+        // 2. Time each following call until the budget and the minimum count
+        //    are both reached (or MaxIterations).
+        // 3. Sort the samples and fill throughput / p50 / p99 / max.
+        using Clock = chrono::steady_clock;
+
+        for (size_t i = 0; i < Options.WarmupIterations; i++)
+            Operation();
+
+        vector<double> vSamples;
+        vSamples.reserve(min<size_t>(Options.MaxIterations, 1 << 16));
+
+        Clock::time_point Start = Clock::now();
+        double ElapsedMs = 0;
+
+        while (vSamples.size() < Options.MaxIterations &&
+               (vSamples.size() < Options.MinIterations || ElapsedMs < Options.TimeBudgetMs))
+        {
+            Clock::time_point Before = Clock::now();
+            Operation();
+            Clock::time_point After = Clock::now();
+
+            vSamples.push_back(chrono::duration<double, micro>(After - Before).count());
+            ElapsedMs = chrono::duration<double, milli>(After - Start).count();
+        }
+
+        sort(vSamples.begin(), vSamples.end());
+
+        stBenchmarkResult Result;
+        Result.Suite = Suite;
+        Result.Name = Name;
+        Result.Accounts = Accounts;
+        Result.Iterations = vSamples.size();
+
+        double TotalMicros = 0;
+        for (double Sample : vSamples)
+            TotalMicros += Sample;
+
+        Result.TotalMs = TotalMicros / 1000.0;
+        Result.OpsPerSecond = (TotalMicros > 0) ? (double)vSamples.size() * 1000000.0 / TotalMicros : 0;
+        Result.P50Micros = _Percentile(vSamples, 50);
+        Result.P99Micros = _Percentile(vSamples, 99);
+        Result.MaxMicros = vSamples.empty() ? 0 : vSamples.back();
+
+        return Result;
+    }
+
+    static string ToJson(const stBenchmarkResult &Result)
+    {
+        return "{\"suite\":\"" + _Escape(Result.Suite) + "\"" +
+               ",\"benchmark\":\"" + _Escape(Result.Name) + "\"" +
+               ",\"accounts\":" + to_string(Result.Accounts) +
+               ",\"iterations\":" + to_string(Result.Iterations) +
+               ",\"total_ms\":" + _Number(Result.TotalMs) +
+               ",\"ops_per_sec\":" + _Number(Result.OpsPerSecond) +
+               ",\"p50_us\":" + _Number(Result.P50Micros) +
+               ",\"p99_us\":" + _Number(Result.P99Micros) +
+               ",\"max_us\":" + _Number(Result.MaxMicros) + "}";
+    }
+};
@@ -0,0 +1,252 @@
+/*clsCompressor Overview
+================================================================================
+                                 clsCompressor.h
+================================================================================
+Overview:
+---------
+This file defines the clsCompressor class — a small, dependency-free utility
+used to pack closed log segments on disk and to verify them when they are read
+back.
+
+It provides:
+1. A fast LZ77 byte compressor (LZ4-style block format, 64 KB window).
+2. The matching decompressor with full bounds checking.
+3. A standard CRC-32 checksum (IEEE polynomial, same as zip/png).
+
+================================================================================
+Block Format:
+-------------
+    [RawSize : 4 bytes little endian]
+    Sequence*  where every sequence is:
+        Token        : 1 byte  (high nibble = literal length, low nibble = match length - 4)
+        LiteralsExt  : 0..n bytes (only when literal length nibble == 15)
+        Literals     : literal length bytes
+        Offset       : 2 bytes little endian   (missing in the last sequence)
+        MatchExt     : 0..n bytes (only when match length nibble == 15)
+
+Text logs such as AllTransactions.txt compress to roughly 20-30% of their size
+because dates, separators and operation names repeat on every line.
+
+================================================================================
+Public Methods:
+---------------
+    static string Compress(const string& Input)
+    static bool Decompress(const string& Input, string& Output)
+    static unsigned int Crc32(string_view Data)
+
+================================================================================
+Usage Example:
+--------------
+    string Packed = clsCompressor::Compress(Text);
+    string Restored;
+    if (clsCompressor::Decompress(Packed, Restored) &&
+        clsCompressor::Crc32(Restored) == clsCompressor::Crc32(Text))
+    {
+        // segment is intact
+    }
+
+================================================================================
+*/
+
+#pragma once
+
+#include <string>
+#include <string_view>
+#include <vector>
+#include <cstring>
+#include <cstdint>
+
+using namespace std;
+
+class clsCompressor
+{
+private:
+    static const int _MinMatch = 4;
+    static const int _HashBits = 14;
+    static const size_t _MaxOffset = 65535;
+
+    static void _WriteU32(string &Out, uint32_t Value)
+    {
+        for (int i = 0; i < 4; i++)
+            Out.push_back(char((Value >> (8 * i)) & 0xFF));
+    }
+
+    static void _WriteLength(string &Out, size_t Length)
+    {
+        // lengths >= 15 continue in extra bytes: 255, 255, ..., remainder
+        while (Length >= 255)
+        {
+            Out.push_back(char(255));
+            Length -= 255;
+        }
+        Out.push_back(char(Length));
+    }
+
+    static void _EmitSequence(string &Out, const unsigned char *Literals, size_t LiteralLength,
+                              size_t Offset, size_t MatchLength, bool HasMatch)
+    {
+        size_t MatchCode = HasMatch ? MatchLength - _MinMatch : 0;
+
+        unsigned char Token = (unsigned char)((LiteralLength >= 15 ? 15 : LiteralLength) << 4);
+        Token |= (unsigned char)(MatchCode >= 15 ? 15 : MatchCode);
+        Out.push_back(char(Token));
+
+        if (LiteralLength >= 15)
+            _WriteLength(Out, LiteralLength - 15);
+
+        Out.append((const char *)Literals, LiteralLength);
+
+        if (!HasMatch)
+            return;
+
+        Out.push_back(char(Offset & 0xFF));
+        Out.push_back(char((Offset >> 8) & 0xFF));
+
+        if (MatchCode >= 15)
+            _WriteLength(Out, MatchCode - 15);
+    }
+
+    static bool _ReadLength(const unsigned char *&Ip, const unsigned char *End, size_t &Length)
+    {
+        unsigned char Byte;
+        do
+        {
+            if (Ip >= End)
+                return false;
+            Byte = *Ip++;
+            Length += Byte;
+        } while (Byte == 255);
+        return true;
+    }
+
+public:
+    static string Compress(const string &Input)
+    {
+        // Compress process steps:
+        // 1. Write the raw size so the decoder can reserve the output once.
+        // 2. Hash every 4-byte sequence and remember its last position.
+        // 3. When the current 4 bytes were seen within the last 64 KB, extend the
+        //    match as far as possible and emit (pending literals + match).
+        // 4. Whatever is left at the end is emitted as a literals-only sequence.
+        string Out;
+        Out.reserve(Input.size() / 2 + 16);
+        _WriteU32(Out, (uint32_t)Input.size());
+
+        const unsigned char *Src = (const unsigned char *)Input.data();
+        const size_t Size = Input.size();
+
+        vector<int64_t> HashTable(size_t(1) << _HashBits, -1);
+
+        size_t Anchor = 0;
+        size_t i = 0;
+
+        while (i + _MinMatch <= Size)
+        {
+            uint32_t Sequence;
+            memcpy(&Sequence, Src + i, 4);
+            uint32_t Hash = (Sequence * 2654435761u) >> (32 - _HashBits);
+
+            int64_t Candidate = HashTable[Hash];
+            HashTable[Hash] = (int64_t)i;
+
+            if (Candidate >= 0 && i - (size_t)Candidate <= _MaxOffset &&
+                memcmp(Src + Candidate, Src + i, _MinMatch) == 0)
+            {
+                size_t MatchLength = _MinMatch;
+                while (i + MatchLength < Size && Src[Candidate + MatchLength] == Src[i + MatchLength])
+                    MatchLength++;
+
+                _EmitSequence(Out, Src + Anchor, i - Anchor, i - (size_t)Candidate, MatchLength, true);
+
+                i += MatchLength;
+                Anchor = i;
+            }
+            else
+            {
+                i++;
+            }
+        }
+
+        _EmitSequence(Out, Src + Anchor, Size - Anchor, 0, 0, false);
+        return Out;
+    }
+
+    static bool Decompress(const string &Input, string &Output)
+    {
+        // Returns false when the block is truncated or references data
+        // outside of what was already decoded (corrupted segment).
+        Output.clear();
+        if (Input.size() < 4)
+            return false;
+
+        const unsigned char *Ip = (const unsigned char *)Input.data();
+        const unsigned char *End = Ip + Input.size();
+
+        uint32_t RawSize = 0;
+        for (int i = 0; i < 4; i++)
+            RawSize |= uint32_t(Ip[i]) << (8 * i);
+        Ip += 4;
+
+        Output.reserve(RawSize);
+
+        while (Ip < End)
+        {
+            unsigned char Token = *Ip++;
+
+            size_t LiteralLength = Token >> 4;
+            if (LiteralLength == 15 && !_ReadLength(Ip, End, LiteralLength))
+                return false;
+
+            if ((size_t)(End - Ip) < LiteralLength)
+                return false;
+            Output.append((const char *)Ip, LiteralLength);
+            Ip += LiteralLength;
+
+            if (Ip >= End)
+                break; // last sequence carries literals only
+
+            if (End - Ip < 2)
+                return false;
+            size_t Offset = size_t(Ip[0]) | (size_t(Ip[1]) << 8);
+            Ip += 2;
+
+            size_t MatchLength = Token & 0x0F;
+            if (MatchLength == 15 && !_ReadLength(Ip, End, MatchLength))
+                return false;
+            MatchLength += _MinMatch;
+
+            if (Offset == 0 || Offset > Output.size())
+                return false;
+
+            // copy byte by byte because the match may overlap what it produces
+            size_t From = Output.size() - Offset;
+            for (size_t k = 0; k < MatchLength; k++)
+                Output.push_back(Output[From + k]);
+        }
+
+        return Output.size() == RawSize;
+    }
+
+    static unsigned int Crc32(string_view Data)
+    {
+        // built once, thread-safe (function-local static)
+        static const vector<unsigned int> Table = []()
+        {
+            vector<unsigned int> T(256);
+            for (unsigned int n = 0; n < 256; n++)
+            {
+                unsigned int c = n;
+                for (int k = 0; k < 8; k++)
+                    c = (c & 1) ? (0xEDB88320u ^ (c >> 1)) : (c >> 1);
+                T[n] = c;
+            }
+            return T;
+        }();
+
+        unsigned int Crc = 0xFFFFFFFFu;
+        for (unsigned char Ch : Data)
+            Crc = Table[(Crc ^ Ch) & 0xFF] ^ (Crc >> 8);
+
+        return Crc ^ 0xFFFFFFFFu;
+    }
+};
@@ -75,6 +75,8 @@ Public Methods:
 
 - Day/month/year helpers:
     NumberOfDaysInAYear(), NumberOfDaysInAMonth()
+    ToDayNumber(), FromDayNumber()       (days since 1/1/1970, O(1))
+    AddMonthsOnDay()                     (X months later on a preferred day)
     DaysFromTheBeginingOfTheYear()
     GetDateFromDayOrderInYear()
 
@@ -127,6 +129,7 @@ End of Documentation
 #include <vector>
 #include <ctime>
 #include <cstdio>
+#include <algorithm>
 
 #include "clsString.h"  // utils/clsString.h
 
@@ -328,6 +331,50 @@ public:
         return NumberOfDaysInAMonth(_Month, _Year);
     }
 
+    // Day numbers (days since 1/1/1970): O(1) conversions for schedulers and
+    // differences, instead of walking day by day with AddOneDay
+    static int ToDayNumber(const clsDate &Date)
+    {
+        int Year = Date._Year - (Date._Month <= 2 ? 1 : 0);
+        int Era = (Year >= 0 ? Year : Year - 399) / 400;
+        int YearOfEra = Year - Era * 400;
+        int MonthFromMarch = (Date._Month + 9) % 12;
+        int DayOfYear = (153 * MonthFromMarch + 2) / 5 + Date._Day - 1;
+        int DayOfEra = YearOfEra * 365 + YearOfEra / 4 - YearOfEra / 100 + DayOfYear;
+        return Era * 146097 + DayOfEra - 719468;
+    }
+
+    int ToDayNumber() const
+    {
+        return ToDayNumber(*this);
+    }
+
+    static clsDate FromDayNumber(int DayNumber)
+    {
+        DayNumber += 719468;
+        int Era = (DayNumber >= 0 ? DayNumber : DayNumber - 146096) / 146097;
+        int DayOfEra = DayNumber - Era * 146097;
+        int YearOfEra = (DayOfEra - DayOfEra / 1460 + DayOfEra / 36524 - DayOfEra / 146096) / 365;
+        int DayOfYear = DayOfEra - (365 * YearOfEra + YearOfEra / 4 - YearOfEra / 100);
+        int MonthFromMarch = (5 * DayOfYear + 2) / 153;
+
+        short Day = (short)(DayOfYear - (153 * MonthFromMarch + 2) / 5 + 1);
+        short Month = (short)(MonthFromMarch < 10 ? MonthFromMarch + 3 : MonthFromMarch - 9);
+        short Year = (short)(YearOfEra + Era * 400 + (Month <= 2 ? 1 : 0));
+        return clsDate(Day, Month, Year);
+    }
+
+    static clsDate AddMonthsOnDay(const clsDate &Date, int Months, short PreferredDay)
+    {
+        // month arithmetic in one step; the day is PreferredDay, clamped to the
+        // length of the target month (31 -> 28/29 Feb -> 31 Mar, no drift)
+        int MonthIndex = Date._Year * 12 + (Date._Month - 1) + Months;
+        short Year = (short)(MonthIndex / 12);
+        short Month = (short)(MonthIndex % 12 + 1);
+        short Day = min(PreferredDay, NumberOfDaysInAMonth(Month, Year));
+        return clsDate(Day, Month, Year);
+    }
+
     static short NumberOfHoursInAMonth(short Month, short Year)
     {
         return NumberOfDaysInAMonth(Month, Year) * 24;
@@ -0,0 +1,126 @@
+/*clsDurableFile Overview
+================================================================================
+                               clsDurableFile.h
+================================================================================
+Overview:
+---------
+This file defines the clsDurableFile class, the few steps a multi-file change
+needs so that a crash (power loss, kill -9) leaves every file either old or
+new, never half written, and never reorders the steps on disk:
+
+- Sync(Path)            the file's content is on disk (fsync).
+- SyncDirectory(Path)   the directory entry of Path is on disk, so a rename
+                        or a new file survives a crash (fsync on the folder).
+- WriteAtomically(Path, Content)
+                        "<Path>.tmp" is written and synced, then renamed over
+                        Path, then the folder is synced: readers and a crash
+                        see the old or the new content, nothing in between.
+
+Windows flushes with FlushFileBuffers; directory entries are committed by
+NTFS itself, so SyncDirectory() does nothing there.
+
+================================================================================
+Public Methods:
+---------------
+    static bool Sync(const string &Path)
+    static bool SyncDirectory(const string &Path)
+    static bool WriteAtomically(const string &Path, const string &Content)
+
+================================================================================
+Usage Example:
+--------------
+    clsDurableFile::WriteAtomically("../data/AllTransactions.manifest", Manifest);
+
+================================================================================
+*/
+
+#pragma once
+
+#include <string>
+#include <fstream>
+#include <filesystem>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+using namespace std;
+
+class clsDurableFile
+{
+private:
+    static string _DirectoryOf(const string &Path)
+    {
+        size_t Slash = Path.find_last_of("/\\");
+        return (Slash == string::npos) ? "." : Path.substr(0, Slash + 1);
+    }
+
+public:
+    static bool Sync(const string &Path)
+    {
+#ifdef _WIN32
+        HANDLE Handle = CreateFileA(Path.c_str(), GENERIC_WRITE, FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE,
+                                    nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+        if (Handle == INVALID_HANDLE_VALUE)
+            return false;
+        bool Flushed = FlushFileBuffers(Handle) != 0;
+        CloseHandle(Handle);
+        return Flushed;
+#else
+        int Fd = open(Path.c_str(), O_RDONLY | O_CLOEXEC);
+        if (Fd < 0)
+            return false;
+        bool Synced = (fsync(Fd) == 0);
+        close(Fd);
+        return Synced;
+#endif
+    }
+
+    static bool SyncDirectory(const string &Path)
+    {
+#ifdef _WIN32
+        (void)Path;
+        return true;
+#else
+        int Fd = open(_DirectoryOf(Path).c_str(), O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+        if (Fd < 0)
+            return false;
+        bool Synced = (fsync(Fd) == 0);
+        close(Fd);
+        return Synced;
+#endif
+    }
+
+    static bool WriteAtomically(const string &Path, const string &Content)
+    {
+        // WriteAtomically process steps:
+        // 1. Write the content to "<Path>.tmp" and sync it.
+        // 2. Rename it over Path (atomic on one file system).
+        // 3. Sync the folder so the rename itself is durable.
+        string TempPath = Path + ".tmp";
+        {
+            ofstream MyFile(TempPath, ios::out | ios::binary | ios::trunc);
+            if (!MyFile.is_open())
+                return false;
+            MyFile.write(Content.data(), (streamsize)Content.size());
+            MyFile.close();
+            if (MyFile.fail())
+                return false;
+        }
+        if (!Sync(TempPath))
+            return false;
+
+        error_code Error;
+        filesystem::rename(TempPath, Path, Error);
+        if (Error)
+        {
+            filesystem::remove(TempPath, Error);
+            return false;
+        }
+        SyncDirectory(Path);
+        return true;
+    }
+};
@@ -0,0 +1,154 @@
+/*clsFileLock Overview
+================================================================================
+                                 clsFileLock.h
+================================================================================
+Overview:
+---------
+This file defines the clsFileLock class, an exclusive lock held on a small
+"<name>.lock" file next to a data file, so that several processes working on
+the same data root (two ATMs, a batch run, the daemon) take turns on writes
+that span more than one system call (log rotation, compaction).
+
+- The lock file is created on first use and never removed.
+- The lock belongs to the object: it is released by the destructor, and by
+  the operating system when the process dies, so a crash never leaves a data
+  root locked.
+- It only orders processes. Threads of one process must still take their own
+  mutex first: two clsFileLock objects of one process on one file wait for
+  each other.
+- The lock file also holds a generation counter (8 bytes). A writer whose
+  change others must notice (a tombstone, a rewrite) bumps it while locked;
+  a process that worked without the lock compares it before committing.
+
+POSIX uses flock(LOCK_EX), Windows LockFileEx(LOCKFILE_EXCLUSIVE_LOCK).
+When the lock file cannot be created (read-only folder) the object is not
+locked and IsLocked() says so; callers keep working with in-process locking
+only.
+
+================================================================================
+Public Methods:
+---------------
+    explicit clsFileLock(const string &LockPath)   blocks until locked
+    bool IsLocked() const
+    unsigned long long GetGeneration() const        0 for a new lock file
+    unsigned long long BumpGeneration()             returns the new value
+
+================================================================================
+Usage Example:
+--------------
+    lock_guard<mutex> Lock(_Mutex());               // threads of this process
+    clsFileLock FileLock("../data/AllTransactions.lock"); // other processes
+    ...
+
+================================================================================
+*/
+
+#pragma once
+
+#include <string>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <sys/file.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <cerrno>
+#endif
+
+using namespace std;
+
+class clsFileLock
+{
+private:
+#ifdef _WIN32
+    HANDLE _Handle = INVALID_HANDLE_VALUE;
+#else
+    int _Fd = -1;
+#endif
+    bool _Locked = false;
+
+public:
+    explicit clsFileLock(const string &LockPath)
+    {
+#ifdef _WIN32
+        _Handle = CreateFileA(LockPath.c_str(), GENERIC_READ | GENERIC_WRITE,
+                              FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE, nullptr,
+                              OPEN_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr);
+        if (_Handle == INVALID_HANDLE_VALUE)
+            return;
+
+        OVERLAPPED Region = {};
+        _Locked = LockFileEx(_Handle, LOCKFILE_EXCLUSIVE_LOCK, 0, 1, 0, &Region) != 0;
+#else
+        _Fd = open(LockPath.c_str(), O_RDWR | O_CREAT | O_CLOEXEC, 0644);
+        if (_Fd < 0)
+            return;
+
+        int Result;
+        do
+            Result = flock(_Fd, LOCK_EX);
+        while (Result != 0 && errno == EINTR);
+        _Locked = (Result == 0);
+#endif
+    }
+
+    clsFileLock(const clsFileLock &) = delete;
+    clsFileLock &operator=(const clsFileLock &) = delete;
+
+    ~clsFileLock()
+    {
+#ifdef _WIN32
+        if (_Handle != INVALID_HANDLE_VALUE)
+        {
+            if (_Locked)
+            {
+                OVERLAPPED Region = {};
+                UnlockFileEx(_Handle, 0, 1, 0, &Region);
+            }
+            CloseHandle(_Handle);
+        }
+#else
+        if (_Fd >= 0)
+            close(_Fd); // releases the flock
+#endif
+    }
+
+    bool IsLocked() const
+    {
+        return _Locked;
+    }
+
+    unsigned long long GetGeneration() const
+    {
+        unsigned long long Generation = 0;
+        if (!_Locked)
+            return 0;
+#ifdef _WIN32
+        OVERLAPPED At = {};
+        DWORD Read = 0;
+        if (!ReadFile(_Handle, &Generation, sizeof(Generation), &Read, &At) || Read != sizeof(Generation))
+            return 0;
+#else
+        if (pread(_Fd, &Generation, sizeof(Generation), 0) != (ssize_t)sizeof(Generation))
+            return 0;
+#endif
+        return Generation;
+    }
+
+    unsigned long long BumpGeneration()
+    {
+        unsigned long long Generation = GetGeneration() + 1;
+        if (!_Locked)
+            return Generation;
+#ifdef _WIN32
+        OVERLAPPED At = {};
+        DWORD Written = 0;
+        WriteFile(_Handle, &Generation, sizeof(Generation), &Written, &At);
+#else
+        ssize_t Written = pwrite(_Fd, &Generation, sizeof(Generation), 0);
+        (void)Written;
+#endif
+        return Generation;
+    }
+};
@@ -0,0 +1,166 @@
+/*clsFixedString Overview
+================================================================================
+                                clsFixedString.h
+================================================================================
+Overview:
+---------
+This file defines clsFixedString<Capacity>, a small fixed-capacity string
+used for short identifiers: account numbers, PIN codes and admin usernames.
+
+std::string costs a heap pointer, a size, a capacity and (for long values) an
+allocation, and it is copied on every Find(), getter and comparison.
+clsFixedString keeps the characters inline:
+
+    [ Length : 1 byte ][ Data : Capacity bytes, zero padded ]
+
+so it is trivially copyable (a copy is a memcpy of 8/16/32 bytes), compares
+with a few integer compares (the whole object is compared at once, the zero
+padding makes equal strings bit-identical) and hashes at compile time when the
+value is a constant.
+
+================================================================================
+Invalid Keys:
+-------------
+A value longer than Capacity is NOT truncated (two different long account
+numbers must never become the same key). The object is marked invalid instead:
+IsValid() returns false, it equals no valid key and the stores simply do not
+find it. Screens limit input to MaxLength so users never produce one. View()
+of an invalid key is empty: code that writes a record back must keep the
+stored text instead (clsBankClient, clsAdmin).
+
+================================================================================
+Aliases:
+--------
+    clsAccountNumber  = clsFixedString<15>   (16 bytes)
+    clsPinCode        = clsFixedString<15>   (16 bytes)
+    clsAdminUsername  = clsFixedString<31>   (32 bytes)
+
+================================================================================
+Public Methods:
+---------------
+    clsFixedString(), clsFixedString(string_view), clsFixedString(const char*)
+    bool IsValid() const, bool IsEmpty() const
+    size_t Length() const
+    string_view View() const, string ToString() const
+    constexpr size_t Hash() const
+    ==, != (with another key, a string_view, a string or a literal), <
+    MaxLength (static)
+
+std::hash is specialized, so the type can be used directly as an
+unordered_map / unordered_set key.
+
+================================================================================
+Usage Example:
+--------------
+    clsAccountNumber Key("A101");
+    if (Key == clsString::GetFieldView(Line, " || ", 4))
+        ...
+    unordered_map<clsAccountNumber, unsigned int> IndexByAccount;
+
+================================================================================
+*/
+
+#pragma once
+
+#include <string>
+#include <string_view>
+#include <cstring>
+#include <ostream>
+#include <functional>
+#include <type_traits>
+
+using namespace std;
+
+template <size_t Capacity>
+class clsFixedString
+{
+    static_assert(Capacity > 0 && Capacity < 255, "clsFixedString capacity must fit in one length byte");
+
+private:
+    static const unsigned char _InvalidLength = 255;
+
+    unsigned char _Length;
+    char _Data[Capacity];
+
+public:
+    static const size_t MaxLength = Capacity;
+
+    constexpr clsFixedString() : _Length(0), _Data{} {}
+
+    // explicit: building a key is a deliberate step, and comparisons with
+    // strings / literals then resolve to the string_view overloads below
+    constexpr explicit clsFixedString(string_view Value) : _Length(0), _Data{}
+    {
+        if (Value.size() > Capacity)
+        {
+            _Length = _InvalidLength;
+            return;
+        }
+
+        for (size_t i = 0; i < Value.size(); i++)
+            _Data[i] = Value[i];
+        _Length = (unsigned char)Value.size();
+    }
+
+    constexpr explicit clsFixedString(const char *Value) : clsFixedString(string_view(Value)) {}
+    explicit clsFixedString(const string &Value) : clsFixedString(string_view(Value)) {}
+
+    constexpr bool IsValid() const { return _Length != _InvalidLength; }
+    constexpr bool IsEmpty() const { return _Length == 0; }
+    constexpr size_t Length() const { return IsValid() ? _Length : 0; }
+
+    constexpr string_view View() const { return string_view(_Data, Length()); }
+    string ToString() const { return string(View()); }
+    operator string() const { return ToString(); }
+
+    constexpr size_t Hash() const
+    {
+        // FNV-1a over the length byte and the characters
+        unsigned long long Hash = 1469598103934665603ull;
+        Hash = (Hash ^ _Length) * 1099511628211ull;
+        for (size_t i = 0; i < Length(); i++)
+            Hash = (Hash ^ (unsigned char)_Data[i]) * 1099511628211ull;
+        return (size_t)Hash;
+    }
+
+    bool operator==(const clsFixedString &Other) const
+    {
+        // invalid keys never match anything, not even each other
+        return IsValid() && memcmp(this, &Other, sizeof(clsFixedString)) == 0;
+    }
+    bool operator!=(const clsFixedString &Other) const { return !(*this == Other); }
+
+    bool operator==(string_view Other) const
+    {
+        return IsValid() && Other.size() == _Length && memcmp(_Data, Other.data(), _Length) == 0;
+    }
+    bool operator!=(string_view Other) const { return !(*this == Other); }
+
+    bool operator<(const clsFixedString &Other) const { return View() < Other.View(); }
+};
+
+template <size_t Capacity>
+inline bool operator==(string_view Left, const clsFixedString<Capacity> &Right) { return Right == Left; }
+
+template <size_t Capacity>
+inline bool operator!=(string_view Left, const clsFixedString<Capacity> &Right) { return Right != Left; }
+
+template <size_t Capacity>
+inline ostream &operator<<(ostream &Out, const clsFixedString<Capacity> &Value) { return Out << Value.View(); }
+
+namespace std
+{
+    template <size_t Capacity>
+    struct hash<clsFixedString<Capacity>>
+    {
+        size_t operator()(const clsFixedString<Capacity> &Value) const { return Value.Hash(); }
+    };
+}
+
+using clsAccountNumber = clsFixedString<15>;
+using clsPinCode = clsFixedString<15>;
+using clsAdminUsername = clsFixedString<31>;
+
+static_assert(is_trivially_copyable<clsAccountNumber>::value, "keys must be trivially copyable");
+static_assert(sizeof(clsAccountNumber) == 16, "account number key must stay 16 bytes");
+static_assert(sizeof(clsAdminUsername) == 32, "admin username key must stay 32 bytes");
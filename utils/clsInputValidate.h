@@ -64,7 +64,9 @@ Usage Examples:
 ================================================================================
 Notes:
 ------
-- The class uses regex to validate Emails and phone numbers.
+- The class uses regex to validate Emails and phone numbers. Each pattern is
+  compiled once, so IsValidEmail / IsValidPhone can validate large batches
+  (and be called from several threads, see clsClientImporter).
 - All Read* methods loop until a valid input is received.
 - Automatically trims spaces from input when necessary.
 - Prevents buffer overflow by limiting string input length.
@@ -79,6 +81,7 @@ End of Documentation
 #include <iostream>
 #include <string>
 #include <limits>
+#include <climits>
 #include <cfloat>
 #include <algorithm>
 #include <sstream>
@@ -321,7 +324,8 @@ public:
 
 	static bool IsValidEmail(const string &Email)
 	{
-		const regex pattern(R"(^[A-Za-z0-9._%+-]+@([A-Za-z0-9-]+\.)+[A-Za-z]{2,}$)");
+		// compiled once; matching against a const regex is safe from many threads
+		static const regex pattern(R"(^[A-Za-z0-9._%+-]+@([A-Za-z0-9-]+\.)+[A-Za-z]{2,}$)");
 		return regex_match(Email, pattern);
 	}
 
@@ -343,7 +347,7 @@ public:
 		trimmed.erase(0, trimmed.find_first_not_of(" \t\n\r"));
 		trimmed.erase(trimmed.find_last_not_of(" \t\n\r") + 1);
 
-		const regex pattern(R"(^\+?\d{10,15}$)");
+		static const regex pattern(R"(^\+?\d{10,15}$)");
 		return regex_match(trimmed, pattern);
 	}
 
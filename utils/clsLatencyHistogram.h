@@ -0,0 +1,198 @@
+/*clsLatencyHistogram Overview
+================================================================================
+                             clsLatencyHistogram.h
+================================================================================
+Overview:
+---------
+This file defines the clsLatencyHistogram class, a lock-free, fixed-size
+latency histogram in the style of HdrHistogram.
+
+Values (nanoseconds) are counted in log-linear buckets: every power of two is
+split into 16 equal sub-buckets, so any recorded value is reported with at
+most ~6% error, from 1 ns up to minutes, in 1024 counters (8 KB):
+
+    value            bucket width
+    0 .. 31 ns       1 ns
+    32 .. 63 ns      2 ns
+    64 .. 127 ns     4 ns
+    ...              (width doubles with every power of two)
+
+================================================================================
+Thread Safety:
+--------------
+Record() is a handful of relaxed atomic increments: no lock, no allocation,
+safe from any number of threads (ATM sessions, batch jobs, compactor).
+GetSnapshot() copies the counters without stopping writers; a snapshot taken
+while operations are running may miss the very last ones, never more.
+
+================================================================================
+Public Methods:
+---------------
+    void Record(unsigned long long Nanoseconds)
+    stSnapshot GetSnapshot() const
+    void Reset()
+
+stSnapshot:
+    Count, SumNanos, MaxNanos
+    double Percentile(double Percent) const     (nanoseconds)
+    double Mean() const                         (nanoseconds)
+
+================================================================================
+Usage Example:
+--------------
+    clsLatencyHistogram Histogram;
+    Histogram.Record(1500);
+
+    clsLatencyHistogram::stSnapshot Snapshot = Histogram.GetSnapshot();
+    cout << Snapshot.Percentile(99) / 1000.0 << " us";
+
+================================================================================
+*/
+
+#pragma once
+
+#include <atomic>
+#include <vector>
+
+using namespace std;
+
+class clsLatencyHistogram
+{
+public:
+    static const unsigned int SubBucketBits = 5; // 32 linear buckets, then 16 per power of two
+    static const unsigned int BucketCount = 1024;
+
+    struct stSnapshot
+    {
+        unsigned long long Count = 0;
+        unsigned long long SumNanos = 0;
+        unsigned long long MaxNanos = 0;
+        vector<unsigned long long> vBuckets;
+
+        double Mean() const
+        {
+            return (Count == 0) ? 0 : (double)SumNanos / (double)Count;
+        }
+
+        double Percentile(double Percent) const
+        {
+            // midpoint of the bucket holding the nearest-rank sample,
+            // capped by the real maximum
+            if (Count == 0)
+                return 0;
+
+            unsigned long long Rank = (unsigned long long)((Percent / 100.0) * (double)Count + 0.5);
+            if (Rank == 0)
+                Rank = 1;
+
+            unsigned long long Seen = 0;
+            for (unsigned int i = 0; i < vBuckets.size(); i++)
+            {
+                Seen += vBuckets[i];
+                if (Seen >= Rank)
+                {
+                    double Middle = (double)BucketLowerBound(i) + (double)BucketWidth(i) / 2.0;
+                    return (Middle > (double)MaxNanos) ? (double)MaxNanos : Middle;
+                }
+            }
+            return (double)MaxNanos;
+        }
+    };
+
+private:
+    atomic<unsigned long long> _Buckets[BucketCount];
+    atomic<unsigned long long> _Count{0};
+    atomic<unsigned long long> _SumNanos{0};
+    atomic<unsigned long long> _MaxNanos{0};
+
+    static unsigned int _HighestBit(unsigned long long Value)
+    {
+        unsigned int Bit = 0;
+        while (Value >>= 1)
+            Bit++;
+        return Bit;
+    }
+
+public:
+    clsLatencyHistogram()
+    {
+        for (auto &Bucket : _Buckets)
+            Bucket.store(0, memory_order_relaxed);
+    }
+
+    clsLatencyHistogram(const clsLatencyHistogram &) = delete;
+    clsLatencyHistogram &operator=(const clsLatencyHistogram &) = delete;
+
+    static unsigned int BucketIndex(unsigned long long Value)
+    {
+        const unsigned long long LinearLimit = 1ull << SubBucketBits;
+        if (Value < LinearLimit)
+            return (unsigned int)Value;
+
+        unsigned int Shift = _HighestBit(Value) - (SubBucketBits - 1);
+        unsigned int Index = (Shift << (SubBucketBits - 1)) + (unsigned int)(Value >> Shift);
+        return (Index < BucketCount) ? Index : BucketCount - 1;
+    }
+
+    static unsigned long long BucketLowerBound(unsigned int Index)
+    {
+        const unsigned int Half = 1u << (SubBucketBits - 1);
+        if (Index < 2 * Half)
+            return Index;
+
+        unsigned int Shift = Index / Half - 1;
+        return (unsigned long long)(Index - Shift * Half) << Shift;
+    }
+
+    static unsigned long long BucketWidth(unsigned int Index)
+    {
+        const unsigned int Half = 1u << (SubBucketBits - 1);
+        return (Index < 2 * Half) ? 1 : 1ull << (Index / Half - 1);
+    }
+
+    void Record(unsigned long long Nanoseconds)
+    {
+        _Buckets[BucketIndex(Nanoseconds)].fetch_add(1, memory_order_relaxed);
+        _Count.fetch_add(1, memory_order_relaxed);
+        _SumNanos.fetch_add(Nanoseconds, memory_order_relaxed);
+
+        unsigned long long Max = _MaxNanos.load(memory_order_relaxed);
+        while (Nanoseconds > Max && !_MaxNanos.compare_exchange_weak(Max, Nanoseconds, memory_order_relaxed))
+        {
+            // Max was reloaded by compare_exchange_weak, try again
+        }
+    }
+
+    stSnapshot GetSnapshot() const
+    {
+        stSnapshot Snapshot;
+        Snapshot.vBuckets.resize(BucketCount);
+
+        unsigned long long Total = 0;
+        for (unsigned int i = 0; i < BucketCount; i++)
+        {
+            Snapshot.vBuckets[i] = _Buckets[i].load(memory_order_relaxed);
+            Total += Snapshot.vBuckets[i];
+        }
+
+        // Count from the buckets themselves, so percentiles always add up
+        Snapshot.Count = Total;
+        Snapshot.SumNanos = _SumNanos.load(memory_order_relaxed);
+        Snapshot.MaxNanos = _MaxNanos.load(memory_order_relaxed);
+        return Snapshot;
+    }
+
+    unsigned long long GetCount() const
+    {
+        return _Count.load(memory_order_relaxed);
+    }
+
+    void Reset()
+    {
+        for (auto &Bucket : _Buckets)
+            Bucket.store(0, memory_order_relaxed);
+        _Count.store(0, memory_order_relaxed);
+        _SumNanos.store(0, memory_order_relaxed);
+        _MaxNanos.store(0, memory_order_relaxed);
+    }
+};
@@ -0,0 +1,206 @@
+/*clsMappedFile Overview
+================================================================================
+                                clsMappedFile.h
+================================================================================
+Overview:
+---------
+This file defines the clsMappedFile class, a read-mostly view of a whole file
+in memory, used to open binary images (clsSnapshot) without parsing or
+copying them.
+
+The file is mapped copy-on-write:
+
+- Pages are read from disk only when they are touched, so opening a file of
+  any size costs the same.
+- The view is writable: a changed page becomes a private copy for this
+  process and the file on disk is never modified.
+
+POSIX uses mmap(MAP_PRIVATE), Windows uses MapViewOfFile(FILE_MAP_COPY).
+Where mapping fails (empty file, special file systems) the whole file is
+read into a private buffer instead, so callers never need a second path.
+
+================================================================================
+Public Methods:
+---------------
+    bool Open(const string &Path)
+    void Close()
+    bool IsOpen() const
+    char *Data()
+    const char *Data() const
+    size_t Size() const
+
+The object is move-only; the mapping is released by the destructor.
+
+================================================================================
+Usage Example:
+--------------
+    clsMappedFile File;
+    if (File.Open("../data/Clients.snapshot"))
+    {
+        const stHeader *Header = (const stHeader *)File.Data();
+        ...
+    }
+
+================================================================================
+*/
+
+#pragma once
+
+#include <string>
+#include <vector>
+#include <fstream>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+using namespace std;
+
+class clsMappedFile
+{
+private:
+    char *_Data = nullptr;
+    size_t _Size = 0;
+    bool _Mapped = false;
+    vector<char> _Buffer; // fallback when the file cannot be mapped
+
+    bool _ReadIntoBuffer(const string &Path)
+    {
+        ifstream MyFile(Path, ios::in | ios::binary | ios::ate);
+        if (!MyFile.is_open())
+            return false;
+
+        streamoff Bytes = MyFile.tellg();
+        if (Bytes <= 0)
+            return false;
+
+        _Buffer.resize((size_t)Bytes);
+        MyFile.seekg(0);
+        if (!MyFile.read(_Buffer.data(), Bytes))
+        {
+            _Buffer.clear();
+            return false;
+        }
+
+        _Data = _Buffer.data();
+        _Size = _Buffer.size();
+        return true;
+    }
+
+    bool _Map(const string &Path)
+    {
+#ifdef _WIN32
+        HANDLE File = CreateFileA(Path.c_str(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE,
+                                  nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+        if (File == INVALID_HANDLE_VALUE)
+            return false;
+
+        LARGE_INTEGER Bytes;
+        if (!GetFileSizeEx(File, &Bytes) || Bytes.QuadPart == 0)
+        {
+            CloseHandle(File);
+            return false;
+        }
+
+        HANDLE Mapping = CreateFileMappingA(File, nullptr, PAGE_WRITECOPY, 0, 0, nullptr);
+        CloseHandle(File); // the mapping keeps the file open
+        if (Mapping == nullptr)
+            return false;
+
+        void *View = MapViewOfFile(Mapping, FILE_MAP_COPY, 0, 0, 0);
+        CloseHandle(Mapping); // the view keeps the mapping alive
+        if (View == nullptr)
+            return false;
+
+        _Data = (char *)View;
+        _Size = (size_t)Bytes.QuadPart;
+#else
+        int File = ::open(Path.c_str(), O_RDONLY);
+        if (File < 0)
+            return false;
+
+        struct stat Info;
+        if (fstat(File, &Info) != 0 || Info.st_size == 0)
+        {
+            ::close(File);
+            return false;
+        }
+
+        void *View = mmap(nullptr, (size_t)Info.st_size, PROT_READ | PROT_WRITE, MAP_PRIVATE, File, 0);
+        ::close(File); // the mapping keeps the file open
+        if (View == MAP_FAILED)
+            return false;
+
+        _Data = (char *)View;
+        _Size = (size_t)Info.st_size;
+#endif
+        _Mapped = true;
+        return true;
+    }
+
+public:
+    clsMappedFile() {}
+
+    clsMappedFile(const clsMappedFile &) = delete;
+    clsMappedFile &operator=(const clsMappedFile &) = delete;
+
+    clsMappedFile(clsMappedFile &&Other) noexcept
+    {
+        *this = move(Other);
+    }
+
+    clsMappedFile &operator=(clsMappedFile &&Other) noexcept
+    {
+        if (this == &Other)
+            return *this;
+
+        Close();
+        _Buffer = move(Other._Buffer);
+        _Mapped = Other._Mapped;
+        _Size = Other._Size;
+        _Data = _Mapped ? Other._Data : _Buffer.data();
+
+        Other._Data = nullptr;
+        Other._Size = 0;
+        Other._Mapped = false;
+        return *this;
+    }
+
+    ~clsMappedFile()
+    {
+        Close();
+    }
+
+    bool Open(const string &Path)
+    {
+        Close();
+        return _Map(Path) || _ReadIntoBuffer(Path);
+    }
+
+    void Close()
+    {
+        if (_Mapped)
+        {
+#ifdef _WIN32
+            UnmapViewOfFile(_Data);
+#else
+            munmap(_Data, _Size);
+#endif
+        }
+        _Buffer.clear();
+        _Buffer.shrink_to_fit();
+        _Data = nullptr;
+        _Size = 0;
+        _Mapped = false;
+    }
+
+    bool IsOpen() const { return _Data != nullptr; }
+    char *Data() { return _Data; }
+    const char *Data() const { return _Data; }
+    size_t Size() const { return _Size; }
+};
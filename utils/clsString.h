@@ -65,11 +65,13 @@ Public Methods:
     InvertLetterCase(char)
 
 - String operations:
-    Split(string Delim)
-    JoinString(vector<string>, string Delim)
-    JoinString(string arr[], short Length, string Delim)
+    Split(string_view Delim)
+    GetFieldView(string_view Line, string_view Delim, short FieldIndex)
+    EqualsIgnoreCase(string_view S1, string_view S2)
+    JoinString(const vector<string>&, string_view Delim)
+    JoinString(const string arr[], short Length, string_view Delim)
     ReverseWordsInString()
-    ReplaceWord(string StringToReplace, string sReplaceTo)
+    ReplaceWord(string_view StringToReplace, string_view sReplaceTo)
     RemovePunctuations()
 
 - Trim functions:
@@ -77,6 +79,16 @@ Public Methods:
     TrimRight()
     Trim()
 
+================================================================================
+Parameter Passing:
+------------------
+- Read-only helpers (counts, Split, Trim, Join, ReplaceWord, GetFieldView...)
+  take string_view, so string, literal and field-view arguments are passed
+  without a copy.
+- Case conversions take their string by value and modify it: a caller that no
+  longer needs the original can std::move it in and its buffer is reused.
+- Split walks the input once (O(n)); the words are its only allocations.
+
 ================================================================================
 Usage Example:
 --------------
@@ -96,6 +108,8 @@ End of Documentation
 #pragma once
 
 #include <iostream>
+#include <string>
+#include <string_view>
 #include <vector>
 
 using namespace std;
@@ -112,22 +126,19 @@ public:
         _Value = "";
     }
 
-    clsString(string Value)
-    {
-        _Value = Value;
-    }
+    clsString(string Value) : _Value(move(Value)) {}
 
     void SetValue(string Value)
     {
-        _Value = Value;
+        _Value = move(Value);
     }
 
-    string GetValue()
+    const string &GetValue() const
     {
         return _Value;
     }
 
-    static short Length(string S1)
+    static short Length(string_view S1)
     {
         return S1.length();
     };
@@ -137,28 +148,24 @@ public:
         return _Value.length();
     };
 
-    static short CountWords(string S1)
+    static short CountWords(string_view S1)
     {
 
-        string delim = " "; // delimiter
         short Counter = 0;
-        short pos = 0;
-        string sWord; // define a string variable
+        size_t Start = 0;
+        size_t pos;
 
-        // use find() function to get the position of the delimiters
-        while ((pos = S1.find(delim)) != std::string::npos)
+        // walk the view with find() from the last position: no copies, no erase()
+        while ((pos = S1.find(' ', Start)) != string_view::npos)
         {
-            sWord = S1.substr(0, pos); // store the word
-            if (sWord != "")
+            if (pos > Start)
             {
                 Counter++;
             }
-
-            // erase() until positon and move to next word.
-            S1.erase(0, pos + delim.length());
+            Start = pos + 1;
         }
 
-        if (S1 != "")
+        if (Start < S1.length())
         {
             Counter++; // it counts the last word of the string.
         }
@@ -176,7 +183,7 @@ public:
 
         bool isFirstLetter = true;
 
-        for (short i = 0; i < S1.length(); i++)
+        for (size_t i = 0; i < S1.length(); i++)
         {
 
             if (S1[i] != ' ' && isFirstLetter)
@@ -193,7 +200,7 @@ public:
     void UpperFirstLetterOfEachWord()
     {
         // no need to return value , this function will directly update the object value
-        _Value = UpperFirstLetterOfEachWord(_Value);
+        _Value = UpperFirstLetterOfEachWord(move(_Value));
     }
 
     static string LowerFirstLetterOfEachWord(string S1)
@@ -201,7 +208,7 @@ public:
 
         bool isFirstLetter = true;
 
-        for (short i = 0; i < S1.length(); i++)
+        for (size_t i = 0; i < S1.length(); i++)
         {
 
             if (S1[i] != ' ' && isFirstLetter)
@@ -219,12 +226,12 @@ public:
     {
 
         // no need to return value , this function will directly update the object value
-        _Value = LowerFirstLetterOfEachWord(_Value);
+        _Value = LowerFirstLetterOfEachWord(move(_Value));
     }
 
     static string UpperAllString(string S1)
     {
-        for (short i = 0; i < S1.length(); i++)
+        for (size_t i = 0; i < S1.length(); i++)
         {
             S1[i] = toupper(S1[i]);
         }
@@ -233,12 +240,12 @@ public:
 
     void UpperAllString()
     {
-        _Value = UpperAllString(_Value);
+        _Value = UpperAllString(move(_Value));
     }
 
     static string LowerAllString(string S1)
     {
-        for (short i = 0; i < S1.length(); i++)
+        for (size_t i = 0; i < S1.length(); i++)
         {
             S1[i] = tolower(S1[i]);
         }
@@ -247,7 +254,7 @@ public:
 
     void LowerAllString()
     {
-        _Value = LowerAllString(_Value);
+        _Value = LowerAllString(move(_Value));
     }
 
     static char InvertLetterCase(char char1)
@@ -257,7 +264,7 @@ public:
 
     static string InvertAllLettersCase(string S1)
     {
-        for (short i = 0; i < S1.length(); i++)
+        for (size_t i = 0; i < S1.length(); i++)
         {
             S1[i] = InvertLetterCase(S1[i]);
         }
@@ -266,7 +273,7 @@ public:
 
     void InvertAllLettersCase()
     {
-        _Value = InvertAllLettersCase(_Value);
+        _Value = InvertAllLettersCase(move(_Value));
     }
 
     enum enWhatToCount
@@ -276,7 +283,7 @@ public:
         All = 3
     };
 
-    static short CountLetters(string S1, enWhatToCount WhatToCount = enWhatToCount::All)
+    static short CountLetters(string_view S1, enWhatToCount WhatToCount = enWhatToCount::All)
     {
 
         if (WhatToCount == enWhatToCount::All)
@@ -286,7 +293,7 @@ public:
 
         short Counter = 0;
 
-        for (short i = 0; i < S1.length(); i++)
+        for (size_t i = 0; i < S1.length(); i++)
         {
 
             if (WhatToCount == enWhatToCount::CapitalLetters && isupper(S1[i]))
@@ -299,12 +306,12 @@ public:
         return Counter;
     }
 
-    static short CountCapitalLetters(string S1)
+    static short CountCapitalLetters(string_view S1)
     {
 
         short Counter = 0;
 
-        for (short i = 0; i < S1.length(); i++)
+        for (size_t i = 0; i < S1.length(); i++)
         {
 
             if (isupper(S1[i]))
@@ -319,12 +326,12 @@ public:
         return CountCapitalLetters(_Value);
     }
 
-    static short CountSmallLetters(string S1)
+    static short CountSmallLetters(string_view S1)
     {
 
         short Counter = 0;
 
-        for (short i = 0; i < S1.length(); i++)
+        for (size_t i = 0; i < S1.length(); i++)
         {
 
             if (islower(S1[i]))
@@ -339,12 +346,12 @@ public:
         return CountSmallLetters(_Value);
     }
 
-    static short CountSpecificLetter(string S1, char Letter, bool MatchCase = true)
+    static short CountSpecificLetter(string_view S1, char Letter, bool MatchCase = true)
     {
 
         short Counter = 0;
 
-        for (short i = 0; i < S1.length(); i++)
+        for (size_t i = 0; i < S1.length(); i++)
         {
 
             if (MatchCase)
@@ -374,12 +381,12 @@ public:
         return ((Ch1 == 'a') || (Ch1 == 'e') || (Ch1 == 'i') || (Ch1 == 'o') || (Ch1 == 'u'));
     }
 
-    static short CountVowels(string S1)
+    static short CountVowels(string_view S1)
     {
 
         short Counter = 0;
 
-        for (short i = 0; i < S1.length(); i++)
+        for (size_t i = 0; i < S1.length(); i++)
         {
 
             if (IsVowel(S1[i]))
@@ -394,50 +401,75 @@ public:
         return CountVowels(_Value);
     }
 
-    static vector<string> Split(string S1, string Delim)
+    static vector<string> Split(string_view S1, string_view Delim)
     {
-
+        // Single left-to-right pass: find() continues from the previous
+        // position instead of erasing the front of a copy, so the cost is O(n)
+        // and the only allocations are the words themselves.
         vector<string> vString;
 
-        short pos = 0;
-        string sWord; // define a string variable
+        size_t Start = 0;
+        size_t pos;
 
-        // use find() function to get the position of the delimiters
-        while ((pos = S1.find(Delim)) != std::string::npos)
+        while ((pos = S1.find(Delim, Start)) != string_view::npos)
         {
-            sWord = S1.substr(0, pos); // store the word
-                                       // if (sWord != "")
-                                       // {
-            vString.push_back(sWord);
-            //}
-
-            S1.erase(0, pos + Delim.length()); /* erase() until positon and move to next word. */
+            vString.emplace_back(S1.substr(Start, pos - Start)); // empty fields are kept
+            Start = pos + Delim.length();
         }
 
-        if (S1 != "")
+        if (Start < S1.length())
         {
-            vString.push_back(S1); // it adds last word of the string.
+            vString.emplace_back(S1.substr(Start)); // it adds last word of the string.
         }
 
         return vString;
     }
 
-    vector<string> Split(string Delim)
+    vector<string> Split(string_view Delim) const
     {
         return Split(_Value, Delim);
     }
 
-    static string TrimLeft(string S1)
+    static string_view GetFieldView(string_view S1, string_view Delim, short FieldIndex)
     {
+        // Returns field number FieldIndex (0-based) of a delimited line as a view
+        // into the line itself: no vector, no copies, no allocation.
+        // Used by record scans to compare the key column before building an object.
+        // Returns an empty view when the line has fewer fields.
+        size_t Start = 0;
 
-        for (short i = 0; i < S1.length(); i++)
+        for (short i = 0; i < FieldIndex; i++)
         {
-            if (S1[i] != ' ')
-            {
-                return S1.substr(i, S1.length() - i);
-            }
+            size_t pos = S1.find(Delim, Start);
+            if (pos == string_view::npos)
+                return string_view();
+            Start = pos + Delim.length();
         }
-        return "";
+
+        size_t End = S1.find(Delim, Start);
+        if (End == string_view::npos)
+            return S1.substr(Start);
+
+        return S1.substr(Start, End - Start);
+    }
+
+    static bool EqualsIgnoreCase(string_view S1, string_view S2)
+    {
+        if (S1.length() != S2.length())
+            return false;
+
+        for (size_t i = 0; i < S1.length(); i++)
+        {
+            if (toupper((unsigned char)S1[i]) != toupper((unsigned char)S2[i]))
+                return false;
+        }
+        return true;
+    }
+
+    static string TrimLeft(string_view S1)
+    {
+        size_t First = S1.find_first_not_of(' ');
+        return (First == string_view::npos) ? string() : string(S1.substr(First));
     }
 
     void TrimLeft()
@@ -445,17 +477,10 @@ public:
         _Value = TrimLeft(_Value);
     }
 
-    static string TrimRight(string S1)
+    static string TrimRight(string_view S1)
     {
-
-        for (short i = S1.length() - 1; i >= 0; i--)
-        {
-            if (S1[i] != ' ')
-            {
-                return S1.substr(0, i + 1);
-            }
-        }
-        return "";
+        size_t Last = S1.find_last_not_of(' ');
+        return (Last == string_view::npos) ? string() : string(S1.substr(0, Last + 1));
     }
 
     void TrimRight()
@@ -463,9 +488,14 @@ public:
         _Value = TrimRight(_Value);
     }
 
-    static string Trim(string S1)
+    static string Trim(string_view S1)
     {
-        return (TrimLeft(TrimRight(S1)));
+        // both ends on the view, one allocation for the result
+        size_t First = S1.find_first_not_of(' ');
+        if (First == string_view::npos)
+            return "";
+        size_t Last = S1.find_last_not_of(' ');
+        return string(S1.substr(First, Last - First + 1));
     }
 
     void Trim()
@@ -473,39 +503,37 @@ public:
         _Value = Trim(_Value);
     }
 
-    static string JoinString(vector<string> vString, string Delim)
+    static string JoinString(const vector<string> &vString, string_view Delim)
     {
-
-        string S1 = "";
-
-        for (string &s : vString)
-        {
-            S1 = S1 + s + Delim;
-        }
-
-        return S1.substr(0, S1.length() - Delim.length());
+        return JoinString(vString.data(), (short)vString.size(), Delim);
     }
 
-    static string JoinString(string arrString[], short Length, string Delim)
+    static string JoinString(const string arrString[], short Length, string_view Delim)
     {
+        // size the result once, then append in place
+        size_t Total = 0;
+        for (short i = 0; i < Length; i++)
+            Total += arrString[i].length() + Delim.length();
 
-        string S1 = "";
+        string S1;
+        S1.reserve(Total);
 
         for (short i = 0; i < Length; i++)
         {
-            S1 = S1 + arrString[i] + Delim;
+            if (i > 0)
+                S1 += Delim;
+            S1 += arrString[i];
         }
 
-        return S1.substr(0, S1.length() - Delim.length());
+        return S1;
     }
 
-    static string ReverseWordsInString(string S1)
+    static string ReverseWordsInString(string_view S1)
     {
 
-        vector<string> vString;
-        string S2 = "";
-
-        vString = Split(S1, " ");
+        vector<string> vString = Split(S1, " ");
+        string S2;
+        S2.reserve(S1.length());
 
         // declare iterator
         vector<string>::iterator iter = vString.end();
@@ -515,10 +543,12 @@ public:
 
             --iter;
 
-            S2 += *iter + " ";
+            S2 += *iter;
+            S2 += ' ';
         }
 
-        S2 = S2.substr(0, S2.length() - 1); // remove last space.
+        if (!S2.empty())
+            S2.pop_back(); // remove last space.
 
         return S2;
     }
@@ -528,7 +558,7 @@ public:
         _Value = ReverseWordsInString(_Value);
     }
 
-    static string ReplaceWord(string S1, string StringToReplace, string sRepalceTo, bool MatchCase = true)
+    static string ReplaceWord(string_view S1, string_view StringToReplace, string_view sRepalceTo, bool MatchCase = true)
     {
 
         vector<string> vString = Split(S1, " ");
@@ -545,7 +575,7 @@ public:
             }
             else
             {
-                if (LowerAllString(s) == LowerAllString(StringToReplace))
+                if (EqualsIgnoreCase(s, StringToReplace))
                 {
                     s = sRepalceTo;
                 }
@@ -555,17 +585,18 @@ public:
         return JoinString(vString, " ");
     }
 
-    string ReplaceWord(string StringToReplace, string sRepalceTo)
+    string ReplaceWord(string_view StringToReplace, string_view sRepalceTo) const
     {
         return ReplaceWord(_Value, StringToReplace, sRepalceTo);
     }
 
-    static string RemovePunctuations(string S1)
+    static string RemovePunctuations(string_view S1)
     {
 
-        string S2 = "";
+        string S2;
+        S2.reserve(S1.length());
 
-        for (short i = 0; i < S1.length(); i++)
+        for (size_t i = 0; i < S1.length(); i++)
         {
             if (!ispunct(S1[i]))
             {
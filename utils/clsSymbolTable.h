@@ -0,0 +1,126 @@
+/*clsSymbolTable Overview
+================================================================================
+                                clsSymbolTable.h
+================================================================================
+Overview:
+---------
+This file defines the clsSymbolTable class, a process-wide string interner.
+
+Values that repeat across thousands of records (account numbers, admin
+usernames, dates, times) are stored once in the table and referred to by a
+32-bit id. Two records mention the same account exactly when they hold the
+same id, so filters compare integers instead of strings, and a record keeps
+four bytes per field instead of a 32-byte std::string.
+
+================================================================================
+Ids:
+----
+- Id 0 is always the empty string.
+- Ids are dense (1, 2, 3, ...) and never reused or removed during the run.
+- Only values read from or written to the data are interned, never user
+  queries, so the table is bounded by the distinct values of the log
+  (dates, times of day, account numbers, usernames). Lookups that must not
+  add a value use TryFind().
+- Name(Id) returns a string_view that stays valid for the whole program:
+  interned strings live in a deque, which never moves its elements.
+
+================================================================================
+Thread Safety:
+--------------
+Lookups take a shared lock; only the first Intern() of a new value takes the
+exclusive lock. Readers on different threads (reports, batch jobs) do not
+block each other.
+
+================================================================================
+Public Methods:
+---------------
+    static unsigned int Intern(string_view Value)
+    static bool TryFind(string_view Value, unsigned int &Id)
+    static string_view Name(unsigned int Id)
+    static size_t Size()
+
+================================================================================
+Usage Example:
+--------------
+    unsigned int Id = clsSymbolTable::Intern("A101");
+    if (Record.ToAccountId == Id)
+        cout << clsSymbolTable::Name(Record.UserId);
+
+================================================================================
+*/
+
+#pragma once
+
+#include <string>
+#include <string_view>
+#include <deque>
+#include <unordered_map>
+#include <shared_mutex>
+#include <mutex>
+
+using namespace std;
+
+class clsSymbolTable
+{
+private:
+    struct stTable
+    {
+        shared_mutex Mutex;
+        deque<string> vNames{string()}; // id 0 = ""
+        unordered_map<string_view, unsigned int> IdsByName{{string_view(), 0}};
+    };
+
+    static stTable &_Table()
+    {
+        static stTable Table;
+        return Table;
+    }
+
+public:
+    static bool TryFind(string_view Value, unsigned int &Id)
+    {
+        stTable &Table = _Table();
+        shared_lock<shared_mutex> Lock(Table.Mutex);
+
+        auto It = Table.IdsByName.find(Value);
+        if (It == Table.IdsByName.end())
+            return false;
+
+        Id = It->second;
+        return true;
+    }
+
+    static unsigned int Intern(string_view Value)
+    {
+        unsigned int Id;
+        if (TryFind(Value, Id))
+            return Id;
+
+        stTable &Table = _Table();
+        unique_lock<shared_mutex> Lock(Table.Mutex);
+
+        // another thread may have added it between the two locks
+        auto It = Table.IdsByName.find(Value);
+        if (It != Table.IdsByName.end())
+            return It->second;
+
+        Id = (unsigned int)Table.vNames.size();
+        Table.vNames.emplace_back(Value);
+        Table.IdsByName.emplace(string_view(Table.vNames.back()), Id);
+        return Id;
+    }
+
+    static string_view Name(unsigned int Id)
+    {
+        stTable &Table = _Table();
+        shared_lock<shared_mutex> Lock(Table.Mutex);
+        return (Id < Table.vNames.size()) ? string_view(Table.vNames[Id]) : string_view();
+    }
+
+    static size_t Size()
+    {
+        stTable &Table = _Table();
+        shared_lock<shared_mutex> Lock(Table.Mutex);
+        return Table.vNames.size();
+    }
+};
@@ -0,0 +1,321 @@
+/*clsTerminal Overview
+================================================================================
+                                 clsTerminal.h
+================================================================================
+Overview:
+---------
+This file defines the clsTerminal class, the portable console layer used by
+every screen (clsScreen::_SetColor and all menus).
+
+It replaces the Windows-only calls the screens used to make:
+
+    SetConsoleTextAttribute(...)   ->  clsTerminal::SetColor(Color)
+    system("cls")                  ->  clsTerminal::ClearScreen()
+    system("pause>0")              ->  clsTerminal::PressAnyKey()
+    Sleep(Milliseconds)            ->  clsTerminal::SleepFor(Milliseconds)
+
+Colors and clearing are ANSI escape sequences written into the output, so no
+shell is spawned per screen and the same code runs on Linux terminals, over
+SSH, and on Windows 10+ consoles (virtual terminal mode is switched on at
+start-up; older consoles fall back to SetConsoleTextAttribute / cls).
+
+================================================================================
+Frame Output:
+-------------
+EnableFrameOutput() points cout at an in-memory frame buffer:
+
+- everything a screen prints (text, colors, clear) is appended to the frame;
+  endl and flush no longer write anything
+- the frame is written with ONE write() when the program waits for the user
+  (any cin read, PressAnyKey, SleepFor) or calls Present()
+
+so a full screen transition is a single system call instead of hundreds of
+small writes interleaved with console calls, and redraws no longer flicker.
+cin is tied to a stream whose only job is to present the frame, so every
+existing input helper (clsInputValidate) keeps working unchanged.
+
+Headless runs (--batch, benchmark, data generator) never enable frame output
+and write straight to cout as before.
+
+================================================================================
+Colors:
+-------
+SetColor() takes the Windows console attribute the screens already use
+(low nibble foreground, high nibble background; 1 blue, 2 green, 4 red,
+8 bright). 7, the default gray, resets to the terminal's own colors. When
+stdout is not a terminal no escape sequences are written at all.
+
+================================================================================
+Public Methods:
+---------------
+    static void EnableFrameOutput()
+    static void Present()
+    static void SetColor(int Color)
+    static string ColorCode(int Color)
+    static void ClearScreen()
+    static void PressAnyKey()
+    static void SleepFor(int Milliseconds)
+
+================================================================================
+Usage Example:
+--------------
+    clsTerminal::EnableFrameOutput();
+
+    clsTerminal::ClearScreen();
+    clsTerminal::SetColor(10);
+    cout << "Hello" << endl;
+    clsTerminal::SetColor(7);
+
+    clsTerminal::PressAnyKey();   // the whole frame is written here, once
+
+================================================================================
+*/
+
+#pragma once
+
+#include <iostream>
+#include <string>
+#include <streambuf>
+#include <thread>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+
+#ifdef _WIN32
+#include <windows.h>
+#include <conio.h>
+#ifndef ENABLE_VIRTUAL_TERMINAL_PROCESSING
+#define ENABLE_VIRTUAL_TERMINAL_PROCESSING 0x0004
+#endif
+#else
+#include <unistd.h>
+#include <termios.h>
+#include <cerrno>
+#endif
+
+using namespace std;
+
+class clsTerminal
+{
+private:
+    static void _WriteAll(const char *Data, size_t Size)
+    {
+#ifdef _WIN32
+        fwrite(Data, 1, Size, stdout);
+        fflush(stdout);
+#else
+        while (Size > 0)
+        {
+            ssize_t Written = ::write(STDOUT_FILENO, Data, Size);
+            if (Written < 0)
+            {
+                if (errno == EINTR)
+                    continue;
+                return;
+            }
+            Data += Written;
+            Size -= (size_t)Written;
+        }
+#endif
+    }
+
+    class clsFrameBuffer : public streambuf
+    {
+    private:
+        string _Frame;
+
+    protected:
+        int_type overflow(int_type Character) override
+        {
+            if (!traits_type::eq_int_type(Character, traits_type::eof()))
+                _Frame += traits_type::to_char_type(Character);
+            return traits_type::not_eof(Character);
+        }
+
+        streamsize xsputn(const char *Data, streamsize Count) override
+        {
+            _Frame.append(Data, (size_t)Count);
+            return Count;
+        }
+
+        int sync() override
+        {
+            return 0; // endl / flush: the frame is presented when input is read
+        }
+
+    public:
+        clsFrameBuffer()
+        {
+            _Frame.reserve(16 * 1024);
+        }
+
+        void Present()
+        {
+            if (_Frame.empty())
+                return;
+            _WriteAll(_Frame.data(), _Frame.size());
+            _Frame.clear();
+        }
+    };
+
+    class clsPresentOnSync : public streambuf
+    {
+    protected:
+        int sync() override
+        {
+            clsTerminal::Present();
+            return 0;
+        }
+    };
+
+    struct stState
+    {
+        clsFrameBuffer Frame;
+        clsPresentOnSync Trigger;
+        ostream TriggerStream;
+        streambuf *OriginalCoutBuffer = nullptr;
+        bool FrameOutput = false;
+        bool Ansi = _DetectAnsi();
+
+        stState() : TriggerStream(&Trigger)
+        {
+        }
+
+        ~stState()
+        {
+            // runs at exit: write what is left and give cout its buffer back
+            // before the iostreams are torn down
+            if (FrameOutput)
+            {
+                Frame.Present();
+                cout.rdbuf(OriginalCoutBuffer);
+                cin.tie(&cout);
+            }
+        }
+    };
+
+    static stState &_State()
+    {
+        static stState State;
+        return State;
+    }
+
+    static bool _DetectAnsi()
+    {
+#ifdef _WIN32
+        HANDLE Output = GetStdHandle(STD_OUTPUT_HANDLE);
+        DWORD Mode = 0;
+        if (!GetConsoleMode(Output, &Mode))
+            return false;
+        return SetConsoleMode(Output, Mode | ENABLE_VIRTUAL_TERMINAL_PROCESSING) != 0;
+#else
+        return isatty(STDOUT_FILENO) != 0;
+#endif
+    }
+
+public:
+    static void EnableFrameOutput()
+    {
+        stState &State = _State();
+        if (State.FrameOutput)
+            return;
+
+        State.OriginalCoutBuffer = cout.rdbuf(&State.Frame);
+        cin.tie(&State.TriggerStream);
+        State.FrameOutput = true;
+    }
+
+    static void Present()
+    {
+        stState &State = _State();
+        if (State.FrameOutput)
+            State.Frame.Present();
+        else
+            cout.flush();
+    }
+
+    static string ColorCode(int Color)
+    {
+        // Windows attribute (BGR bits + bright) -> ANSI SGR (RGB order)
+        if (Color == 7)
+            return "\033[0m";
+
+        auto AnsiIndex = [](int Bits)
+        { return ((Bits & 4) ? 1 : 0) | ((Bits & 2) ? 2 : 0) | ((Bits & 1) ? 4 : 0); };
+
+        int Foreground = Color & 0x0F;
+        int Background = (Color >> 4) & 0x0F;
+
+        string Code = "\033[0;" + to_string(((Foreground & 8) ? 90 : 30) + AnsiIndex(Foreground));
+        if (Background != 0)
+            Code += ";" + to_string(((Background & 8) ? 100 : 40) + AnsiIndex(Background));
+        return Code + "m";
+    }
+
+    static void SetColor(int Color)
+    {
+        stState &State = _State();
+        if (State.Ansi)
+        {
+            cout << ColorCode(Color);
+            return;
+        }
+#ifdef _WIN32
+        // legacy console: the attribute applies to what is written next
+        Present();
+        SetConsoleTextAttribute(GetStdHandle(STD_OUTPUT_HANDLE), (WORD)Color);
+#endif
+    }
+
+    static void ClearScreen()
+    {
+        stState &State = _State();
+        if (State.Ansi)
+        {
+            cout << "\033[H\033[2J\033[3J"; // home, clear screen, clear scrollback
+            return;
+        }
+#ifdef _WIN32
+        Present();
+        system("cls");
+#endif
+    }
+
+    static void PressAnyKey()
+    {
+        // waits for one key without echo, like "pause>0"
+        Present();
+#ifdef _WIN32
+        _getch();
+#else
+        if (!isatty(STDIN_FILENO))
+        {
+            cin.get();
+            return;
+        }
+
+        termios Original;
+        tcgetattr(STDIN_FILENO, &Original);
+
+        termios Raw = Original;
+        Raw.c_lflag &= ~(ICANON | ECHO);
+        Raw.c_cc[VMIN] = 1;
+        Raw.c_cc[VTIME] = 0;
+        tcsetattr(STDIN_FILENO, TCSANOW, &Raw);
+
+        char Key;
+        while (::read(STDIN_FILENO, &Key, 1) < 0 && errno == EINTR)
+        {
+        }
+
+        tcflush(STDIN_FILENO, TCIFLUSH); // the rest of a multi-byte key (arrows...)
+        tcsetattr(STDIN_FILENO, TCSANOW, &Original);
+#endif
+    }
+
+    static void SleepFor(int Milliseconds)
+    {
+        Present();
+        this_thread::sleep_for(chrono::milliseconds(Milliseconds));
+    }
+};
@@ -0,0 +1,522 @@
+/*clsThreadPool Overview
+================================================================================
+                                clsThreadPool.h
+================================================================================
+Overview:
+---------
+This file defines the clsThreadPool class, the work-stealing task scheduler
+shared by every parallel job in the system (table loading, interest runs,
+report aggregation, CSV import validation) and by the background jobs
+(snapshot writes, log compaction), so no job starts threads of its own.
+
+Every worker owns a deque of tasks:
+
+    worker 0 : [ oldest ............ newest ]  <- pushes / pops (its own tasks)
+                 ^ steals by idle workers
+    worker 1 : [ ... ]
+    injection: [ ... ]   tasks pushed by threads outside the pool
+    background:[ ... ]   Submit(): fire-and-forget, lowest priority
+
+- A worker runs its newest task first (the data it just split is still in
+  cache) and, when its deque is empty, takes the injection queue and then
+  steals the OLDEST task of another worker, which is the biggest piece of
+  work left (ranges are split in halves, the first halves pushed first).
+- The thread that calls ParallelFor() works too: it splits the range, runs
+  pieces and, while pieces run elsewhere, helps with queued pieces instead of
+  sleeping. A ParallelFor() inside a task therefore never deadlocks.
+- Background tasks only run on workers, never on a thread waiting for a
+  ParallelFor(): a report never ends up writing a snapshot.
+- Idle workers sleep on a condition variable; nothing spins while the pool
+  has no work.
+
+================================================================================
+Chunks And Determinism:
+-----------------------
+ParallelFor(Begin, End, Grain, Body) cuts [Begin, End) into fixed chunks of
+Grain items (the last one shorter) and calls Body(ChunkBegin, ChunkEnd) once
+per chunk, on any thread, in any order. A range of at most Grain items runs
+on the calling thread without touching the pool.
+
+ParallelReduce() computes one partial result per chunk and combines them in
+chunk order on the calling thread. The chunks do not depend on the worker
+count or on who ran what, so a floating-point total is the same on every run
+and on every machine (for up to Grain items it is exactly the serial loop).
+
+Bodies should compute, not wait: a body that blocks on a lock held by the
+thread waiting for the ParallelFor() can deadlock it.
+
+An exception thrown by a body is rethrown by ParallelFor() after all chunks
+have finished (the first one wins).
+
+================================================================================
+Configuration:
+--------------
+- SharedWorkers: worker threads of the Shared() pool, read once when the
+  pool is first used (0 = one per hardware thread). The application sets it
+  from --workers / SMARTBANK_WORKERS. With 1 worker every ParallelFor() runs
+  its chunks in order on the calling thread (the serial baseline).
+- The pool is created on first use, so start-up time does not include it.
+- SetTaskHook(Hook): called after every task with its name, the worker that
+  ran it, the time it waited in a queue and the time it ran (per-task timing,
+  e.g. into clsMetrics). No clock is read while no hook is set.
+
+================================================================================
+Public Methods:
+---------------
+    explicit clsThreadPool(size_t Workers)
+    static clsThreadPool &Shared()
+    size_t WorkerCount() const
+    void ParallelFor(size_t Begin, size_t End, size_t Grain, Body(size_t, size_t), const char *Name)
+    T ParallelReduce(size_t Begin, size_t End, size_t Grain, T Identity,
+                     Map(size_t, size_t) -> T, Combine(T, T) -> T, const char *Name)
+    void Submit(Task(), const char *Name)          background, fire-and-forget
+    stStatistics GetStatistics() const              tasks run / stolen so far
+    static void SetTaskHook(TaskHook Hook)
+    static size_t DefaultWorkerCount()
+
+================================================================================
+Usage Example:
+--------------
+    double Total = clsThreadPool::Shared().ParallelReduce(
+        0, vBalances.size(), 65536, 0.0,
+        [&](size_t Begin, size_t End)
+        {
+            double Sum = 0;
+            for (size_t i = Begin; i < End; i++)
+                Sum += vBalances[i];
+            return Sum;
+        },
+        [](double A, double B) { return A + B; }, "TotalBalances");
+
+================================================================================
+*/
+
+#pragma once
+
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <deque>
+#include <vector>
+#include <memory>
+#include <functional>
+#include <exception>
+#include <chrono>
+#include <algorithm>
+
+using namespace std;
+
+class clsThreadPool
+{
+public:
+    struct stTaskTiming
+    {
+        const char *Name = "";
+        int Worker = -1;                    // -1: a thread outside the pool
+        bool Stolen = false;                // taken from another worker's deque
+        unsigned long long QueuedNanos = 0; // pushed -> started
+        unsigned long long RunNanos = 0;    // started -> finished
+    };
+
+    typedef function<void(const stTaskTiming &Timing)> TaskHook;
+
+    struct stStatistics
+    {
+        unsigned long long TasksRun = 0;
+        unsigned long long TasksStolen = 0;
+    };
+
+    // worker threads of Shared(), read when it is created (0 = hardware threads)
+    inline static size_t SharedWorkers = 0;
+
+private:
+    struct stGroup
+    {
+        atomic<size_t> Pending{0};
+        mutex ErrorMutex;
+        exception_ptr Error;
+    };
+
+    struct stTask
+    {
+        function<void()> Work;
+        const char *Name = "";
+        stGroup *Group = nullptr; // nullptr: background task
+        chrono::steady_clock::time_point Queued;
+    };
+
+    struct alignas(64) stQueue
+    {
+        mutex Mutex;
+        deque<stTask> Tasks;
+        atomic<unsigned long long> Run{0};
+        atomic<unsigned long long> Stolen{0};
+    };
+
+    // _Queues[0 .. Workers-1]: one per worker, then the injection queue
+    vector<unique_ptr<stQueue>> _Queues;
+    stQueue _Background;
+    vector<thread> _Workers;
+    size_t _WorkerCount = 0; // set before the first worker starts
+
+    mutex _SleepMutex;
+    condition_variable _WakeUp;
+    atomic<size_t> _Queued{0};
+    bool _Stopping = false;
+
+    // which pool and worker the current thread is (nullptr outside any pool)
+    inline static thread_local clsThreadPool *_CurrentPool = nullptr;
+    inline static thread_local size_t _CurrentWorker = 0;
+
+    static shared_ptr<const TaskHook> &_Hook()
+    {
+        static shared_ptr<const TaskHook> Hook;
+        return Hook;
+    }
+
+    size_t _InjectionQueue() const { return _WorkerCount; }
+
+    int _WorkerIndex() const
+    {
+        return (_CurrentPool == this) ? (int)_CurrentWorker : -1;
+    }
+
+    void _Push(stTask Task, stQueue &Queue)
+    {
+        if (atomic_load(&_Hook()))
+            Task.Queued = chrono::steady_clock::now();
+        {
+            lock_guard<mutex> Lock(Queue.Mutex);
+            Queue.Tasks.push_back(move(Task));
+        }
+        _Queued++;
+        {
+            // empty critical section: a worker between its check and its
+            // wait cannot miss this notification
+            lock_guard<mutex> Lock(_SleepMutex);
+        }
+        _WakeUp.notify_one();
+    }
+
+    void _PushShared(stTask Task)
+    {
+        int Worker = _WorkerIndex();
+        _Push(move(Task), *_Queues[(Worker < 0) ? _InjectionQueue() : (size_t)Worker]);
+    }
+
+    bool _PopBack(stQueue &Queue, stTask &Task)
+    {
+        lock_guard<mutex> Lock(Queue.Mutex);
+        if (Queue.Tasks.empty())
+            return false;
+        Task = move(Queue.Tasks.back());
+        Queue.Tasks.pop_back();
+        return true;
+    }
+
+    bool _PopFront(stQueue &Queue, stTask &Task)
+    {
+        lock_guard<mutex> Lock(Queue.Mutex);
+        if (Queue.Tasks.empty())
+            return false;
+        Task = move(Queue.Tasks.front());
+        Queue.Tasks.pop_front();
+        return true;
+    }
+
+    bool _TakeTask(int Worker, bool TakeBackground, stTask &Task, bool &Stolen)
+    {
+        // own deque (newest first), then the injection queue, then the oldest
+        // task of another worker, then (idle workers only) background work
+        Stolen = false;
+        if (Worker >= 0 && _PopBack(*_Queues[Worker], Task))
+            return true;
+        if (_PopFront(*_Queues[_InjectionQueue()], Task))
+            return true;
+
+        size_t Workers = _WorkerCount;
+        size_t Start = (Worker >= 0) ? (size_t)Worker + 1 : 0;
+        for (size_t i = 0; i < Workers; i++)
+        {
+            size_t Victim = (Start + i) % Workers;
+            if ((int)Victim != Worker && _PopFront(*_Queues[Victim], Task))
+            {
+                Stolen = true;
+                return true;
+            }
+        }
+
+        return TakeBackground && _PopFront(_Background, Task);
+    }
+
+    void _Run(stTask &Task, int Worker, bool Stolen)
+    {
+        _Queued--;
+
+        shared_ptr<const TaskHook> Hook = atomic_load(&_Hook());
+        chrono::steady_clock::time_point Start;
+        if (Hook)
+            Start = chrono::steady_clock::now();
+
+        try
+        {
+            Task.Work();
+        }
+        catch (...)
+        {
+            if (Task.Group == nullptr)
+                throw; // background task: nobody to hand it to (as on its own thread)
+            lock_guard<mutex> Lock(Task.Group->ErrorMutex);
+            if (!Task.Group->Error)
+                Task.Group->Error = current_exception();
+        }
+
+        stQueue &Counters = (Worker >= 0) ? *_Queues[Worker] : *_Queues[_InjectionQueue()];
+        Counters.Run.fetch_add(1, memory_order_relaxed);
+        if (Stolen)
+            Counters.Stolen.fetch_add(1, memory_order_relaxed);
+
+        if (Hook)
+        {
+            stTaskTiming Timing;
+            Timing.Name = Task.Name;
+            Timing.Worker = Worker;
+            Timing.Stolen = Stolen;
+            auto End = chrono::steady_clock::now();
+            if (Task.Queued.time_since_epoch().count() != 0)
+                Timing.QueuedNanos = (unsigned long long)chrono::duration_cast<chrono::nanoseconds>(Start - Task.Queued).count();
+            Timing.RunNanos = (unsigned long long)chrono::duration_cast<chrono::nanoseconds>(End - Start).count();
+            (*Hook)(Timing);
+        }
+
+        // last: the waiting thread may return (and free the group) right after
+        if (Task.Group != nullptr)
+            Task.Group->Pending.fetch_sub(1, memory_order_acq_rel);
+    }
+
+    void _WorkerLoop(size_t Index)
+    {
+        _CurrentPool = this;
+        _CurrentWorker = Index;
+
+        stTask Task;
+        bool Stolen = false;
+        while (true)
+        {
+            if (_TakeTask((int)Index, true, Task, Stolen))
+            {
+                _Run(Task, (int)Index, Stolen);
+                Task = stTask();
+                continue;
+            }
+
+            unique_lock<mutex> Lock(_SleepMutex);
+            if (_Stopping && _Queued == 0)
+                return;
+            _WakeUp.wait(Lock, [this]()
+                         { return _Stopping || _Queued > 0; });
+        }
+    }
+
+    void _Wait(stGroup &Group)
+    {
+        // help instead of sleeping: pieces of this (or another) ParallelFor
+        int Worker = _WorkerIndex();
+        stTask Task;
+        bool Stolen = false;
+        while (Group.Pending.load(memory_order_acquire) > 0)
+        {
+            if (_TakeTask(Worker, false, Task, Stolen))
+            {
+                _Run(Task, Worker, Stolen);
+                Task = stTask();
+            }
+            else
+                this_thread::yield();
+        }
+
+        if (Group.Error)
+            rethrow_exception(Group.Error);
+    }
+
+    void _ForChunks(stGroup &Group, size_t First, size_t Last, const function<void(size_t Chunk)> &RunChunk, const char *Name)
+    {
+        // keep the first half, push the second: the oldest task in a deque
+        // is always the biggest range left, which is what a thief takes
+        while (Last - First > 1)
+        {
+            size_t Middle = First + (Last - First) / 2;
+            Group.Pending++;
+
+            stTask Task;
+            Task.Name = Name;
+            Task.Group = &Group;
+            Task.Work = [this, &Group, Middle, Last, &RunChunk, Name]()
+            { _ForChunks(Group, Middle, Last, RunChunk, Name); };
+            _PushShared(move(Task));
+
+            Last = Middle;
+        }
+        RunChunk(First);
+    }
+
+    void _RunInline(size_t Begin, size_t End, const function<void(size_t, size_t)> &Body, const char *Name)
+    {
+        // small range: the calling thread, no queue; still reported to the hook
+        shared_ptr<const TaskHook> Hook = atomic_load(&_Hook());
+        if (!Hook)
+        {
+            Body(Begin, End);
+            return;
+        }
+
+        auto Start = chrono::steady_clock::now();
+        Body(Begin, End);
+
+        stTaskTiming Timing;
+        Timing.Name = Name;
+        Timing.Worker = _WorkerIndex();
+        Timing.RunNanos = (unsigned long long)chrono::duration_cast<chrono::nanoseconds>(chrono::steady_clock::now() - Start).count();
+        (*Hook)(Timing);
+    }
+
+public:
+    explicit clsThreadPool(size_t Workers)
+    {
+        if (Workers == 0)
+            Workers = DefaultWorkerCount();
+        _WorkerCount = Workers;
+
+        for (size_t i = 0; i <= Workers; i++) // + the injection queue
+            _Queues.push_back(make_unique<stQueue>());
+
+        _Workers.reserve(Workers);
+        for (size_t i = 0; i < Workers; i++)
+            _Workers.emplace_back(&clsThreadPool::_WorkerLoop, this, i);
+    }
+
+    ~clsThreadPool()
+    {
+        // queued tasks (a pending snapshot write) still run before the join
+        {
+            lock_guard<mutex> Lock(_SleepMutex);
+            _Stopping = true;
+        }
+        _WakeUp.notify_all();
+        for (thread &Worker : _Workers)
+            Worker.join();
+    }
+
+    clsThreadPool(const clsThreadPool &) = delete;
+    clsThreadPool &operator=(const clsThreadPool &) = delete;
+
+    static size_t DefaultWorkerCount()
+    {
+        return max(1u, thread::hardware_concurrency());
+    }
+
+    static clsThreadPool &Shared()
+    {
+        static clsThreadPool Pool(SharedWorkers);
+        return Pool;
+    }
+
+    size_t WorkerCount() const { return _WorkerCount; }
+
+    static void SetTaskHook(TaskHook Hook)
+    {
+        // an empty hook removes it
+        shared_ptr<const TaskHook> New = Hook ? make_shared<const TaskHook>(move(Hook)) : nullptr;
+        atomic_store(&_Hook(), New);
+    }
+
+    void ParallelFor(size_t Begin, size_t End, size_t Grain, const function<void(size_t Begin, size_t End)> &Body,
+                     const char *Name = "ParallelFor")
+    {
+        if (End <= Begin)
+            return;
+        if (Grain == 0)
+            Grain = 1;
+
+        size_t Count = End - Begin;
+        if (Count <= Grain || _WorkerCount <= 1)
+        {
+            // one chunk, or nobody to share it with: the chunks in order here
+            for (size_t ChunkBegin = Begin; ChunkBegin < End; ChunkBegin += min(Grain, End - ChunkBegin))
+                _RunInline(ChunkBegin, min(ChunkBegin + Grain, End), Body, Name);
+            return;
+        }
+
+        size_t Chunks = (Count + Grain - 1) / Grain;
+        auto RunChunk = [Begin, End, Grain, &Body](size_t Chunk)
+        {
+            size_t ChunkBegin = Begin + Chunk * Grain;
+            Body(ChunkBegin, min(ChunkBegin + Grain, End));
+        };
+
+        stGroup Group;
+        Group.Pending = 1; // the caller's own share, done below
+        function<void(size_t)> RunChunkFunction = RunChunk;
+        try
+        {
+            _ForChunks(Group, 0, Chunks, RunChunkFunction, Name);
+        }
+        catch (...)
+        {
+            lock_guard<mutex> Lock(Group.ErrorMutex);
+            if (!Group.Error)
+                Group.Error = current_exception();
+        }
+        Group.Pending--;
+        _Wait(Group);
+    }
+
+    template <typename T, typename MapFunction, typename CombineFunction>
+    T ParallelReduce(size_t Begin, size_t End, size_t Grain, T Identity, MapFunction Map, CombineFunction Combine,
+                     const char *Name = "ParallelReduce")
+    {
+        // one partial per chunk, combined in chunk order (deterministic)
+        if (End <= Begin)
+            return Identity;
+        if (Grain == 0)
+            Grain = 1;
+
+        size_t Chunks = (End - Begin + Grain - 1) / Grain;
+        if (Chunks == 1)
+        {
+            T Result = Identity;
+            _RunInline(Begin, End, [&](size_t ChunkBegin, size_t ChunkEnd)
+                       { Result = Combine(Result, Map(ChunkBegin, ChunkEnd)); }, Name);
+            return Result;
+        }
+
+        vector<T> vPartials(Chunks, Identity);
+        ParallelFor(Begin, End, Grain, [&](size_t ChunkBegin, size_t ChunkEnd)
+                    { vPartials[(ChunkBegin - Begin) / Grain] = Map(ChunkBegin, ChunkEnd); }, Name);
+
+        T Result = Identity;
+        for (const T &Partial : vPartials)
+            Result = Combine(Result, Partial);
+        return Result;
+    }
+
+    void Submit(function<void()> Task, const char *Name = "Background")
+    {
+        stTask Background;
+        Background.Work = move(Task);
+        Background.Name = Name;
+        _Push(move(Background), _Background);
+    }
+
+    stStatistics GetStatistics() const
+    {
+        stStatistics Statistics;
+        for (const unique_ptr<stQueue> &Queue : _Queues)
+        {
+            Statistics.TasksRun += Queue->Run.load(memory_order_relaxed);
+            Statistics.TasksStolen += Queue->Stolen.load(memory_order_relaxed);
+        }
+        return Statistics;
+    }
+};
@@ -0,0 +1,279 @@
+/*clsTimerWheel Overview
+================================================================================
+                                clsTimerWheel.h
+================================================================================
+Overview:
+---------
+This file defines the clsTimerWheel class template, a hierarchical timer
+wheel: items are scheduled on an integer tick (clsStandingOrders uses day
+numbers) and handed back, in tick order and one batch per tick, when the wheel
+is advanced past that tick.
+
+A sorted list or a "scan everything on every tick" loop costs O(N) per tick.
+The wheel costs O(1) to schedule and only touches the slots that hold work:
+
+    level 0 : 64 slots of 1 tick        (the current 64 ticks)
+    level 1 : 64 slots of 64 ticks      (the current 4,096 ticks)
+    level 2 : 64 slots of 4,096 ticks   (the current 262,144 ticks)
+    level 3 : 64 slots of 262,144 ticks (the current 16,777,216 ticks)
+
+An item is placed on the lowest level whose slot holds its tick. When time
+reaches a higher-level slot, its items are cascaded (re-placed) into the lower
+levels, so every item moves at most Levels times before it fires.
+
+================================================================================
+Skipping Idle Time:
+-------------------
+Every level keeps a 64-bit occupancy mask. Advance() jumps straight to the
+next occupied slot instead of stepping tick by tick, so catching up after a
+long downtime (Advance over years of days) costs the number of occupied
+slots, not the number of ticks.
+
+================================================================================
+Rules:
+------
+- Items scheduled on a tick that has already passed fire on the next Advance().
+- Items scheduled from inside the OnDue callback on a tick <= the current
+  target fire in the same Advance() call.
+- There is no Cancel(): callers check whether an item is still wanted when it
+  fires (lazy cancellation), which keeps slots plain vectors.
+- Not thread-safe: one owner advances the wheel.
+
+================================================================================
+Public Methods:
+---------------
+    clsTimerWheel(long long StartTick)
+    void Schedule(long long Tick, T Item)
+    size_t Advance(long long TargetTick, OnDue(long long Tick, vector<T> &vDue))
+    long long GetCurrentTick() const      first tick not processed yet
+    size_t Size() const                   items waiting
+
+================================================================================
+Usage Example:
+--------------
+    clsTimerWheel<int> Wheel(clsDate::ToDayNumber(clsDate::GetSystemDate()));
+    Wheel.Schedule(Today + 30, OrderId);
+
+    Wheel.Advance(Today + 365, [](long long Day, vector<int> &vDue)
+    {
+        // every order due on Day, in one batch
+    });
+
+================================================================================
+*/
+
+#pragma once
+
+#include <vector>
+#include <utility>
+
+using namespace std;
+
+template <typename T>
+class clsTimerWheel
+{
+public:
+    static const unsigned int SlotBits = 6;
+    static const unsigned int SlotsPerLevel = 1u << SlotBits;
+    static const unsigned int Levels = 4;
+
+private:
+    struct stEntry
+    {
+        long long Tick;
+        T Item;
+    };
+
+    vector<stEntry> _Slots[Levels][SlotsPerLevel];
+    unsigned long long _Occupied[Levels] = {};
+    vector<stEntry> _Overflow; // beyond the top level: re-placed when time gets there
+    long long _Current;
+    size_t _Size = 0;
+
+    static unsigned int _SlotOf(long long Tick, unsigned int Level)
+    {
+        return (unsigned int)((Tick >> (SlotBits * Level)) & (SlotsPerLevel - 1));
+    }
+
+    static unsigned int _LowestBit(unsigned long long Mask)
+    {
+        unsigned int Bit = 0;
+        while ((Mask & 1ull) == 0)
+        {
+            Mask >>= 1;
+            Bit++;
+        }
+        return Bit;
+    }
+
+    void _Place(stEntry Entry)
+    {
+        // the level is the highest 6-bit digit where the tick differs from the
+        // current tick: the slot of that level is the tick's digit
+        if (Entry.Tick < _Current)
+            Entry.Tick = _Current;
+
+        unsigned long long Diff = (unsigned long long)(Entry.Tick ^ _Current);
+        unsigned int Level = 0;
+        while (Level < Levels && (Diff >> (SlotBits * (Level + 1))) != 0)
+            Level++;
+
+        if (Level == Levels)
+        {
+            _Overflow.push_back(move(Entry));
+            return;
+        }
+
+        unsigned int Slot = _SlotOf(Entry.Tick, Level);
+        _Slots[Level][Slot].push_back(move(Entry));
+        _Occupied[Level] |= 1ull << Slot;
+    }
+
+    vector<stEntry> _TakeSlot(unsigned int Level, unsigned int Slot)
+    {
+        vector<stEntry> vEntries;
+        vEntries.swap(_Slots[Level][Slot]);
+        _Occupied[Level] &= ~(1ull << Slot);
+        return vEntries;
+    }
+
+    bool _NextOccupiedSlot(long long &Tick, unsigned int &Level) const
+    {
+        // lower levels always hold earlier ticks than higher levels
+        for (unsigned int L = 0; L < Levels; L++)
+        {
+            unsigned long long Ahead = _Occupied[L] & (~0ull << _SlotOf(_Current, L));
+            if (Ahead == 0)
+                continue;
+
+            unsigned int BlockShift = SlotBits * (L + 1);
+            long long BlockStart = (_Current >> BlockShift) << BlockShift;
+
+            Tick = BlockStart + ((long long)_LowestBit(Ahead) << (SlotBits * L));
+            Level = L;
+            return true;
+        }
+        return false;
+    }
+
+    void _ReplaceOverflow()
+    {
+        // overflow items that now share the top block with the current tick
+        // move into the levels, the others go back to the overflow list
+        vector<stEntry> vEntries;
+        vEntries.swap(_Overflow);
+        for (stEntry &Entry : vEntries)
+            _Place(move(Entry));
+    }
+
+    void _MoveTo(long long Tick)
+    {
+        // every higher-level slot the current tick enters is cascaded at once,
+        // top level first, so lower levels always hold the earliest items
+        long long Changed = Tick ^ _Current;
+        _Current = Tick;
+
+        if (!_Overflow.empty() && (Changed >> (SlotBits * Levels)) != 0)
+            _ReplaceOverflow();
+
+        for (unsigned int Level = Levels - 1; Level > 0; Level--)
+        {
+            unsigned int Slot = _SlotOf(Tick, Level);
+            if ((Changed >> (SlotBits * Level)) == 0 || (_Occupied[Level] & (1ull << Slot)) == 0)
+                continue;
+
+            for (stEntry &Entry : _TakeSlot(Level, Slot))
+                _Place(move(Entry));
+        }
+    }
+
+    bool _PullOverflow(long long TargetTick)
+    {
+        // all levels are empty: jump to the earliest overflow item if it is due
+        if (_Overflow.empty())
+            return false;
+
+        long long Earliest = _Overflow[0].Tick;
+        for (const stEntry &Entry : _Overflow)
+            Earliest = (Entry.Tick < Earliest) ? Entry.Tick : Earliest;
+
+        if (Earliest > TargetTick)
+            return false;
+
+        _MoveTo(Earliest);
+        return true;
+    }
+
+public:
+    explicit clsTimerWheel(long long StartTick = 0) : _Current(StartTick)
+    {
+    }
+
+    void Schedule(long long Tick, T Item)
+    {
+        _Place({Tick, move(Item)});
+        _Size++;
+    }
+
+    template <typename OnDueFunction>
+    size_t Advance(long long TargetTick, OnDueFunction OnDue)
+    {
+        // Advance process steps:
+        // 1. Find the next occupied slot through the occupancy masks.
+        // 2. Level 0 slot: its items are due on that tick, hand them over as one batch.
+        //    Higher level slot: move to its first tick, which cascades it.
+        // 3. Repeat until the next slot is after TargetTick, then move the
+        //    current tick to TargetTick + 1.
+        size_t Fired = 0;
+        long long Tick;
+        unsigned int Level;
+
+        while (TargetTick >= _Current)
+        {
+            if (!_NextOccupiedSlot(Tick, Level))
+            {
+                if (_PullOverflow(TargetTick))
+                    continue;
+                break;
+            }
+
+            if (Tick > TargetTick)
+                break;
+
+            if (Level > 0)
+            {
+                _MoveTo(Tick); // entering the slot cascades it
+                continue;
+            }
+
+            vector<stEntry> vEntries = _TakeSlot(0, _SlotOf(Tick, 0));
+
+            // past this tick before calling out, so items rescheduled from the
+            // callback land on later ticks
+            _MoveTo(Tick + 1);
+            _Size -= vEntries.size();
+            Fired += vEntries.size();
+
+            vector<T> vDue;
+            vDue.reserve(vEntries.size());
+            for (stEntry &Entry : vEntries)
+                vDue.push_back(move(Entry.Item));
+
+            OnDue(Tick, vDue);
+        }
+
+        if (_Current <= TargetTick)
+            _MoveTo(TargetTick + 1);
+        return Fired;
+    }
+
+    long long GetCurrentTick() const
+    {
+        return _Current;
+    }
+
+    size_t Size() const
+    {
+        return _Size;
+    }
+};
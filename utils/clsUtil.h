@@ -22,11 +22,21 @@ Class Responsibilities:
 6. Convert numbers to their English textual representation.
 7. Encrypt and decrypt strings using a simple Caesar cipher.
 
+================================================================================
+Random Generator:
+-----------------
+All random helpers draw from one std::mt19937 engine. Its output sequence is
+fixed by the C++ standard, so Srand(Seed) reproduces exactly the same words,
+keys and numbers on every compiler and platform (the data generator and the
+benchmarks rely on this). Srand() seeds it from the clock as before.
+
 ================================================================================
 Public Methods:
 ---------------
 - Random Generators:
     static void Srand()                         // Seed the random number generator
+    static void Srand(unsigned int Seed)        // Seed with a fixed value (reproducible runs)
+    static unsigned int NextRandom()            // Raw 32-bit value from the generator
     static int RandomNumber(int From, int To)   // Generate random number in range
     static char GetRandomCharacter(enCharType CharType)
     static string GenerateWord(enCharType CharType, short Length)
@@ -72,7 +82,7 @@ Enums:
 Usage Examples:
 ---------------
 
-    clsUtil::Srand();
+    clsUtil::Srand();          // or clsUtil::Srand(42) for a repeatable sequence
     int r = clsUtil::RandomNumber(1, 100);
     char c = clsUtil::GetRandomCharacter(clsUtil::CapitalLetter);
     string word = clsUtil::GenerateWord(clsUtil::SamallLetter, 6);
@@ -98,6 +108,8 @@ End of Documentation
 
 #include <iostream>
 #include <string>
+#include <random>
+#include <ctime>
 
 #include "clsDate.h"  // utils/clsDate.h
 
@@ -106,6 +118,13 @@ using namespace std;
 class clsUtil
 {
 
+private:
+    static mt19937 &_Generator()
+    {
+        static mt19937 Generator(5489u); // std::mt19937 default seed until Srand() is called
+        return Generator;
+    }
+
 public:
     enum enCharType
     {
@@ -118,13 +137,28 @@ public:
     static void Srand()
     {
         // Seeds the random number generator in C++, called only once
-        srand((unsigned)time(NULL));
+        Srand((unsigned)time(NULL));
+    }
+
+    static void Srand(unsigned int Seed)
+    {
+        // Same seed -> same sequence, on every platform
+        srand(Seed);
+        _Generator().seed(Seed);
+    }
+
+    static unsigned int NextRandom()
+    {
+        return (unsigned int)_Generator()();
     }
 
     static int RandomNumber(int From, int To)
     {
         // Function to generate a random number
-        int randNum = rand() % (To - From + 1) + From;
+        // (modulo of the raw mt19937 output instead of uniform_int_distribution,
+        //  whose algorithm differs between standard libraries)
+        unsigned int Range = (unsigned int)(To - From) + 1;
+        int randNum = From + (int)(NextRandom() % Range);
         return randNum;
     }
 
@@ -173,12 +207,13 @@ public:
 
     {
         string Word;
+        Word.reserve(Length > 0 ? Length : 0);
 
         for (int i = 1; i <= Length; i++)
 
         {
 
-            Word = Word + GetRandomCharacter(CharType);
+            Word += GetRandomCharacter(CharType);
         }
         return Word;
     }
@@ -367,7 +402,7 @@ public:
     static string EncryptText(string Text, short EncryptionKey = 2)
     {
 
-        for (int i = 0; i <= Text.length(); i++)
+        for (size_t i = 0; i < Text.length(); i++)
         {
 
             Text[i] = char((int)Text[i] + EncryptionKey);
@@ -379,7 +414,7 @@ public:
     static string DecryptText(string Text, short EncryptionKey = 2)
     {
 
-        for (int i = 0; i <= Text.length(); i++)
+        for (size_t i = 0; i < Text.length(); i++)
         {
 
             Text[i] = char((int)Text[i] - EncryptionKey);